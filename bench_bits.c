@@ -0,0 +1,209 @@
+#define _POSIX_C_SOURCE 200809L
+
+// Mide los kernels de bits_simd.c en cada nivel (escalar, SSE4.2, AVX2) sobre
+// las familias densas de grafos/ llevadas a cientos o miles de nodos: completo,
+// bipartito completo y aleatorio con 70% de densidad. Para cada tamaño muestra
+// la mediana de varias repeticiones de:
+//   grados      popcount de todas las filas (vector de grados y paridades)
+//   expansion   una frontera con todos los nodos: OR de todas las filas sin los
+//               visitados (el mismo paso que un OR sobre predecesores)
+//   clasificar  clasificar_euleriano_csr completo (grados del CSR + conexidad)
+//
+// Uso: bench_bits [N ...]     (por omisión 1000 2000 4000)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bits_simd.h"
+#include "euler.h"
+#include "matriz_bits.h"
+
+#define REPETICIONES 7
+
+typedef enum {
+    FAMILIA_COMPLETO,
+    FAMILIA_BIPARTITO,
+    FAMILIA_ALEATORIO_70
+} Familia;
+
+static const char *NOMBRES_FAMILIA[] = {"completo", "bipartito", "aleatorio_70"};
+
+static double ahora_ms(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+static int comparar_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double mediana(double *tiempos, int n) {
+    qsort(tiempos, (size_t)n, sizeof(double), comparar_double);
+    return tiempos[n / 2];
+}
+
+static uint64_t siguiente_aleatorio(uint64_t *estado) {
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+static bool hay_arista(Familia familia, int n, int u, int v, uint64_t *estado) {
+    switch (familia) {
+        case FAMILIA_COMPLETO: return true;
+        case FAMILIA_BIPARTITO: return (u < n / 2) != (v < n / 2);
+        default: return siguiente_aleatorio(estado) % 100 < 70;
+    }
+}
+
+// Grafo no dirigido simple, con cada arista en ambos sentidos como en el CSR
+static bool generar(Familia familia, int n, GrafoCSR *grafo) {
+    memset(grafo, 0, sizeof(*grafo));
+    grafo->num_nodos = n;
+    grafo->tipo = NO_DIRIGIDO;
+    MatrizBits matriz = {n, ((size_t)n + 63) / 64, NULL};
+    matriz.filas = calloc((size_t)n * matriz.palabras_fila, sizeof(uint64_t));
+    grafo->inicio = malloc(((size_t)n + 1) * sizeof(long long));
+    if (!matriz.filas || !grafo->inicio) {
+        free(matriz.filas);
+        return false;
+    }
+
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    long long arcos = 0;
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (!hay_arista(familia, n, u, v, &estado)) continue;
+            fila_matriz_bits(&matriz, u)[v / 64] |= (uint64_t)1 << (v % 64);
+            fila_matriz_bits(&matriz, v)[u / 64] |= (uint64_t)1 << (u % 64);
+            arcos += 2;
+        }
+    }
+    grafo->num_arcos = arcos;
+    grafo->destinos = malloc((size_t)(arcos > 0 ? arcos : 1) * sizeof(int));
+    if (!grafo->destinos) {
+        free(matriz.filas);
+        return false;
+    }
+    long long a = 0;
+    for (int u = 0; u < n; u++) {
+        grafo->inicio[u] = a;
+        for (int v = 0; v < n; v++) {
+            if ((fila_matriz_bits(&matriz, u)[v / 64] >> (v % 64)) & 1) grafo->destinos[a++] = v;
+        }
+    }
+    grafo->inicio[n] = a;
+    free(matriz.filas);
+    return true;
+}
+
+typedef struct {
+    double grados;
+    double expansion;
+    double clasificar;
+} Tiempos;
+
+static Tiempos medir(const GrafoCSR *grafo, const MatrizBits *matriz) {
+    int n = matriz->num_nodos;
+    size_t w = matriz->palabras_fila;
+    long long *grados = malloc((size_t)n * sizeof(long long));
+    uint64_t *siguiente = calloc(w, sizeof(uint64_t));
+    uint64_t *visitados = calloc(w, sizeof(uint64_t));
+    Tiempos t = {0, 0, 0};
+    if (!grados || !siguiente || !visitados) {
+        free(grados);
+        free(siguiente);
+        free(visitados);
+        return t;
+    }
+    // La mitad de los nodos, salteados, ya visitados
+    for (size_t i = 0; i < w; i++) visitados[i] = 0x5555555555555555ULL;
+
+    double tiempos[REPETICIONES];
+    long long control = 0;
+    for (int r = 0; r < REPETICIONES; r++) {
+        double inicio = ahora_ms();
+        for (int u = 0; u < n; u++) {
+            grados[u] = contar_bits_palabras(fila_matriz_bits(matriz, u), w);
+        }
+        tiempos[r] = ahora_ms() - inicio;
+        control += grados[n - 1];
+    }
+    t.grados = mediana(tiempos, REPETICIONES);
+
+    for (int r = 0; r < REPETICIONES; r++) {
+        memset(siguiente, 0, w * sizeof(uint64_t));
+        double inicio = ahora_ms();
+        for (int u = 0; u < n; u++) {
+            acumular_fila_bits(siguiente, fila_matriz_bits(matriz, u), visitados, w);
+        }
+        tiempos[r] = ahora_ms() - inicio;
+        control += (long long)siguiente[0];
+    }
+    t.expansion = mediana(tiempos, REPETICIONES);
+
+    for (int r = 0; r < REPETICIONES; r++) {
+        int inicio_recorrido;
+        double inicio = ahora_ms();
+        control += clasificar_euleriano_csr(grafo, &inicio_recorrido);
+        tiempos[r] = ahora_ms() - inicio;
+    }
+    t.clasificar = mediana(tiempos, REPETICIONES);
+
+    // Que el compilador no descarte los cálculos
+    if (control == 42) fprintf(stderr, " ");
+    free(grados);
+    free(siguiente);
+    free(visitados);
+    return t;
+}
+
+int main(int argc, char *argv[]) {
+    int tamanos[16] = {1000, 2000, 4000};
+    int num_tamanos = 3;
+    if (argc > 1) {
+        num_tamanos = 0;
+        for (int i = 1; i < argc && num_tamanos < 16; i++) {
+            int n = atoi(argv[i]);
+            if (n < 2) {
+                fprintf(stderr, "Uso: %s [N ...] (N >= 2)\n", argv[0]);
+                return 2;
+            }
+            tamanos[num_tamanos++] = n;
+        }
+    }
+
+    NivelSimd soportado = nivel_simd();
+    printf("Procesador: hasta %s\n", nombre_nivel_simd(soportado));
+    printf("%-13s %6s %-8s %12s %7s %12s %7s %12s\n", "familia", "n", "nivel",
+           "grados_ms", "x", "expansion_ms", "x", "clasificar_ms");
+
+    for (int f = FAMILIA_COMPLETO; f <= FAMILIA_ALEATORIO_70; f++) {
+        for (int i = 0; i < num_tamanos; i++) {
+            GrafoCSR grafo;
+            MatrizBits matriz;
+            if (!generar((Familia)f, tamanos[i], &grafo) || !matriz_bits_desde_csr(&grafo, false, &matriz)) {
+                fprintf(stderr, "%s %d: Memoria insuficiente\n", NOMBRES_FAMILIA[f], tamanos[i]);
+                liberar_grafo_csr(&grafo);
+                return 1;
+            }
+            Tiempos base = {0, 0, 0};
+            for (int nivel = SIMD_ESCALAR; nivel <= (int)soportado; nivel++) {
+                limitar_nivel_simd((NivelSimd)nivel);
+                Tiempos t = medir(&grafo, &matriz);
+                if (nivel == SIMD_ESCALAR) base = t;
+                printf("%-13s %6d %-8s %12.3f %7.2f %12.3f %7.2f %12.3f\n", NOMBRES_FAMILIA[f], tamanos[i],
+                       nombre_nivel_simd((NivelSimd)nivel), t.grados, base.grados / t.grados,
+                       t.expansion, base.expansion / t.expansion, t.clasificar);
+            }
+            liberar_matriz_bits(&matriz);
+            liberar_grafo_csr(&grafo);
+        }
+    }
+    limitar_nivel_simd(soportado);
+    return 0;
+}
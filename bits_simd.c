@@ -0,0 +1,233 @@
+#include "bits_simd.h"
+
+#include <stdatomic.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BITS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+typedef struct {
+    long long (*contar)(const uint64_t *palabras, size_t n);
+    void (*acumular)(uint64_t *destino, const uint64_t *fila, const uint64_t *excluidos, size_t n);
+    long long (*absorber)(uint64_t *visitados, const uint64_t *frontera, size_t n);
+} KernelsBits;
+
+// Versión escalar. Sin -mpopcnt el compilador cuenta con operaciones de bits.
+
+static long long contar_escalar(const uint64_t *palabras, size_t n) {
+    long long total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += __builtin_popcountll(palabras[i]);
+    }
+    return total;
+}
+
+static void acumular_escalar(uint64_t *destino, const uint64_t *fila, const uint64_t *excluidos, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        destino[i] |= fila[i] & ~excluidos[i];
+    }
+}
+
+static long long absorber_escalar(uint64_t *visitados, const uint64_t *frontera, size_t n) {
+    long long total = 0;
+    for (size_t i = 0; i < n; i++) {
+        visitados[i] |= frontera[i];
+        total += __builtin_popcountll(frontera[i]);
+    }
+    return total;
+}
+
+#ifdef BITS_SIMD_X86
+
+// SSE4.2: la instrucción POPCNT por palabra y OR / AND-NOT de a dos palabras
+
+__attribute__((target("sse4.2,popcnt")))
+static long long contar_sse42(const uint64_t *palabras, size_t n) {
+    // Cuatro acumuladores para no encadenar cada suma con la anterior
+    long long a = 0, b = 0, c = 0, d = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        a += _mm_popcnt_u64(palabras[i]);
+        b += _mm_popcnt_u64(palabras[i + 1]);
+        c += _mm_popcnt_u64(palabras[i + 2]);
+        d += _mm_popcnt_u64(palabras[i + 3]);
+    }
+    for (; i < n; i++) {
+        a += _mm_popcnt_u64(palabras[i]);
+    }
+    return a + b + c + d;
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static void acumular_sse42(uint64_t *destino, const uint64_t *fila, const uint64_t *excluidos, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(destino + i));
+        __m128i f = _mm_loadu_si128((const __m128i *)(fila + i));
+        __m128i x = _mm_loadu_si128((const __m128i *)(excluidos + i));
+        _mm_storeu_si128((__m128i *)(destino + i), _mm_or_si128(d, _mm_andnot_si128(x, f)));
+    }
+    for (; i < n; i++) {
+        destino[i] |= fila[i] & ~excluidos[i];
+    }
+}
+
+__attribute__((target("sse4.2,popcnt")))
+static long long absorber_sse42(uint64_t *visitados, const uint64_t *frontera, size_t n) {
+    long long total = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(visitados + i));
+        __m128i f = _mm_loadu_si128((const __m128i *)(frontera + i));
+        _mm_storeu_si128((__m128i *)(visitados + i), _mm_or_si128(v, f));
+        total += _mm_popcnt_u64(frontera[i]) + _mm_popcnt_u64(frontera[i + 1]);
+    }
+    for (; i < n; i++) {
+        visitados[i] |= frontera[i];
+        total += _mm_popcnt_u64(frontera[i]);
+    }
+    return total;
+}
+
+// AVX2: de a cuatro palabras. El conteo busca cada nibble en una tabla de 16
+// entradas con PSHUFB y suma los bytes con PSADBW (método de Muła); los bytes
+// se vacían cada 31 vueltas, antes de que pasen de 255.
+
+#define VUELTAS_BYTES_AVX2 31
+
+__attribute__((target("avx2")))
+static inline __m256i bits_por_byte_avx2(__m256i v) {
+    const __m256i tabla = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i bajos = _mm256_shuffle_epi8(tabla, _mm256_and_si256(v, nibble));
+    __m256i altos = _mm256_shuffle_epi8(tabla, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    return _mm256_add_epi8(bajos, altos);
+}
+
+__attribute__((target("avx2")))
+static inline long long sumar_carriles_avx2(__m256i v) {
+    __m128i suma = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(suma) + _mm_extract_epi64(suma, 1);
+}
+
+__attribute__((target("avx2,popcnt")))
+static long long contar_avx2(const uint64_t *palabras, size_t n) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    while (i + 4 <= n) {
+        size_t limite = i + 4 * VUELTAS_BYTES_AVX2;
+        if (limite > n) limite = n;
+        __m256i bytes = _mm256_setzero_si256();
+        for (; i + 4 <= limite; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(palabras + i));
+            bytes = _mm256_add_epi8(bytes, bits_por_byte_avx2(v));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    long long resto = 0;
+    for (; i < n; i++) {
+        resto += _mm_popcnt_u64(palabras[i]);
+    }
+    return sumar_carriles_avx2(total) + resto;
+}
+
+__attribute__((target("avx2")))
+static void acumular_avx2(uint64_t *destino, const uint64_t *fila, const uint64_t *excluidos, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(destino + i));
+        __m256i f = _mm256_loadu_si256((const __m256i *)(fila + i));
+        __m256i x = _mm256_loadu_si256((const __m256i *)(excluidos + i));
+        _mm256_storeu_si256((__m256i *)(destino + i), _mm256_or_si256(d, _mm256_andnot_si256(x, f)));
+    }
+    for (; i < n; i++) {
+        destino[i] |= fila[i] & ~excluidos[i];
+    }
+}
+
+__attribute__((target("avx2,popcnt")))
+static long long absorber_avx2(uint64_t *visitados, const uint64_t *frontera, size_t n) {
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+    while (i + 4 <= n) {
+        size_t limite = i + 4 * VUELTAS_BYTES_AVX2;
+        if (limite > n) limite = n;
+        __m256i bytes = _mm256_setzero_si256();
+        for (; i + 4 <= limite; i += 4) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(visitados + i));
+            __m256i f = _mm256_loadu_si256((const __m256i *)(frontera + i));
+            _mm256_storeu_si256((__m256i *)(visitados + i), _mm256_or_si256(v, f));
+            bytes = _mm256_add_epi8(bytes, bits_por_byte_avx2(f));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    long long resto = 0;
+    for (; i < n; i++) {
+        visitados[i] |= frontera[i];
+        resto += _mm_popcnt_u64(frontera[i]);
+    }
+    return sumar_carriles_avx2(total) + resto;
+}
+
+#endif
+
+static const KernelsBits kernels_por_nivel[] = {
+    [SIMD_ESCALAR] = {contar_escalar, acumular_escalar, absorber_escalar},
+#ifdef BITS_SIMD_X86
+    [SIMD_SSE42] = {contar_sse42, acumular_sse42, absorber_sse42},
+    [SIMD_AVX2] = {contar_avx2, acumular_avx2, absorber_avx2},
+#else
+    [SIMD_SSE42] = {contar_escalar, acumular_escalar, absorber_escalar},
+    [SIMD_AVX2] = {contar_escalar, acumular_escalar, absorber_escalar},
+#endif
+};
+
+// -1 hasta la primera consulta; las búsquedas en hilos pueden llegar a la vez
+static atomic_int nivel_en_uso = -1;
+
+static NivelSimd nivel_soportado(void) {
+#ifdef BITS_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) return SIMD_SSE42;
+#endif
+    return SIMD_ESCALAR;
+}
+
+NivelSimd nivel_simd(void) {
+    int nivel = atomic_load_explicit(&nivel_en_uso, memory_order_relaxed);
+    if (nivel < 0) {
+        nivel = nivel_soportado();
+        atomic_store_explicit(&nivel_en_uso, nivel, memory_order_relaxed);
+    }
+    return (NivelSimd)nivel;
+}
+
+NivelSimd limitar_nivel_simd(NivelSimd maximo) {
+    NivelSimd nivel = nivel_soportado();
+    if (nivel > maximo) nivel = maximo;
+    atomic_store_explicit(&nivel_en_uso, (int)nivel, memory_order_relaxed);
+    return nivel;
+}
+
+const char *nombre_nivel_simd(NivelSimd nivel) {
+    switch (nivel) {
+        case SIMD_AVX2: return "AVX2";
+        case SIMD_SSE42: return "SSE4.2";
+        default: return "escalar";
+    }
+}
+
+long long contar_bits_palabras(const uint64_t *palabras, size_t n) {
+    return kernels_por_nivel[nivel_simd()].contar(palabras, n);
+}
+
+void acumular_fila_bits(uint64_t *destino, const uint64_t *fila, const uint64_t *excluidos, size_t n) {
+    kernels_por_nivel[nivel_simd()].acumular(destino, fila, excluidos, n);
+}
+
+long long absorber_frontera_bits(uint64_t *visitados, const uint64_t *frontera, size_t n) {
+    return kernels_por_nivel[nivel_simd()].absorber(visitados, frontera, n);
+}
@@ -0,0 +1,38 @@
+#ifndef BITS_SIMD_H
+#define BITS_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Operaciones sobre tiras de palabras de 64 bits (las filas de una MatrizBits)
+// con versiones AVX2, SSE4.2 y escalar. La versión se elige la primera vez que
+// se usa, según lo que soporte el procesador, así que el mismo ejecutable corre
+// en cualquier x86-64 (y en otras arquitecturas usa la escalar).
+//
+// Las filas de filas_bits.h (grafo denso, MAX_NODOS = 12) ocupan una sola
+// palabra y no pasan por aquí: elegir la versión costaría más que la operación.
+
+typedef enum {
+    SIMD_ESCALAR,
+    SIMD_SSE42,         // POPCNT y registros de 128 bits
+    SIMD_AVX2           // Registros de 256 bits y conteo por tabla de nibbles
+} NivelSimd;
+
+NivelSimd nivel_simd(void);
+// Usa como mucho 'maximo' aunque el procesador soporte más (para comparar las
+// versiones). Devuelve el nivel que queda en uso.
+NivelSimd limitar_nivel_simd(NivelSimd maximo);
+const char *nombre_nivel_simd(NivelSimd nivel);
+
+// Bits encendidos en palabras[0 .. n - 1]
+long long contar_bits_palabras(const uint64_t *palabras, size_t n);
+
+// destino |= fila & ~excluidos. Es la expansión de una frontera (los vecinos de
+// u que aún no se visitaron) y, en general, el "OR sobre predecesores" de
+// cualquier actualización de filas por conjuntos.
+void acumular_fila_bits(uint64_t *destino, const uint64_t *fila, const uint64_t *excluidos, size_t n);
+
+// visitados |= frontera. Devuelve cuántos bits tenía la frontera (0: terminó).
+long long absorber_frontera_bits(uint64_t *visitados, const uint64_t *frontera, size_t n);
+
+#endif
@@ -0,0 +1,155 @@
+#include "buffer_texto.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CAPACIDAD_INICIAL 4096
+
+void buffer_iniciar(BufferTexto *b) {
+    b->datos = NULL;
+    b->longitud = 0;
+    b->capacidad = 0;
+    b->error = false;
+}
+
+void buffer_liberar(BufferTexto *b) {
+    free(b->datos);
+    buffer_iniciar(b);
+}
+
+// Garantiza espacio para 'adicional' bytes más el terminador. La capacidad se
+// duplica para que agregar texto tenga costo amortizado constante.
+bool buffer_reservar(BufferTexto *b, size_t adicional) {
+    if (b->error) return false;
+
+    size_t necesario = b->longitud + adicional + 1;
+    if (necesario <= b->capacidad) return true;
+
+    size_t nueva = b->capacidad > 0 ? b->capacidad : CAPACIDAD_INICIAL;
+    while (nueva < necesario) {
+        nueva *= 2;
+    }
+
+    char *datos = realloc(b->datos, nueva);
+    if (!datos) {
+        b->error = true;
+        return false;
+    }
+    b->datos = datos;
+    b->capacidad = nueva;
+    return true;
+}
+
+void buffer_agregar_n(BufferTexto *b, const char *texto, size_t n) {
+    if (!buffer_reservar(b, n)) return;
+    memcpy(b->datos + b->longitud, texto, n);
+    b->longitud += n;
+    b->datos[b->longitud] = '\0';
+}
+
+// Escribe los dígitos de 'valor' al final de 'fin' hacia atrás y devuelve el inicio
+static char *escribir_digitos(char *fin, unsigned long long valor) {
+    do {
+        *--fin = (char)('0' + valor % 10);
+        valor /= 10;
+    } while (valor > 0);
+    return fin;
+}
+
+void buffer_agregar_entero(BufferTexto *b, long valor) {
+    char temp[24];
+    char *fin = temp + sizeof(temp);
+    unsigned long long magnitud = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    char *inicio = escribir_digitos(fin, magnitud);
+    if (valor < 0) {
+        *--inicio = '-';
+    }
+    buffer_agregar_n(b, inicio, (size_t)(fin - inicio));
+}
+
+// Equivalente a "%.Nf" para los valores que aparecen en el reporte (escalas y
+// coordenadas), sin pasar por el intérprete de formato de printf. printf redondea
+// el valor binario exacto; el producto escalado puede diferir de él en el último
+// bit, así que los casos casi a mitad de camino (0.125, 2.675) se le dejan a printf.
+void buffer_agregar_fijo(BufferTexto *b, double valor, int decimales) {
+    static const double potencias[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+    if (decimales < 0) decimales = 0;
+    if (decimales > 9) decimales = 9;
+
+    double escalado = valor * potencias[decimales];
+    double magnitud = escalado < 0 ? -escalado : escalado;
+    // Hasta 1e9 el error del producto es menor que 1e-6, y NaN no pasa la comparación
+    bool rapido = magnitud < 1e9;
+    if (rapido) {
+        double resto = magnitud - (double)(unsigned long long)magnitud;
+        rapido = resto < 0.5 - 1e-6 || resto > 0.5 + 1e-6;
+    }
+    if (!rapido) {
+        buffer_printf(b, "%.*f", decimales, valor);
+        return;
+    }
+
+    // Como printf, el signo se escribe aunque el valor redondee a cero ("-0.00")
+    bool negativo = signbit(valor);
+    unsigned long long unidades = (unsigned long long)(magnitud + 0.5);
+    unsigned long long divisor = (unsigned long long)potencias[decimales];
+    unsigned long long entera = unidades / divisor;
+    unsigned long long fraccion = unidades % divisor;
+
+    char temp[40];
+    char *fin = temp + sizeof(temp);
+    char *inicio = fin;
+    if (decimales > 0) {
+        for (int i = 0; i < decimales; i++) {
+            *--inicio = (char)('0' + fraccion % 10);
+            fraccion /= 10;
+        }
+        *--inicio = '.';
+    }
+    inicio = escribir_digitos(inicio, entera);
+    if (negativo) {
+        *--inicio = '-';
+    }
+    buffer_agregar_n(b, inicio, (size_t)(fin - inicio));
+}
+
+void buffer_printf(BufferTexto *b, const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    va_list copia;
+    va_copy(copia, args);
+
+    int n = vsnprintf(NULL, 0, formato, args);
+    va_end(args);
+
+    if (n >= 0 && buffer_reservar(b, (size_t)n)) {
+        vsnprintf(b->datos + b->longitud, (size_t)n + 1, formato, copia);
+        b->longitud += (size_t)n;
+    }
+    va_end(copia);
+}
+
+void buffer_concatenar(BufferTexto *destino, const BufferTexto *origen) {
+    if (origen->error) {
+        destino->error = true;
+        return;
+    }
+    if (origen->longitud > 0) {
+        buffer_agregar_n(destino, origen->datos, origen->longitud);
+    }
+}
+
+// Escribe el contenido completo con una única llamada a fwrite
+bool buffer_escribir_archivo(const BufferTexto *b, const char *ruta) {
+    if (b->error) return false;
+
+    FILE *f = fopen(ruta, "wb");
+    if (!f) return false;
+
+    bool ok = fwrite(b->datos, 1, b->longitud, f) == b->longitud;
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
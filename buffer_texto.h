@@ -0,0 +1,46 @@
+#ifndef BUFFER_TEXTO_H
+#define BUFFER_TEXTO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// Buffer de texto en memoria que crece según se necesite. El reporte LaTeX se
+// arma por secciones en buffers independientes y se escribe con una sola escritura.
+typedef struct {
+    char *datos;
+    size_t longitud;
+    size_t capacidad;
+    bool error;  // Se activa si alguna reserva de memoria falló
+} BufferTexto;
+
+void buffer_iniciar(BufferTexto *b);
+void buffer_liberar(BufferTexto *b);
+bool buffer_reservar(BufferTexto *b, size_t adicional);
+void buffer_agregar_n(BufferTexto *b, const char *texto, size_t n);
+void buffer_agregar_entero(BufferTexto *b, long valor);
+void buffer_agregar_fijo(BufferTexto *b, double valor, int decimales);
+void buffer_printf(BufferTexto *b, const char *formato, ...)
+    __attribute__((format(printf, 2, 3)));
+void buffer_concatenar(BufferTexto *destino, const BufferTexto *origen);
+bool buffer_escribir_archivo(const BufferTexto *b, const char *ruta);
+
+// Agrega texto sin interpretar formato. Con literales el compilador resuelve strlen.
+static inline void buffer_agregar(BufferTexto *b, const char *texto) {
+    buffer_agregar_n(b, texto, strlen(texto));
+}
+
+// Descarta el contenido conservando la memoria reservada
+static inline void buffer_vaciar(BufferTexto *b) {
+    b->longitud = 0;
+    if (b->datos) b->datos[0] = '\0';
+}
+
+static inline void buffer_agregar_caracter(BufferTexto *b, char c) {
+    if (b->longitud + 1 < b->capacidad || buffer_reservar(b, 1)) {
+        b->datos[b->longitud++] = c;
+        b->datos[b->longitud] = '\0';
+    }
+}
+
+#endif
@@ -0,0 +1,658 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "cargador.h"
+#include "instantanea.h"
+#include "intercambio.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Archivo completo proyectado en memoria de solo lectura
+typedef struct {
+    const char *datos;
+    size_t tam;
+} ArchivoMapeado;
+
+// Cursor sobre el archivo. Lleva la línea actual y dónde empieza para poder
+// informar la columna de cualquier error sin recorrer el archivo de nuevo.
+typedef struct {
+    const char *pos;
+    const char *fin;
+    const char *inicio_linea;
+    int linea;
+} Lector;
+
+static void fijar_error(ErrorCarga *error, int linea, int columna, const char *formato, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void fijar_error(ErrorCarga *error, int linea, int columna, const char *formato, ...) {
+    error->linea = linea;
+    error->columna = columna;
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(error->mensaje, sizeof(error->mensaje), formato, args);
+    va_end(args);
+}
+
+static int columna_de(const Lector *l, const char *donde) {
+    return (int)(donde - l->inicio_linea) + 1;
+}
+
+static bool mapear_archivo(const char *ruta, ArchivoMapeado *archivo, ErrorCarga *error) {
+    archivo->datos = NULL;
+    archivo->tam = 0;
+
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        fijar_error(error, 0, 0, "No se pudo abrir el archivo");
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        fijar_error(error, 0, 0, "No se pudo leer el tamaño del archivo");
+        close(fd);
+        return false;
+    }
+
+    // Un archivo vacío no se puede proyectar; el analizador reporta el error de formato
+    if (info.st_size > 0) {
+        void *datos = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (datos == MAP_FAILED) {
+            fijar_error(error, 0, 0, "No se pudo proyectar el archivo en memoria");
+            close(fd);
+            return false;
+        }
+        posix_madvise(datos, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+        archivo->datos = datos;
+        archivo->tam = (size_t)info.st_size;
+    }
+
+    close(fd);
+    return true;
+}
+
+static void liberar_archivo(ArchivoMapeado *archivo) {
+    if (archivo->datos) {
+        munmap((void *)archivo->datos, archivo->tam);
+    }
+    archivo->datos = NULL;
+    archivo->tam = 0;
+}
+
+static void iniciar_lector(Lector *l, const ArchivoMapeado *archivo) {
+    l->pos = archivo->datos;
+    l->fin = archivo->datos + archivo->tam;
+    l->inicio_linea = archivo->datos;
+    l->linea = 1;
+}
+
+static inline bool es_espacio(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline bool es_digito(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+static void saltar_espacios(Lector *l) {
+    while (l->pos < l->fin) {
+        char c = *l->pos;
+        if (c == '\n') {
+            l->pos++;
+            l->linea++;
+            l->inicio_linea = l->pos;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            l->pos++;
+        } else {
+            break;
+        }
+    }
+}
+
+// Verifica que el número termine en un separador y no en basura como "12a"
+static bool fin_de_token(Lector *l, const char *que, ErrorCarga *error) {
+    if (l->pos < l->fin && !es_espacio(*l->pos)) {
+        fijar_error(error, l->linea, columna_de(l, l->pos),
+                    "Carácter inesperado '%c' en %s", *l->pos, que);
+        return false;
+    }
+    return true;
+}
+
+static bool leer_entero(Lector *l, long long minimo, long long maximo, const char *que,
+                        long long *valor, ErrorCarga *error) {
+    saltar_espacios(l);
+    const char *inicio = l->pos;
+    if (l->pos >= l->fin) {
+        fijar_error(error, l->linea, columna_de(l, inicio),
+                    "Fin de archivo inesperado: se esperaba %s", que);
+        return false;
+    }
+
+    bool negativo = false;
+    if (*l->pos == '-' || *l->pos == '+') {
+        negativo = *l->pos == '-';
+        l->pos++;
+    }
+    if (l->pos >= l->fin || !es_digito(*l->pos)) {
+        fijar_error(error, l->linea, columna_de(l, inicio), "Se esperaba %s", que);
+        return false;
+    }
+
+    // Se leen todos los dígitos aunque el valor no quepa en long long, para
+    // informar el número completo
+    long long v = 0;
+    bool desborde = false;
+    while (l->pos < l->fin && es_digito(*l->pos)) {
+        int d = *l->pos - '0';
+        if (v > (LLONG_MAX - d) / 10) {
+            desborde = true;
+        } else if (!desborde) {
+            v = v * 10 + d;
+        }
+        l->pos++;
+    }
+    if (!fin_de_token(l, que, error)) return false;
+
+    if (negativo) v = -v;
+    if (desborde || v < minimo || v > maximo) {
+        fijar_error(error, l->linea, columna_de(l, inicio),
+                    "Valor %.*s fuera de rango para %s (debe estar entre %lld y %lld)",
+                    (int)(l->pos - inicio), inicio, que, minimo, maximo);
+        return false;
+    }
+
+    *valor = v;
+    return true;
+}
+
+// Coordenada entera o decimal ("166.666"), redondeada al entero más cercano
+static bool leer_coordenada(Lector *l, const char *que, int *valor, ErrorCarga *error) {
+    saltar_espacios(l);
+    const char *inicio = l->pos;
+    if (l->pos >= l->fin) {
+        fijar_error(error, l->linea, columna_de(l, inicio),
+                    "Fin de archivo inesperado: se esperaba %s", que);
+        return false;
+    }
+
+    bool negativo = false;
+    if (*l->pos == '-' || *l->pos == '+') {
+        negativo = *l->pos == '-';
+        l->pos++;
+    }
+
+    double v = 0.0;
+    bool hay_digitos = false;
+    while (l->pos < l->fin && es_digito(*l->pos)) {
+        v = v * 10.0 + (*l->pos - '0');
+        hay_digitos = true;
+        l->pos++;
+    }
+    if (l->pos < l->fin && *l->pos == '.') {
+        l->pos++;
+        double escala = 0.1;
+        while (l->pos < l->fin && es_digito(*l->pos)) {
+            v += (*l->pos - '0') * escala;
+            escala *= 0.1;
+            hay_digitos = true;
+            l->pos++;
+        }
+    }
+    if (!hay_digitos) {
+        fijar_error(error, l->linea, columna_de(l, inicio), "Se esperaba %s", que);
+        return false;
+    }
+    if (!fin_de_token(l, que, error)) return false;
+
+    if (v + 0.5 > (double)INT_MAX) {
+        fijar_error(error, l->linea, columna_de(l, inicio), "Valor fuera de rango para %s", que);
+        return false;
+    }
+    int redondeado = (int)(v + 0.5);
+    *valor = negativo ? -redondeado : redondeado;
+    return true;
+}
+
+// Lee una fila de la matriz. Con SSE2 se reconocen de 8 en 8 las celdas con el
+// formato habitual "0 1 0 1 " (un dígito 0/1 seguido de un espacio): se comparan
+// 16 bytes a la vez y los unos salen de una máscara de bits. Cualquier otra
+// cosa (números de varios dígitos, tabuladores, fin de línea) sigue por el
+// lector general, que además valida y ubica el error.
+static bool leer_fila_matriz(Lector *l, int fila, int K, const ReceptorGrafo *receptor,
+                             ErrorCarga *error) {
+    int j = 0;
+    while (j < K) {
+        saltar_espacios(l);
+#ifdef __SSE2__
+        const __m128i patron = _mm_set1_epi16(0x2030);  // "0 " en cada par de bytes
+        const __m128i bit_uno = _mm_set1_epi16(0x0001);
+        while (K - j >= 8 && l->fin - l->pos >= 16) {
+            __m128i bytes = _mm_loadu_si128((const __m128i *)l->pos);
+            __m128i diferencia = _mm_xor_si128(bytes, patron);
+            __m128i resto = _mm_andnot_si128(bit_uno, diferencia);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(resto, _mm_setzero_si128())) != 0xFFFF) {
+                break;
+            }
+            unsigned unos = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(diferencia, bit_uno)) & 0x5555u;
+            while (unos) {
+                receptor->arista(receptor->datos, fila, j + __builtin_ctz(unos) / 2, 1);
+                unos &= unos - 1;
+            }
+            j += 8;
+            l->pos += 16;
+        }
+        if (j >= K) break;
+#endif
+        long long valor;
+        if (!leer_entero(l, 0, INT_MAX, "un valor de la matriz de adyacencia", &valor, error)) {
+            return false;
+        }
+        if (valor > 0) {
+            receptor->arista(receptor->datos, fila, j, (int)valor);
+        }
+        j++;
+    }
+    return true;
+}
+
+// Pide al receptor que acepte el encabezado; si lo rechaza, el error apunta al
+// número de nodos
+static bool aceptar_encabezado(const ReceptorGrafo *receptor, int K, TipoGrafo tipo,
+                               int linea, int columna, ErrorCarga *error) {
+    error->linea = linea;
+    error->columna = columna;
+    error->mensaje[0] = '\0';
+    return receptor->encabezado(receptor->datos, K, tipo, error);
+}
+
+static bool leer_posicion(Lector *l, int nodo, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    Coordenada pos;
+    if (!leer_coordenada(l, "la coordenada x de un nodo", &pos.x, error)) return false;
+    if (!leer_coordenada(l, "la coordenada y de un nodo", &pos.y, error)) return false;
+    if (receptor->posicion) {
+        receptor->posicion(receptor->datos, nodo, pos);
+    }
+    return true;
+}
+
+static bool verificar_fin(Lector *l, const char *despues_de, ErrorCarga *error) {
+    saltar_espacios(l);
+    if (l->pos < l->fin) {
+        fijar_error(error, l->linea, columna_de(l, l->pos),
+                    "Contenido inesperado después de %s", despues_de);
+        return false;
+    }
+    return true;
+}
+
+// Entrega una arista leída de una lista. En grafos no dirigidos se entrega en
+// ambos sentidos para que el receptor vea lo mismo que con la matriz.
+static void emitir_arista(const ReceptorGrafo *receptor, TipoGrafo tipo, int u, int v) {
+    receptor->arista(receptor->datos, u, v, 1);
+    if (tipo == NO_DIRIGIDO && u != v) {
+        receptor->arista(receptor->datos, v, u, 1);
+    }
+}
+
+static void saltar_hasta_fin_linea(Lector *l) {
+    while (l->pos < l->fin && *l->pos != '\n') {
+        l->pos++;
+    }
+}
+
+// Espacios y líneas de comentario que empiezan con '#'
+static void saltar_comentarios(Lector *l) {
+    saltar_espacios(l);
+    while (l->pos < l->fin && *l->pos == '#') {
+        saltar_hasta_fin_linea(l);
+        saltar_espacios(l);
+    }
+}
+
+static bool analizar_matriz(Lector *l, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    long long K, tipo;
+
+    saltar_espacios(l);
+    int linea_K = l->linea;
+    int columna_K = columna_de(l, l->pos);
+    if (!leer_entero(l, 1, INT_MAX - 1, "el número de nodos", &K, error)) return false;
+    if (!leer_entero(l, 0, 1, "el tipo de grafo (0 = no dirigido, 1 = dirigido)", &tipo, error)) return false;
+    if (!aceptar_encabezado(receptor, (int)K, (TipoGrafo)tipo, linea_K, columna_K, error)) return false;
+
+    for (int i = 0; i < K; i++) {
+        if (!leer_fila_matriz(l, i, (int)K, receptor, error)) return false;
+    }
+    for (int i = 0; i < K; i++) {
+        if (!leer_posicion(l, i, receptor, error)) return false;
+    }
+    return verificar_fin(l, "las posiciones de los nodos", error);
+}
+
+// Lista de aristas: "K tipo M", M líneas "u v" (nodos desde 0) y, opcionalmente,
+// K líneas "x y" con las posiciones. Las líneas que empiezan con '#' se ignoran.
+static bool analizar_lista_aristas(Lector *l, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    long long K, tipo, M;
+
+    saltar_comentarios(l);
+    int linea_K = l->linea;
+    int columna_K = columna_de(l, l->pos);
+    if (!leer_entero(l, 1, INT_MAX - 1, "el número de nodos", &K, error)) return false;
+    if (!leer_entero(l, 0, 1, "el tipo de grafo (0 = no dirigido, 1 = dirigido)", &tipo, error)) return false;
+    if (!leer_entero(l, 0, LLONG_MAX / 4, "el número de aristas", &M, error)) return false;
+    if (!aceptar_encabezado(receptor, (int)K, (TipoGrafo)tipo, linea_K, columna_K, error)) return false;
+
+    for (long long a = 0; a < M; a++) {
+        long long u, v;
+        saltar_comentarios(l);
+        if (!leer_entero(l, 0, K - 1, "el origen de una arista", &u, error)) return false;
+        if (!leer_entero(l, 0, K - 1, "el destino de una arista", &v, error)) return false;
+        emitir_arista(receptor, (TipoGrafo)tipo, (int)u, (int)v);
+    }
+
+    saltar_comentarios(l);
+    if (l->pos < l->fin) {
+        for (int i = 0; i < K; i++) {
+            saltar_comentarios(l);
+            if (!leer_posicion(l, i, receptor, error)) return false;
+        }
+    }
+    saltar_comentarios(l);
+    return verificar_fin(l, "las posiciones de los nodos", error);
+}
+
+static bool leer_palabra(Lector *l, char *palabra, size_t tam, const char *que, ErrorCarga *error) {
+    saltar_espacios(l);
+    const char *inicio = l->pos;
+    size_t n = 0;
+    while (l->pos < l->fin && !es_espacio(*l->pos)) {
+        if (n + 1 < tam) palabra[n++] = *l->pos;
+        l->pos++;
+    }
+    palabra[n] = '\0';
+    if (l->pos == inicio) {
+        fijar_error(error, l->linea, columna_de(l, inicio), "Se esperaba %s", que);
+        return false;
+    }
+    return true;
+}
+
+// Indica si queda algún dato en la línea actual
+static bool quedan_datos_en_linea(Lector *l) {
+    while (l->pos < l->fin && (*l->pos == ' ' || *l->pos == '\t' || *l->pos == '\r')) {
+        l->pos++;
+    }
+    return l->pos < l->fin && *l->pos != '\n';
+}
+
+// Formato DIMACS: "c" comentarios, "p edge N M" (o "p col") para grafos no
+// dirigidos con líneas "e u v", "p sp N M" para dirigidos con líneas "a u v [peso]"
+// y, opcionalmente, líneas "v id x y" con posiciones como en los archivos .co.
+// Los nodos se numeran desde 1; el peso de los arcos se ignora.
+static bool analizar_dimacs(Lector *l, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    bool hay_problema = false;
+    TipoGrafo tipo = NO_DIRIGIDO;
+    long long N = 0, M = 0, leidas = 0;
+
+    for (;;) {
+        saltar_espacios(l);
+        if (l->pos >= l->fin) break;
+
+        const char *inicio = l->pos;
+        int linea = l->linea;
+        char clase = *l->pos++;
+        if (clase == 'c') {
+            saltar_hasta_fin_linea(l);
+            continue;
+        }
+        if (l->pos < l->fin && !es_espacio(*l->pos)) {
+            l->pos = inicio;
+            clase = '?';
+        }
+
+        if (clase == 'p') {
+            char formato[16];
+            if (hay_problema) {
+                fijar_error(error, linea, columna_de(l, inicio), "Línea 'p' repetida");
+                return false;
+            }
+            if (!leer_palabra(l, formato, sizeof(formato), "el formato del problema", error)) return false;
+            if (strcmp(formato, "edge") == 0 || strcmp(formato, "col") == 0) {
+                tipo = NO_DIRIGIDO;
+            } else if (strcmp(formato, "sp") == 0) {
+                tipo = DIRIGIDO;
+            } else {
+                fijar_error(error, linea, columna_de(l, inicio),
+                            "Formato DIMACS '%s' no soportado (se esperaba edge, col o sp)", formato);
+                return false;
+            }
+            saltar_espacios(l);
+            int linea_N = l->linea;
+            int columna_N = columna_de(l, l->pos);
+            if (!leer_entero(l, 1, INT_MAX - 1, "el número de nodos", &N, error)) return false;
+            if (!leer_entero(l, 0, LLONG_MAX / 4, "el número de aristas", &M, error)) return false;
+            if (!aceptar_encabezado(receptor, (int)N, tipo, linea_N, columna_N, error)) return false;
+            hay_problema = true;
+        } else if (clase == 'e' || clase == 'a' || clase == 'v') {
+            if (!hay_problema) {
+                fijar_error(error, linea, columna_de(l, inicio), "Falta la línea 'p' antes de los datos");
+                return false;
+            }
+            long long u, v;
+            if (clase == 'v') {
+                if (!leer_entero(l, 1, N, "el número de nodo", &u, error)) return false;
+                if (!leer_posicion(l, (int)u - 1, receptor, error)) return false;
+            } else {
+                if (!leer_entero(l, 1, N, "el origen de una arista", &u, error)) return false;
+                if (!leer_entero(l, 1, N, "el destino de una arista", &v, error)) return false;
+                if (clase == 'a' && quedan_datos_en_linea(l)) {
+                    long long peso;
+                    if (!leer_entero(l, -LLONG_MAX / 4, LLONG_MAX / 4, "el peso del arco", &peso, error)) return false;
+                }
+                emitir_arista(receptor, tipo, (int)u - 1, (int)v - 1);
+                leidas++;
+            }
+        } else {
+            fijar_error(error, linea, columna_de(l, inicio),
+                        "Línea DIMACS desconocida (se esperaba c, p, e, a o v)");
+            return false;
+        }
+        if (quedan_datos_en_linea(l)) {
+            fijar_error(error, l->linea, columna_de(l, l->pos), "Datos de más al final de la línea");
+            return false;
+        }
+    }
+
+    if (!hay_problema) {
+        fijar_error(error, l->linea, columna_de(l, l->pos), "Falta la línea 'p'");
+        return false;
+    }
+    if (leidas != M) {
+        fijar_error(error, l->linea, columna_de(l, l->pos),
+                    "La línea 'p' declara %lld aristas pero el archivo tiene %lld", M, leidas);
+        return false;
+    }
+    return true;
+}
+
+// Reconoce el formato por el contenido: DIMACS empieza con líneas "c" o "p";
+// la lista de aristas tiene "K tipo M" en la primera línea y la matriz solo K.
+static FormatoGrafo detectar_formato(const ArchivoMapeado *archivo) {
+    Lector l;
+    iniciar_lector(&l, archivo);
+    saltar_comentarios(&l);
+    if (l.pos < l.fin && (*l.pos == 'c' || *l.pos == 'p')) {
+        return FORMATO_DIMACS;
+    }
+
+    int tokens = 0;
+    while (quedan_datos_en_linea(&l)) {
+        tokens++;
+        while (l.pos < l.fin && !es_espacio(*l.pos)) l.pos++;
+    }
+    return tokens >= 3 ? FORMATO_LISTA_ARISTAS : FORMATO_MATRIZ;
+}
+
+static bool es_letra_minuscula(char c) {
+    return c >= 'a' && c <= 'z';
+}
+
+// GraphML y DOT se leen por bloques, así que se reconocen por los primeros bytes
+// antes de proyectar el archivo: '<' abre el XML; DOT empieza con un comentario
+// o con "strict", "graph" o "digraph" (en cualquier combinación de mayúsculas).
+// Las líneas '#' del principio se saltan: son comentarios en la lista de
+// aristas y líneas del preprocesador en DOT.
+static FormatoGrafo detectar_formato_por_inicio(const char *ruta) {
+    char inicio[4096];
+    size_t n = 0;
+    FILE *f = fopen(ruta, "rb");
+    if (f) {
+        n = fread(inicio, 1, sizeof(inicio) - 1, f);
+        fclose(f);
+    }
+    inicio[n] = '\0';
+
+    const char *p = inicio;
+    if (strncmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;  // Marca de orden de bytes UTF-8
+    while (*p && es_espacio(*p)) p++;
+    while (*p == '#') {
+        while (*p && *p != '\n') p++;
+        while (*p && es_espacio(*p)) p++;
+    }
+    if (*p == '<') return FORMATO_GRAPHML;
+    if (*p == '/') return FORMATO_DOT;
+
+    char palabra[8];
+    size_t len = 0;
+    while (len + 1 < sizeof(palabra) && es_letra_minuscula((char)(p[len] | 0x20))) {
+        palabra[len] = (char)(p[len] | 0x20);
+        len++;
+    }
+    palabra[len] = '\0';
+    if (strcmp(palabra, "strict") == 0 || strcmp(palabra, "graph") == 0 || strcmp(palabra, "digraph") == 0) {
+        return FORMATO_DOT;
+    }
+    return FORMATO_AUTOMATICO;
+}
+
+bool cargar_grafo_con_formato(const char *ruta, FormatoGrafo formato,
+                              const ReceptorGrafo *receptor, ErrorCarga *error) {
+    if (formato == FORMATO_AUTOMATICO) {
+        formato = detectar_formato_por_inicio(ruta);
+    }
+    if (formato == FORMATO_GRAPHML) {
+        return cargar_graphml(ruta, receptor, error);
+    }
+    if (formato == FORMATO_DOT) {
+        return cargar_dot(ruta, receptor, error);
+    }
+
+    ArchivoMapeado archivo;
+    if (!mapear_archivo(ruta, &archivo, error)) return false;
+
+    if (formato == FORMATO_AUTOMATICO) {
+        formato = es_instantanea(archivo.datos, archivo.tam) ? FORMATO_INSTANTANEA
+                                                            : detectar_formato(&archivo);
+    }
+    if (formato == FORMATO_INSTANTANEA) {
+        bool ok = leer_instantanea(archivo.datos, archivo.tam, receptor, error);
+        liberar_archivo(&archivo);
+        return ok;
+    }
+
+    Lector l;
+    iniciar_lector(&l, &archivo);
+    bool ok;
+    switch (formato) {
+        case FORMATO_LISTA_ARISTAS:
+            ok = analizar_lista_aristas(&l, receptor, error);
+            break;
+        case FORMATO_DIMACS:
+            ok = analizar_dimacs(&l, receptor, error);
+            break;
+        default:
+            ok = analizar_matriz(&l, receptor, error);
+            break;
+    }
+
+    liberar_archivo(&archivo);
+    return ok;
+}
+
+bool cargar_grafo(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    return cargar_grafo_con_formato(ruta, FORMATO_AUTOMATICO, receptor, error);
+}
+
+static bool termina_en(const char *texto, const char *sufijo) {
+    size_t n = strlen(texto);
+    size_t m = strlen(sufijo);
+    return n >= m && strcmp(texto + n - m, sufijo) == 0;
+}
+
+FormatoGrafo formato_por_extension(const char *ruta) {
+    if (termina_en(ruta, ".p4g")) {
+        return FORMATO_INSTANTANEA;
+    }
+    if (termina_en(ruta, ".graphml") || termina_en(ruta, ".xml")) {
+        return FORMATO_GRAPHML;
+    }
+    if (termina_en(ruta, ".dot") || termina_en(ruta, ".gv")) {
+        return FORMATO_DOT;
+    }
+    if (termina_en(ruta, ".col") || termina_en(ruta, ".gr") || termina_en(ruta, ".dimacs")) {
+        return FORMATO_DIMACS;
+    }
+    if (termina_en(ruta, ".el") || termina_en(ruta, ".aristas")) {
+        return FORMATO_LISTA_ARISTAS;
+    }
+    return FORMATO_MATRIZ;
+}
+
+static bool denso_encabezado(void *datos, int K, TipoGrafo tipo, ErrorCarga *error) {
+    Grafo *grafo = (Grafo *)datos;
+    if (K < 1 || K > MAX_NODOS) {
+        snprintf(error->mensaje, sizeof(error->mensaje),
+                 "Número de nodos inválido (debe estar entre 1 y %d)", MAX_NODOS);
+        return false;
+    }
+    memset(grafo, 0, sizeof(*grafo));
+    grafo->K = K;
+    grafo->tipo = tipo;
+    return true;
+}
+
+static void denso_arista(void *datos, int u, int v, int peso) {
+    Grafo *grafo = (Grafo *)datos;
+    grafo->matriz_adyacencia[u][v] += peso;
+}
+
+static void denso_posicion(void *datos, int nodo, Coordenada pos) {
+    Grafo *grafo = (Grafo *)datos;
+    grafo->posiciones[nodo] = pos;
+}
+
+void receptor_grafo_denso(ReceptorGrafo *receptor, Grafo *grafo) {
+    receptor->encabezado = denso_encabezado;
+    receptor->arista = denso_arista;
+    receptor->posicion = denso_posicion;
+    receptor->datos = grafo;
+}
+
+void describir_error_carga(const ErrorCarga *error, char *texto, int tam) {
+    if (error->linea > 0) {
+        snprintf(texto, (size_t)tam, "línea %d, columna %d: %s",
+                 error->linea, error->columna, error->mensaje);
+    } else {
+        snprintf(texto, (size_t)tam, "%s", error->mensaje);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef CARGADOR_H
+#define CARGADOR_H
+
+#include <stdbool.h>
+#include "grafo.h"
+
+// Posición (1-based) y descripción del primer error encontrado al leer un archivo
+typedef struct {
+    int linea;
+    int columna;
+    char mensaje[256];
+} ErrorCarga;
+
+// Destino de los datos que el cargador va leyendo. El cargador valida la sintaxis
+// y entrega cada dato en cuanto lo lee, sin guardar el grafo completo; el receptor
+// decide cómo almacenarlo (matriz densa para la interfaz, listas compactas para
+// grafos grandes).
+typedef struct {
+    // Se llama una vez con el número de nodos y el tipo. Devolver false rechaza el
+    // archivo; en ese caso el receptor escribe el motivo en error->mensaje.
+    bool (*encabezado)(void *datos, int K, TipoGrafo tipo, ErrorCarga *error);
+    // Arco u -> v con multiplicidad 'peso' (> 0). En grafos no dirigidos cada
+    // arista llega en ambos sentidos, igual que en la matriz de adyacencia.
+    void (*arista)(void *datos, int u, int v, int peso);
+    // Posición del nodo (opcional, puede ser NULL)
+    void (*posicion)(void *datos, int nodo, Coordenada pos);
+    void *datos;
+} ReceptorGrafo;
+
+typedef enum {
+    FORMATO_AUTOMATICO,     // Solo para cargar: se reconoce por el contenido
+    FORMATO_MATRIZ,         // K, tipo, matriz K x K y K líneas "x y"
+    FORMATO_LISTA_ARISTAS,  // "K tipo M", M líneas "u v" y posiciones opcionales
+    FORMATO_DIMACS,         // "p edge N M" / "p sp N M" con líneas "e"/"a" y "v" opcionales
+    FORMATO_INSTANTANEA,    // Binario que se proyecta directamente como CSR (instantanea.h)
+    FORMATO_GRAPHML,        // XML de GraphML, se lee por bloques (intercambio.h)
+    FORMATO_DOT             // Graphviz DOT, se lee por bloques (intercambio.h)
+} FormatoGrafo;
+
+// Carga un archivo reconociendo su formato. En la matriz y las posiciones se
+// aceptan decimales, que se redondean al entero más cercano.
+bool cargar_grafo(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error);
+bool cargar_grafo_con_formato(const char *ruta, FormatoGrafo formato,
+                              const ReceptorGrafo *receptor, ErrorCarga *error);
+
+// Formato para guardar según la extensión: .p4g, .graphml/.xml, .dot/.gv,
+// .col/.gr/.dimacs, .el/.aristas o matriz
+FormatoGrafo formato_por_extension(const char *ruta);
+
+// Receptor que llena un Grafo denso (K entre 1 y MAX_NODOS)
+void receptor_grafo_denso(ReceptorGrafo *receptor, Grafo *grafo);
+
+// Texto "línea L, columna C: mensaje" para mostrar al usuario
+void describir_error_carga(const ErrorCarga *error, char *texto, int tam);
+
+#endif
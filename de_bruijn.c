@@ -0,0 +1,320 @@
+#include "de_bruijn.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAM_BLOQUE_LECTURA (1 << 16)
+#define TAM_BLOQUE_ESCRITURA (1 << 20)
+#define ANCHO_LINEA_FASTA 60
+
+static const char BASES[4] = {'A', 'C', 'G', 'T'};
+
+// (k-1)-mero -> nodo, con direccionamiento abierto. La clave va junto al
+// índice para que cada búsqueda toque una sola línea de caché.
+typedef struct {
+    uint64_t prefijo;
+    int nodo;               // -1 si está libre
+} RanuraPrefijo;
+
+typedef struct {
+    RanuraPrefijo *ranuras;
+    size_t num_ranuras;     // Potencia de 2
+    int capacidad;
+} TablaPrefijos;
+
+typedef struct {
+    FILE *archivo;
+    char *bloque;
+    int k;
+    bool fasta;
+    int pasada;             // 1: numera los nodos, 2: entrega los arcos
+    DeBruijn *de_bruijn;
+    TablaPrefijos tabla;
+    const ReceptorGrafo *receptor;
+    ErrorCarga *error;
+} LectorSecuencias;
+
+// Mezcla de splitmix64: los (k-1)-meros vecinos difieren en pocos bits
+static uint64_t dispersar_prefijo(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+static RanuraPrefijo *ranura_de(const TablaPrefijos *t, uint64_t prefijo) {
+    size_t mascara = t->num_ranuras - 1;
+    size_t r = (size_t)dispersar_prefijo(prefijo) & mascara;
+    while (t->ranuras[r].nodo >= 0 && t->ranuras[r].prefijo != prefijo) {
+        r = (r + 1) & mascara;
+    }
+    return &t->ranuras[r];
+}
+
+static bool agrandar_ranuras(LectorSecuencias *l) {
+    size_t nuevas = l->tabla.num_ranuras ? l->tabla.num_ranuras * 2 : 1024;
+    RanuraPrefijo *ranuras = malloc(nuevas * sizeof(RanuraPrefijo));
+    if (!ranuras) return false;
+    for (size_t i = 0; i < nuevas; i++) {
+        ranuras[i].nodo = -1;
+    }
+
+    free(l->tabla.ranuras);
+    l->tabla.ranuras = ranuras;
+    l->tabla.num_ranuras = nuevas;
+    for (int i = 0; i < l->de_bruijn->num_nodos; i++) {
+        RanuraPrefijo *r = ranura_de(&l->tabla, l->de_bruijn->prefijos[i]);
+        r->prefijo = l->de_bruijn->prefijos[i];
+        r->nodo = i;
+    }
+    return true;
+}
+
+// Índice del (k-1)-mero, nuevo o existente; -1 si falta memoria
+static int registrar_prefijo(LectorSecuencias *l, uint64_t prefijo) {
+    DeBruijn *db = l->de_bruijn;
+    if ((size_t)(db->num_nodos + 1) * 2 > l->tabla.num_ranuras && !agrandar_ranuras(l)) return -1;
+    RanuraPrefijo *r = ranura_de(&l->tabla, prefijo);
+    if (r->nodo >= 0) return r->nodo;
+    if (db->num_nodos == INT_MAX - 1) return -1;
+
+    if (db->num_nodos == l->tabla.capacidad) {
+        int capacidad = l->tabla.capacidad ? l->tabla.capacidad * 2 : 1024;
+        uint64_t *prefijos = realloc(db->prefijos, (size_t)capacidad * sizeof(uint64_t));
+        if (!prefijos) return -1;
+        db->prefijos = prefijos;
+        l->tabla.capacidad = capacidad;
+    }
+    db->prefijos[db->num_nodos] = prefijo;
+    r->prefijo = prefijo;
+    r->nodo = db->num_nodos;
+    return db->num_nodos++;
+}
+
+static bool fallar(LectorSecuencias *l, int linea, int columna, const char *mensaje) {
+    l->error->linea = linea;
+    l->error->columna = columna;
+    snprintf(l->error->mensaje, sizeof(l->error->mensaje), "%s", mensaje);
+    return false;
+}
+
+static bool procesar_kmero(LectorSecuencias *l, uint64_t kmero, int linea, int columna) {
+    uint64_t prefijo = kmero >> 2;
+    uint64_t sufijo = kmero & ((UINT64_C(1) << (2 * (l->k - 1))) - 1);
+
+    if (l->pasada == 1) {
+        if (registrar_prefijo(l, prefijo) < 0 || registrar_prefijo(l, sufijo) < 0) {
+            return fallar(l, linea, columna, "Memoria insuficiente para los nodos");
+        }
+        l->de_bruijn->num_kmeros++;
+    } else {
+        int u = ranura_de(&l->tabla, prefijo)->nodo;
+        int v = ranura_de(&l->tabla, sufijo)->nodo;
+        l->receptor->arista(l->receptor->datos, u, v, 1);
+    }
+    return true;
+}
+
+static int codigo_base(int c) {
+    switch (c) {
+        case 'A': case 'a': return 0;
+        case 'C': case 'c': return 1;
+        case 'G': case 'g': return 2;
+        case 'T': case 't': case 'U': case 'u': return 3;
+        default: return -1;
+    }
+}
+
+// Una pasada por el archivo. La ventana guarda las últimas k bases de la lectura
+// actual; 'bases' cuenta cuántas son válidas.
+static bool analizar_secuencias(LectorSecuencias *l) {
+    rewind(l->archivo);
+    uint64_t mascara = l->k == 32 ? ~UINT64_C(0) : (UINT64_C(1) << (2 * l->k)) - 1;
+    uint64_t ventana = 0;
+    int bases = 0;
+    int linea = 1;
+    int columna = 1;
+    bool inicio_linea = true;
+    bool saltar_linea = false;
+    bool primero = true;
+
+    size_t leidos;
+    while ((leidos = fread(l->bloque, 1, TAM_BLOQUE_LECTURA, l->archivo)) > 0) {
+        for (size_t i = 0; i < leidos; i++) {
+            int c = (unsigned char)l->bloque[i];
+            int col = columna++;
+            if (c == '\n') {
+                linea++;
+                columna = 1;
+                inicio_linea = true;
+                saltar_linea = false;
+                // Sin FASTA cada línea es una lectura
+                if (!l->fasta) bases = 0;
+                continue;
+            }
+            if (saltar_linea) continue;
+
+            int b = codigo_base(c);
+            if (b >= 0) {
+                ventana = ((ventana << 2) | (uint64_t)b) & mascara;
+                if (bases < l->k) bases++;
+                if (bases == l->k && !procesar_kmero(l, ventana, linea, col)) return false;
+            } else if (c == ' ' || c == '\t' || c == '\r') {
+                if (!l->fasta) bases = 0;
+                continue;
+            } else if (inicio_linea && (c == '>' || c == ';')) {
+                if (primero && c == '>') l->fasta = true;
+                saltar_linea = true;
+                bases = 0;
+            } else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-' || c == '.' ||
+                       c == '*') {
+                bases = 0;
+            } else {
+                char mensaje[64];
+                snprintf(mensaje, sizeof(mensaje), "Carácter inesperado '%c' en la secuencia",
+                         c >= 32 && c < 127 ? c : '?');
+                return fallar(l, linea, col, mensaje);
+            }
+            inicio_linea = false;
+            primero = false;
+        }
+    }
+    if (ferror(l->archivo)) {
+        return fallar(l, linea, columna, "Error al leer el archivo");
+    }
+    return true;
+}
+
+bool cargar_de_bruijn(const char *ruta, int k, const ReceptorGrafo *receptor,
+                      DeBruijn *de_bruijn, ErrorCarga *error) {
+    LectorSecuencias l;
+    memset(&l, 0, sizeof(l));
+    memset(de_bruijn, 0, sizeof(*de_bruijn));
+    memset(error, 0, sizeof(*error));
+    de_bruijn->k = k;
+    l.k = k;
+    l.de_bruijn = de_bruijn;
+    l.receptor = receptor;
+    l.error = error;
+
+    if (k < 2 || k > MAX_K_DE_BRUIJN) {
+        char mensaje[64];
+        snprintf(mensaje, sizeof(mensaje), "k debe estar entre 2 y %d", MAX_K_DE_BRUIJN);
+        return fallar(&l, 0, 0, mensaje);
+    }
+    l.archivo = fopen(ruta, "rb");
+    if (!l.archivo) {
+        return fallar(&l, 0, 0, "No se pudo abrir el archivo");
+    }
+    l.bloque = malloc(TAM_BLOQUE_LECTURA);
+    bool ok = l.bloque != NULL;
+    if (!ok) fallar(&l, 0, 0, "Memoria insuficiente");
+
+    if (ok) {
+        l.pasada = 1;
+        ok = analizar_secuencias(&l);
+    }
+    if (ok && de_bruijn->num_kmeros == 0) {
+        char mensaje[64];
+        snprintf(mensaje, sizeof(mensaje), "No hay lecturas de al menos %d bases", k);
+        ok = fallar(&l, 0, 0, mensaje);
+    }
+    if (ok) {
+        ok = receptor->encabezado(receptor->datos, de_bruijn->num_nodos, DIRIGIDO, error);
+    }
+    if (ok) {
+        l.pasada = 2;
+        ok = analizar_secuencias(&l);
+    }
+
+    free(l.bloque);
+    free(l.tabla.ranuras);
+    fclose(l.archivo);
+    if (!ok) liberar_de_bruijn(de_bruijn);
+    return ok;
+}
+
+void liberar_de_bruijn(DeBruijn *de_bruijn) {
+    free(de_bruijn->prefijos);
+    de_bruijn->prefijos = NULL;
+    de_bruijn->num_nodos = 0;
+}
+
+// --------------------------------------------------------------------------
+// Salida FASTA
+
+static void volcar_secuencia(SalidaSecuencia *s) {
+    if (s->buffer.error) {
+        s->ok = false;
+    } else if (s->buffer.longitud > 0 &&
+               fwrite(s->buffer.datos, 1, s->buffer.longitud, s->archivo) != s->buffer.longitud) {
+        s->ok = false;
+    }
+    buffer_vaciar(&s->buffer);
+}
+
+static void agregar_base(SalidaSecuencia *s, int base) {
+    if (s->restantes == 0) return;
+    buffer_agregar_caracter(&s->buffer, BASES[base]);
+    s->restantes--;
+    if (++s->columna == ANCHO_LINEA_FASTA || s->restantes == 0) {
+        buffer_agregar_caracter(&s->buffer, '\n');
+        s->columna = 0;
+    }
+}
+
+static bool secuencia_inicio(void *datos, long long num_vertices) {
+    SalidaSecuencia *s = (SalidaSecuencia *)datos;
+    int k = s->de_bruijn->k;
+    // E + k - 1 bases; en un ciclo las últimas k - 1 repiten el comienzo
+    s->restantes = num_vertices - 1 + (s->circular ? 0 : k - 1);
+    buffer_printf(&s->buffer, ">ensamblado k=%d longitud=%lld %s\n", k, s->restantes,
+                  s->circular ? "circular" : "lineal");
+    return !s->buffer.error;
+}
+
+static bool secuencia_vertice(void *datos, int v) {
+    SalidaSecuencia *s = (SalidaSecuencia *)datos;
+    int k = s->de_bruijn->k;
+    uint64_t prefijo = s->de_bruijn->prefijos[v];
+    if (s->primero) {
+        for (int i = k - 2; i >= 0; i--) {
+            agregar_base(s, (int)((prefijo >> (2 * i)) & 3));
+        }
+        s->primero = false;
+    } else {
+        agregar_base(s, (int)(prefijo & 3));
+    }
+    if (s->buffer.longitud >= TAM_BLOQUE_ESCRITURA) {
+        volcar_secuencia(s);
+    }
+    return s->ok;
+}
+
+static bool secuencia_fin(void *datos) {
+    SalidaSecuencia *s = (SalidaSecuencia *)datos;
+    volcar_secuencia(s);
+    buffer_liberar(&s->buffer);
+    if (fflush(s->archivo) != 0) s->ok = false;
+    return s->ok;
+}
+
+void sumidero_secuencia(SumideroRecorrido *sumidero, SalidaSecuencia *salida, FILE *archivo,
+                        const DeBruijn *de_bruijn, bool circular) {
+    salida->archivo = archivo;
+    salida->de_bruijn = de_bruijn;
+    salida->circular = circular;
+    buffer_iniciar(&salida->buffer);
+    salida->restantes = 0;
+    salida->columna = 0;
+    salida->primero = true;
+    salida->ok = true;
+
+    sumidero->inicio = secuencia_inicio;
+    sumidero->vertice = secuencia_vertice;
+    sumidero->fin = secuencia_fin;
+    sumidero->datos = salida;
+}
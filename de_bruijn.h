@@ -0,0 +1,55 @@
+#ifndef DE_BRUIJN_H
+#define DE_BRUIJN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "buffer_texto.h"
+#include "cargador.h"
+#include "euler.h"
+
+// Ensamblado de secuencias con el grafo de de Bruijn: cada k-mero de las
+// lecturas es un arco de su prefijo de k - 1 bases a su sufijo, y un recorrido
+// euleriano de ese multigrafo dirigido deletrea la secuencia original.
+//
+// Las lecturas vienen en FASTA (líneas '>' de encabezado, la secuencia puede
+// ocupar varias líneas) o una por línea. Se aceptan A, C, G, T (y U) en
+// mayúscula o minúscula; cualquier otra letra, '-', '.' o '*' corta la lectura.
+// Cada lectura aporta todos sus k-meros, así que para reconstruir exactamente
+// conviene dar cada k-mero una sola vez.
+
+#define MAX_K_DE_BRUIJN 32
+
+// Nodos del grafo: el (k-1)-mero de cada uno, 2 bits por base (A=0, C=1, G=2,
+// T=3) con la primera base en los bits altos
+typedef struct {
+    int k;
+    int num_nodos;
+    long long num_kmeros;
+    uint64_t *prefijos;
+} DeBruijn;
+
+// Lee el archivo en dos pasadas por bloques (la primera numera los
+// (k-1)-meros con una tabla de dispersión, la segunda entrega los arcos) y
+// llena 'de_bruijn'. k entre 2 y MAX_K_DE_BRUIJN.
+bool cargar_de_bruijn(const char *ruta, int k, const ReceptorGrafo *receptor,
+                      DeBruijn *de_bruijn, ErrorCarga *error);
+void liberar_de_bruijn(DeBruijn *de_bruijn);
+
+// Sumidero que deletrea el recorrido como FASTA. En un ciclo se omiten las
+// últimas k - 1 bases, que repiten las primeras (secuencia circular).
+typedef struct {
+    FILE *archivo;
+    const DeBruijn *de_bruijn;
+    bool circular;
+    BufferTexto buffer;
+    long long restantes;    // Bases que faltan escribir
+    int columna;
+    bool primero;
+    bool ok;
+} SalidaSecuencia;
+
+void sumidero_secuencia(SumideroRecorrido *sumidero, SalidaSecuencia *salida, FILE *archivo,
+                        const DeBruijn *de_bruijn, bool circular);
+
+#endif
@@ -0,0 +1,358 @@
+#include "distribucion.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THETA_BARNES_HUT 0.9        // Lado / distancia bajo el que una celda cuenta como un punto
+#define PROFUNDIDAD_MAXIMA 48       // Nodos más juntos que lado / 2^48 comparten hoja
+#define GRAVEDAD 0.05
+#define ANGULO_AUREO 2.39996322972865332
+
+static bool posiciones_distintas(const GrafoCSR *grafo) {
+    if (!grafo->posiciones) return false;
+    for (int i = 1; i < grafo->num_nodos; i++) {
+        if (grafo->posiciones[i].x != grafo->posiciones[0].x ||
+            grafo->posiciones[i].y != grafo->posiciones[0].y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Las posiciones iniciales ocupan un cuadrado de lado sqrt(n), unos n puntos
+// separados por la distancia ideal
+static void posiciones_iniciales(Distribucion *d) {
+    int n = d->num_nodos;
+    const GrafoCSR *grafo = d->grafo;
+
+    if (posiciones_distintas(grafo)) {
+        int min_x = grafo->posiciones[0].x, max_x = min_x;
+        int min_y = grafo->posiciones[0].y, max_y = min_y;
+        for (int i = 1; i < n; i++) {
+            if (grafo->posiciones[i].x < min_x) min_x = grafo->posiciones[i].x;
+            if (grafo->posiciones[i].x > max_x) max_x = grafo->posiciones[i].x;
+            if (grafo->posiciones[i].y < min_y) min_y = grafo->posiciones[i].y;
+            if (grafo->posiciones[i].y > max_y) max_y = grafo->posiciones[i].y;
+        }
+        double lado = fmax(max_x - min_x, max_y - min_y);
+        double escala = sqrt((double)n) / lado;
+        for (int i = 0; i < n; i++) {
+            // Los nodos repetidos se separan un poco para que la repulsión tenga dirección
+            d->x[i] = (grafo->posiciones[i].x - (min_x + max_x) / 2.0) * escala + 1e-3 * cos(i * ANGULO_AUREO);
+            d->y[i] = (grafo->posiciones[i].y - (min_y + max_y) / 2.0) * escala + 1e-3 * sin(i * ANGULO_AUREO);
+        }
+        return;
+    }
+
+    // Espiral de girasol: densidad pareja, sin puntos repetidos
+    for (int i = 0; i < n; i++) {
+        double radio = 0.5 * sqrt(i + 0.5);
+        d->x[i] = radio * cos(i * ANGULO_AUREO);
+        d->y[i] = radio * sin(i * ANGULO_AUREO);
+    }
+}
+
+bool iniciar_distribucion(Distribucion *d, const GrafoCSR *grafo, int iteraciones) {
+    memset(d, 0, sizeof(*d));
+    d->grafo = grafo;
+    d->num_nodos = grafo->num_nodos;
+    d->iteraciones = iteraciones > 0 ? iteraciones : ITERACIONES_DISTRIBUCION;
+
+    size_t n = d->num_nodos > 0 ? (size_t)d->num_nodos : 1;
+    d->x = malloc(n * sizeof(double));
+    d->y = malloc(n * sizeof(double));
+    d->dx = calloc(n, sizeof(double));
+    d->dy = calloc(n, sizeof(double));
+    d->orden = malloc(n * sizeof(int));
+    d->capacidad_celdas = 2 * (int)n + 1;
+    d->celdas = malloc((size_t)d->capacidad_celdas * sizeof(CeldaQuadtree));
+    if (!d->x || !d->y || !d->dx || !d->dy || !d->orden || !d->celdas) {
+        liberar_distribucion(d);
+        return false;
+    }
+
+    posiciones_iniciales(d);
+    d->temperatura_inicial = 1.0 + sqrt((double)d->num_nodos) / 10.0;
+    d->temperatura = d->temperatura_inicial;
+    return true;
+}
+
+void liberar_distribucion(Distribucion *d) {
+    free(d->x);
+    free(d->y);
+    free(d->dx);
+    free(d->dy);
+    free(d->orden);
+    free(d->celdas);
+    d->x = NULL;
+    d->y = NULL;
+    d->dx = NULL;
+    d->dy = NULL;
+    d->orden = NULL;
+    d->celdas = NULL;
+    d->num_celdas = 0;
+    d->capacidad_celdas = 0;
+}
+
+static int nueva_celda(Distribucion *d) {
+    if (d->num_celdas == d->capacidad_celdas) {
+        if (d->capacidad_celdas > INT32_MAX / 2) return -1;
+        int capacidad = d->capacidad_celdas * 2;
+        CeldaQuadtree *celdas = realloc(d->celdas, (size_t)capacidad * sizeof(CeldaQuadtree));
+        if (!celdas) return -1;
+        d->celdas = celdas;
+        d->capacidad_celdas = capacidad;
+    }
+    return d->num_celdas++;
+}
+
+// Deja primero los nodos de orden[primero .. ultimo - 1] con coordenada menor que
+// 'corte' y devuelve dónde empiezan los demás
+static int partir(int *orden, int primero, int ultimo, const double *coordenada, double corte) {
+    int i = primero;
+    int j = ultimo - 1;
+    while (i <= j) {
+        if (coordenada[orden[i]] < corte) {
+            i++;
+        } else {
+            int t = orden[i];
+            orden[i] = orden[j];
+            orden[j] = t;
+            j--;
+        }
+    }
+    return i;
+}
+
+static int construir_celda(Distribucion *d, int primero, int ultimo, double x0, double y0, double lado,
+                           int profundidad) {
+    int c = nueva_celda(d);
+    if (c < 0) return -1;
+
+    CeldaQuadtree *celda = &d->celdas[c];
+    celda->x0 = x0;
+    celda->y0 = y0;
+    celda->lado = lado;
+    celda->primero = primero;
+    celda->ultimo = ultimo;
+    for (int q = 0; q < 4; q++) celda->hijos[q] = -1;
+
+    double sx = 0, sy = 0;
+    for (int k = primero; k < ultimo; k++) {
+        sx += d->x[d->orden[k]];
+        sy += d->y[d->orden[k]];
+    }
+    celda->masa = ultimo - primero;
+    celda->cx = sx / celda->masa;
+    celda->cy = sy / celda->masa;
+    if (ultimo - primero == 1 || profundidad == PROFUNDIDAD_MAXIMA) return c;
+
+    // Cuadrantes: (izquierda, abajo), (izquierda, arriba), (derecha, abajo), (derecha, arriba)
+    double mitad = lado / 2.0;
+    int medio = partir(d->orden, primero, ultimo, d->x, x0 + mitad);
+    int cortes[5] = {
+        primero,
+        partir(d->orden, primero, medio, d->y, y0 + mitad),
+        medio,
+        partir(d->orden, medio, ultimo, d->y, y0 + mitad),
+        ultimo
+    };
+    for (int q = 0; q < 4; q++) {
+        if (cortes[q] == cortes[q + 1]) continue;
+        int hijo = construir_celda(d, cortes[q], cortes[q + 1], x0 + (q >= 2 ? mitad : 0),
+                                   y0 + (q % 2 ? mitad : 0), mitad, profundidad + 1);
+        if (hijo < 0) return -1;
+        // construir_celda puede haber movido el arreglo de celdas
+        d->celdas[c].hijos[q] = hijo;
+    }
+    return c;
+}
+
+bool preparar_paso_distribucion(Distribucion *d) {
+    d->num_celdas = 0;
+    if (d->num_nodos == 0) return true;
+
+    double min_x = d->x[0], max_x = d->x[0];
+    double min_y = d->y[0], max_y = d->y[0];
+    for (int i = 0; i < d->num_nodos; i++) {
+        d->orden[i] = i;
+        if (d->x[i] < min_x) min_x = d->x[i];
+        if (d->x[i] > max_x) max_x = d->x[i];
+        if (d->y[i] < min_y) min_y = d->y[i];
+        if (d->y[i] > max_y) max_y = d->y[i];
+    }
+    // El borde derecho y el superior deben quedar dentro del cuadrado
+    double lado = fmax(max_x - min_x, max_y - min_y) * (1 + 1e-9) + 1e-9;
+    return construir_celda(d, 0, d->num_nodos, min_x, min_y, lado, 0) == 0;
+}
+
+void calcular_repulsion_distribucion(Distribucion *d, int desde, int hasta) {
+    int pila[3 * PROFUNDIDAD_MAXIMA + 4];
+
+    // Se recorre en el orden del quadtree: nodos vecinos visitan casi las mismas celdas
+    for (int n = desde; n < hasta; n++) {
+        int i = d->orden[n];
+        double x = d->x[i];
+        double y = d->y[i];
+        double fx = 0, fy = 0;
+        int tope = 0;
+        pila[tope++] = 0;
+
+        while (tope > 0) {
+            const CeldaQuadtree *celda = &d->celdas[pila[--tope]];
+            bool hoja = celda->hijos[0] < 0 && celda->hijos[1] < 0 &&
+                        celda->hijos[2] < 0 && celda->hijos[3] < 0;
+
+            if (!hoja) {
+                double ddx = x - celda->cx;
+                double ddy = y - celda->cy;
+                double d2 = ddx * ddx + ddy * ddy;
+                bool contiene = x >= celda->x0 && x < celda->x0 + celda->lado &&
+                                y >= celda->y0 && y < celda->y0 + celda->lado;
+                // Una celda lejana y que no contiene al nodo repele como un solo punto
+                if (!contiene && celda->lado * celda->lado < THETA_BARNES_HUT * THETA_BARNES_HUT * d2) {
+                    fx += celda->masa * ddx / d2;
+                    fy += celda->masa * ddy / d2;
+                } else {
+                    for (int q = 0; q < 4; q++) {
+                        if (celda->hijos[q] >= 0) pila[tope++] = celda->hijos[q];
+                    }
+                }
+                continue;
+            }
+
+            // Con k = 1 la fuerza k^2/d en la dirección unitaria es (dx, dy) / d^2
+            for (int k = celda->primero; k < celda->ultimo; k++) {
+                int j = d->orden[k];
+                if (j == i) continue;
+                double ddx = x - d->x[j];
+                double ddy = y - d->y[j];
+                double d2 = ddx * ddx + ddy * ddy;
+                if (d2 < 1e-18) {
+                    // Nodos en el mismo punto: se empujan en sentidos opuestos
+                    fx += i < j ? -1.0 : 1.0;
+                    continue;
+                }
+                fx += ddx / d2;
+                fy += ddy / d2;
+            }
+        }
+        d->dx[i] = fx;
+        d->dy[i] = fy;
+    }
+}
+
+bool aplicar_paso_distribucion(Distribucion *d) {
+    const GrafoCSR *grafo = d->grafo;
+    // En los no dirigidos cada arista aparece en los dos sentidos
+    double factor = grafo->tipo == NO_DIRIGIDO ? 0.5 : 1.0;
+
+    for (int u = 0; u < d->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            if (v == u) continue;
+            // Atracción d^2/k en la dirección unitaria: (dx, dy) * d
+            double ddx = d->x[u] - d->x[v];
+            double ddy = d->y[u] - d->y[v];
+            double f = factor * sqrt(ddx * ddx + ddy * ddy);
+            d->dx[u] -= ddx * f;
+            d->dy[u] -= ddy * f;
+            d->dx[v] += ddx * f;
+            d->dy[v] += ddy * f;
+        }
+    }
+
+    for (int i = 0; i < d->num_nodos; i++) {
+        double fx = d->dx[i] - GRAVEDAD * d->x[i];
+        double fy = d->dy[i] - GRAVEDAD * d->y[i];
+        double largo = sqrt(fx * fx + fy * fy);
+        if (largo > 0) {
+            double paso = fmin(largo, d->temperatura) / largo;
+            d->x[i] += fx * paso;
+            d->y[i] += fy * paso;
+        }
+    }
+
+    d->iteracion++;
+    d->temperatura = d->temperatura_inicial * (d->iteraciones - d->iteracion) / d->iteraciones;
+    return d->iteracion < d->iteraciones;
+}
+
+static bool ocupada(const unsigned char *ocupadas, int lado, int x, int y) {
+    size_t k = (size_t)y * (size_t)lado + (size_t)x;
+    return ocupadas[k / 8] & (1u << (k % 8));
+}
+
+static void ocupar(unsigned char *ocupadas, int lado, int x, int y) {
+    size_t k = (size_t)y * (size_t)lado + (size_t)x;
+    ocupadas[k / 8] |= (unsigned char)(1u << (k % 8));
+}
+
+// Recorre anillos de radio creciente (en distancia de Chebyshev) hasta que
+// ningún anillo pendiente pueda tener un punto libre más cercano que el hallado
+static void buscar_libre(const unsigned char *ocupadas, int limite, int *px, int *py) {
+    int mejor_x = -1, mejor_y = -1;
+    long long mejor = -1;
+    for (long long r = 1; r <= limite && (mejor < 0 || r * r <= mejor); r++) {
+        for (long long dy = -r; dy <= r; dy++) {
+            // En las filas intermedias solo cuentan los dos extremos del anillo
+            long long paso = (dy == -r || dy == r) ? 1 : 2 * r;
+            for (long long dx = -r; dx <= r; dx += paso) {
+                long long x = *px + dx;
+                long long y = *py + dy;
+                if (x < 0 || y < 0 || x > limite || y > limite) continue;
+                if (ocupada(ocupadas, limite + 1, (int)x, (int)y)) continue;
+                long long distancia = dx * dx + dy * dy;
+                if (mejor < 0 || distancia < mejor) {
+                    mejor = distancia;
+                    mejor_x = (int)x;
+                    mejor_y = (int)y;
+                }
+            }
+        }
+    }
+    *px = mejor_x;
+    *py = mejor_y;
+}
+
+bool ajustar_posiciones_distribucion(const Distribucion *d, int limite, Coordenada *posiciones) {
+    int n = d->num_nodos;
+    size_t puntos = (size_t)(limite + 1) * (size_t)(limite + 1);
+    if (limite < 0 || (size_t)n > puntos) return false;
+    if (n == 0) return true;
+
+    double min_x = d->x[0], max_x = d->x[0];
+    double min_y = d->y[0], max_y = d->y[0];
+    for (int i = 1; i < n; i++) {
+        if (d->x[i] < min_x) min_x = d->x[i];
+        if (d->x[i] > max_x) max_x = d->x[i];
+        if (d->y[i] < min_y) min_y = d->y[i];
+        if (d->y[i] > max_y) max_y = d->y[i];
+    }
+    double lado = fmax(max_x - min_x, max_y - min_y);
+    double escala = lado > 0 ? limite / lado : 0;
+    // El lado corto queda centrado
+    double margen_x = (limite - (max_x - min_x) * escala) / 2.0;
+    double margen_y = (limite - (max_y - min_y) * escala) / 2.0;
+
+    unsigned char *ocupadas = calloc(puntos / 8 + 1, 1);
+    if (!ocupadas) return false;
+    for (int i = 0; i < n; i++) {
+        int x = (int)lround(margen_x + (d->x[i] - min_x) * escala);
+        int y = (int)lround(margen_y + (d->y[i] - min_y) * escala);
+        if (x < 0) x = 0;
+        if (y < 0) y = 0;
+        if (x > limite) x = limite;
+        if (y > limite) y = limite;
+        if (ocupada(ocupadas, limite + 1, x, y)) {
+            buscar_libre(ocupadas, limite, &x, &y);
+        }
+        ocupar(ocupadas, limite + 1, x, y);
+        posiciones[i].x = x;
+        posiciones[i].y = y;
+    }
+    free(ocupadas);
+    return true;
+}
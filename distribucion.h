@@ -0,0 +1,66 @@
+#ifndef DISTRIBUCION_H
+#define DISTRIBUCION_H
+
+#include <stdbool.h>
+#include "grafo.h"
+#include "grafo_csr.h"
+
+// Distribución automática de los nodos por fuerzas (Fruchterman-Reingold): las
+// aristas atraen a sus extremos con fuerza d^2/k, todos los nodos se repelen
+// con fuerza k^2/d y una gravedad débil mantiene juntas las componentes. La
+// repulsión se aproxima con un quadtree de Barnes-Hut, así que cada iteración
+// cuesta O(V log V + E) en lugar de O(V^2).
+//
+// Cada iteración se hace en tres partes para que el llamador pueda repartir
+// la del medio entre hilos y mostrar el avance entre iteraciones:
+//   preparar_paso_distribucion             arma el quadtree (un hilo)
+//   calcular_repulsion_distribucion        nodos orden[desde .. hasta - 1] (en
+//                                          el orden del quadtree, de 0 a V); los
+//                                          tramos disjuntos pueden correr en paralelo
+//   aplicar_paso_distribucion              atracción, movimiento y enfriamiento
+
+#define ITERACIONES_DISTRIBUCION 300
+
+// Celda del quadtree: las hojas guardan sus nodos en orden[primero .. ultimo - 1]
+typedef struct {
+    double x0, y0, lado;
+    double masa;
+    double cx, cy;          // Centro de masa
+    int hijos[4];           // -1 si el cuadrante está vacío; sin hijos es hoja
+    int primero;
+    int ultimo;
+} CeldaQuadtree;
+
+typedef struct {
+    const GrafoCSR *grafo;
+    int num_nodos;
+    double *x;              // Posiciones continuas, con distancia ideal k = 1
+    double *y;
+    double *dx;             // Desplazamiento acumulado en la iteración
+    double *dy;
+    double temperatura;     // Desplazamiento máximo por iteración
+    double temperatura_inicial;
+    int iteracion;
+    int iteraciones;
+    int *orden;             // Nodos agrupados por hoja
+    CeldaQuadtree *celdas;
+    int num_celdas;
+    int capacidad_celdas;
+} Distribucion;
+
+// Parte de las posiciones del grafo si las trae (y no están todas en el mismo
+// punto); si no, de una espiral. El grafo debe seguir vivo mientras se use.
+bool iniciar_distribucion(Distribucion *d, const GrafoCSR *grafo, int iteraciones);
+void liberar_distribucion(Distribucion *d);
+
+bool preparar_paso_distribucion(Distribucion *d);
+void calcular_repulsion_distribucion(Distribucion *d, int desde, int hasta);
+// Devuelve false cuando ya no quedan iteraciones
+bool aplicar_paso_distribucion(Distribucion *d);
+
+// Lleva las posiciones continuas a enteros entre 0 y 'limite' conservando la
+// proporción; dos nodos que caen en el mismo punto se separan al punto libre
+// más cercano. Falla si no caben (más de (limite + 1)^2 nodos) o sin memoria.
+bool ajustar_posiciones_distribucion(const Distribucion *d, int limite, Coordenada *posiciones);
+
+#endif
@@ -0,0 +1,345 @@
+#include "escritor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "buffer_texto.h"
+#include "instantanea.h"
+
+// Tamaño a partir del cual el buffer se vuelca al archivo
+#define TAM_BLOQUE_ESCRITURA (1 << 20)
+
+typedef struct {
+    FILE *archivo;
+    BufferTexto buffer;
+    bool ok;
+} Escritor;
+
+static void volcar(Escritor *e) {
+    if (e->buffer.error) {
+        e->ok = false;
+    } else if (e->buffer.longitud > 0 &&
+               fwrite(e->buffer.datos, 1, e->buffer.longitud, e->archivo) != e->buffer.longitud) {
+        e->ok = false;
+    }
+    buffer_vaciar(&e->buffer);
+}
+
+static inline void volcar_si_lleno(Escritor *e) {
+    if (e->buffer.longitud >= TAM_BLOQUE_ESCRITURA) {
+        volcar(e);
+    }
+}
+
+static void escribir_par(Escritor *e, long a, long b) {
+    buffer_agregar_entero(&e->buffer, a);
+    buffer_agregar_caracter(&e->buffer, ' ');
+    buffer_agregar_entero(&e->buffer, b);
+    buffer_agregar_caracter(&e->buffer, '\n');
+    volcar_si_lleno(e);
+}
+
+static Coordenada posicion_de(const GrafoCSR *grafo, int nodo) {
+    if (grafo->posiciones) return grafo->posiciones[nodo];
+    Coordenada origen = {0, 0};
+    return origen;
+}
+
+// Cantidad de aristas tal como se escriben en las listas: en grafos no dirigidos
+// cada arista cuenta una vez aunque el CSR la guarde en ambos sentidos
+static long long contar_aristas(const GrafoCSR *grafo) {
+    if (grafo->tipo == DIRIGIDO) return grafo->num_arcos;
+
+    long long aristas = 0;
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            if (grafo->destinos[a] >= u) aristas++;
+        }
+    }
+    return aristas;
+}
+
+// Mismo formato que guarda la interfaz: K, tipo, la matriz fila por fila y las
+// posiciones. Cada fila se arma desde los arcos del nodo con un arreglo de conteos.
+static bool escribir_matriz(Escritor *e, const GrafoCSR *grafo) {
+    int K = grafo->num_nodos;
+    int *fila = calloc((size_t)K, sizeof(int));
+    if (!fila) return false;
+
+    buffer_printf(&e->buffer, "%d\n%d\n", K, (int)grafo->tipo);
+    for (int u = 0; u < K; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            fila[grafo->destinos[a]]++;
+        }
+        for (int v = 0; v < K; v++) {
+            buffer_agregar_entero(&e->buffer, fila[v]);
+            buffer_agregar_caracter(&e->buffer, ' ');
+            fila[v] = 0;
+        }
+        buffer_agregar_caracter(&e->buffer, '\n');
+        volcar_si_lleno(e);
+    }
+    free(fila);
+
+    for (int u = 0; u < K; u++) {
+        Coordenada pos = posicion_de(grafo, u);
+        escribir_par(e, pos.x, pos.y);
+    }
+    return true;
+}
+
+static bool escribir_lista_aristas(Escritor *e, const GrafoCSR *grafo) {
+    buffer_printf(&e->buffer, "%d %d %lld\n", grafo->num_nodos, (int)grafo->tipo, contar_aristas(grafo));
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            if (grafo->tipo == DIRIGIDO || v >= u) {
+                escribir_par(e, u, v);
+            }
+        }
+    }
+    if (grafo->posiciones) {
+        for (int u = 0; u < grafo->num_nodos; u++) {
+            escribir_par(e, grafo->posiciones[u].x, grafo->posiciones[u].y);
+        }
+    }
+    return true;
+}
+
+static bool escribir_dimacs(Escritor *e, const GrafoCSR *grafo) {
+    bool dirigido = grafo->tipo == DIRIGIDO;
+    buffer_agregar(&e->buffer, "c Grafo exportado por proyecto-4aa\n");
+    buffer_printf(&e->buffer, "p %s %d %lld\n", dirigido ? "sp" : "edge",
+                  grafo->num_nodos, contar_aristas(grafo));
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            // El formato de caminos más cortos exige un peso en cada arco
+            if (dirigido) {
+                buffer_agregar(&e->buffer, "a ");
+                buffer_agregar_entero(&e->buffer, u + 1);
+                buffer_agregar_caracter(&e->buffer, ' ');
+                buffer_agregar_entero(&e->buffer, v + 1);
+                buffer_agregar(&e->buffer, " 1\n");
+                volcar_si_lleno(e);
+            } else if (v >= u) {
+                buffer_agregar(&e->buffer, "e ");
+                escribir_par(e, u + 1, v + 1);
+            }
+        }
+    }
+    if (grafo->posiciones) {
+        for (int u = 0; u < grafo->num_nodos; u++) {
+            buffer_agregar(&e->buffer, "v ");
+            buffer_agregar_entero(&e->buffer, u + 1);
+            buffer_agregar_caracter(&e->buffer, ' ');
+            escribir_par(e, grafo->posiciones[u].x, grafo->posiciones[u].y);
+        }
+    }
+    return true;
+}
+
+// Número de paso de cada arco en el recorrido (0 si no lo usa). En grafos no
+// dirigidos el paso queda en el arco que se escribe, el que va del menor al mayor.
+// Las aristas múltiples se asignan en orden, una por paso.
+static int *pasos_recorrido(const GrafoCSR *grafo, const RecorridoGrafo *recorrido) {
+    int *paso = calloc((size_t)(grafo->num_arcos > 0 ? grafo->num_arcos : 1), sizeof(int));
+    if (!paso) return NULL;
+
+    for (int i = 0; i + 1 < recorrido->longitud; i++) {
+        int u = recorrido->secuencia[i];
+        int v = recorrido->secuencia[i + 1];
+        if (u < 0 || v < 0 || u >= grafo->num_nodos || v >= grafo->num_nodos) continue;
+        if (grafo->tipo == NO_DIRIGIDO && v < u) {
+            int t = u;
+            u = v;
+            v = t;
+        }
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            if (grafo->destinos[a] == v && paso[a] == 0) {
+                paso[a] = i + 1;
+                break;
+            }
+        }
+    }
+    return paso;
+}
+
+// Escribe texto dentro de un valor de atributo XML
+static void escribir_xml(Escritor *e, const char *texto) {
+    for (; *texto; texto++) {
+        switch (*texto) {
+            case '<': buffer_agregar(&e->buffer, "&lt;"); break;
+            case '>': buffer_agregar(&e->buffer, "&gt;"); break;
+            case '&': buffer_agregar(&e->buffer, "&amp;"); break;
+            case '"': buffer_agregar(&e->buffer, "&quot;"); break;
+            default: buffer_agregar_caracter(&e->buffer, *texto); break;
+        }
+    }
+}
+
+static bool escribir_graphml(Escritor *e, const GrafoCSR *grafo, const RecorridoGrafo *recorridos,
+                             int * const *pasos, int num_recorridos) {
+    buffer_agregar(&e->buffer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    buffer_agregar(&e->buffer, "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n");
+    if (grafo->posiciones) {
+        buffer_agregar(&e->buffer, "  <key id=\"x\" for=\"node\" attr.name=\"x\" attr.type=\"int\"/>\n");
+        buffer_agregar(&e->buffer, "  <key id=\"y\" for=\"node\" attr.name=\"y\" attr.type=\"int\"/>\n");
+    }
+    for (int r = 0; r < num_recorridos; r++) {
+        buffer_agregar(&e->buffer, "  <key id=\"");
+        escribir_xml(e, recorridos[r].nombre);
+        buffer_agregar(&e->buffer, "\" for=\"edge\" attr.name=\"");
+        escribir_xml(e, recorridos[r].nombre);
+        buffer_agregar(&e->buffer, "\" attr.type=\"int\"/>\n");
+    }
+    buffer_printf(&e->buffer, "  <graph id=\"G\" edgedefault=\"%s\">\n",
+                  grafo->tipo == DIRIGIDO ? "directed" : "undirected");
+
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        buffer_agregar(&e->buffer, "    <node id=\"n");
+        buffer_agregar_entero(&e->buffer, u);
+        if (grafo->posiciones) {
+            buffer_agregar(&e->buffer, "\"><data key=\"x\">");
+            buffer_agregar_entero(&e->buffer, grafo->posiciones[u].x);
+            buffer_agregar(&e->buffer, "</data><data key=\"y\">");
+            buffer_agregar_entero(&e->buffer, grafo->posiciones[u].y);
+            buffer_agregar(&e->buffer, "</data></node>\n");
+        } else {
+            buffer_agregar(&e->buffer, "\"/>\n");
+        }
+        volcar_si_lleno(e);
+    }
+
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            if (grafo->tipo == NO_DIRIGIDO && v < u) continue;
+
+            buffer_agregar(&e->buffer, "    <edge source=\"n");
+            buffer_agregar_entero(&e->buffer, u);
+            buffer_agregar(&e->buffer, "\" target=\"n");
+            buffer_agregar_entero(&e->buffer, v);
+            buffer_agregar(&e->buffer, "\"");
+            bool con_datos = false;
+            for (int r = 0; r < num_recorridos; r++) {
+                if (pasos[r][a] == 0) continue;
+                buffer_agregar(&e->buffer, con_datos ? "<data key=\"" : "><data key=\"");
+                escribir_xml(e, recorridos[r].nombre);
+                buffer_agregar(&e->buffer, "\">");
+                buffer_agregar_entero(&e->buffer, pasos[r][a]);
+                buffer_agregar(&e->buffer, "</data>");
+                con_datos = true;
+            }
+            buffer_agregar(&e->buffer, con_datos ? "</edge>\n" : "/>\n");
+            volcar_si_lleno(e);
+        }
+    }
+
+    buffer_agregar(&e->buffer, "  </graph>\n</graphml>\n");
+    return true;
+}
+
+static bool escribir_dot(Escritor *e, const GrafoCSR *grafo, const RecorridoGrafo *recorridos,
+                         int * const *pasos, int num_recorridos) {
+    bool dirigido = grafo->tipo == DIRIGIDO;
+    buffer_agregar(&e->buffer, dirigido ? "digraph G {\n" : "graph G {\n");
+
+    // Se declaran todos los nodos para conservar su orden al volver a leer el
+    // archivo; "!" fija la posición en neato
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        if (grafo->posiciones) {
+            buffer_printf(&e->buffer, "  n%d [pos=\"%d,%d!\"];\n", u,
+                          grafo->posiciones[u].x, grafo->posiciones[u].y);
+        } else {
+            buffer_printf(&e->buffer, "  n%d;\n", u);
+        }
+        volcar_si_lleno(e);
+    }
+
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            if (!dirigido && v < u) continue;
+
+            buffer_agregar(&e->buffer, "  n");
+            buffer_agregar_entero(&e->buffer, u);
+            buffer_agregar(&e->buffer, dirigido ? " -> n" : " -- n");
+            buffer_agregar_entero(&e->buffer, v);
+            bool con_atributos = false;
+            for (int r = 0; r < num_recorridos; r++) {
+                if (pasos[r][a] == 0) continue;
+                buffer_agregar(&e->buffer, con_atributos ? ", " : " [");
+                buffer_agregar(&e->buffer, recorridos[r].nombre);
+                buffer_agregar_caracter(&e->buffer, '=');
+                buffer_agregar_entero(&e->buffer, pasos[r][a]);
+                con_atributos = true;
+            }
+            buffer_agregar(&e->buffer, con_atributos ? "];\n" : ";\n");
+            volcar_si_lleno(e);
+        }
+    }
+
+    buffer_agregar(&e->buffer, "}\n");
+    return true;
+}
+
+bool guardar_grafo_csr(const char *ruta, FormatoGrafo formato, const GrafoCSR *grafo) {
+    return guardar_grafo_anotado(ruta, formato, grafo, NULL, 0);
+}
+
+bool guardar_grafo_anotado(const char *ruta, FormatoGrafo formato, const GrafoCSR *grafo,
+                           const RecorridoGrafo *recorridos, int num_recorridos) {
+    if (formato == FORMATO_INSTANTANEA) {
+        return guardar_instantanea(ruta, grafo);
+    }
+    if (formato != FORMATO_GRAPHML && formato != FORMATO_DOT) {
+        num_recorridos = 0;
+    }
+
+    int **pasos = calloc((size_t)(num_recorridos > 0 ? num_recorridos : 1), sizeof(int *));
+    bool escrito = pasos != NULL;
+    for (int r = 0; escrito && r < num_recorridos; r++) {
+        pasos[r] = pasos_recorrido(grafo, &recorridos[r]);
+        escrito = pasos[r] != NULL;
+    }
+
+    Escritor e;
+    e.archivo = escrito ? fopen(ruta, "wb") : NULL;
+    if (!e.archivo) {
+        escrito = false;
+    } else {
+        buffer_iniciar(&e.buffer);
+        e.ok = true;
+
+        switch (formato) {
+            case FORMATO_LISTA_ARISTAS:
+                escrito = escribir_lista_aristas(&e, grafo);
+                break;
+            case FORMATO_DIMACS:
+                escrito = escribir_dimacs(&e, grafo);
+                break;
+            case FORMATO_GRAPHML:
+                escrito = escribir_graphml(&e, grafo, recorridos, pasos, num_recorridos);
+                break;
+            case FORMATO_DOT:
+                escrito = escribir_dot(&e, grafo, recorridos, pasos, num_recorridos);
+                break;
+            default:
+                escrito = escribir_matriz(&e, grafo);
+                break;
+        }
+        volcar(&e);
+
+        buffer_liberar(&e.buffer);
+        if (fclose(e.archivo) != 0) e.ok = false;
+        escrito = escrito && e.ok;
+    }
+
+    if (pasos) {
+        for (int r = 0; r < num_recorridos; r++) {
+            free(pasos[r]);
+        }
+        free(pasos);
+    }
+    return escrito;
+}
@@ -0,0 +1,27 @@
+#ifndef ESCRITOR_H
+#define ESCRITOR_H
+
+#include <stdbool.h>
+#include "cargador.h"
+#include "grafo_csr.h"
+
+// Guarda el grafo en el formato indicado (no acepta FORMATO_AUTOMATICO). La
+// salida se arma en memoria por bloques, así que el costo no depende de la
+// cantidad de llamadas a fprintf sino del tamaño del archivo.
+bool guardar_grafo_csr(const char *ruta, FormatoGrafo formato, const GrafoCSR *grafo);
+
+// Recorrido del grafo (ciclo euleriano, hamiltoniano, ...) como secuencia de
+// vértices; cada par consecutivo es un paso
+typedef struct {
+    const char *nombre;     // Nombre del atributo de arista, por ejemplo "euler"
+    const int *secuencia;
+    int longitud;
+} RecorridoGrafo;
+
+// Como guardar_grafo_csr, pero en GraphML y DOT cada arista usada por un
+// recorrido lleva un atributo con el número de paso (1, 2, ...). Los formatos
+// de texto y la instantánea no tienen dónde guardarlos y los ignoran.
+bool guardar_grafo_anotado(const char *ruta, FormatoGrafo formato, const GrafoCSR *grafo,
+                           const RecorridoGrafo *recorridos, int num_recorridos);
+
+#endif
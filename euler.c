@@ -0,0 +1,528 @@
+#include "euler.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matriz_bits.h"
+
+#define TAM_BLOQUE_ESCRITURA (1 << 20)
+
+// Hasta esta cantidad de nodos los grados y la matriz de bits de la conexidad
+// van en la pila: clasificar no pide memoria y las filas son de una palabra
+#define NODOS_EN_PILA 64
+
+static const char MAGIA_RECORRIDO[8] = "P4AAEUL";
+
+// Conjuntos disjuntos para la conexidad; con compresión de caminos a la mitad
+static int raiz(int *padre, int x) {
+    while (padre[x] != x) {
+        padre[x] = padre[padre[x]];
+        x = padre[x];
+    }
+    return x;
+}
+
+// Todos los nodos con aristas deben quedar en una misma componente (débil,
+// para dirigidos: con grados balanceados equivale a la fuerte)
+static bool aristas_conexas(const GrafoCSR *grafo, const long long *grado, bool *sin_memoria) {
+    int n = grafo->num_nodos;
+
+    // Los grafos pequeños y los densos usan la matriz de bits (en grafos densos no
+    // ocupa más que el CSR) y cada nivel del recorrido avanza una fila entera; sin
+    // memoria para ella se usan los conjuntos
+    uint64_t filas_pila[NODOS_EN_PILA];
+    MatrizBits matriz = {n, 1, filas_pila};
+    bool con_matriz;
+    if (n <= NODOS_EN_PILA) {
+        memset(filas_pila, 0, (size_t)n * sizeof(uint64_t));
+        marcar_arcos_matriz_bits(grafo, grafo->tipo == DIRIGIDO, &matriz);
+        con_matriz = true;
+    } else {
+        con_matriz = conviene_matriz_bits(grafo) &&
+                     matriz_bits_desde_csr(grafo, grafo->tipo == DIRIGIDO, &matriz);
+    }
+    if (con_matriz) {
+        int origen = -1;
+        long long con_aristas = 0;
+        for (int u = 0; u < n; u++) {
+            if (grado[u] == 0) continue;
+            if (origen < 0) origen = u;
+            con_aristas++;
+        }
+        long long alcanzados = origen >= 0 ? alcanzables_matriz_bits(&matriz, origen, con_aristas) : 0;
+        if (matriz.filas != filas_pila) liberar_matriz_bits(&matriz);
+        if (alcanzados >= 0) return alcanzados == con_aristas;
+    }
+
+    int *padre = malloc((size_t)n * sizeof(int));
+    if (!padre) {
+        *sin_memoria = true;
+        return false;
+    }
+    for (int u = 0; u < n; u++) {
+        padre[u] = u;
+    }
+    // En no dirigidos cada arista está en ambos sentidos: basta con uno
+    bool ambos_sentidos = grafo->tipo == DIRIGIDO;
+    for (int u = 0; u < n; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            if (!ambos_sentidos && v < u) continue;
+            int ru = raiz(padre, u);
+            int rv = raiz(padre, v);
+            if (ru != rv) padre[ru] = rv;
+        }
+    }
+
+    int componente = -1;
+    bool conexo = true;
+    for (int u = 0; u < n && conexo; u++) {
+        if (grado[u] == 0) continue;
+        int r = raiz(padre, u);
+        if (componente < 0) componente = r;
+        conexo = r == componente;
+    }
+    free(padre);
+    return conexo;
+}
+
+// Grado de cada nodo: en no dirigidos el lazo (guardado una sola vez) cuenta
+// dos; en dirigidos, salida menos entrada. 'grado' debe venir en cero.
+static void calcular_grados(const GrafoCSR *grafo, long long *grado) {
+    int n = grafo->num_nodos;
+    for (int u = 0; u < n; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            if (grafo->tipo == DIRIGIDO) {
+                grado[u]++;
+                grado[v]--;
+            } else {
+                grado[u] += v == u ? 2 : 1;
+            }
+        }
+    }
+}
+
+static ClaseEuleriana clasificar(const GrafoCSR *grafo, int *inicio, int *arranque, bool *sin_memoria) {
+    int n = grafo->num_nodos;
+    *sin_memoria = false;
+    if (grafo->num_arcos == 0) return EULER_NINGUNO;
+
+    long long grado_pila[NODOS_EN_PILA];
+    long long *grado = n <= NODOS_EN_PILA ? grado_pila : calloc((size_t)n, sizeof(long long));
+    if (!grado) {
+        *sin_memoria = true;
+        return EULER_NINGUNO;
+    }
+    if (grado == grado_pila) memset(grado_pila, 0, (size_t)n * sizeof(long long));
+    calcular_grados(grafo, grado);
+
+    // Extremos de la ruta: en dirigidos el de salida sobrante y el de entrada sobrante
+    int extremos[2] = {-1, -1};
+    int num_impares = 0;
+    int con_aristas = -1;
+    bool valido = true;
+    for (int u = 0; u < n && valido; u++) {
+        if (con_aristas < 0 && grafo->inicio[u + 1] > grafo->inicio[u]) con_aristas = u;
+        if (grafo->tipo == DIRIGIDO) {
+            if (grado[u] == 1 && extremos[0] < 0) extremos[0] = u;
+            else if (grado[u] == -1 && extremos[1] < 0) extremos[1] = u;
+            else if (grado[u] != 0) valido = false;
+        } else if (grado[u] % 2 != 0) {
+            if (num_impares < 2) extremos[num_impares] = u;
+            valido = ++num_impares <= 2;
+        }
+    }
+
+    // En dirigidos el grado ya no sirve para la conexidad; marca los nodos con arcos
+    if (valido && grafo->tipo == DIRIGIDO) {
+        memset(grado, 0, (size_t)n * sizeof(long long));
+        for (int u = 0; u < n; u++) {
+            for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+                grado[u] = 1;
+                grado[grafo->destinos[a]] = 1;
+            }
+        }
+    }
+    if (valido) {
+        valido = aristas_conexas(grafo, grado, sin_memoria);
+    }
+    if (grado != grado_pila) free(grado);
+    if (!valido) return EULER_NINGUNO;
+
+    bool ruta = grafo->tipo == DIRIGIDO ? extremos[0] >= 0 : num_impares == 2;
+    if (grafo->tipo == DIRIGIDO && (extremos[0] >= 0) != (extremos[1] >= 0)) return EULER_NINGUNO;
+
+    if (!ruta) {
+        *inicio = con_aristas;
+        *arranque = con_aristas;
+        return EULER_CICLO;
+    }
+    // El recorrido sale de la pila al revés: en no dirigidos se arranca desde el
+    // otro extremo y en dirigidos (sobre el transpuesto) desde el final de la ruta
+    *inicio = extremos[0];
+    *arranque = extremos[1];
+    return EULER_RUTA;
+}
+
+ClaseEuleriana clasificar_euleriano_csr(const GrafoCSR *grafo, int *inicio) {
+    int arranque;
+    bool sin_memoria;
+    return clasificar(grafo, inicio, &arranque, &sin_memoria);
+}
+
+// Arco gemelo de cada arco en un grafo no dirigido (v -> u para u -> v; los
+// lazos son su propio gemelo). Los arcos u -> v con u < v se ordenan por
+// (v, u) y los v -> u por (v, u) también, con dos pasadas de conteo estables;
+// así el i-ésimo de cada lista es la misma arista si la matriz es simétrica,
+// lo que se comprueba par por par (con 'simetrico' en false si no lo es). O(V + E).
+static long long *emparejar_arcos(const GrafoCSR *grafo, bool *simetrico) {
+    int n = grafo->num_nodos;
+    long long m = grafo->num_arcos;
+    long long *pareja = malloc((size_t)(m > 0 ? m : 1) * sizeof(long long));
+    long long *conteo = calloc((size_t)n + 1, sizeof(long long));
+    long long *bajos = NULL, *altos = NULL, *temporal = NULL;
+    int *origen_temporal = NULL;
+    *simetrico = true;
+
+    long long num_bajos = 0;
+    for (int u = 0; u < n; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            if (grafo->destinos[a] > u) num_bajos++;
+        }
+    }
+    size_t tam = (size_t)(num_bajos > 0 ? num_bajos : 1);
+    if (pareja && conteo) {
+        bajos = malloc(tam * sizeof(long long));
+        altos = malloc(tam * sizeof(long long));
+        temporal = malloc(tam * sizeof(long long));
+        origen_temporal = malloc(tam * sizeof(int));
+    }
+    bool ok = pareja && conteo && bajos && altos && temporal && origen_temporal;
+    long long num_altos = 0;
+
+    if (ok) {
+        // Bajos u -> v (u < v) por (v, u): se reparten por v recorriendo u en orden
+        for (int u = 0; u < n; u++) {
+            for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+                int v = grafo->destinos[a];
+                if (v > u) conteo[v + 1]++;
+                if (v == u) pareja[a] = a;
+            }
+        }
+        for (int v = 0; v < n; v++) conteo[v + 1] += conteo[v];
+        for (int u = 0; u < n; u++) {
+            for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+                if (grafo->destinos[a] > u) bajos[conteo[grafo->destinos[a]]++] = a;
+            }
+        }
+
+        // Altos v -> u (u < v) por (v, u): primero por u y luego, estable, por v
+        memset(conteo, 0, ((size_t)n + 1) * sizeof(long long));
+        for (int v = 0; v < n; v++) {
+            for (long long a = grafo->inicio[v]; a < grafo->inicio[v + 1]; a++) {
+                if (grafo->destinos[a] < v) {
+                    conteo[grafo->destinos[a] + 1]++;
+                    num_altos++;
+                }
+            }
+        }
+        *simetrico = num_altos == num_bajos;
+        ok = *simetrico;
+    }
+    if (ok) {
+        for (int u = 0; u < n; u++) conteo[u + 1] += conteo[u];
+        for (int v = 0; v < n; v++) {
+            for (long long a = grafo->inicio[v]; a < grafo->inicio[v + 1]; a++) {
+                int u = grafo->destinos[a];
+                if (u < v) {
+                    long long i = conteo[u]++;
+                    temporal[i] = a;
+                    origen_temporal[i] = v;
+                }
+            }
+        }
+        memset(conteo, 0, ((size_t)n + 1) * sizeof(long long));
+        for (long long i = 0; i < num_altos; i++) conteo[origen_temporal[i] + 1]++;
+        for (int v = 0; v < n; v++) conteo[v + 1] += conteo[v];
+        for (long long i = 0; i < num_altos; i++) altos[conteo[origen_temporal[i]]++] = temporal[i];
+
+        for (long long i = 0; i < num_bajos && ok; i++) {
+            pareja[bajos[i]] = altos[i];
+            pareja[altos[i]] = bajos[i];
+        }
+
+        // Con totales iguales pero celdas distintas (a[0][1] y a[2][0]) el
+        // i-ésimo bajo y el i-ésimo alto no son la misma arista: el gemelo de
+        // u -> v debe ser v -> u, es decir, estar en la fila de v y apuntar a u
+        for (int u = 0; u < n && *simetrico; u++) {
+            for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+                int v = grafo->destinos[a];
+                if (v <= u) continue;
+                long long b = pareja[a];
+                if (grafo->destinos[b] != u || b < grafo->inicio[v] || b >= grafo->inicio[v + 1]) {
+                    *simetrico = false;
+                    break;
+                }
+            }
+        }
+        ok = *simetrico;
+    }
+
+    free(conteo);
+    free(bajos);
+    free(altos);
+    free(temporal);
+    free(origen_temporal);
+    if (!ok) {
+        free(pareja);
+        return NULL;
+    }
+    return pareja;
+}
+
+// Transpuesto del CSR: para cada nodo, los orígenes de los arcos que llegan
+static bool transponer(const GrafoCSR *grafo, long long **inicio_t, int **origenes_t) {
+    int n = grafo->num_nodos;
+    long long m = grafo->num_arcos;
+    *inicio_t = calloc((size_t)n + 1, sizeof(long long));
+    *origenes_t = malloc((size_t)(m > 0 ? m : 1) * sizeof(int));
+    if (!*inicio_t || !*origenes_t) return false;
+
+    long long *inicio = *inicio_t;
+    for (long long a = 0; a < m; a++) inicio[grafo->destinos[a] + 1]++;
+    for (int v = 0; v < n; v++) inicio[v + 1] += inicio[v];
+    for (int u = 0; u < n; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            (*origenes_t)[inicio[grafo->destinos[a]]++] = u;
+        }
+    }
+    for (int v = n; v > 0; v--) inicio[v] = inicio[v - 1];
+    inicio[0] = 0;
+    return true;
+}
+
+bool recorrido_euleriano_csr(const GrafoCSR *grafo, const SumideroRecorrido *sumidero,
+                             ClaseEuleriana *clase, const char **motivo) {
+    if (motivo) *motivo = NULL;
+    int inicio, arranque;
+    bool sin_memoria;
+    ClaseEuleriana encontrada = clasificar(grafo, &inicio, &arranque, &sin_memoria);
+    if (clase) *clase = encontrada;
+    if (encontrada == EULER_NINGUNO) return false;
+
+    int n = grafo->num_nodos;
+    long long m = grafo->num_arcos;
+    bool dirigido = grafo->tipo == DIRIGIDO;
+
+    // Adyacencia que se recorre: la del grafo (no dirigido) o la transpuesta
+    const long long *fila = grafo->inicio;
+    const int *vecinos = grafo->destinos;
+    long long *inicio_t = NULL;
+    int *origenes_t = NULL;
+    long long *pareja = NULL;
+    unsigned char *usado = NULL;
+    long long num_aristas = m;
+
+    bool ok;
+    if (dirigido) {
+        ok = transponer(grafo, &inicio_t, &origenes_t);
+        fila = inicio_t;
+        vecinos = origenes_t;
+    } else {
+        bool simetrico;
+        pareja = emparejar_arcos(grafo, &simetrico);
+        if (!simetrico && motivo) *motivo = "La matriz de un grafo no dirigido no es simétrica";
+        usado = calloc((size_t)(m / 8 + 1), 1);
+        ok = pareja && usado;
+        long long lazos = 0;
+        for (int u = 0; u < n; u++) {
+            for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+                if (grafo->destinos[a] == u) lazos++;
+            }
+        }
+        num_aristas = (m + lazos) / 2;
+    }
+
+    long long *cursor = ok ? malloc((size_t)n * sizeof(long long)) : NULL;
+    int *pila = ok ? malloc((size_t)(num_aristas + 1) * sizeof(int)) : NULL;
+    ok = cursor && pila;
+
+    if (ok) {
+        memcpy(cursor, fila, (size_t)n * sizeof(long long));
+        ok = !sumidero->inicio || sumidero->inicio(sumidero->datos, num_aristas + 1);
+    }
+
+    long long tope = 0;
+    if (ok) pila[tope++] = arranque;
+    while (ok && tope > 0) {
+        int u = pila[tope - 1];
+        long long a = cursor[u];
+        if (!dirigido) {
+            while (a < fila[u + 1] && (usado[a >> 3] & (1u << (a & 7)))) a++;
+        }
+        if (a < fila[u + 1]) {
+            cursor[u] = a + 1;
+            if (!dirigido) {
+                long long b = pareja[a];
+                usado[a >> 3] |= (unsigned char)(1u << (a & 7));
+                usado[b >> 3] |= (unsigned char)(1u << (b & 7));
+            }
+            pila[tope++] = vecinos[a];
+        } else {
+            cursor[u] = a;
+            tope--;
+            ok = sumidero->vertice(sumidero->datos, u);
+        }
+    }
+    if (ok && sumidero->fin) {
+        ok = sumidero->fin(sumidero->datos);
+    }
+
+    free(inicio_t);
+    free(origenes_t);
+    free(pareja);
+    free(usado);
+    free(cursor);
+    free(pila);
+    return ok;
+}
+
+// --------------------------------------------------------------------------
+// Salida a archivo
+
+static void volcar_salida(SalidaRecorrido *s) {
+    if (s->buffer.error) {
+        s->ok = false;
+    } else if (s->buffer.longitud > 0 &&
+               fwrite(s->buffer.datos, 1, s->buffer.longitud, s->archivo) != s->buffer.longitud) {
+        s->ok = false;
+    }
+    buffer_vaciar(&s->buffer);
+}
+
+// Entero sin signo en base 128, 7 bits por byte (LEB128)
+static void agregar_varint(BufferTexto *b, uint64_t valor) {
+    while (valor >= 0x80) {
+        buffer_agregar_caracter(b, (char)(valor | 0x80));
+        valor >>= 7;
+    }
+    buffer_agregar_caracter(b, (char)valor);
+}
+
+static uint64_t zigzag(long long valor) {
+    return ((uint64_t)valor << 1) ^ (uint64_t)(valor >> 63);
+}
+
+static long long deshacer_zigzag(uint64_t valor) {
+    return (long long)(valor >> 1) ^ -(long long)(valor & 1);
+}
+
+// Cada diferencia se escribe como zigzag(d) << 1; si el bit bajo es 1, sigue la
+// cantidad de repeticiones extra de la misma diferencia
+static void escribir_diferencia_pendiente(SalidaRecorrido *s) {
+    if (s->repeticiones == 0) return;
+    uint64_t token = zigzag(s->diferencia) << 1;
+    if (s->repeticiones == 1) {
+        agregar_varint(&s->buffer, token);
+    } else {
+        agregar_varint(&s->buffer, token | 1);
+        agregar_varint(&s->buffer, (uint64_t)(s->repeticiones - 1));
+    }
+    s->repeticiones = 0;
+}
+
+static bool salida_inicio(void *datos, long long num_vertices) {
+    SalidaRecorrido *s = (SalidaRecorrido *)datos;
+    if (s->codificacion == RECORRIDO_BINARIO) {
+        buffer_agregar_n(&s->buffer, MAGIA_RECORRIDO, sizeof(MAGIA_RECORRIDO));
+        agregar_varint(&s->buffer, (uint64_t)num_vertices);
+    }
+    return !s->buffer.error;
+}
+
+static bool salida_vertice(void *datos, int v) {
+    SalidaRecorrido *s = (SalidaRecorrido *)datos;
+    if (s->codificacion == RECORRIDO_TEXTO) {
+        buffer_agregar_entero(&s->buffer, v);
+        buffer_agregar_caracter(&s->buffer, '\n');
+    } else {
+        long long diferencia = v - s->anterior;
+        s->anterior = v;
+        if (s->repeticiones > 0 && diferencia == s->diferencia) {
+            s->repeticiones++;
+        } else {
+            escribir_diferencia_pendiente(s);
+            s->diferencia = diferencia;
+            s->repeticiones = 1;
+        }
+    }
+    if (s->buffer.longitud >= TAM_BLOQUE_ESCRITURA) {
+        volcar_salida(s);
+    }
+    return s->ok;
+}
+
+static bool salida_fin(void *datos) {
+    SalidaRecorrido *s = (SalidaRecorrido *)datos;
+    escribir_diferencia_pendiente(s);
+    volcar_salida(s);
+    buffer_liberar(&s->buffer);
+    if (fflush(s->archivo) != 0) s->ok = false;
+    return s->ok;
+}
+
+void sumidero_archivo(SumideroRecorrido *sumidero, SalidaRecorrido *salida, FILE *archivo,
+                      CodificacionRecorrido codificacion) {
+    salida->archivo = archivo;
+    salida->codificacion = codificacion;
+    buffer_iniciar(&salida->buffer);
+    salida->anterior = 0;
+    salida->diferencia = 0;
+    salida->repeticiones = 0;
+    salida->ok = true;
+
+    sumidero->inicio = salida_inicio;
+    sumidero->vertice = salida_vertice;
+    sumidero->fin = salida_fin;
+    sumidero->datos = salida;
+}
+
+static bool leer_varint(FILE *archivo, uint64_t *valor) {
+    *valor = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+        int c = getc(archivo);
+        if (c == EOF) return false;
+        *valor |= (uint64_t)(c & 0x7F) << desplazamiento;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+bool leer_recorrido_binario(FILE *archivo, const SumideroRecorrido *sumidero) {
+    char magia[sizeof(MAGIA_RECORRIDO)];
+    uint64_t total;
+    if (fread(magia, 1, sizeof(magia), archivo) != sizeof(magia) ||
+        memcmp(magia, MAGIA_RECORRIDO, sizeof(magia)) != 0 || !leer_varint(archivo, &total) ||
+        total > (uint64_t)LLONG_MAX) {
+        return false;
+    }
+    if (sumidero->inicio && !sumidero->inicio(sumidero->datos, (long long)total)) return false;
+
+    long long vertice = 0;
+    uint64_t leidos = 0;
+    while (leidos < total) {
+        uint64_t token, repeticiones = 0;
+        if (!leer_varint(archivo, &token)) return false;
+        if ((token & 1) && !leer_varint(archivo, &repeticiones)) return false;
+        long long diferencia = deshacer_zigzag(token >> 1);
+        for (uint64_t i = 0; i <= repeticiones; i++) {
+            vertice += diferencia;
+            if (vertice < 0 || vertice > INT_MAX || leidos == total) return false;
+            if (!sumidero->vertice(sumidero->datos, (int)vertice)) return false;
+            leidos++;
+        }
+    }
+    return !sumidero->fin || sumidero->fin(sumidero->datos);
+}
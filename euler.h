@@ -0,0 +1,66 @@
+#ifndef EULER_H
+#define EULER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "buffer_texto.h"
+#include "grafo_csr.h"
+
+// Hierholzer sobre el CSR para grafos de cualquier tamaño. En lugar de llenar un
+// arreglo y darlo vuelta, los vértices se entregan a un sumidero en el orden en
+// que salen de la pila: en grafos no dirigidos eso ya es un recorrido válido (el
+// mismo, en sentido inverso) y en dirigidos se recorre el grafo transpuesto,
+// cuyo orden de salida es el recorrido en el sentido de los arcos. Así nunca se
+// guarda la secuencia completa.
+
+typedef enum {
+    EULER_NINGUNO,      // Ni ciclo ni ruta euleriana (o el grafo no tiene aristas)
+    EULER_RUTA,
+    EULER_CICLO
+} ClaseEuleriana;
+
+// Destino de los vértices del recorrido. Cualquier función puede devolver false
+// para cortar el recorrido (por ejemplo, si falló una escritura).
+typedef struct {
+    // Se llama antes del primer vértice con la cantidad total de vértices
+    bool (*inicio)(void *datos, long long num_vertices);
+    bool (*vertice)(void *datos, int v);
+    bool (*fin)(void *datos);
+    void *datos;
+} SumideroRecorrido;
+
+// Indica si hay ciclo o ruta euleriana (grados y conexidad de los nodos con
+// aristas). En 'inicio' deja el vértice donde empieza el recorrido que se emitiría.
+ClaseEuleriana clasificar_euleriano_csr(const GrafoCSR *grafo, int *inicio);
+
+// Emite el ciclo euleriano o, si no hay, la ruta euleriana. Devuelve false si no
+// existe ninguno (clase queda en EULER_NINGUNO), si falta memoria, si el
+// sumidero cortó el recorrido o si el grafo no dirigido no es simétrico (con la
+// explicación en 'motivo', que si no queda en NULL). 'clase' y 'motivo' pueden
+// ser NULL.
+bool recorrido_euleriano_csr(const GrafoCSR *grafo, const SumideroRecorrido *sumidero,
+                             ClaseEuleriana *clase, const char **motivo);
+
+// Sumideros a archivo (también sirven para tuberías: nunca se hace seek)
+typedef enum {
+    RECORRIDO_TEXTO,    // Un vértice por línea
+    RECORRIDO_BINARIO   // Diferencias entre vértices consecutivos con repeticiones comprimidas
+} CodificacionRecorrido;
+
+typedef struct {
+    FILE *archivo;
+    CodificacionRecorrido codificacion;
+    BufferTexto buffer;
+    long long anterior;
+    long long diferencia;   // Diferencia pendiente de escribir
+    long long repeticiones; // Veces seguidas que se repitió (0: nada pendiente)
+    bool ok;
+} SalidaRecorrido;
+
+void sumidero_archivo(SumideroRecorrido *sumidero, SalidaRecorrido *salida, FILE *archivo,
+                      CodificacionRecorrido codificacion);
+
+// Lee un recorrido en formato binario y lo entrega al sumidero
+bool leer_recorrido_binario(FILE *archivo, const SumideroRecorrido *sumidero);
+
+#endif
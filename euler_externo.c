@@ -0,0 +1,803 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "euler_externo.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define MEMORIA_POR_DEFECTO ((size_t)256 << 20)
+#define MEMORIA_MINIMA ((size_t)4 << 20)
+// Los arcos se leen al azar (un bloque chico desperdicia menos por fallo); los
+// segmentos, casi en orden
+#define TAM_BLOQUE_ARCOS 4096
+#define TAM_BLOQUE_SEGMENTOS (64 * 1024)
+#define TAM_BUFFER_ARCHIVO (1 << 20)
+
+// Arco en disco. En no dirigidos cada arista aparece en la lista de sus dos
+// extremos con el mismo número, que indexa el mapa de bits de usadas; en las
+// corridas también van, con arista ESPEJO, los u -> v con u > v que el cargador
+// entrega como copia de v -> u, para comprobar al fusionar que la matriz es
+// simétrica.
+#define ESPEJO -1
+
+typedef struct {
+    int origen;
+    int destino;
+    long long arista;
+} RegistroArco;
+
+// --------------------------------------------------------------------------
+// Archivos temporales
+
+// Se borra del directorio apenas se crea: desaparece al cerrarlo aunque el
+// programa termine mal
+static FILE *crear_temporal(const char *directorio) {
+    if (!directorio) directorio = getenv("TMPDIR");
+    if (!directorio || !*directorio) directorio = "/tmp";
+
+    char ruta[4096];
+    if (snprintf(ruta, sizeof(ruta), "%s/proyecto-4aa-XXXXXX", directorio) >= (int)sizeof(ruta)) {
+        return NULL;
+    }
+    int fd = mkstemp(ruta);
+    if (fd < 0) return NULL;
+    unlink(ruta);
+    FILE *archivo = fdopen(fd, "w+b");
+    if (!archivo) close(fd);
+    return archivo;
+}
+
+// Caché de bloques de correspondencia directa sobre un archivo de registros de
+// tamaño fijo; se lee con pread, sin mover la posición del FILE
+typedef struct {
+    int fd;
+    size_t tam_registro;
+    size_t tam_bloque;
+    size_t por_bloque;
+    size_t num_bloques;
+    unsigned char *datos;
+    long long *etiqueta;
+    bool error;
+} CacheBloques;
+
+static bool iniciar_cache(CacheBloques *cache, FILE *archivo, size_t tam_registro,
+                          size_t tam_bloque, size_t memoria) {
+    cache->fd = fileno(archivo);
+    cache->tam_registro = tam_registro;
+    cache->tam_bloque = tam_bloque;
+    cache->por_bloque = tam_bloque / tam_registro;
+    cache->num_bloques = memoria / tam_bloque;
+    if (cache->num_bloques == 0) cache->num_bloques = 1;
+    cache->datos = malloc(cache->num_bloques * tam_bloque);
+    cache->etiqueta = malloc(cache->num_bloques * sizeof(long long));
+    cache->error = false;
+    if (!cache->datos || !cache->etiqueta) return false;
+    for (size_t i = 0; i < cache->num_bloques; i++) {
+        cache->etiqueta[i] = -1;
+    }
+    return true;
+}
+
+static void liberar_cache(CacheBloques *cache) {
+    free(cache->datos);
+    free(cache->etiqueta);
+    cache->datos = NULL;
+    cache->etiqueta = NULL;
+}
+
+static const void *leer_registro(CacheBloques *cache, long long indice) {
+    long long bloque = indice / (long long)cache->por_bloque;
+    size_t ranura = (size_t)(bloque % (long long)cache->num_bloques);
+    unsigned char *datos = cache->datos + ranura * cache->tam_bloque;
+
+    if (cache->etiqueta[ranura] != bloque) {
+        size_t tam = cache->por_bloque * cache->tam_registro;
+        off_t desplazamiento = (off_t)bloque * (off_t)tam;
+        size_t leidos = 0;
+        // El último bloque del archivo puede venir incompleto
+        while (leidos < tam) {
+            ssize_t r = pread(cache->fd, datos + leidos, tam - leidos, desplazamiento + (off_t)leidos);
+            if (r <= 0) break;
+            leidos += (size_t)r;
+        }
+        size_t necesarios = (size_t)(indice % (long long)cache->por_bloque + 1) * cache->tam_registro;
+        if (leidos < necesarios) {
+            cache->error = true;
+            cache->etiqueta[ranura] = -1;
+            memset(datos, 0, cache->tam_registro);
+            return datos;
+        }
+        cache->etiqueta[ranura] = bloque;
+    }
+    return datos + (size_t)(indice % (long long)cache->por_bloque) * cache->tam_registro;
+}
+
+// --------------------------------------------------------------------------
+// Fase 1: arcos ordenados por origen en disco
+
+typedef struct {
+    const ConfiguracionExterna *config;
+    size_t memoria;
+    int num_nodos;
+    TipoGrafo tipo;
+
+    // Por vértice
+    long long *salida;          // Arcos que salen; luego desplazamientos (num_nodos + 1)
+    long long *balance;         // Dirigidos: salida - entrada; no dirigidos: grado
+    int *padre;                 // Conjuntos disjuntos para la conexidad
+
+    // Corrida en memoria y corridas ya ordenadas en disco
+    RegistroArco *corrida;
+    RegistroArco *auxiliar;
+    size_t capacidad;
+    size_t longitud;
+    FILE **corridas;
+    int num_corridas;
+    int capacidad_corridas;
+
+    long long num_aristas;
+    long long sobrantes;        // No dirigidos: espejos menos aristas guardadas (u != v);
+                                // descarta pronto los totales distintos
+    bool fallo;
+    const char *motivo;
+} Particion;
+
+static int raiz(int *padre, int x) {
+    while (padre[x] != x) {
+        padre[x] = padre[padre[x]];
+        x = padre[x];
+    }
+    return x;
+}
+
+static void fallar(Particion *p, const char *motivo) {
+    if (!p->fallo) {
+        p->fallo = true;
+        p->motivo = motivo;
+    }
+}
+
+static unsigned byte_clave(const RegistroArco *r, bool por_destino, int desplazamiento) {
+    return ((unsigned)(por_destino ? r->destino : r->origen) >> desplazamiento) & 0xFF;
+}
+
+// Radix LSD por bytes del origen (en no dirigidos, por origen y destino, para
+// que cada arco quede junto a su espejo); solo las pasadas que hacen falta según K
+static void ordenar_corrida(Particion *p) {
+    size_t n = p->longitud;
+    RegistroArco *origen = p->corrida;
+    RegistroArco *destino = p->auxiliar;
+    bool en_auxiliar = false;
+
+    for (int campo = p->tipo == DIRIGIDO; campo < 2; campo++) {
+        bool por_destino = campo == 0;
+        for (int desplazamiento = 0; desplazamiento < 32 &&
+             ((unsigned)(p->num_nodos - 1) >> desplazamiento) != 0; desplazamiento += 8) {
+            size_t conteo[257] = {0};
+            for (size_t i = 0; i < n; i++) {
+                conteo[byte_clave(&origen[i], por_destino, desplazamiento) + 1]++;
+            }
+            for (int b = 0; b < 256; b++) conteo[b + 1] += conteo[b];
+            for (size_t i = 0; i < n; i++) {
+                destino[conteo[byte_clave(&origen[i], por_destino, desplazamiento)]++] = origen[i];
+            }
+            RegistroArco *t = origen;
+            origen = destino;
+            destino = t;
+            en_auxiliar = !en_auxiliar;
+        }
+    }
+    if (en_auxiliar) {
+        memcpy(p->corrida, p->auxiliar, n * sizeof(RegistroArco));
+    }
+}
+
+static void volcar_corrida(Particion *p) {
+    if (p->fallo || p->longitud == 0) return;
+    ordenar_corrida(p);
+
+    if (p->num_corridas == p->capacidad_corridas) {
+        int nueva = p->capacidad_corridas > 0 ? p->capacidad_corridas * 2 : 8;
+        FILE **corridas = realloc(p->corridas, (size_t)nueva * sizeof(FILE *));
+        if (!corridas) {
+            fallar(p, "Memoria insuficiente");
+            return;
+        }
+        p->corridas = corridas;
+        p->capacidad_corridas = nueva;
+    }
+    FILE *archivo = crear_temporal(p->config->directorio);
+    if (!archivo) {
+        fallar(p, "No se pudo crear un archivo temporal");
+        return;
+    }
+    p->corridas[p->num_corridas++] = archivo;
+    if (fwrite(p->corrida, sizeof(RegistroArco), p->longitud, archivo) != p->longitud ||
+        fflush(archivo) != 0) {
+        fallar(p, "Error al escribir un archivo temporal");
+    }
+    p->longitud = 0;
+}
+
+static void agregar_arco(Particion *p, int u, int v, long long arista) {
+    if (p->longitud == p->capacidad) {
+        volcar_corrida(p);
+        if (p->fallo) return;
+    }
+    RegistroArco *r = &p->corrida[p->longitud++];
+    r->origen = u;
+    r->destino = v;
+    r->arista = arista;
+    if (arista != ESPEJO) p->salida[u]++;
+}
+
+static bool particion_encabezado(void *datos, int K, TipoGrafo tipo, ErrorCarga *error) {
+    Particion *p = (Particion *)datos;
+    if (K < 1 || K == INT_MAX) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "Número de nodos inválido");
+        return false;
+    }
+    p->num_nodos = K;
+    p->tipo = tipo;
+    p->salida = calloc((size_t)K + 1, sizeof(long long));
+    p->balance = calloc((size_t)K, sizeof(long long));
+    p->padre = malloc((size_t)K * sizeof(int));
+    // La mitad para la corrida y la otra mitad para la pasada del radix
+    p->capacidad = p->memoria / 2 / sizeof(RegistroArco);
+    p->corrida = malloc(p->capacidad * sizeof(RegistroArco));
+    p->auxiliar = malloc(p->capacidad * sizeof(RegistroArco));
+    if (!p->salida || !p->balance || !p->padre || !p->corrida || !p->auxiliar) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "Memoria insuficiente");
+        return false;
+    }
+    for (int u = 0; u < K; u++) {
+        p->padre[u] = u;
+    }
+    return true;
+}
+
+static void particion_arista(void *datos, int u, int v, int peso) {
+    Particion *p = (Particion *)datos;
+    if (p->fallo) return;
+
+    if (p->tipo == DIRIGIDO) {
+        for (int k = 0; k < peso; k++) {
+            agregar_arco(p, u, v, 0);
+        }
+        p->num_aristas += peso;
+        p->balance[u] += peso;
+        p->balance[v] -= peso;
+    } else {
+        // Cada arista llega en ambos sentidos (los lazos, una vez): se guarda al
+        // recibir u -> v con u <= v, con un número propio en las dos listas. El
+        // v -> u de u > v solo se anota como espejo.
+        if (u > v) {
+            p->sobrantes += peso;
+            for (int k = 0; k < peso; k++) {
+                agregar_arco(p, u, v, ESPEJO);
+            }
+            return;
+        }
+        if (u != v) p->sobrantes -= peso;
+        for (int k = 0; k < peso; k++) {
+            long long arista = p->num_aristas++;
+            agregar_arco(p, u, v, arista);
+            if (u != v) agregar_arco(p, v, u, arista);
+        }
+        p->balance[u] += peso;
+        p->balance[v] += peso;
+    }
+
+    int ru = raiz(p->padre, u);
+    int rv = raiz(p->padre, v);
+    if (ru != rv) p->padre[ru] = rv;
+}
+
+// Fusión de k corridas con un montículo por origen. Cada corrida se lee por
+// trozos con pread y la salida se junta en un buffer propio.
+typedef struct {
+    int fd;
+    off_t posicion;
+    RegistroArco *buffer;
+    size_t cantidad;
+    size_t siguiente;
+} LectorCorrida;
+
+typedef struct {
+    RegistroArco actual;
+    int corrida;
+} CabezaCorrida;
+
+static bool leer_corrida(LectorCorrida *lector, RegistroArco *registro, size_t capacidad, bool *error) {
+    if (lector->siguiente == lector->cantidad) {
+        ssize_t r = pread(lector->fd, lector->buffer, capacidad * sizeof(RegistroArco), lector->posicion);
+        if (r < 0) *error = true;
+        if (r <= 0) return false;
+        lector->posicion += r;
+        lector->cantidad = (size_t)r / sizeof(RegistroArco);
+        lector->siguiente = 0;
+        if (lector->cantidad == 0) {
+            *error = true;
+            return false;
+        }
+    }
+    *registro = lector->buffer[lector->siguiente++];
+    return true;
+}
+
+static bool cabeza_menor(const CabezaCorrida *a, const CabezaCorrida *b) {
+    if (a->actual.origen != b->actual.origen) return a->actual.origen < b->actual.origen;
+    if (a->actual.destino != b->actual.destino) return a->actual.destino < b->actual.destino;
+    return a->corrida < b->corrida;
+}
+
+static void hundir(CabezaCorrida *monticulo, int n, int i) {
+    for (;;) {
+        int menor = i;
+        int izquierdo = 2 * i + 1;
+        int derecho = izquierdo + 1;
+        if (izquierdo < n && cabeza_menor(&monticulo[izquierdo], &monticulo[menor])) menor = izquierdo;
+        if (derecho < n && cabeza_menor(&monticulo[derecho], &monticulo[menor])) menor = derecho;
+        if (menor == i) return;
+        CabezaCorrida t = monticulo[i];
+        monticulo[i] = monticulo[menor];
+        monticulo[menor] = t;
+        i = menor;
+    }
+}
+
+// En no dirigidos la salida llega ordenada por (origen, destino), así que cada
+// par u -> v con u > v aparece seguido: las copias guardadas y los espejos deben
+// ser tantos como los otros. Los espejos no pasan al archivo de arcos.
+static FILE *fusionar_corridas(Particion *p) {
+    int k = p->num_corridas;
+    bool dirigido = p->tipo == DIRIGIDO;
+    if (k == 1 && dirigido) {
+        p->num_corridas = 0;
+        return p->corridas[0];
+    }
+
+    FILE *salida = crear_temporal(p->config->directorio);
+    if (!salida) {
+        fallar(p, "No se pudo crear un archivo temporal");
+        return NULL;
+    }
+    // Un trozo por corrida y uno más para la salida
+    size_t capacidad = p->memoria / ((size_t)k + 1) / sizeof(RegistroArco);
+    if (capacidad < 256) capacidad = 256;
+    LectorCorrida *lectores = calloc((size_t)k, sizeof(LectorCorrida));
+    CabezaCorrida *monticulo = malloc((size_t)k * sizeof(CabezaCorrida));
+    RegistroArco *escritura = malloc(capacidad * sizeof(RegistroArco));
+    bool ok = lectores && monticulo && escritura;
+    bool error = false;
+
+    int n = 0;
+    for (int i = 0; i < k && ok; i++) {
+        lectores[i].fd = fileno(p->corridas[i]);
+        lectores[i].buffer = malloc(capacidad * sizeof(RegistroArco));
+        ok = lectores[i].buffer != NULL;
+        if (ok && leer_corrida(&lectores[i], &monticulo[n].actual, capacidad, &error)) {
+            monticulo[n++].corrida = i;
+        }
+    }
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        hundir(monticulo, n, i);
+    }
+    size_t pendientes = 0;
+    RegistroArco par = {-1, -1, 0};
+    long long diferencia = 0;   // Copias guardadas menos espejos del par actual
+    bool simetrica = true;
+    while (ok && n > 0) {
+        const RegistroArco *r = &monticulo[0].actual;
+        if (!dirigido && r->origen > r->destino) {
+            if (r->origen != par.origen || r->destino != par.destino) {
+                simetrica = simetrica && diferencia == 0;
+                diferencia = 0;
+                par = *r;
+            }
+            diferencia += r->arista == ESPEJO ? -1 : 1;
+        }
+        if (r->arista != ESPEJO) escritura[pendientes++] = *r;
+        if (pendientes == capacidad) {
+            ok = fwrite(escritura, sizeof(RegistroArco), pendientes, salida) == pendientes;
+            pendientes = 0;
+        }
+        int i = monticulo[0].corrida;
+        if (!leer_corrida(&lectores[i], &monticulo[0].actual, capacidad, &error)) {
+            monticulo[0] = monticulo[--n];
+        }
+        hundir(monticulo, n, 0);
+    }
+    if (ok && pendientes > 0) {
+        ok = fwrite(escritura, sizeof(RegistroArco), pendientes, salida) == pendientes;
+    }
+    ok = ok && !error && fflush(salida) == 0;
+    simetrica = simetrica && diferencia == 0;
+
+    for (int i = 0; i < k; i++) {
+        if (lectores) free(lectores[i].buffer);
+        fclose(p->corridas[i]);
+    }
+    p->num_corridas = 0;
+    free(lectores);
+    free(monticulo);
+    free(escritura);
+    if (!ok || !simetrica) {
+        fclose(salida);
+        fallar(p, ok ? "La matriz de un grafo no dirigido no es simétrica"
+                     : "Error al fusionar los archivos temporales");
+        return NULL;
+    }
+    return salida;
+}
+
+static void liberar_particion(Particion *p) {
+    free(p->salida);
+    free(p->balance);
+    free(p->padre);
+    free(p->corrida);
+    free(p->auxiliar);
+    for (int i = 0; i < p->num_corridas; i++) {
+        fclose(p->corridas[i]);
+    }
+    free(p->corridas);
+}
+
+// Mismas reglas que clasificar_euleriano_csr, con los grados ya calculados
+static ClaseEuleriana clasificar_particion(Particion *p, int *inicio) {
+    int n = p->num_nodos;
+    bool dirigido = p->tipo == DIRIGIDO;
+    if (p->num_aristas == 0) return EULER_NINGUNO;
+
+    int extremos[2] = {-1, -1};
+    int num_impares = 0;
+    int con_aristas = -1;
+    int componente = -1;
+    bool valido = true;
+    for (int u = 0; u < n && valido; u++) {
+        long long grado = p->balance[u];
+        if (con_aristas < 0 && p->salida[u] > 0) con_aristas = u;
+        if (dirigido) {
+            if (grado == 1 && extremos[0] < 0) extremos[0] = u;
+            else if (grado == -1 && extremos[1] < 0) extremos[1] = u;
+            else if (grado != 0) valido = false;
+        } else if (grado % 2 != 0) {
+            if (num_impares < 2) extremos[num_impares] = u;
+            valido = ++num_impares <= 2;
+        }
+        // Con arcos: en dirigidos basta con que entre o salga alguno
+        bool tiene = p->salida[u] > 0 || (dirigido && p->salida[u] != grado);
+        if (valido && tiene) {
+            int r = raiz(p->padre, u);
+            if (componente < 0) componente = r;
+            valido = r == componente;
+        }
+    }
+    if (!valido) return EULER_NINGUNO;
+    if (dirigido && (extremos[0] >= 0) != (extremos[1] >= 0)) return EULER_NINGUNO;
+
+    bool ruta = dirigido ? extremos[0] >= 0 : num_impares == 2;
+    *inicio = ruta ? extremos[0] : con_aristas;
+    return ruta ? EULER_RUTA : EULER_CICLO;
+}
+
+// --------------------------------------------------------------------------
+// Fase 2: subcircuitos enlazados en disco
+
+typedef struct {
+    long long inicio;       // Posición del primer vértice en el archivo de segmentos
+    long long longitud;     // Aristas del segmento (tiene longitud + 1 vértices)
+    long long posicion;     // Posición en el padre donde se inserta
+    int padre;              // -1 en el segmento raíz
+} Segmento;
+
+typedef struct {
+    int num_nodos;
+    bool dirigido;
+    const long long *fin;       // Fin de la lista de cada vértice (inicio[u + 1])
+    long long *cursor;
+    CacheBloques arcos;
+    unsigned char *usado;       // Mapa de bits de aristas (no dirigidos)
+    size_t tam_usado;
+
+    FILE *segmentos;
+    long long escritos;
+    Segmento *lista;
+    int num_segmentos;
+    int capacidad_segmentos;
+
+    int *primer_segmento;       // Primera aparición de cada vértice, o -1
+    long long *primera_posicion;
+    int *pendientes;
+    int num_pendientes;
+    bool ok;
+} Recorrido;
+
+static int siguiente_vecino(Recorrido *r, int u) {
+    while (r->cursor[u] < r->fin[u]) {
+        const RegistroArco *arco = leer_registro(&r->arcos, r->cursor[u]++);
+        if (r->dirigido) return arco->destino;
+        long long a = arco->arista;
+        unsigned char bit = (unsigned char)(1u << (a & 7));
+        if (!(r->usado[a >> 3] & bit)) {
+            r->usado[a >> 3] |= bit;
+            return arco->destino;
+        }
+    }
+    return -1;
+}
+
+static void escribir_vertice(Recorrido *r, int v) {
+    if (fwrite(&v, sizeof(v), 1, r->segmentos) != 1) r->ok = false;
+    r->escritos++;
+}
+
+// Avanza desde x hasta trabarse y guarda el subcircuito como un segmento hijo
+// de (padre, posicion). Cada vértice nuevo queda pendiente: si le sobran arcos,
+// de él sale otro subcircuito.
+static void recorrer_subcircuito(Recorrido *r, int x, int padre, long long posicion) {
+    int v = siguiente_vecino(r, x);
+    if (v < 0) return;
+
+    if (r->num_segmentos == r->capacidad_segmentos) {
+        int nueva = r->capacidad_segmentos > 0 ? r->capacidad_segmentos * 2 : 1024;
+        Segmento *lista = realloc(r->lista, (size_t)nueva * sizeof(Segmento));
+        if (!lista) {
+            r->ok = false;
+            return;
+        }
+        r->lista = lista;
+        r->capacidad_segmentos = nueva;
+    }
+    int s = r->num_segmentos++;
+    Segmento *segmento = &r->lista[s];
+    segmento->inicio = r->escritos;
+    segmento->padre = padre;
+    segmento->posicion = posicion;
+
+    escribir_vertice(r, x);
+    long long i = 0;
+    while (v >= 0 && r->ok) {
+        escribir_vertice(r, v);
+        i++;
+        if (r->primer_segmento[v] < 0) {
+            r->primer_segmento[v] = s;
+            r->primera_posicion[v] = i;
+            r->pendientes[r->num_pendientes++] = v;
+        }
+        v = siguiente_vecino(r, v);
+    }
+    segmento->longitud = i;
+    if (r->arcos.error) r->ok = false;
+}
+
+static bool recorrer_subcircuitos(Recorrido *r, int inicio) {
+    r->primer_segmento[inicio] = 0;
+    r->primera_posicion[inicio] = 0;
+    r->pendientes[r->num_pendientes++] = inicio;
+    recorrer_subcircuito(r, inicio, -1, 0);
+
+    while (r->ok && r->num_pendientes > 0) {
+        int x = r->pendientes[--r->num_pendientes];
+        recorrer_subcircuito(r, x, r->primer_segmento[x], r->primera_posicion[x]);
+    }
+    return r->ok && fflush(r->segmentos) == 0;
+}
+
+// --------------------------------------------------------------------------
+// Fase 3: emisión siguiendo los enlaces
+
+typedef struct {
+    long long posicion;
+    int padre;
+    int segmento;
+} Hijo;
+
+static int comparar_hijos(const void *a, const void *b) {
+    const Hijo *x = (const Hijo *)a;
+    const Hijo *y = (const Hijo *)b;
+    if (x->padre != y->padre) return x->padre < y->padre ? -1 : 1;
+    if (x->posicion != y->posicion) return x->posicion < y->posicion ? -1 : 1;
+    return x->segmento < y->segmento ? -1 : (x->segmento > y->segmento);
+}
+
+typedef struct {
+    int segmento;
+    int hijo;           // Próximo hijo en el arreglo ordenado
+    long long i;        // Próximo vértice del segmento
+} Marco;
+
+// Un hijo en la posición p se emite después del vértice p del padre; su primer
+// vértice es ese mismo, así que el hijo empieza desde el segundo
+static bool emitir_segmentos(Recorrido *r, size_t memoria, long long num_aristas,
+                             const SumideroRecorrido *sumidero) {
+    int num = r->num_segmentos;
+    Hijo *hijos = malloc((size_t)num * sizeof(Hijo));
+    int *primer_hijo = calloc((size_t)num + 1, sizeof(int));
+    Marco *pila = malloc((size_t)num * sizeof(Marco));
+    CacheBloques cache = {0};
+    bool ok = hijos && primer_hijo && pila &&
+              iniciar_cache(&cache, r->segmentos, sizeof(int), TAM_BLOQUE_SEGMENTOS, memoria);
+
+    int num_hijos = 0;
+    if (ok) {
+        for (int s = 1; s < num; s++) {
+            hijos[num_hijos].padre = r->lista[s].padre;
+            hijos[num_hijos].posicion = r->lista[s].posicion;
+            hijos[num_hijos].segmento = s;
+            primer_hijo[r->lista[s].padre + 1]++;
+            num_hijos++;
+        }
+        qsort(hijos, (size_t)num_hijos, sizeof(Hijo), comparar_hijos);
+        for (int s = 0; s < num; s++) {
+            primer_hijo[s + 1] += primer_hijo[s];
+        }
+        ok = !sumidero->inicio || sumidero->inicio(sumidero->datos, num_aristas + 1);
+    }
+
+    int tope = 0;
+    if (ok) {
+        pila[0].segmento = 0;
+        pila[0].hijo = primer_hijo[0];
+        pila[0].i = 0;
+    }
+    while (ok && tope >= 0) {
+        Marco *m = &pila[tope];
+        const Segmento *segmento = &r->lista[m->segmento];
+        if (m->hijo < primer_hijo[m->segmento + 1] && hijos[m->hijo].posicion < m->i) {
+            int s = hijos[m->hijo++].segmento;
+            tope++;
+            pila[tope].segmento = s;
+            pila[tope].hijo = primer_hijo[s];
+            pila[tope].i = 1;
+        } else if (m->i <= segmento->longitud) {
+            int v = *(const int *)leer_registro(&cache, segmento->inicio + m->i);
+            m->i++;
+            ok = !cache.error && sumidero->vertice(sumidero->datos, v);
+        } else {
+            tope--;
+        }
+    }
+    if (ok && sumidero->fin) {
+        ok = sumidero->fin(sumidero->datos);
+    }
+
+    liberar_cache(&cache);
+    free(hijos);
+    free(primer_hijo);
+    free(pila);
+    return ok;
+}
+
+// --------------------------------------------------------------------------
+
+static bool mapear_usadas(Recorrido *r, const char *directorio, long long num_aristas) {
+    r->tam_usado = (size_t)(num_aristas / 8 + 1);
+    FILE *archivo = crear_temporal(directorio);
+    if (!archivo) return false;
+    bool ok = ftruncate(fileno(archivo), (off_t)r->tam_usado) == 0;
+    if (ok) {
+        void *mapeo = mmap(NULL, r->tam_usado, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(archivo), 0);
+        ok = mapeo != MAP_FAILED;
+        r->usado = ok ? mapeo : NULL;
+    }
+    // La proyección sigue válida después de cerrar el archivo
+    fclose(archivo);
+    return ok;
+}
+
+static void error_sin_posicion(ErrorCarga *error, const char *mensaje) {
+    error->linea = 0;
+    error->columna = 0;
+    snprintf(error->mensaje, sizeof(error->mensaje), "%s", mensaje);
+}
+
+bool recorrido_euleriano_externo(const char *ruta, const ConfiguracionExterna *config,
+                                 const SumideroRecorrido *sumidero, ClaseEuleriana *clase,
+                                 ErrorCarga *error) {
+    memset(error, 0, sizeof(*error));
+    if (clase) *clase = EULER_NINGUNO;
+
+    Particion p = {0};
+    p.config = config;
+    p.memoria = config->memoria > 0 ? config->memoria : MEMORIA_POR_DEFECTO;
+    if (p.memoria < MEMORIA_MINIMA) p.memoria = MEMORIA_MINIMA;
+
+    ReceptorGrafo receptor = {particion_encabezado, particion_arista, NULL, &p};
+    if (!cargar_grafo(ruta, &receptor, error)) {
+        liberar_particion(&p);
+        return false;
+    }
+    volcar_corrida(&p);
+    free(p.corrida);
+    free(p.auxiliar);
+    p.corrida = p.auxiliar = NULL;
+    if (!p.fallo && p.sobrantes != 0) {
+        fallar(&p, "La matriz de un grafo no dirigido no es simétrica");
+    }
+    if (p.fallo) {
+        error_sin_posicion(error, p.motivo);
+        liberar_particion(&p);
+        return false;
+    }
+
+    if (p.num_aristas == 0) {
+        liberar_particion(&p);
+        return false;
+    }
+
+    // La simetría de cada par se comprueba al fusionar, antes de clasificar, para
+    // no dar por euleriano (o no) un grafo que no es el del archivo
+    FILE *arcos = fusionar_corridas(&p);
+    if (!arcos) {
+        error_sin_posicion(error, p.motivo);
+        liberar_particion(&p);
+        return false;
+    }
+
+    int inicio;
+    ClaseEuleriana encontrada = clasificar_particion(&p, &inicio);
+    if (clase) *clase = encontrada;
+    if (encontrada == EULER_NINGUNO) {
+        fclose(arcos);
+        liberar_particion(&p);
+        return false;
+    }
+
+    // Desplazamientos en el lugar de los grados de salida; el balance ya no hace
+    // falta y pasa a ser el cursor, y los conjuntos disjuntos, la pila
+    int n = p.num_nodos;
+    long long acumulado = 0;
+    for (int u = 0; u <= n; u++) {
+        long long grado = u < n ? p.salida[u] : 0;
+        p.salida[u] = acumulado;
+        acumulado += grado;
+    }
+    long long num_aristas = p.num_aristas;
+
+    Recorrido r = {0};
+    r.num_nodos = n;
+    r.dirigido = p.tipo == DIRIGIDO;
+    r.fin = p.salida + 1;
+    r.cursor = p.balance;
+    memcpy(r.cursor, p.salida, (size_t)n * sizeof(long long));
+    r.pendientes = p.padre;
+    r.primer_segmento = malloc((size_t)n * sizeof(int));
+    r.primera_posicion = malloc((size_t)n * sizeof(long long));
+    r.segmentos = crear_temporal(config->directorio);
+    r.ok = r.primer_segmento && r.primera_posicion && r.segmentos &&
+           iniciar_cache(&r.arcos, arcos, sizeof(RegistroArco), TAM_BLOQUE_ARCOS, p.memoria) &&
+           (r.dirigido || mapear_usadas(&r, config->directorio, num_aristas));
+    if (r.ok) {
+        for (int u = 0; u < n; u++) {
+            r.primer_segmento[u] = -1;
+        }
+        r.ok = setvbuf(r.segmentos, NULL, _IOFBF, TAM_BUFFER_ARCHIVO) == 0;
+    }
+
+    bool recorrido = r.ok && recorrer_subcircuitos(&r, inicio);
+    liberar_cache(&r.arcos);
+    fclose(arcos);
+    if (r.usado) munmap(r.usado, r.tam_usado);
+    free(r.primer_segmento);
+    free(r.primera_posicion);
+    liberar_particion(&p);
+
+    // Todas las aristas quedaron en algún segmento (la conexidad ya se verificó)
+    if (recorrido && r.escritos != num_aristas + r.num_segmentos) recorrido = false;
+
+    bool ok = false;
+    if (!recorrido) {
+        error_sin_posicion(error, "Error al recorrer los archivos temporales");
+    } else {
+        ok = emitir_segmentos(&r, p.memoria, num_aristas, sumidero);
+    }
+    if (r.segmentos) fclose(r.segmentos);
+    free(r.lista);
+    return ok;
+}
@@ -0,0 +1,45 @@
+#ifndef EULER_EXTERNO_H
+#define EULER_EXTERNO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cargador.h"
+#include "euler.h"
+
+// Hierholzer semiexterno, para multigrafos cuyas aristas no caben en memoria.
+// En RAM solo hay estado por vértice (desplazamientos, cursores, primera
+// aparición, conjuntos disjuntos) más un presupuesto fijo para ordenar y para
+// una caché de bloques; las aristas van a disco:
+//
+//  1. Los arcos que entrega el cargador (cualquier formato de cargar_grafo) se
+//     ordenan por origen en corridas del tamaño del presupuesto y se fusionan en
+//     un archivo de arcos agrupado por vértice. Grados y conexidad se calculan
+//     mientras llegan. En no dirigidos se ordena por (origen, destino) y las
+//     copias v -> u que entrega el cargador se fusionan junto a sus aristas,
+//     así que una matriz que no es simétrica se rechaza par por par.
+//  2. Se recorren subcircuitos: desde un vértice con arcos libres se avanza por
+//     cursores hasta trabarse. Cada subcircuito se escribe seguido en un archivo
+//     de segmentos y queda enlazado a la primera aparición de su vértice inicial
+//     en un segmento anterior. Los vértices vistos por primera vez se apilan
+//     para arrancar el siguiente subcircuito.
+//  3. Se emite el circuito leyendo los segmentos y entrando en cada hijo en la
+//     posición donde se enlazó.
+//
+// En no dirigidos, las aristas usadas se marcan en un mapa de bits de E bits
+// proyectado desde un archivo temporal. El resultado tiene la misma forma que
+// el de encontrar_ciclo_euleriano_hierholzer: E + 1 vértices, y el primero
+// igual al último si es ciclo.
+typedef struct {
+    size_t memoria;             // Bytes para ordenar y para la caché (0: valor por defecto)
+    const char *directorio;     // Archivos temporales; NULL usa $TMPDIR o /tmp
+} ConfiguracionExterna;
+
+// Lee 'ruta' y entrega su ciclo (o ruta) euleriano al sumidero. Devuelve false
+// si el archivo no se pudo leer o falló un temporal (con el motivo en 'error'),
+// si no hay recorrido (clase EULER_NINGUNO y error->mensaje vacío) o si el
+// sumidero cortó el recorrido. 'clase' puede ser NULL.
+bool recorrido_euleriano_externo(const char *ruta, const ConfiguracionExterna *config,
+                                 const SumideroRecorrido *sumidero, ClaseEuleriana *clase,
+                                 ErrorCarga *error);
+
+#endif
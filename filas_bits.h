@@ -0,0 +1,133 @@
+#ifndef FILAS_BITS_H
+#define FILAS_BITS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "grafo.h"
+
+// Filas de adyacencia empaquetadas: el bit j de una fila indica la arista
+// i -> j. Con MAX_NODOS = 12 cada fila ocupa una palabra (8 bytes en lugar de
+// 48 de la fila de int); las operaciones tienen una versión para ese caso y
+// otra que recorre PALABRAS_FILA palabras. Los vecinos se visitan saltando de
+// un bit al siguiente con ctz, los grados salen de popcount y los conjuntos
+// (visitados, fronteras) se combinan palabra por palabra.
+//
+// Recorrido de los vecinos de u en orden creciente:
+//   for (int v = siguiente_bit_fila(&filas[u], 0); v >= 0; v = siguiente_bit_fila(&filas[u], v + 1))
+
+#define PALABRAS_FILA ((MAX_NODOS + 63) / 64)
+
+typedef struct {
+    uint64_t palabras[PALABRAS_FILA];
+} FilaBits;
+
+// Con MAX_NODOS <= 64 se compilan las versiones de una palabra, sin ciclos
+#if PALABRAS_FILA == 1
+
+static inline void vaciar_fila_bits(FilaBits *f) {
+    f->palabras[0] = 0;
+}
+
+static inline void poner_bit_fila(FilaBits *f, int j) {
+    f->palabras[0] |= (uint64_t)1 << j;
+}
+
+static inline void quitar_bit_fila(FilaBits *f, int j) {
+    f->palabras[0] &= ~((uint64_t)1 << j);
+}
+
+static inline bool bit_fila(const FilaBits *f, int j) {
+    return (f->palabras[0] >> j) & 1;
+}
+
+static inline bool fila_vacia(const FilaBits *f) {
+    return f->palabras[0] == 0;
+}
+
+static inline int contar_bits_fila(const FilaBits *f) {
+    return __builtin_popcountll(f->palabras[0]);
+}
+
+// Primer bit encendido en la posición 'desde' o después; -1 si no hay
+static inline int siguiente_bit_fila(const FilaBits *f, int desde) {
+    if (desde >= 64) return -1;
+    uint64_t palabra = f->palabras[0] & (~(uint64_t)0 << desde);
+    return palabra != 0 ? __builtin_ctzll(palabra) : -1;
+}
+
+// destino |= f
+static inline void unir_filas(FilaBits *destino, const FilaBits *f) {
+    destino->palabras[0] |= f->palabras[0];
+}
+
+// destino &= f
+static inline void intersecar_filas(FilaBits *destino, const FilaBits *f) {
+    destino->palabras[0] &= f->palabras[0];
+}
+
+// destino &= ~f
+static inline void restar_filas(FilaBits *destino, const FilaBits *f) {
+    destino->palabras[0] &= ~f->palabras[0];
+}
+
+#else
+
+static inline void vaciar_fila_bits(FilaBits *f) {
+    memset(f->palabras, 0, sizeof(f->palabras));
+}
+
+static inline void poner_bit_fila(FilaBits *f, int j) {
+    f->palabras[j / 64] |= (uint64_t)1 << (j % 64);
+}
+
+static inline void quitar_bit_fila(FilaBits *f, int j) {
+    f->palabras[j / 64] &= ~((uint64_t)1 << (j % 64));
+}
+
+static inline bool bit_fila(const FilaBits *f, int j) {
+    return (f->palabras[j / 64] >> (j % 64)) & 1;
+}
+
+static inline bool fila_vacia(const FilaBits *f) {
+    uint64_t todo = 0;
+    for (int w = 0; w < PALABRAS_FILA; w++) todo |= f->palabras[w];
+    return todo == 0;
+}
+
+static inline int contar_bits_fila(const FilaBits *f) {
+    int total = 0;
+    for (int w = 0; w < PALABRAS_FILA; w++) total += __builtin_popcountll(f->palabras[w]);
+    return total;
+}
+
+// Primer bit encendido en la posición 'desde' o después; -1 si no hay
+static inline int siguiente_bit_fila(const FilaBits *f, int desde) {
+    int w = desde / 64;
+    if (w >= PALABRAS_FILA) return -1;
+    uint64_t palabra = f->palabras[w] & (~(uint64_t)0 << (desde % 64));
+    while (palabra == 0) {
+        if (++w >= PALABRAS_FILA) return -1;
+        palabra = f->palabras[w];
+    }
+    return w * 64 + __builtin_ctzll(palabra);
+}
+
+// destino |= f
+static inline void unir_filas(FilaBits *destino, const FilaBits *f) {
+    for (int w = 0; w < PALABRAS_FILA; w++) destino->palabras[w] |= f->palabras[w];
+}
+
+// destino &= f
+static inline void intersecar_filas(FilaBits *destino, const FilaBits *f) {
+    for (int w = 0; w < PALABRAS_FILA; w++) destino->palabras[w] &= f->palabras[w];
+}
+
+// destino &= ~f
+static inline void restar_filas(FilaBits *destino, const FilaBits *f) {
+    for (int w = 0; w < PALABRAS_FILA; w++) destino->palabras[w] &= ~f->palabras[w];
+}
+
+#endif
+
+#endif
@@ -0,0 +1,537 @@
+#include "generador.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const double PI = 3.14159265358979323846;
+
+// Reinicios del grafo regular antes de darse por vencido
+#define MAX_REINICIOS_REGULAR 100
+// Intentos fallidos seguidos antes de revisar si quedan pares válidos
+#define MAX_FALLOS_REGULAR 1000
+
+static const char *NOMBRES_FAMILIA[NUM_FAMILIAS] = {
+    "completo", "ciclo", "camino", "estrella", "bipartito",
+    "aleatorio", "euleriano", "rueda", "arbol", "dirigido",
+    "hamiltoniano", "regular"
+};
+
+// Menos nodos no alcanzan para la forma de la familia
+static const int MINIMO_NODOS[NUM_FAMILIAS] = {1, 3, 1, 2, 2, 1, 3, 4, 1, 1, 3, 1};
+
+const char *nombre_familia(FamiliaGrafo familia) {
+    return familia >= 0 && familia < NUM_FAMILIAS ? NOMBRES_FAMILIA[familia] : "?";
+}
+
+bool familia_por_nombre(const char *nombre, FamiliaGrafo *familia) {
+    for (int f = 0; f < NUM_FAMILIAS; f++) {
+        if (strcmp(nombre, NOMBRES_FAMILIA[f]) == 0) {
+            *familia = (FamiliaGrafo)f;
+            return true;
+        }
+    }
+    return false;
+}
+
+double aristas_esperadas(const ParametrosGenerador *parametros) {
+    double n = parametros->num_nodos;
+    double p = parametros->densidad;
+    double pares = n * (n - 1) / 2;
+    switch (parametros->familia) {
+        case FAMILIA_COMPLETO: return pares;
+        case FAMILIA_CICLO: return n;
+        case FAMILIA_CAMINO:
+        case FAMILIA_ESTRELLA:
+        case FAMILIA_ARBOL: return n > 0 ? n - 1 : 0;
+        case FAMILIA_BIPARTITO: return floor(n / 2) * (n - floor(n / 2));
+        case FAMILIA_ALEATORIO: return p * pares;
+        case FAMILIA_EULERIANO:
+        case FAMILIA_HAMILTONIANO: return n + p * (pares - n);
+        case FAMILIA_RUEDA: return 2 * (n - 1);
+        case FAMILIA_DIRIGIDO: return p * 2 * pares;
+        case FAMILIA_REGULAR: return n * parametros->grado / 2;
+        default: return 0;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Números al azar: splitmix64, que con la misma semilla repite la secuencia
+
+typedef struct {
+    uint64_t estado;
+} Azar;
+
+static uint64_t siguiente_azar(Azar *azar) {
+    uint64_t z = (azar->estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniforme en [0, 1)
+static double uniforme(Azar *azar) {
+    return (double)(siguiente_azar(azar) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Uniforme en [0, limite)
+static size_t azar_menor(Azar *azar, size_t limite) {
+    return (size_t)(uniforme(azar) * (double)limite);
+}
+
+// --------------------------------------------------------------------------
+// Muestreo de pares con salto geométrico (Batagelj y Brandes): en lugar de
+// sortear cada par, se sortea cuántos pares se saltan hasta el siguiente
+// elegido, que con probabilidad p sigue una distribución geométrica. Los pares
+// salen en orden: en no dirigidos (u, v) con v < u, fila por fila; en dirigidos
+// las celdas u -> v con u != v.
+
+typedef struct {
+    Azar *azar;
+    int n;
+    bool dirigido;
+    double p;
+    double log_q;           // log(1 - p)
+    double max_salto;       // Más que todos los pares: evita desbordes con p diminuto
+    long long u;
+    long long v;
+} MuestreoPares;
+
+static void iniciar_muestreo(MuestreoPares *m, Azar *azar, int n, bool dirigido, double p) {
+    m->azar = azar;
+    m->n = n;
+    m->dirigido = dirigido;
+    m->p = p;
+    m->log_q = log1p(-p);
+    m->max_salto = (double)n * n;
+    m->u = dirigido ? 0 : 1;
+    m->v = -1;
+}
+
+static long long salto_geometrico(MuestreoPares *m) {
+    if (m->p >= 1) return 0;
+    double salto = floor(log1p(-uniforme(m->azar)) / m->log_q);
+    return salto < m->max_salto ? (long long)salto : (long long)m->max_salto;
+}
+
+// Siguiente par elegido; false cuando se terminan
+static bool siguiente_par(MuestreoPares *m, int *u, int *v) {
+    int n = m->n;
+    if (m->p <= 0 || m->u >= n) return false;
+    m->v += 1 + salto_geometrico(m);
+    if (m->dirigido) {
+        // Filas de n - 1 celdas (sin la diagonal)
+        if (n < 2) return false;
+        m->u += m->v / (n - 1);
+        m->v %= n - 1;
+        if (m->u >= n) return false;
+        *u = (int)m->u;
+        *v = (int)(m->v < m->u ? m->v : m->v + 1);
+        return true;
+    }
+    // La fila u tiene u pares; el salto puede cruzar varias filas
+    while (m->v >= m->u && m->u < n) {
+        m->v -= m->u;
+        m->u++;
+    }
+    if (m->u >= n) return false;
+    *u = (int)m->u;
+    *v = (int)m->v;
+    return true;
+}
+
+// --------------------------------------------------------------------------
+
+typedef struct {
+    const ReceptorGrafo *receptor;
+    TipoGrafo tipo;
+} Emisor;
+
+static void emitir(const Emisor *e, int u, int v) {
+    e->receptor->arista(e->receptor->datos, u, v, 1);
+    if (e->tipo == NO_DIRIGIDO && u != v) {
+        e->receptor->arista(e->receptor->datos, v, u, 1);
+    }
+}
+
+static void generar_aleatorio(const Emisor *e, int n, double p, Azar *azar) {
+    MuestreoPares m;
+    iniciar_muestreo(&m, azar, n, e->tipo == DIRIGIDO, p);
+    int u, v;
+    while (siguiente_par(&m, &u, &v)) {
+        emitir(e, u, v);
+    }
+}
+
+// Pares {u, v} empaquetados con el mayor adelante, así el orden como enteros es
+// el mismo en que salen del muestreo no dirigido
+static uint64_t empaquetar_par(int u, int v) {
+    if (u < v) {
+        int t = u;
+        u = v;
+        v = t;
+    }
+    return (uint64_t)u << 32 | (uint32_t)v;
+}
+
+static int comparar_pares(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Posiciones consecutivas en un ciclo de n
+static bool vecinos_en_ciclo(long long i, long long j, int n) {
+    long long d = i > j ? i - j : j - i;
+    return d == 1 || d == n - 1;
+}
+
+// Euleriano: el ciclo 0 .. n-1 (que lo hace conexo) más cuerdas al azar. Las
+// cuerdas dejan grados impares; se juntan los impares de a dos y se invierte la
+// cuerda entre ellos, o, si son vecinos en el ciclo, las dos cuerdas que pasan
+// por un tercer nodo c (que cambia de paridad dos veces). Con menos de 5 nodos
+// ningún agregado al ciclo queda con grados pares, así que queda el ciclo solo.
+static bool generar_euleriano(const Emisor *e, int n, double p, Azar *azar) {
+    for (int u = 0; u < n; u++) {
+        emitir(e, u, (u + 1) % n);
+    }
+    if (n < 5 || p <= 0) return true;
+
+    // Las cuerdas salen ordenadas del muestreo
+    size_t capacidad = 1024, num_cuerdas = 0;
+    uint64_t *cuerdas = malloc(capacidad * sizeof(uint64_t));
+    unsigned char *impar = calloc((size_t)n, 1);
+    bool ok = cuerdas && impar;
+    MuestreoPares m;
+    iniciar_muestreo(&m, azar, n, false, p);
+    int u, v;
+    while (ok && siguiente_par(&m, &u, &v)) {
+        if (vecinos_en_ciclo(u, v, n)) continue;
+        if (num_cuerdas == capacidad) {
+            uint64_t *ampliado = realloc(cuerdas, 2 * capacidad * sizeof(uint64_t));
+            if (!ampliado) {
+                ok = false;
+                break;
+            }
+            cuerdas = ampliado;
+            capacidad *= 2;
+        }
+        cuerdas[num_cuerdas++] = empaquetar_par(u, v);
+        impar[u] ^= 1;
+        impar[v] ^= 1;
+    }
+
+    // Cuerdas que se invierten; una que aparece dos veces se anula
+    uint64_t *cambios = ok ? malloc((size_t)n * sizeof(uint64_t)) : NULL;
+    size_t num_cambios = 0;
+    ok = ok && cambios;
+    int pendiente = -1;
+    for (int w = 0; w < n && ok; w++) {
+        if (!impar[w]) continue;
+        if (pendiente < 0) {
+            pendiente = w;
+            continue;
+        }
+        int a = pendiente, b = w;
+        pendiente = -1;
+        if (!vecinos_en_ciclo(a, b, n)) {
+            cambios[num_cambios++] = empaquetar_par(a, b);
+        } else {
+            // b sigue a a en el ciclo; c está a dos pasos de b y a tres de a
+            if ((a + 1) % n != b) {
+                int t = a;
+                a = b;
+                b = t;
+            }
+            int c = (b + 2) % n;
+            cambios[num_cambios++] = empaquetar_par(a, c);
+            cambios[num_cambios++] = empaquetar_par(c, b);
+        }
+    }
+
+    if (ok) {
+        qsort(cambios, num_cambios, sizeof(uint64_t), comparar_pares);
+        // Diferencia simétrica de las dos listas ordenadas
+        size_t i = 0, j = 0;
+        while (i < num_cuerdas || j < num_cambios) {
+            if (j + 1 < num_cambios && cambios[j] == cambios[j + 1]) {
+                j += 2;
+                continue;
+            }
+            uint64_t par;
+            if (j == num_cambios || (i < num_cuerdas && cuerdas[i] < cambios[j])) {
+                par = cuerdas[i++];
+            } else if (i == num_cuerdas || cambios[j] < cuerdas[i]) {
+                par = cambios[j++];
+            } else {
+                i++;
+                j++;
+                continue;
+            }
+            emitir(e, (int)(par >> 32), (int)(uint32_t)par);
+        }
+    }
+    free(cuerdas);
+    free(impar);
+    free(cambios);
+    return ok;
+}
+
+// Hamiltoniano: un ciclo que visita los nodos en un orden al azar (Fisher-Yates)
+// y, encima, cada otro par con probabilidad p
+static bool generar_hamiltoniano(const Emisor *e, int n, double p, Azar *azar) {
+    int *orden = malloc((size_t)n * sizeof(int));
+    int *posicion = malloc((size_t)n * sizeof(int));
+    if (!orden || !posicion) {
+        free(orden);
+        free(posicion);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        orden[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)azar_menor(azar, (size_t)i + 1);
+        int t = orden[i];
+        orden[i] = orden[j];
+        orden[j] = t;
+    }
+    for (int i = 0; i < n; i++) {
+        posicion[orden[i]] = i;
+        emitir(e, orden[i], orden[(i + 1) % n]);
+    }
+
+    MuestreoPares m;
+    iniciar_muestreo(&m, azar, n, false, p);
+    int u, v;
+    while (siguiente_par(&m, &u, &v)) {
+        if (!vecinos_en_ciclo(posicion[u], posicion[v], n)) emitir(e, u, v);
+    }
+    free(orden);
+    free(posicion);
+    return true;
+}
+
+// Conjunto de pares con direccionamiento abierto; 0 marca un hueco (el par
+// empaquetado {0, 0} sería un lazo, que nunca se guarda)
+typedef struct {
+    uint64_t *claves;
+    size_t mascara;
+} ConjuntoPares;
+
+static bool iniciar_conjunto(ConjuntoPares *c, size_t elementos) {
+    size_t capacidad = 16;
+    while (capacidad < 2 * elementos) capacidad *= 2;
+    c->claves = calloc(capacidad, sizeof(uint64_t));
+    c->mascara = capacidad - 1;
+    return c->claves != NULL;
+}
+
+static size_t ranura_par(const ConjuntoPares *c, uint64_t clave) {
+    size_t i = (size_t)((clave * 0x9E3779B97F4A7C15ULL) >> 32) & c->mascara;
+    while (c->claves[i] != 0 && c->claves[i] != clave) {
+        i = (i + 1) & c->mascara;
+    }
+    return i;
+}
+
+static bool contiene_par(const ConjuntoPares *c, int u, int v) {
+    return c->claves[ranura_par(c, empaquetar_par(u, v))] != 0;
+}
+
+static void agregar_par(ConjuntoPares *c, int u, int v) {
+    uint64_t clave = empaquetar_par(u, v);
+    c->claves[ranura_par(c, clave)] = clave;
+}
+
+// Indica si entre los puntos libres queda algún par de nodos distintos que
+// todavía no están unidos
+static bool queda_par_valido(const ConjuntoPares *c, const int *puntos, size_t libres) {
+    for (size_t i = 0; i < libres; i++) {
+        for (size_t j = i + 1; j < libres; j++) {
+            if (puntos[i] != puntos[j] && !contiene_par(c, puntos[i], puntos[j])) return true;
+        }
+    }
+    return false;
+}
+
+// Regular de grado d por el método de Steger y Wormald: cada nodo aporta d
+// puntos y se unen pares de puntos al azar, descartando lazos y aristas
+// repetidas; si no quedan pares posibles se empieza de nuevo. Para grados de
+// más de la mitad se arma el complemento, que es regular de grado n - 1 - d.
+static bool generar_regular(const Emisor *e, int n, int d, Azar *azar, bool *agotado) {
+    bool complemento = d > (n - 1) / 2;
+    int grado = complemento ? n - 1 - d : d;
+    size_t total = (size_t)n * grado;
+    int *puntos = malloc((total > 0 ? total : 1) * sizeof(int));
+    ConjuntoPares aristas;
+    aristas.claves = NULL;
+    bool ok = puntos && iniciar_conjunto(&aristas, total / 2);
+
+    bool armado = false;
+    for (int intento = 0; ok && !armado && intento < MAX_REINICIOS_REGULAR; intento++) {
+        memset(aristas.claves, 0, (aristas.mascara + 1) * sizeof(uint64_t));
+        for (size_t i = 0; i < total; i++) {
+            puntos[i] = (int)(i / (size_t)grado);
+        }
+        size_t libres = total;
+        int fallos = 0;
+        while (libres > 0) {
+            size_t i = azar_menor(azar, libres);
+            size_t j = azar_menor(azar, libres);
+            int u = puntos[i], v = puntos[j];
+            if (u != v && !contiene_par(&aristas, u, v)) {
+                agregar_par(&aristas, u, v);
+                // Quita los dos puntos pasando los últimos a su lugar
+                if (i < j) {
+                    size_t t = i;
+                    i = j;
+                    j = t;
+                }
+                puntos[i] = puntos[--libres];
+                puntos[j] = puntos[--libres];
+                fallos = 0;
+            } else if (++fallos > MAX_FALLOS_REGULAR) {
+                if (!queda_par_valido(&aristas, puntos, libres)) break;
+                fallos = 0;
+            }
+        }
+        armado = libres == 0;
+    }
+
+    if (ok && armado) {
+        if (complemento) {
+            for (int u = 1; u < n; u++) {
+                for (int v = 0; v < u; v++) {
+                    if (!contiene_par(&aristas, u, v)) emitir(e, u, v);
+                }
+            }
+        } else {
+            for (size_t i = 0; i <= aristas.mascara; i++) {
+                uint64_t par = aristas.claves[i];
+                if (par != 0) emitir(e, (int)(par >> 32), (int)(uint32_t)par);
+            }
+        }
+    }
+    free(puntos);
+    free(aristas.claves);
+    *agotado = ok && !armado;
+    return ok && armado;
+}
+
+// En círculo si los nodos caben sin juntarse; si no, en una cuadrícula
+static void emitir_posiciones(const ReceptorGrafo *receptor, int n, int limite) {
+    if (!receptor->posicion || limite <= 0) return;
+    double centro = limite / 2.0;
+    double radio = 0.4 * limite;
+    // Al menos dos unidades entre vecinos, para que no se redondeen al mismo punto
+    if (n <= 1 || 2 * PI * radio / n >= 2.0) {
+        for (int i = 0; i < n; i++) {
+            double angulo = n > 1 ? 2 * PI * i / n - PI / 2 : 0;
+            Coordenada pos = {(int)lround(centro + radio * cos(angulo)),
+                              (int)lround(centro + radio * sin(angulo))};
+            receptor->posicion(receptor->datos, i, pos);
+        }
+        return;
+    }
+    long long lado = (long long)ceil(sqrt((double)n));
+    if (lado > (long long)limite + 1) return;
+    int paso = (int)(limite / (lado - 1));
+    for (int i = 0; i < n; i++) {
+        Coordenada pos = {(int)(i % lado) * paso, (int)(i / lado) * paso};
+        receptor->posicion(receptor->datos, i, pos);
+    }
+}
+
+bool generar_grafo(const ParametrosGenerador *parametros, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    FamiliaGrafo familia = parametros->familia;
+    int n = parametros->num_nodos;
+    double p = parametros->densidad;
+    error->linea = 0;
+    error->columna = 0;
+    error->mensaje[0] = '\0';
+
+    if (familia < 0 || familia >= NUM_FAMILIAS) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "Familia de grafos desconocida");
+        return false;
+    }
+    if (n < MINIMO_NODOS[familia]) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "La familia %s necesita al menos %d nodos",
+                 NOMBRES_FAMILIA[familia], MINIMO_NODOS[familia]);
+        return false;
+    }
+    if (!(p >= 0 && p <= 1)) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "La densidad debe estar entre 0 y 1");
+        return false;
+    }
+    if (familia == FAMILIA_REGULAR) {
+        int d = parametros->grado;
+        if (d < 0 || d >= n) {
+            snprintf(error->mensaje, sizeof(error->mensaje), "El grado debe estar entre 0 y %d", n - 1);
+            return false;
+        }
+        if ((long long)n * d % 2 != 0) {
+            snprintf(error->mensaje, sizeof(error->mensaje),
+                     "No hay grafos de %d nodos con grado %d: la suma de los grados debe ser par", n, d);
+            return false;
+        }
+    }
+
+    Emisor e = {receptor, familia == FAMILIA_DIRIGIDO ? DIRIGIDO : NO_DIRIGIDO};
+    if (!receptor->encabezado(receptor->datos, n, e.tipo, error)) return false;
+
+    Azar azar = {parametros->semilla};
+    bool ok = true;
+    bool agotado = false;
+    switch (familia) {
+        case FAMILIA_COMPLETO:
+            generar_aleatorio(&e, n, 1.0, &azar);
+            break;
+        case FAMILIA_CICLO:
+            for (int u = 0; u < n; u++) emitir(&e, u, (u + 1) % n);
+            break;
+        case FAMILIA_CAMINO:
+            for (int u = 0; u + 1 < n; u++) emitir(&e, u, u + 1);
+            break;
+        case FAMILIA_ESTRELLA:
+            for (int u = 1; u < n; u++) emitir(&e, 0, u);
+            break;
+        case FAMILIA_BIPARTITO:
+            for (int u = 0; u < n / 2; u++) {
+                for (int v = n / 2; v < n; v++) emitir(&e, u, v);
+            }
+            break;
+        case FAMILIA_ALEATORIO:
+        case FAMILIA_DIRIGIDO:
+            generar_aleatorio(&e, n, p, &azar);
+            break;
+        case FAMILIA_EULERIANO:
+            ok = generar_euleriano(&e, n, p, &azar);
+            break;
+        case FAMILIA_RUEDA:
+            for (int u = 1; u < n; u++) {
+                emitir(&e, 0, u);
+                emitir(&e, u, u + 1 < n ? u + 1 : 1);
+            }
+            break;
+        case FAMILIA_ARBOL:
+            for (int u = 1; u < n; u++) emitir(&e, (u - 1) / 2, u);
+            break;
+        case FAMILIA_HAMILTONIANO:
+            ok = generar_hamiltoniano(&e, n, p, &azar);
+            break;
+        case FAMILIA_REGULAR:
+            ok = generar_regular(&e, n, parametros->grado, &azar, &agotado);
+            break;
+        default:
+            break;
+    }
+    if (!ok) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "%s", agotado
+                 ? "No se pudo armar el grafo regular; pruebe con otra semilla"
+                 : "Memoria insuficiente");
+        return false;
+    }
+    emitir_posiciones(receptor, n, parametros->limite_posicion);
+    return true;
+}
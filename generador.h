@@ -0,0 +1,51 @@
+#ifndef GENERADOR_H
+#define GENERADOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cargador.h"
+
+// Generador de las familias de grafos/README.md en cualquier tamaño. Entrega el
+// grafo a un ReceptorGrafo igual que el cargador, así que sirve tanto para la
+// matriz densa como para el CSR o para contar. Con la misma semilla siempre
+// sale el mismo grafo. Las familias al azar saltan de una arista elegida a la
+// siguiente, así que el costo es proporcional a las aristas y no a los pares.
+
+typedef enum {
+    FAMILIA_COMPLETO,
+    FAMILIA_CICLO,
+    FAMILIA_CAMINO,
+    FAMILIA_ESTRELLA,       // Centro en el nodo 0
+    FAMILIA_BIPARTITO,      // Bipartito completo entre las dos mitades
+    FAMILIA_ALEATORIO,      // Cada arista con probabilidad 'densidad'
+    FAMILIA_EULERIANO,      // Ciclo 0 .. n-1 con cuerdas al azar y todos los grados pares
+    FAMILIA_RUEDA,          // Ciclo 1 .. n-1 y el centro 0 unido a todos
+    FAMILIA_ARBOL,          // Árbol binario: el padre de i es (i - 1) / 2
+    FAMILIA_DIRIGIDO,       // Cada arco u -> v (u != v) con probabilidad 'densidad'
+    FAMILIA_HAMILTONIANO,   // Ciclo hamiltoniano en orden al azar más aristas con probabilidad 'densidad'
+    FAMILIA_REGULAR,        // Regular de grado 'grado', al azar
+    NUM_FAMILIAS
+} FamiliaGrafo;
+
+typedef struct {
+    FamiliaGrafo familia;
+    int num_nodos;
+    double densidad;        // Aleatorio, dirigido, hamiltoniano y cuerdas del euleriano (0 a 1)
+    int grado;              // Regular: entre 0 y num_nodos - 1, con num_nodos * grado par
+    uint64_t semilla;
+    int limite_posicion;    // Posiciones entre 0 y este valor; 0: sin posiciones
+} ParametrosGenerador;
+
+const char *nombre_familia(FamiliaGrafo familia);
+bool familia_por_nombre(const char *nombre, FamiliaGrafo *familia);
+
+// Aristas que tendrá el grafo (el valor esperado en las familias al azar); sirve
+// para decidir el tamaño antes de generar
+double aristas_esperadas(const ParametrosGenerador *parametros);
+
+// Entrega el encabezado, las aristas (en no dirigidos, en ambos sentidos) y las
+// posiciones. Falla con un mensaje en 'error' si los parámetros no sirven para
+// la familia, si el receptor rechaza el encabezado o si falta memoria.
+bool generar_grafo(const ParametrosGenerador *parametros, const ReceptorGrafo *receptor, ErrorCarga *error);
+
+#endif
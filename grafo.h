@@ -0,0 +1,23 @@
+#ifndef GRAFO_H
+#define GRAFO_H
+
+#define MAX_NODOS 12
+
+typedef enum {
+    NO_DIRIGIDO,
+    DIRIGIDO
+} TipoGrafo;
+
+typedef struct {
+    int x;
+    int y;
+} Coordenada;
+
+typedef struct {
+    int K;
+    TipoGrafo tipo;
+    int matriz_adyacencia[MAX_NODOS][MAX_NODOS];
+    Coordenada posiciones[MAX_NODOS];
+} Grafo;
+
+#endif
@@ -0,0 +1,182 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "grafo_csr.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define CAPACIDAD_INICIAL_ARCOS 1024
+
+void iniciar_constructor_csr(ConstructorCSR *constructor, GrafoCSR *grafo) {
+    memset(grafo, 0, sizeof(*grafo));
+    constructor->grafo = grafo;
+    constructor->origenes = NULL;
+    constructor->destinos = NULL;
+    constructor->num_arcos = 0;
+    constructor->capacidad = 0;
+    constructor->sin_memoria = false;
+}
+
+static bool csr_encabezado(void *datos, int K, TipoGrafo tipo, ErrorCarga *error) {
+    ConstructorCSR *constructor = (ConstructorCSR *)datos;
+    if (K < 1 || K == INT_MAX) {
+        snprintf(error->mensaje, sizeof(error->mensaje), "Número de nodos inválido");
+        return false;
+    }
+    constructor->grafo->num_nodos = K;
+    constructor->grafo->tipo = tipo;
+    return true;
+}
+
+static bool crecer_constructor(ConstructorCSR *constructor) {
+    long long nueva = constructor->capacidad > 0 ? constructor->capacidad * 2 : CAPACIDAD_INICIAL_ARCOS;
+    int *origenes = realloc(constructor->origenes, (size_t)nueva * sizeof(int));
+    if (!origenes) return false;
+    constructor->origenes = origenes;
+    int *destinos = realloc(constructor->destinos, (size_t)nueva * sizeof(int));
+    if (!destinos) return false;
+    constructor->destinos = destinos;
+    constructor->capacidad = nueva;
+    return true;
+}
+
+static void csr_arista(void *datos, int u, int v, int peso) {
+    ConstructorCSR *constructor = (ConstructorCSR *)datos;
+    if (constructor->sin_memoria) return;
+
+    // Las aristas múltiples se guardan repetidas, como en un multigrafo
+    for (int k = 0; k < peso; k++) {
+        if (constructor->num_arcos == constructor->capacidad && !crecer_constructor(constructor)) {
+            constructor->sin_memoria = true;
+            return;
+        }
+        constructor->origenes[constructor->num_arcos] = u;
+        constructor->destinos[constructor->num_arcos] = v;
+        constructor->num_arcos++;
+    }
+}
+
+static void csr_posicion(void *datos, int nodo, Coordenada pos) {
+    ConstructorCSR *constructor = (ConstructorCSR *)datos;
+    GrafoCSR *grafo = constructor->grafo;
+    if (!grafo->posiciones) {
+        grafo->posiciones = calloc((size_t)grafo->num_nodos, sizeof(Coordenada));
+        if (!grafo->posiciones) {
+            constructor->sin_memoria = true;
+            return;
+        }
+    }
+    grafo->posiciones[nodo] = pos;
+}
+
+void receptor_grafo_csr(ReceptorGrafo *receptor, ConstructorCSR *constructor) {
+    receptor->encabezado = csr_encabezado;
+    receptor->arista = csr_arista;
+    receptor->posicion = csr_posicion;
+    receptor->datos = constructor;
+}
+
+// Ordenamiento por conteo según el origen. Es estable, así que los arcos de
+// cada nodo conservan el orden en que aparecen en el archivo.
+bool terminar_constructor_csr(ConstructorCSR *constructor) {
+    GrafoCSR *grafo = constructor->grafo;
+    int n = grafo->num_nodos;
+    long long m = constructor->num_arcos;
+    bool ok = !constructor->sin_memoria;
+
+    if (ok) {
+        grafo->inicio = calloc((size_t)n + 1, sizeof(long long));
+        grafo->destinos = malloc((size_t)(m > 0 ? m : 1) * sizeof(int));
+        ok = grafo->inicio && grafo->destinos;
+    }
+
+    if (ok) {
+        for (long long a = 0; a < m; a++) {
+            grafo->inicio[constructor->origenes[a] + 1]++;
+        }
+        for (int u = 0; u < n; u++) {
+            grafo->inicio[u + 1] += grafo->inicio[u];
+        }
+        // Cada inicio[u] avanza hasta el inicio de u + 1; luego se corre una posición
+        for (long long a = 0; a < m; a++) {
+            grafo->destinos[grafo->inicio[constructor->origenes[a]]++] = constructor->destinos[a];
+        }
+        for (int u = n; u > 0; u--) {
+            grafo->inicio[u] = grafo->inicio[u - 1];
+        }
+        grafo->inicio[0] = 0;
+        grafo->num_arcos = m;
+    }
+
+    free(constructor->origenes);
+    free(constructor->destinos);
+    constructor->origenes = NULL;
+    constructor->destinos = NULL;
+    constructor->num_arcos = 0;
+    constructor->capacidad = 0;
+
+    if (!ok) {
+        liberar_grafo_csr(grafo);
+    }
+    return ok;
+}
+
+bool grafo_csr_desde_denso(const Grafo *denso, GrafoCSR *grafo) {
+    ConstructorCSR constructor;
+    ReceptorGrafo receptor;
+    ErrorCarga error;
+    iniciar_constructor_csr(&constructor, grafo);
+    receptor_grafo_csr(&receptor, &constructor);
+
+    if (!receptor.encabezado(&constructor, denso->K, denso->tipo, &error)) {
+        return false;
+    }
+    for (int i = 0; i < denso->K; i++) {
+        for (int j = 0; j < denso->K; j++) {
+            if (denso->matriz_adyacencia[i][j] > 0) {
+                receptor.arista(&constructor, i, j, denso->matriz_adyacencia[i][j]);
+            }
+        }
+    }
+    for (int i = 0; i < denso->K; i++) {
+        receptor.posicion(&constructor, i, denso->posiciones[i]);
+    }
+    return terminar_constructor_csr(&constructor);
+}
+
+bool grafo_denso_desde_csr(const GrafoCSR *grafo, Grafo *denso) {
+    if (grafo->num_nodos < 1 || grafo->num_nodos > MAX_NODOS) return false;
+
+    memset(denso, 0, sizeof(*denso));
+    denso->K = grafo->num_nodos;
+    denso->tipo = grafo->tipo;
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            denso->matriz_adyacencia[u][grafo->destinos[a]]++;
+        }
+        if (grafo->posiciones) {
+            denso->posiciones[u] = grafo->posiciones[u];
+        }
+    }
+    return true;
+}
+
+void liberar_grafo_csr(GrafoCSR *grafo) {
+    if (grafo->mapeo) {
+        munmap(grafo->mapeo, grafo->tam_mapeo);
+    } else {
+        free(grafo->inicio);
+        free(grafo->destinos);
+        free(grafo->posiciones);
+    }
+    grafo->mapeo = NULL;
+    grafo->tam_mapeo = 0;
+    grafo->inicio = NULL;
+    grafo->destinos = NULL;
+    grafo->posiciones = NULL;
+    grafo->num_nodos = 0;
+    grafo->num_arcos = 0;
+}
@@ -0,0 +1,49 @@
+#ifndef GRAFO_CSR_H
+#define GRAFO_CSR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cargador.h"
+#include "grafo.h"
+
+// Grafo en formato de filas comprimidas (CSR): los arcos que salen del nodo u son
+// destinos[inicio[u]] .. destinos[inicio[u + 1] - 1]. Ocupa O(V + E) en lugar de
+// O(V^2), así que sirve para grafos grandes y dispersos. Igual que en la matriz
+// de adyacencia, en grafos no dirigidos cada arista aparece en ambos sentidos
+// (los lazos, una sola vez) y las aristas múltiples se repiten.
+typedef struct {
+    int num_nodos;
+    TipoGrafo tipo;
+    long long num_arcos;
+    long long *inicio;          // num_nodos + 1 desplazamientos
+    int *destinos;              // num_arcos destinos
+    Coordenada *posiciones;     // NULL si el archivo no trae posiciones
+    void *mapeo;                // Instantánea proyectada a la que apuntan los arreglos, o NULL
+    size_t tam_mapeo;
+} GrafoCSR;
+
+// Acumula los arcos que entrega el cargador y al final los ordena por origen
+typedef struct {
+    GrafoCSR *grafo;
+    int *origenes;
+    int *destinos;
+    long long num_arcos;
+    long long capacidad;
+    bool sin_memoria;
+} ConstructorCSR;
+
+void iniciar_constructor_csr(ConstructorCSR *constructor, GrafoCSR *grafo);
+void receptor_grafo_csr(ReceptorGrafo *receptor, ConstructorCSR *constructor);
+// Arma el CSR con los arcos recibidos y libera los temporales del constructor
+bool terminar_constructor_csr(ConstructorCSR *constructor);
+
+bool grafo_csr_desde_denso(const Grafo *denso, GrafoCSR *grafo);
+// Solo para grafos de hasta MAX_NODOS nodos
+bool grafo_denso_desde_csr(const GrafoCSR *grafo, Grafo *denso);
+void liberar_grafo_csr(GrafoCSR *grafo);
+
+static inline long long grado_salida_csr(const GrafoCSR *grafo, int u) {
+    return grafo->inicio[u + 1] - grafo->inicio[u];
+}
+
+#endif
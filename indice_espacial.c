@@ -0,0 +1,156 @@
+#include "indice_espacial.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Mezcla de splitmix64 sobre las dos coordenadas de la celda: las celdas
+// vecinas no deben caer en cubetas vecinas
+static uint64_t dispersar_celda(long long cx, long long cy) {
+    uint64_t x = (uint64_t)cx * 0x9e3779b97f4a7c15ull ^ (uint64_t)cy;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+static long long celda(const IndiceEspacial *indice, double v) {
+    return (long long)floor(v / indice->lado);
+}
+
+static int cubeta(const IndiceEspacial *indice, long long cx, long long cy) {
+    return (int)(dispersar_celda(cx, cy) & (uint64_t)(indice->num_cubetas - 1));
+}
+
+static int cubeta_nodo(const IndiceEspacial *indice, const Coordenada *p) {
+    return cubeta(indice, celda(indice, p->x), celda(indice, p->y));
+}
+
+bool construir_indice_espacial(IndiceEspacial *indice, const Coordenada *posiciones, int num_nodos,
+                               double lado) {
+    memset(indice, 0, sizeof(*indice));
+    indice->lado = lado;
+    indice->num_nodos = num_nodos;
+    indice->num_cubetas = 1;
+    while (indice->num_cubetas < num_nodos) indice->num_cubetas *= 2;
+
+    indice->inicio = calloc((size_t)indice->num_cubetas + 1, sizeof(int));
+    indice->nodos = malloc((num_nodos > 0 ? (size_t)num_nodos : 1) * sizeof(int));
+    if (!indice->inicio || !indice->nodos) {
+        liberar_indice_espacial(indice);
+        return false;
+    }
+
+    // Conteo por cubeta y luego reparto, como al armar un CSR
+    for (int i = 0; i < num_nodos; i++) {
+        indice->inicio[cubeta_nodo(indice, &posiciones[i]) + 1]++;
+    }
+    for (int c = 0; c < indice->num_cubetas; c++) {
+        indice->inicio[c + 1] += indice->inicio[c];
+    }
+    int *siguiente = malloc((size_t)indice->num_cubetas * sizeof(int));
+    if (!siguiente) {
+        liberar_indice_espacial(indice);
+        return false;
+    }
+    memcpy(siguiente, indice->inicio, (size_t)indice->num_cubetas * sizeof(int));
+    for (int i = 0; i < num_nodos; i++) {
+        indice->nodos[siguiente[cubeta_nodo(indice, &posiciones[i])]++] = i;
+    }
+    free(siguiente);
+    return true;
+}
+
+void liberar_indice_espacial(IndiceEspacial *indice) {
+    free(indice->inicio);
+    free(indice->nodos);
+    indice->inicio = NULL;
+    indice->nodos = NULL;
+    indice->num_nodos = 0;
+    indice->num_cubetas = 0;
+}
+
+static bool dentro(const Coordenada *p, double x0, double y0, double x1, double y1) {
+    return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1;
+}
+
+void nodos_en_rectangulo(const IndiceEspacial *indice, const Coordenada *posiciones,
+                         double x0, double y0, double x1, double y1,
+                         VisitarNodo visitar, void *datos) {
+    if (x0 > x1 || y0 > y1) return;
+    long long cx0 = celda(indice, x0), cx1 = celda(indice, x1);
+    long long cy0 = celda(indice, y0), cy1 = celda(indice, y1);
+
+    // Si el rectángulo abarca más celdas que nodos hay, es más barato filtrarlos todos
+    double celdas = (double)(cx1 - cx0 + 1) * (double)(cy1 - cy0 + 1);
+    if (celdas > indice->num_nodos) {
+        for (int i = 0; i < indice->num_nodos; i++) {
+            if (dentro(&posiciones[i], x0, y0, x1, y1)) visitar(i, datos);
+        }
+        return;
+    }
+
+    for (long long cy = cy0; cy <= cy1; cy++) {
+        for (long long cx = cx0; cx <= cx1; cx++) {
+            int c = cubeta(indice, cx, cy);
+            for (int k = indice->inicio[c]; k < indice->inicio[c + 1]; k++) {
+                int nodo = indice->nodos[k];
+                const Coordenada *p = &posiciones[nodo];
+                // Otras celdas pueden compartir la cubeta: solo cuenta la propia,
+                // así ningún nodo se visita dos veces
+                if (celda(indice, p->x) != cx || celda(indice, p->y) != cy) continue;
+                if (dentro(p, x0, y0, x1, y1)) visitar(nodo, datos);
+            }
+        }
+    }
+}
+
+typedef struct {
+    const Coordenada *posiciones;
+    double x;
+    double y;
+    double mejor_distancia;
+    int mejor;
+} BusquedaCercano;
+
+static void comparar_cercano(int nodo, void *datos) {
+    BusquedaCercano *b = (BusquedaCercano *)datos;
+    double dx = b->posiciones[nodo].x - b->x;
+    double dy = b->posiciones[nodo].y - b->y;
+    double distancia = dx * dx + dy * dy;
+    if (distancia <= b->mejor_distancia) {
+        b->mejor_distancia = distancia;
+        b->mejor = nodo;
+    }
+}
+
+int nodo_mas_cercano(const IndiceEspacial *indice, const Coordenada *posiciones,
+                     double x, double y, double radio) {
+    BusquedaCercano b = {posiciones, x, y, radio * radio, -1};
+    nodos_en_rectangulo(indice, posiciones, x - radio, y - radio, x + radio, y + radio,
+                        comparar_cercano, &b);
+    return b.mejor;
+}
+
+// Dos nodos en la misma posición caen en la misma celda, y por lo tanto en la
+// misma cubeta: basta comparar dentro de cada cubeta
+bool buscar_posicion_repetida(const IndiceEspacial *indice, const Coordenada *posiciones,
+                              int *a, int *b) {
+    for (int c = 0; c < indice->num_cubetas; c++) {
+        for (int i = indice->inicio[c]; i < indice->inicio[c + 1]; i++) {
+            for (int j = i + 1; j < indice->inicio[c + 1]; j++) {
+                int u = indice->nodos[i];
+                int v = indice->nodos[j];
+                if (posiciones[u].x == posiciones[v].x && posiciones[u].y == posiciones[v].y) {
+                    *a = u < v ? u : v;
+                    *b = u < v ? v : u;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,41 @@
+#ifndef INDICE_ESPACIAL_H
+#define INDICE_ESPACIAL_H
+
+#include <stdbool.h>
+#include "grafo.h"
+
+// Rejilla uniforme sobre las posiciones de los nodos, para responder en tiempo
+// proporcional a lo consultado en lugar de a todos los nodos: qué nodo hay
+// bajo el puntero, qué nodos caen en la parte visible del lienzo y si dos
+// nodos comparten posición. Las celdas de lado 'lado' se reparten por
+// dispersión en una tabla de cubetas (potencia de dos, al menos tantas como
+// nodos) y los nodos quedan agrupados por cubeta como en GrafoCSR. El índice
+// no copia las posiciones: las consultas reciben el mismo arreglo con que se
+// construyó, y hay que reconstruirlo si las posiciones cambian.
+typedef struct {
+    double lado;
+    int num_nodos;
+    int num_cubetas;
+    int *inicio;        // num_cubetas + 1 desplazamientos en 'nodos'
+    int *nodos;         // num_nodos índices de nodo agrupados por cubeta
+} IndiceEspacial;
+
+bool construir_indice_espacial(IndiceEspacial *indice, const Coordenada *posiciones, int num_nodos,
+                               double lado);
+void liberar_indice_espacial(IndiceEspacial *indice);
+
+// Llama a 'visitar' una vez por cada nodo dentro del rectángulo (bordes incluidos)
+typedef void (*VisitarNodo)(int nodo, void *datos);
+void nodos_en_rectangulo(const IndiceEspacial *indice, const Coordenada *posiciones,
+                         double x0, double y0, double x1, double y1,
+                         VisitarNodo visitar, void *datos);
+
+// Nodo más cercano a (x, y) a distancia menor o igual que 'radio', o -1
+int nodo_mas_cercano(const IndiceEspacial *indice, const Coordenada *posiciones,
+                     double x, double y, double radio);
+
+// Busca dos nodos con la misma posición; si los hay los deja en *a < *b
+bool buscar_posicion_repetida(const IndiceEspacial *indice, const Coordenada *posiciones,
+                              int *a, int *b);
+
+#endif
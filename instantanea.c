@@ -0,0 +1,359 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "instantanea.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char MAGIA_INSTANTANEA[8] = "P4AAGRF";
+
+// Se guarda con el orden de bytes de la máquina; al abrir se rechaza si no coincide
+#define MARCA_ORDEN_BYTES 0x01020304u
+
+#define CON_POSICIONES 1u
+
+typedef struct {
+    char magia[8];
+    uint32_t version;
+    uint32_t orden_bytes;
+    int32_t num_nodos;
+    uint32_t tipo;
+    int64_t num_arcos;
+    uint32_t banderas;
+    uint32_t reservado;
+    uint64_t desp_inicio;
+    uint64_t desp_destinos;
+    uint64_t desp_posiciones;   // 0 si no hay posiciones
+    uint64_t tam_total;
+    uint64_t suma;
+} CabeceraInstantanea;
+
+// La proyección se usa como GrafoCSR, así que los tipos deben coincidir en tamaño
+_Static_assert(sizeof(CabeceraInstantanea) == 80, "cabecera de instantánea");
+_Static_assert(sizeof(long long) == sizeof(int64_t), "inicio del CSR");
+_Static_assert(sizeof(int) == sizeof(int32_t), "destinos del CSR");
+_Static_assert(sizeof(Coordenada) == 2 * sizeof(int32_t), "posiciones del CSR");
+
+// Suma de verificación por palabras de 64 bits en cuatro carriles independientes
+// (rondas al estilo de xxHash64), para que verificar un archivo de varios GB
+// cueste poco más que leerlo
+#define PRIMO_1 0x9E3779B185EBCA87ull
+#define PRIMO_2 0xC2B2AE3D27D4EB4Full
+
+typedef struct {
+    uint64_t carril[4];
+    uint64_t palabras;
+} SumaInstantanea;
+
+static inline uint64_t ronda_suma(uint64_t h, uint64_t palabra) {
+    h += palabra * PRIMO_2;
+    h = (h << 31) | (h >> 33);
+    return h * PRIMO_1;
+}
+
+static void iniciar_suma(SumaInstantanea *s) {
+    s->carril[0] = PRIMO_1 + PRIMO_2;
+    s->carril[1] = PRIMO_2;
+    s->carril[2] = 0;
+    s->carril[3] = 0 - PRIMO_1;
+    s->palabras = 0;
+}
+
+static void sumar_palabras(SumaInstantanea *s, const void *datos, size_t n) {
+    const unsigned char *p = (const unsigned char *)datos;
+    uint64_t palabra;
+    size_t i = 0;
+
+    // Completa el bloque de cuatro que quedó a medias en la llamada anterior
+    while (i < n && (s->palabras & 3) != 0) {
+        memcpy(&palabra, p + i * 8, 8);
+        s->carril[s->palabras & 3] = ronda_suma(s->carril[s->palabras & 3], palabra);
+        s->palabras++;
+        i++;
+    }
+
+    uint64_t h0 = s->carril[0], h1 = s->carril[1], h2 = s->carril[2], h3 = s->carril[3];
+    for (; i + 4 <= n; i += 4) {
+        uint64_t w[4];
+        memcpy(w, p + i * 8, sizeof(w));
+        h0 = ronda_suma(h0, w[0]);
+        h1 = ronda_suma(h1, w[1]);
+        h2 = ronda_suma(h2, w[2]);
+        h3 = ronda_suma(h3, w[3]);
+        s->palabras += 4;
+    }
+    s->carril[0] = h0;
+    s->carril[1] = h1;
+    s->carril[2] = h2;
+    s->carril[3] = h3;
+
+    for (; i < n; i++) {
+        memcpy(&palabra, p + i * 8, 8);
+        s->carril[s->palabras & 3] = ronda_suma(s->carril[s->palabras & 3], palabra);
+        s->palabras++;
+    }
+}
+
+static uint64_t terminar_suma(const SumaInstantanea *s) {
+    uint64_t h = s->palabras;
+    for (int i = 0; i < 4; i++) {
+        h = ronda_suma(h, s->carril[i]);
+    }
+    h ^= h >> 29;
+    return h;
+}
+
+static uint64_t alinear_8(uint64_t desplazamiento) {
+    return (desplazamiento + 7) & ~(uint64_t)7;
+}
+
+// Desplazamientos que corresponden a un grafo de ese tamaño. Tanto al guardar
+// como al abrir se calculan aquí, así que la cabecera no puede apuntar fuera
+// del archivo ni solapar secciones.
+static void calcular_distribucion(CabeceraInstantanea *c) {
+    uint64_t n = (uint64_t)c->num_nodos;
+    uint64_t m = (uint64_t)c->num_arcos;
+    c->desp_inicio = sizeof(CabeceraInstantanea);
+    c->desp_destinos = c->desp_inicio + (n + 1) * sizeof(int64_t);
+    uint64_t fin = alinear_8(c->desp_destinos + m * sizeof(int32_t));
+    if (c->banderas & CON_POSICIONES) {
+        c->desp_posiciones = fin;
+        fin += n * sizeof(Coordenada);
+    } else {
+        c->desp_posiciones = 0;
+    }
+    c->tam_total = fin;
+}
+
+bool es_instantanea(const void *datos, size_t tam) {
+    return tam >= sizeof(MAGIA_INSTANTANEA) &&
+           memcmp(datos, MAGIA_INSTANTANEA, sizeof(MAGIA_INSTANTANEA)) == 0;
+}
+
+static bool escribir_seccion(FILE *f, SumaInstantanea *suma, const void *datos, size_t tam) {
+    if (tam == 0) return true;
+    sumar_palabras(suma, datos, tam / 8);
+    return fwrite(datos, 1, tam, f) == tam;
+}
+
+bool guardar_instantanea(const char *ruta, const GrafoCSR *grafo) {
+    CabeceraInstantanea c;
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magia, MAGIA_INSTANTANEA, sizeof(c.magia));
+    c.version = VERSION_INSTANTANEA;
+    c.orden_bytes = MARCA_ORDEN_BYTES;
+    c.num_nodos = grafo->num_nodos;
+    c.tipo = (uint32_t)grafo->tipo;
+    c.num_arcos = grafo->num_arcos;
+    c.banderas = grafo->posiciones ? CON_POSICIONES : 0;
+    calcular_distribucion(&c);
+
+    FILE *f = fopen(ruta, "wb");
+    if (!f) return false;
+
+    // La suma se conoce al final: primero se reserva el lugar de la cabecera
+    SumaInstantanea suma;
+    iniciar_suma(&suma);
+    bool ok = fwrite(&c, sizeof(c), 1, f) == 1;
+
+    uint64_t n = (uint64_t)grafo->num_nodos;
+    uint64_t m = (uint64_t)grafo->num_arcos;
+    ok = ok && escribir_seccion(f, &suma, grafo->inicio, (n + 1) * sizeof(int64_t));
+
+    // Los destinos son de 4 bytes: el último, si queda impar, se completa con ceros
+    size_t tam_pares = (size_t)(m / 2) * 2 * sizeof(int32_t);
+    ok = ok && escribir_seccion(f, &suma, grafo->destinos, tam_pares);
+    if (m % 2 != 0) {
+        int32_t ultimo[2] = {grafo->destinos[m - 1], 0};
+        ok = ok && escribir_seccion(f, &suma, ultimo, sizeof(ultimo));
+    }
+
+    if (grafo->posiciones) {
+        ok = ok && escribir_seccion(f, &suma, grafo->posiciones, (size_t)n * sizeof(Coordenada));
+    }
+
+    c.suma = terminar_suma(&suma);
+    ok = ok && fseek(f, 0, SEEK_SET) == 0 && fwrite(&c, sizeof(c), 1, f) == 1;
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+static bool error_instantanea(ErrorCarga *error, const char *mensaje) {
+    error->linea = 0;
+    error->columna = 0;
+    snprintf(error->mensaje, sizeof(error->mensaje), "%s", mensaje);
+    return false;
+}
+
+// Revisa la cabecera en tiempo constante
+static bool validar_cabecera(const void *datos, size_t tam, const CabeceraInstantanea **cabecera,
+                             ErrorCarga *error) {
+    if (!es_instantanea(datos, tam) || tam < sizeof(CabeceraInstantanea)) {
+        return error_instantanea(error, "El archivo no es una instantánea de grafo");
+    }
+    const CabeceraInstantanea *c = (const CabeceraInstantanea *)datos;
+    if (c->version != VERSION_INSTANTANEA) {
+        return error_instantanea(error, "Versión de instantánea no soportada");
+    }
+    if (c->orden_bytes != MARCA_ORDEN_BYTES) {
+        return error_instantanea(error, "La instantánea se guardó con otro orden de bytes");
+    }
+    if (c->num_nodos < 1 || c->tipo > DIRIGIDO || c->num_arcos < 0 ||
+        (uint64_t)c->num_arcos > (uint64_t)tam / sizeof(int32_t) || (c->banderas & ~CON_POSICIONES) != 0) {
+        return error_instantanea(error, "Cabecera de instantánea inválida");
+    }
+
+    CabeceraInstantanea esperada = *c;
+    calcular_distribucion(&esperada);
+    if (esperada.desp_inicio != c->desp_inicio || esperada.desp_destinos != c->desp_destinos ||
+        esperada.desp_posiciones != c->desp_posiciones || esperada.tam_total != c->tam_total) {
+        return error_instantanea(error, "Cabecera de instantánea inválida");
+    }
+    if (c->tam_total != tam) {
+        return error_instantanea(error, "El tamaño del archivo no coincide con la instantánea");
+    }
+    *cabecera = c;
+    return true;
+}
+
+// Desplazamientos crecientes y destinos en rango: sin esto un archivo dañado con
+// una cabecera válida haría leer fuera de los arreglos. O(V + E), como cualquier
+// recorrido del grafo.
+static bool verificar_arcos(const CabeceraInstantanea *c, ErrorCarga *error) {
+    const char *base = (const char *)c;
+    const int64_t *inicio = (const int64_t *)(base + c->desp_inicio);
+    const int32_t *destinos = (const int32_t *)(base + c->desp_destinos);
+    if (inicio[0] != 0 || inicio[c->num_nodos] != c->num_arcos) {
+        return error_instantanea(error, "Desplazamientos del CSR inválidos");
+    }
+    for (int32_t u = 0; u < c->num_nodos; u++) {
+        if (inicio[u + 1] < inicio[u]) {
+            return error_instantanea(error, "Desplazamientos del CSR inválidos");
+        }
+    }
+    for (int64_t a = 0; a < c->num_arcos; a++) {
+        if ((uint32_t)destinos[a] >= (uint32_t)c->num_nodos) {
+            return error_instantanea(error, "Arco con destino fuera de rango");
+        }
+    }
+    return true;
+}
+
+// Recorre todo el contenido: suma de verificación y arcos consistentes
+static bool verificar_contenido(const CabeceraInstantanea *c, ErrorCarga *error) {
+    const char *base = (const char *)c;
+    SumaInstantanea suma;
+    iniciar_suma(&suma);
+    sumar_palabras(&suma, base + c->desp_inicio, (size_t)(c->tam_total - c->desp_inicio) / 8);
+    if (terminar_suma(&suma) != c->suma) {
+        return error_instantanea(error, "La suma de verificación no coincide: el archivo está dañado");
+    }
+    return verificar_arcos(c, error);
+}
+
+bool leer_instantanea(const void *datos, size_t tam, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    const CabeceraInstantanea *c;
+    if (!validar_cabecera(datos, tam, &c, error)) return false;
+    if (!verificar_contenido(c, error)) return false;
+
+    error->linea = 0;
+    error->columna = 0;
+    error->mensaje[0] = '\0';
+    if (!receptor->encabezado(receptor->datos, c->num_nodos, (TipoGrafo)c->tipo, error)) return false;
+
+    const char *base = (const char *)datos;
+    const int64_t *inicio = (const int64_t *)(base + c->desp_inicio);
+    const int32_t *destinos = (const int32_t *)(base + c->desp_destinos);
+    for (int32_t u = 0; u < c->num_nodos; u++) {
+        for (int64_t a = inicio[u]; a < inicio[u + 1]; a++) {
+            receptor->arista(receptor->datos, u, destinos[a], 1);
+        }
+    }
+    if (c->desp_posiciones && receptor->posicion) {
+        const Coordenada *posiciones = (const Coordenada *)(base + c->desp_posiciones);
+        for (int32_t u = 0; u < c->num_nodos; u++) {
+            receptor->posicion(receptor->datos, u, posiciones[u]);
+        }
+    }
+    return true;
+}
+
+bool abrir_instantanea(const char *ruta, GrafoCSR *grafo, bool verificar, ErrorCarga *error) {
+    memset(grafo, 0, sizeof(*grafo));
+
+    int fd = open(ruta, O_RDONLY);
+    if (fd < 0) {
+        return error_instantanea(error, "No se pudo abrir el archivo");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return error_instantanea(error, "No se pudo leer el tamaño del archivo");
+    }
+    if (info.st_size < (off_t)sizeof(CabeceraInstantanea)) {
+        close(fd);
+        return error_instantanea(error, "El archivo no es una instantánea de grafo");
+    }
+
+    // Copia privada al escribir: el grafo se puede modificar en memoria sin tocar
+    // el archivo, y mientras no se modifique no se copia ninguna página
+    size_t tam = (size_t)info.st_size;
+    void *datos = mmap(NULL, tam, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (datos == MAP_FAILED) {
+        return error_instantanea(error, "No se pudo proyectar el archivo en memoria");
+    }
+
+    const CabeceraInstantanea *c;
+    if (!validar_cabecera(datos, tam, &c, error) ||
+        !(verificar ? verificar_contenido(c, error) : verificar_arcos(c, error))) {
+        munmap(datos, tam);
+        return false;
+    }
+
+    char *base = (char *)datos;
+    grafo->num_nodos = c->num_nodos;
+    grafo->tipo = (TipoGrafo)c->tipo;
+    grafo->num_arcos = c->num_arcos;
+    grafo->inicio = (long long *)(base + c->desp_inicio);
+    grafo->destinos = (int *)(base + c->desp_destinos);
+    grafo->posiciones = c->desp_posiciones ? (Coordenada *)(base + c->desp_posiciones) : NULL;
+    grafo->mapeo = datos;
+    grafo->tam_mapeo = tam;
+    return true;
+}
+
+bool abrir_grafo_csr(const char *ruta, GrafoCSR *grafo, bool verificar, ErrorCarga *error) {
+    char magia[sizeof(MAGIA_INSTANTANEA)];
+    size_t leidos = 0;
+    FILE *f = fopen(ruta, "rb");
+    if (f) {
+        leidos = fread(magia, 1, sizeof(magia), f);
+        fclose(f);
+    }
+    if (es_instantanea(magia, leidos)) {
+        return abrir_instantanea(ruta, grafo, verificar, error);
+    }
+
+    ConstructorCSR constructor;
+    ReceptorGrafo receptor;
+    iniciar_constructor_csr(&constructor, grafo);
+    receptor_grafo_csr(&receptor, &constructor);
+
+    bool cargado = cargar_grafo(ruta, &receptor, error);
+    // Se termina siempre para liberar los arcos acumulados
+    bool construido = terminar_constructor_csr(&constructor);
+    if (cargado && !construido) {
+        error_instantanea(error, "Memoria insuficiente");
+    }
+    if (!cargado || !construido) {
+        liberar_grafo_csr(grafo);
+        return false;
+    }
+    return true;
+}
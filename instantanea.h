@@ -0,0 +1,39 @@
+#ifndef INSTANTANEA_H
+#define INSTANTANEA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cargador.h"
+#include "grafo_csr.h"
+
+// Instantánea binaria de un GrafoCSR (extensión .p4g). Tras la cabecera vienen
+// los arreglos del CSR tal como están en memoria y alineados a 8 bytes, así que
+// un archivo proyectado con mmap se usa directamente como grafo sin copiarlo:
+//
+//   cabecera | inicio[num_nodos + 1] (int64) | destinos[num_arcos] (int32) + relleno
+//            | posiciones[num_nodos] (dos int32, opcional)
+//
+// La suma de verificación cubre todo lo que sigue a la cabecera.
+#define VERSION_INSTANTANEA 1
+
+bool es_instantanea(const void *datos, size_t tam);
+
+bool guardar_instantanea(const char *ruta, const GrafoCSR *grafo);
+
+// Proyecta la instantánea y deja el grafo apuntando al archivo. Siempre se
+// revisan la cabecera y que los arcos sean consistentes (desplazamientos
+// crecientes, destinos en rango), en una pasada que solo lee los arreglos; con
+// 'verificar' también la suma de todo el contenido. liberar_grafo_csr libera la
+// proyección.
+bool abrir_instantanea(const char *ruta, GrafoCSR *grafo, bool verificar, ErrorCarga *error);
+
+// Verifica la instantánea ya proyectada por el cargador y entrega su contenido
+// al receptor, igual que los formatos de texto
+bool leer_instantanea(const void *datos, size_t tam, const ReceptorGrafo *receptor, ErrorCarga *error);
+
+// Abre cualquier formato como GrafoCSR: las instantáneas se proyectan (con
+// 'verificar' como en abrir_instantanea) y los formatos de texto se cargan con
+// el constructor
+bool abrir_grafo_csr(const char *ruta, GrafoCSR *grafo, bool verificar, ErrorCarga *error);
+
+#endif
@@ -0,0 +1,1051 @@
+#include "intercambio.h"
+
+#include <limits.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "buffer_texto.h"
+
+#define TAM_BLOQUE_LECTURA (1 << 16)
+
+// Lectura por bloques con la posición del último carácter consumido
+typedef struct {
+    FILE *archivo;
+    char *bloque;
+    size_t pos;
+    size_t len;
+    int linea;
+    int columna;
+} Flujo;
+
+static int mirar(Flujo *f) {
+    if (f->pos == f->len) {
+        f->len = fread(f->bloque, 1, TAM_BLOQUE_LECTURA, f->archivo);
+        f->pos = 0;
+        if (f->len == 0) return EOF;
+    }
+    return (unsigned char)f->bloque[f->pos];
+}
+
+static int consumir(Flujo *f) {
+    int c = mirar(f);
+    if (c == EOF) return EOF;
+    f->pos++;
+    if (c == '\n') {
+        f->linea++;
+        f->columna = 1;
+    } else {
+        f->columna++;
+    }
+    return c;
+}
+
+// Deja el texto terminado en '\0' aunque esté vacío (datos nunca queda en NULL)
+static void terminar_texto(BufferTexto *b) {
+    if (buffer_reservar(b, 0)) {
+        b->datos[b->longitud] = '\0';
+    }
+}
+
+static void rebobinar(Flujo *f) {
+    rewind(f->archivo);
+    f->pos = 0;
+    f->len = 0;
+    f->linea = 1;
+    f->columna = 1;
+}
+
+// Nombres de nodo -> índice, en el orden en que aparecen por primera vez.
+// Direccionamiento abierto sobre un arreglo de ranuras; los nombres se guardan
+// seguidos en un solo buffer.
+typedef struct {
+    BufferTexto nombres;
+    size_t *desplazamientos;
+    int num;
+    int capacidad;
+    int *ranuras;       // -1 si está libre
+    size_t num_ranuras; // Potencia de 2
+} TablaNombres;
+
+static uint64_t dispersar(const char *texto, size_t n) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ (unsigned char)texto[i]) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+static const char *nombre_de(const TablaNombres *t, int indice) {
+    return t->nombres.datos + t->desplazamientos[indice];
+}
+
+static size_t ranura_de(const TablaNombres *t, const char *texto, size_t n) {
+    size_t mascara = t->num_ranuras - 1;
+    size_t r = (size_t)dispersar(texto, n) & mascara;
+    while (t->ranuras[r] >= 0) {
+        const char *nombre = nombre_de(t, t->ranuras[r]);
+        if (strncmp(nombre, texto, n) == 0 && nombre[n] == '\0') break;
+        r = (r + 1) & mascara;
+    }
+    return r;
+}
+
+static bool agrandar_ranuras(TablaNombres *t) {
+    size_t nuevas = t->num_ranuras ? t->num_ranuras * 2 : 1024;
+    int *ranuras = malloc(nuevas * sizeof(int));
+    if (!ranuras) return false;
+    memset(ranuras, -1, nuevas * sizeof(int));
+
+    free(t->ranuras);
+    t->ranuras = ranuras;
+    t->num_ranuras = nuevas;
+    for (int i = 0; i < t->num; i++) {
+        const char *nombre = nombre_de(t, i);
+        t->ranuras[ranura_de(t, nombre, strlen(nombre))] = i;
+    }
+    return true;
+}
+
+static int buscar_nombre(const TablaNombres *t, const char *texto, size_t n) {
+    if (t->num_ranuras == 0) return -1;
+    return t->ranuras[ranura_de(t, texto, n)];
+}
+
+// Devuelve el índice del nombre (nuevo o existente); -1 si falta memoria
+static int registrar_nombre(TablaNombres *t, const char *texto, size_t n, bool *nuevo) {
+    *nuevo = false;
+    int indice = buscar_nombre(t, texto, n);
+    if (indice >= 0) return indice;
+    if (t->num == INT_MAX - 1) return -1;
+
+    if ((size_t)(t->num + 1) * 2 > t->num_ranuras && !agrandar_ranuras(t)) return -1;
+    if (t->num == t->capacidad) {
+        int capacidad = t->capacidad ? t->capacidad * 2 : 1024;
+        size_t *desplazamientos = realloc(t->desplazamientos, (size_t)capacidad * sizeof(size_t));
+        if (!desplazamientos) return -1;
+        t->desplazamientos = desplazamientos;
+        t->capacidad = capacidad;
+    }
+
+    t->desplazamientos[t->num] = t->nombres.longitud;
+    buffer_agregar_n(&t->nombres, texto, n);
+    buffer_agregar_caracter(&t->nombres, '\0');
+    if (t->nombres.error) return -1;
+
+    t->ranuras[ranura_de(t, texto, n)] = t->num;
+    *nuevo = true;
+    return t->num++;
+}
+
+static void liberar_tabla(TablaNombres *t) {
+    buffer_liberar(&t->nombres);
+    free(t->desplazamientos);
+    free(t->ranuras);
+}
+
+// Estado común a los dos importadores
+typedef struct {
+    Flujo flujo;
+    TablaNombres nodos;
+    Coordenada *posiciones;     // Crece junto con la tabla en la primera pasada
+    int capacidad_posiciones;
+    bool hay_posiciones;
+    TipoGrafo tipo;
+    int pasada;                 // 1: nodos y posiciones, 2: aristas
+    const ReceptorGrafo *receptor;
+    ErrorCarga *error;
+    BufferTexto texto;          // Token o texto actual
+} Importador;
+
+static bool fallar(Importador *imp, int linea, int columna, const char *formato, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static bool fallar(Importador *imp, int linea, int columna, const char *formato, ...) {
+    imp->error->linea = linea;
+    imp->error->columna = columna;
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(imp->error->mensaje, sizeof(imp->error->mensaje), formato, args);
+    va_end(args);
+    return false;
+}
+
+// Registra un nodo en la primera pasada. Con 'unico', repetir el nombre es un
+// error (GraphML exige un id distinto por nodo).
+static int registrar_nodo(Importador *imp, const char *nombre, size_t n, bool unico,
+                          int linea, int columna) {
+    bool nuevo;
+    int indice = registrar_nombre(&imp->nodos, nombre, n, &nuevo);
+    if (indice < 0) {
+        fallar(imp, linea, columna, "Memoria insuficiente para los nodos");
+        return -1;
+    }
+    if (!nuevo && unico) {
+        fallar(imp, linea, columna, "Nodo '%.*s' repetido", (int)n, nombre);
+        return -1;
+    }
+    if (nuevo && indice >= imp->capacidad_posiciones) {
+        int capacidad = imp->capacidad_posiciones ? imp->capacidad_posiciones * 2 : 1024;
+        Coordenada *posiciones = realloc(imp->posiciones, (size_t)capacidad * sizeof(Coordenada));
+        if (!posiciones) {
+            fallar(imp, linea, columna, "Memoria insuficiente para los nodos");
+            return -1;
+        }
+        imp->posiciones = posiciones;
+        imp->capacidad_posiciones = capacidad;
+    }
+    if (nuevo) {
+        imp->posiciones[indice].x = 0;
+        imp->posiciones[indice].y = 0;
+    }
+    return indice;
+}
+
+static int nodo_existente(Importador *imp, const char *nombre, size_t n, int linea, int columna) {
+    int indice = buscar_nombre(&imp->nodos, nombre, n);
+    if (indice < 0) {
+        fallar(imp, linea, columna, "Nodo '%.*s' no declarado", (int)n, nombre);
+    }
+    return indice;
+}
+
+// Misma convención que el cargador: en grafos no dirigidos cada arista llega
+// en ambos sentidos
+static void emitir_arista(Importador *imp, int u, int v) {
+    const ReceptorGrafo *r = imp->receptor;
+    r->arista(r->datos, u, v, 1);
+    if (imp->tipo == NO_DIRIGIDO && u != v) {
+        r->arista(r->datos, v, u, 1);
+    }
+}
+
+// Coordenada decimal redondeada al entero más cercano, como en el cargador.
+// 'fin' queda después del número.
+static bool convertir_coordenada(const char *texto, int *valor, const char **fin) {
+    char *resto;
+    double v = strtod(texto, &resto);
+    if (resto == texto || v != v || v > INT_MAX - 1 || v < INT_MIN + 1) return false;
+    *valor = v < 0 ? -(int)(-v + 0.5) : (int)(v + 0.5);
+    if (fin) *fin = resto;
+    return true;
+}
+
+static bool ejecutar_importador(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error,
+                                bool (*analizar)(Importador *)) {
+    Importador imp;
+    memset(&imp, 0, sizeof(imp));
+    imp.receptor = receptor;
+    imp.error = error;
+    imp.tipo = NO_DIRIGIDO;
+    buffer_iniciar(&imp.nodos.nombres);
+    buffer_iniciar(&imp.texto);
+
+    imp.flujo.archivo = fopen(ruta, "rb");
+    if (!imp.flujo.archivo) {
+        return fallar(&imp, 0, 0, "No se pudo abrir el archivo");
+    }
+    imp.flujo.bloque = malloc(TAM_BLOQUE_LECTURA);
+    bool ok = imp.flujo.bloque != NULL;
+    if (!ok) fallar(&imp, 0, 0, "Memoria insuficiente");
+
+    if (ok) {
+        rebobinar(&imp.flujo);
+        imp.pasada = 1;
+        ok = analizar(&imp);
+    }
+    if (ok && imp.nodos.num == 0) {
+        ok = fallar(&imp, imp.flujo.linea, imp.flujo.columna, "El grafo no tiene nodos");
+    }
+    if (ok) {
+        error->linea = 0;
+        error->columna = 0;
+        error->mensaje[0] = '\0';
+        ok = receptor->encabezado(receptor->datos, imp.nodos.num, imp.tipo, error);
+    }
+    if (ok) {
+        rebobinar(&imp.flujo);
+        imp.pasada = 2;
+        ok = analizar(&imp);
+    }
+    if (ok && imp.hay_posiciones && receptor->posicion) {
+        for (int i = 0; i < imp.nodos.num; i++) {
+            receptor->posicion(receptor->datos, i, imp.posiciones[i]);
+        }
+    }
+
+    free(imp.flujo.bloque);
+    fclose(imp.flujo.archivo);
+    liberar_tabla(&imp.nodos);
+    free(imp.posiciones);
+    buffer_liberar(&imp.texto);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// GraphML
+
+#define MAX_ATRIBUTOS_XML 16
+
+// Atributos de la etiqueta actual; los valores están en 'valores' separados por '\0'
+typedef struct {
+    BufferTexto valores;
+    size_t nombre[MAX_ATRIBUTOS_XML];
+    size_t valor[MAX_ATRIBUTOS_XML];
+    int num;
+} AtributosXml;
+
+typedef struct {
+    Importador *imp;
+    AtributosXml atributos;
+    BufferTexto etiqueta;
+    BufferTexto clave_x;        // id de la clave con attr.name="x"
+    BufferTexto clave_y;
+    int nodo_actual;            // Nodo abierto, o -1
+    int coordenada;             // 0: ninguna, 1: x, 2: y (dentro de <data>)
+    int linea_dato;
+    int columna_dato;
+    int grafos_abiertos;
+} LectorGraphml;
+
+static bool es_espacio_xml(int c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static bool es_caracter_nombre(int c) {
+    return c != EOF && !es_espacio_xml(c) && c != '=' && c != '>' && c != '/' && c != '<' &&
+           c != '"' && c != '\'';
+}
+
+static const char *atributo(const LectorGraphml *g, const char *nombre) {
+    const AtributosXml *a = &g->atributos;
+    for (int i = 0; i < a->num; i++) {
+        if (strcmp(a->valores.datos + a->nombre[i], nombre) == 0) {
+            return a->valores.datos + a->valor[i];
+        }
+    }
+    return NULL;
+}
+
+// Salta hasta consumir 'fin' (por ejemplo "-->")
+// Caracteres de 'fin' ya vistos tras leer c. Los terminadores de XML ("?>", "-->",
+// "]]>") repiten solo su primer carácter, así que ante un fallo con ese carácter
+// la coincidencia se mantiene si todo lo visto era ese carácter ("]]]>" cierra)
+static size_t avanzar_coincidencia(const char *fin, size_t coincidencia, int c) {
+    if (c == fin[coincidencia]) return coincidencia + 1;
+    if (c != fin[0]) return 0;
+    return coincidencia > 0 && fin[coincidencia - 1] == fin[0] ? coincidencia : 1;
+}
+
+static bool saltar_hasta(Importador *imp, const char *fin, int linea, int columna, const char *que) {
+    size_t n = strlen(fin);
+    size_t coincidencia = 0;
+    for (;;) {
+        int c = consumir(&imp->flujo);
+        if (c == EOF) {
+            return fallar(imp, linea, columna, "%s sin cerrar", que);
+        }
+        coincidencia = avanzar_coincidencia(fin, coincidencia, c);
+        if (coincidencia == n) return true;
+    }
+}
+
+// Agrega un carácter del documento decodificando las entidades XML básicas
+// (&lt; &gt; &amp; &quot; &apos; y &#N;); las demás se copian tal cual
+static void agregar_con_entidades(Flujo *f, BufferTexto *b, int c) {
+    if (c != '&') {
+        buffer_agregar_caracter(b, (char)c);
+        return;
+    }
+    char entidad[12];
+    size_t n = 0;
+    while (n + 1 < sizeof(entidad) && mirar(f) != ';' && mirar(f) != EOF && !es_espacio_xml(mirar(f)) &&
+           mirar(f) != '<') {
+        entidad[n++] = (char)consumir(f);
+    }
+    entidad[n] = '\0';
+    bool cerrada = mirar(f) == ';';
+    if (cerrada) consumir(f);
+
+    char simple = 0;
+    if (cerrada) {
+        if (strcmp(entidad, "lt") == 0) simple = '<';
+        else if (strcmp(entidad, "gt") == 0) simple = '>';
+        else if (strcmp(entidad, "amp") == 0) simple = '&';
+        else if (strcmp(entidad, "quot") == 0) simple = '"';
+        else if (strcmp(entidad, "apos") == 0) simple = '\'';
+        else if (entidad[0] == '#') {
+            long codigo = entidad[1] == 'x' ? strtol(entidad + 2, NULL, 16) : strtol(entidad + 1, NULL, 10);
+            if (codigo > 0 && codigo < 128) simple = (char)codigo;
+        }
+    }
+    if (simple) {
+        buffer_agregar_caracter(b, simple);
+    } else {
+        buffer_agregar_caracter(b, '&');
+        buffer_agregar_n(b, entidad, n);
+        if (cerrada) buffer_agregar_caracter(b, ';');
+    }
+}
+
+static void saltar_espacios_xml(Flujo *f) {
+    while (es_espacio_xml(mirar(f))) consumir(f);
+}
+
+static void leer_nombre_xml(Flujo *f, BufferTexto *b) {
+    buffer_vaciar(b);
+    while (es_caracter_nombre(mirar(f))) {
+        buffer_agregar_caracter(b, (char)consumir(f));
+    }
+    terminar_texto(b);
+}
+
+// Lee los atributos hasta '>' o "/>". Devuelve false ante un error de sintaxis.
+static bool leer_atributos_xml(LectorGraphml *g, bool *autocerrada, int linea, int columna) {
+    Importador *imp = g->imp;
+    Flujo *f = &imp->flujo;
+    AtributosXml *a = &g->atributos;
+    buffer_vaciar(&a->valores);
+    a->num = 0;
+    *autocerrada = false;
+
+    for (;;) {
+        saltar_espacios_xml(f);
+        int c = mirar(f);
+        if (c == '>') {
+            consumir(f);
+            return true;
+        }
+        if (c == '/') {
+            consumir(f);
+            if (consumir(f) != '>') break;
+            *autocerrada = true;
+            return true;
+        }
+        if (!es_caracter_nombre(c)) break;
+
+        size_t nombre = a->valores.longitud;
+        while (es_caracter_nombre(mirar(f))) {
+            buffer_agregar_caracter(&a->valores, (char)consumir(f));
+        }
+        buffer_agregar_caracter(&a->valores, '\0');
+        saltar_espacios_xml(f);
+        if (consumir(f) != '=') break;
+        saltar_espacios_xml(f);
+        int comilla = consumir(f);
+        if (comilla != '"' && comilla != '\'') break;
+
+        size_t valor = a->valores.longitud;
+        for (;;) {
+            c = consumir(f);
+            if (c == EOF) return fallar(imp, linea, columna, "Etiqueta sin cerrar");
+            if (c == comilla) break;
+            agregar_con_entidades(f, &a->valores, c);
+        }
+        buffer_agregar_caracter(&a->valores, '\0');
+        if (a->num < MAX_ATRIBUTOS_XML) {
+            a->nombre[a->num] = nombre;
+            a->valor[a->num] = valor;
+            a->num++;
+        }
+    }
+    if (mirar(f) == EOF) {
+        return fallar(imp, linea, columna, "Etiqueta sin cerrar");
+    }
+    return fallar(imp, f->linea, f->columna, "Atributo mal formado en la etiqueta");
+}
+
+static bool requerir_atributo(LectorGraphml *g, const char *nombre, const char **valor,
+                              int linea, int columna) {
+    *valor = atributo(g, nombre);
+    if (!*valor) {
+        return fallar(g->imp, linea, columna, "Falta el atributo '%s' en <%s>", nombre, g->etiqueta.datos);
+    }
+    return true;
+}
+
+static void copiar_texto(BufferTexto *destino, const char *texto) {
+    buffer_vaciar(destino);
+    buffer_agregar(destino, texto);
+}
+
+static bool abrir_elemento(LectorGraphml *g, bool autocerrada, int linea, int columna) {
+    Importador *imp = g->imp;
+    const char *nombre = g->etiqueta.datos;
+
+    if (strcmp(nombre, "key") == 0) {
+        const char *para = atributo(g, "for");
+        const char *id = atributo(g, "id");
+        const char *nombre_atributo = atributo(g, "attr.name");
+        if (id && nombre_atributo && (!para || strcmp(para, "node") == 0 || strcmp(para, "all") == 0)) {
+            if (strcmp(nombre_atributo, "x") == 0) copiar_texto(&g->clave_x, id);
+            if (strcmp(nombre_atributo, "y") == 0) copiar_texto(&g->clave_y, id);
+        }
+    } else if (strcmp(nombre, "graph") == 0) {
+        if (++g->grafos_abiertos > 1) {
+            return fallar(imp, linea, columna, "Los grafos anidados no están soportados");
+        }
+        const char *tipo = atributo(g, "edgedefault");
+        imp->tipo = tipo && strcmp(tipo, "directed") == 0 ? DIRIGIDO : NO_DIRIGIDO;
+        if (autocerrada) g->grafos_abiertos--;
+    } else if (strcmp(nombre, "node") == 0) {
+        const char *id;
+        if (!requerir_atributo(g, "id", &id, linea, columna)) return false;
+        int indice = imp->pasada == 1 ? registrar_nodo(imp, id, strlen(id), true, linea, columna)
+                                      : nodo_existente(imp, id, strlen(id), linea, columna);
+        if (indice < 0) return false;
+        g->nodo_actual = autocerrada ? -1 : indice;
+    } else if (strcmp(nombre, "edge") == 0) {
+        const char *origen, *destino;
+        if (!requerir_atributo(g, "source", &origen, linea, columna)) return false;
+        if (!requerir_atributo(g, "target", &destino, linea, columna)) return false;
+        // 'directed' cambia el sentido por arista. Una no dirigida en un grafo
+        // dirigido son dos arcos; una dirigida en uno no dirigido no se puede
+        // representar, así que se rechaza
+        const char *dirigida = atributo(g, "directed");
+        bool doble = dirigida && strcmp(dirigida, "false") == 0 && imp->tipo == DIRIGIDO;
+        if (dirigida && strcmp(dirigida, "true") == 0 && imp->tipo == NO_DIRIGIDO) {
+            return fallar(imp, linea, columna,
+                          "Arista dirigida en un grafo no dirigido: los grafos mixtos no están soportados");
+        }
+        if (imp->pasada == 2) {
+            int u = nodo_existente(imp, origen, strlen(origen), linea, columna);
+            if (u < 0) return false;
+            int v = nodo_existente(imp, destino, strlen(destino), linea, columna);
+            if (v < 0) return false;
+            emitir_arista(imp, u, v);
+            if (doble && u != v) emitir_arista(imp, v, u);
+        }
+    } else if (strcmp(nombre, "data") == 0 && !autocerrada && g->nodo_actual >= 0 && imp->pasada == 1) {
+        const char *clave = atributo(g, "key");
+        g->coordenada = 0;
+        if (clave && g->clave_x.datos && strcmp(clave, g->clave_x.datos) == 0) g->coordenada = 1;
+        if (clave && g->clave_y.datos && strcmp(clave, g->clave_y.datos) == 0) g->coordenada = 2;
+        g->linea_dato = linea;
+        g->columna_dato = columna;
+        buffer_vaciar(&imp->texto);
+    }
+    return true;
+}
+
+static bool cerrar_elemento(LectorGraphml *g) {
+    Importador *imp = g->imp;
+    const char *nombre = g->etiqueta.datos;
+
+    if (strcmp(nombre, "node") == 0) {
+        g->nodo_actual = -1;
+    } else if (strcmp(nombre, "graph") == 0) {
+        g->grafos_abiertos--;
+    } else if (strcmp(nombre, "data") == 0 && g->coordenada != 0) {
+        terminar_texto(&imp->texto);
+        int valor;
+        const char *fin;
+        const char *texto = imp->texto.datos ? imp->texto.datos : "";
+        if (!convertir_coordenada(texto, &valor, &fin) || strspn(fin, " \t\r\n") != strlen(fin)) {
+            return fallar(imp, g->linea_dato, g->columna_dato, "Coordenada inválida '%s'", texto);
+        }
+        if (g->coordenada == 1) {
+            imp->posiciones[g->nodo_actual].x = valor;
+        } else {
+            imp->posiciones[g->nodo_actual].y = valor;
+        }
+        imp->hay_posiciones = true;
+        g->coordenada = 0;
+    }
+    return true;
+}
+
+static bool analizar_graphml_pasada(LectorGraphml *g) {
+    Importador *imp = g->imp;
+    Flujo *f = &imp->flujo;
+    g->nodo_actual = -1;
+    g->coordenada = 0;
+    g->grafos_abiertos = 0;
+
+    for (;;) {
+        int c = consumir(f);
+        if (c == EOF) break;
+        if (c != '<') {
+            if (g->coordenada != 0) agregar_con_entidades(f, &imp->texto, c);
+            continue;
+        }
+
+        int linea = f->linea;
+        int columna = f->columna - 1;
+        c = mirar(f);
+        if (c == '?') {
+            if (!saltar_hasta(imp, "?>", linea, columna, "Instrucción de procesamiento")) return false;
+        } else if (c == '!') {
+            consumir(f);
+            if (mirar(f) == '-') {
+                consumir(f);
+                if (consumir(f) != '-') return fallar(imp, linea, columna, "Comentario mal formado");
+                if (!saltar_hasta(imp, "-->", linea, columna, "Comentario")) return false;
+            } else if (mirar(f) == '[') {
+                // <![CDATA[ ... ]]>: el contenido es texto literal
+                const char *cdata = "[CDATA[";
+                for (const char *p = cdata; *p; p++) {
+                    if (consumir(f) != *p) return fallar(imp, linea, columna, "Sección CDATA mal formada");
+                }
+                size_t coincidencia = 0;
+                for (;;) {
+                    c = consumir(f);
+                    if (c == EOF) return fallar(imp, linea, columna, "Sección CDATA sin cerrar");
+                    if (g->coordenada != 0) buffer_agregar_caracter(&imp->texto, (char)c);
+                    coincidencia = avanzar_coincidencia("]]>", coincidencia, c);
+                    if (coincidencia == 3) break;
+                }
+                if (g->coordenada != 0) imp->texto.longitud -= 3;
+            } else {
+                if (!saltar_hasta(imp, ">", linea, columna, "Declaración")) return false;
+            }
+        } else if (c == '/') {
+            consumir(f);
+            leer_nombre_xml(f, &g->etiqueta);
+            saltar_espacios_xml(f);
+            if (consumir(f) != '>') return fallar(imp, linea, columna, "Etiqueta de cierre mal formada");
+            if (!cerrar_elemento(g)) return false;
+        } else {
+            leer_nombre_xml(f, &g->etiqueta);
+            if (g->etiqueta.longitud == 0) return fallar(imp, linea, columna, "Etiqueta sin nombre");
+            bool autocerrada;
+            if (!leer_atributos_xml(g, &autocerrada, linea, columna)) return false;
+            if (!abrir_elemento(g, autocerrada, linea, columna)) return false;
+        }
+        if (imp->texto.error || g->atributos.valores.error) {
+            return fallar(imp, linea, columna, "Memoria insuficiente");
+        }
+    }
+    return true;
+}
+
+static bool analizar_graphml(Importador *imp) {
+    LectorGraphml g;
+    memset(&g, 0, sizeof(g));
+    g.imp = imp;
+    buffer_iniciar(&g.atributos.valores);
+    buffer_iniciar(&g.etiqueta);
+    buffer_iniciar(&g.clave_x);
+    buffer_iniciar(&g.clave_y);
+
+    bool ok = analizar_graphml_pasada(&g);
+
+    buffer_liberar(&g.atributos.valores);
+    buffer_liberar(&g.etiqueta);
+    buffer_liberar(&g.clave_x);
+    buffer_liberar(&g.clave_y);
+    return ok;
+}
+
+bool cargar_graphml(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    return ejecutar_importador(ruta, receptor, error, analizar_graphml);
+}
+
+// ---------------------------------------------------------------------------
+// DOT
+
+typedef enum {
+    TOKEN_FIN,
+    TOKEN_ID,           // Identificador, número, "cadena" o <html>
+    TOKEN_ARISTA,       // -- o ->
+    TOKEN_SIMBOLO       // { } [ ] = ; , :
+} ClaseToken;
+
+// Aristas ya emitidas de un grafo 'strict', con direccionamiento abierto. La
+// clave es el par empaquetado más 1, así que 0 marca un hueco aunque haya lazos.
+typedef struct {
+    uint64_t *claves;
+    size_t num;
+    size_t num_ranuras; // Potencia de 2
+} ConjuntoAristas;
+
+static size_t ranura_arista(const ConjuntoAristas *c, uint64_t clave) {
+    size_t mascara = c->num_ranuras - 1;
+    size_t r = (size_t)((clave * 0x9E3779B97F4A7C15ull) >> 32) & mascara;
+    while (c->claves[r] != 0 && c->claves[r] != clave) {
+        r = (r + 1) & mascara;
+    }
+    return r;
+}
+
+static bool agrandar_aristas(ConjuntoAristas *c) {
+    size_t nuevas = c->num_ranuras ? c->num_ranuras * 2 : 1024;
+    uint64_t *claves = calloc(nuevas, sizeof(uint64_t));
+    if (!claves) return false;
+
+    uint64_t *anteriores = c->claves;
+    size_t num_anteriores = c->num_ranuras;
+    c->claves = claves;
+    c->num_ranuras = nuevas;
+    for (size_t i = 0; i < num_anteriores; i++) {
+        if (anteriores[i] != 0) c->claves[ranura_arista(c, anteriores[i])] = anteriores[i];
+    }
+    free(anteriores);
+    return true;
+}
+
+// Registra la arista u-v (en grafos no dirigidos sin importar el sentido) y dice
+// si era nueva. false si falta memoria.
+static bool registrar_arista(ConjuntoAristas *c, int u, int v, TipoGrafo tipo, bool *nueva) {
+    if (tipo == NO_DIRIGIDO && u > v) {
+        int t = u;
+        u = v;
+        v = t;
+    }
+    if ((c->num + 1) * 2 > c->num_ranuras && !agrandar_aristas(c)) return false;
+    uint64_t clave = ((uint64_t)(uint32_t)u << 32 | (uint32_t)v) + 1;
+    size_t r = ranura_arista(c, clave);
+    *nueva = c->claves[r] == 0;
+    if (*nueva) {
+        c->claves[r] = clave;
+        c->num++;
+    }
+    return true;
+}
+
+typedef struct {
+    Importador *imp;
+    ClaseToken clase;
+    char simbolo;       // Para TOKEN_SIMBOLO, o '-'/'>' para TOKEN_ARISTA
+    bool entre_comillas;
+    int linea;
+    int columna;
+    BufferTexto nombre;     // Copia de un ID mientras se lee el siguiente token
+    bool estricto;          // 'strict': las aristas repetidas se unen en una
+    ConjuntoAristas aristas;
+} LectorDot;
+
+static bool es_letra_dot(int c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c >= 0x80;
+}
+
+static bool es_digito_dot(int c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool es_palabra(const LectorDot *d, const char *palabra) {
+    if (d->clase != TOKEN_ID || d->entre_comillas) return false;
+    const char *texto = d->imp->texto.datos;
+    size_t i = 0;
+    for (; palabra[i]; i++) {
+        char c = texto[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (c != palabra[i]) return false;
+    }
+    return texto[i] == '\0';
+}
+
+static bool es_simbolo(const LectorDot *d, char simbolo) {
+    return d->clase == TOKEN_SIMBOLO && d->simbolo == simbolo;
+}
+
+// Espacios y comentarios: // y /* */, y las líneas '#' del preprocesador
+static bool saltar_separadores_dot(LectorDot *d) {
+    Flujo *f = &d->imp->flujo;
+    // El '#' solo abre una línea del preprocesador si antes hay solo espacios
+    bool inicio_de_linea = f->columna == 1;
+    for (;;) {
+        int c = mirar(f);
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            consumir(f);
+            if (c == '\n') inicio_de_linea = true;
+        } else if (c == '#' && inicio_de_linea) {
+            while (mirar(f) != '\n' && mirar(f) != EOF) consumir(f);
+        } else if (c == '/') {
+            int linea = f->linea, columna = f->columna;
+            consumir(f);
+            c = consumir(f);
+            if (c == '/') {
+                while (mirar(f) != '\n' && mirar(f) != EOF) consumir(f);
+            } else if (c == '*') {
+                if (!saltar_hasta(d->imp, "*/", linea, columna, "Comentario")) return false;
+                inicio_de_linea = false;
+            } else {
+                return fallar(d->imp, linea, columna, "Carácter inesperado '/'");
+            }
+        } else {
+            return true;
+        }
+    }
+}
+
+static bool siguiente_token(LectorDot *d) {
+    Importador *imp = d->imp;
+    Flujo *f = &imp->flujo;
+    if (!saltar_separadores_dot(d)) return false;
+
+    d->linea = f->linea;
+    d->columna = f->columna;
+    d->entre_comillas = false;
+    buffer_vaciar(&imp->texto);
+
+    int c = mirar(f);
+    if (c == EOF) {
+        d->clase = TOKEN_FIN;
+        return true;
+    }
+    if (strchr("{}[]=;,:", c)) {
+        consumir(f);
+        d->clase = TOKEN_SIMBOLO;
+        d->simbolo = (char)c;
+        return true;
+    }
+
+    d->clase = TOKEN_ID;
+    if (c == '-') {
+        consumir(f);
+        if (mirar(f) == '-' || mirar(f) == '>') {
+            d->clase = TOKEN_ARISTA;
+            d->simbolo = (char)consumir(f);
+            return true;
+        }
+        buffer_agregar_caracter(&imp->texto, '-');
+        c = mirar(f);
+        if (!es_digito_dot(c) && c != '.') {
+            return fallar(imp, d->linea, d->columna, "Carácter inesperado '-'");
+        }
+    }
+
+    if (c == '"') {
+        consumir(f);
+        d->entre_comillas = true;
+        for (;;) {
+            c = consumir(f);
+            if (c == EOF) return fallar(imp, d->linea, d->columna, "Cadena sin cerrar");
+            if (c == '"') break;
+            if (c == '\\') {
+                int escapado = consumir(f);
+                if (escapado == '\n') continue;  // Continuación de línea
+                if (escapado != '"') buffer_agregar_caracter(&imp->texto, '\\');
+                if (escapado != EOF) buffer_agregar_caracter(&imp->texto, (char)escapado);
+                continue;
+            }
+            buffer_agregar_caracter(&imp->texto, (char)c);
+        }
+    } else if (c == '<') {
+        consumir(f);
+        int profundidad = 1;
+        d->entre_comillas = true;
+        for (;;) {
+            c = consumir(f);
+            if (c == EOF) return fallar(imp, d->linea, d->columna, "Cadena HTML sin cerrar");
+            if (c == '<') profundidad++;
+            if (c == '>' && --profundidad == 0) break;
+            buffer_agregar_caracter(&imp->texto, (char)c);
+        }
+    } else if (es_digito_dot(c) || c == '.') {
+        while (es_digito_dot(mirar(f)) || mirar(f) == '.') {
+            buffer_agregar_caracter(&imp->texto, (char)consumir(f));
+        }
+    } else if (es_letra_dot(c)) {
+        while (es_letra_dot(mirar(f)) || es_digito_dot(mirar(f))) {
+            buffer_agregar_caracter(&imp->texto, (char)consumir(f));
+        }
+    } else {
+        return fallar(imp, d->linea, d->columna, "Carácter inesperado '%c'", c);
+    }
+
+    terminar_texto(&imp->texto);
+    if (imp->texto.error) return fallar(imp, d->linea, d->columna, "Memoria insuficiente");
+    return true;
+}
+
+static bool esperar_simbolo(LectorDot *d, char simbolo) {
+    if (!es_simbolo(d, simbolo)) {
+        return fallar(d->imp, d->linea, d->columna, "Se esperaba '%c'", simbolo);
+    }
+    return siguiente_token(d);
+}
+
+static bool esperar_id(LectorDot *d, const char *que) {
+    if (d->clase != TOKEN_ID) {
+        return fallar(d->imp, d->linea, d->columna, "Se esperaba %s", que);
+    }
+    return true;
+}
+
+// "x,y" o "x,y!" (coordenada fija en Graphviz)
+static bool leer_pos_dot(LectorDot *d, int nodo) {
+    Importador *imp = d->imp;
+    const char *texto = imp->texto.datos;
+    const char *resto;
+    Coordenada pos;
+    if (!convertir_coordenada(texto, &pos.x, &resto) || *resto != ',' ||
+        !convertir_coordenada(resto + 1, &pos.y, &resto) || (*resto != '\0' && *resto != '!' && *resto != ',')) {
+        return fallar(imp, d->linea, d->columna, "Posición inválida '%s' (se esperaba \"x,y\")", texto);
+    }
+    imp->posiciones[nodo] = pos;
+    imp->hay_posiciones = true;
+    return true;
+}
+
+// Listas [a=b, c=d][...]. Solo interesa "pos" de los nodos en la primera pasada.
+static bool leer_lista_atributos(LectorDot *d, int nodo) {
+    while (es_simbolo(d, '[')) {
+        if (!siguiente_token(d)) return false;
+        while (!es_simbolo(d, ']')) {
+            if (!esperar_id(d, "un atributo o ']'")) return false;
+            bool es_pos = es_palabra(d, "pos");
+            if (!siguiente_token(d)) return false;
+            if (es_simbolo(d, '=')) {
+                if (!siguiente_token(d)) return false;
+                if (!esperar_id(d, "el valor del atributo")) return false;
+                if (es_pos && nodo >= 0 && !leer_pos_dot(d, nodo)) return false;
+                if (!siguiente_token(d)) return false;
+            }
+            if (es_simbolo(d, ';') || es_simbolo(d, ',')) {
+                if (!siguiente_token(d)) return false;
+            }
+        }
+        if (!siguiente_token(d)) return false;
+    }
+    return true;
+}
+
+// Puerto opcional tras un nodo ("a:n" o "a:p:n"); no cambia el grafo
+static bool saltar_puerto(LectorDot *d) {
+    for (int i = 0; i < 2 && es_simbolo(d, ':'); i++) {
+        if (!siguiente_token(d)) return false;
+        if (!esperar_id(d, "un puerto")) return false;
+        if (!siguiente_token(d)) return false;
+    }
+    return true;
+}
+
+// Nodo del token actual: se registra en la primera pasada y se busca en la segunda
+static int nodo_del_token(LectorDot *d) {
+    Importador *imp = d->imp;
+    const char *nombre = imp->texto.datos;
+    size_t n = imp->texto.longitud;
+    if (imp->pasada == 1) {
+        return registrar_nodo(imp, nombre, n, false, d->linea, d->columna);
+    }
+    return nodo_existente(imp, nombre, n, d->linea, d->columna);
+}
+
+static bool analizar_sentencias_dot(LectorDot *d, int profundidad);
+
+static bool analizar_sentencia_dot(LectorDot *d, int profundidad) {
+    Importador *imp = d->imp;
+
+    if (es_palabra(d, "graph") || es_palabra(d, "node") || es_palabra(d, "edge")) {
+        if (!siguiente_token(d)) return false;
+        return leer_lista_atributos(d, -1);
+    }
+    if (es_palabra(d, "subgraph") || es_simbolo(d, '{')) {
+        if (es_palabra(d, "subgraph")) {
+            if (!siguiente_token(d)) return false;
+            if (d->clase == TOKEN_ID && !siguiente_token(d)) return false;
+        }
+        int linea = d->linea, columna = d->columna;
+        if (!esperar_simbolo(d, '{')) return false;
+        if (!analizar_sentencias_dot(d, profundidad + 1)) return false;
+        if (!esperar_simbolo(d, '}')) return false;
+        if (d->clase == TOKEN_ARISTA) {
+            return fallar(imp, linea, columna, "Las aristas hacia subgrafos no están soportadas");
+        }
+        return true;
+    }
+    if (!esperar_id(d, "una sentencia")) return false;
+
+    int linea = d->linea, columna = d->columna;
+    buffer_vaciar(&d->nombre);
+    buffer_agregar(&d->nombre, imp->texto.datos);
+    if (!siguiente_token(d)) return false;
+
+    // Atributo del grafo: a = b
+    if (es_simbolo(d, '=')) {
+        if (!siguiente_token(d)) return false;
+        if (!esperar_id(d, "el valor del atributo")) return false;
+        return siguiente_token(d);
+    }
+
+    int u = imp->pasada == 1 ? registrar_nodo(imp, d->nombre.datos, d->nombre.longitud, false, linea, columna)
+                             : nodo_existente(imp, d->nombre.datos, d->nombre.longitud, linea, columna);
+    if (u < 0) return false;
+    if (!saltar_puerto(d)) return false;
+
+    if (d->clase != TOKEN_ARISTA) {
+        return leer_lista_atributos(d, imp->pasada == 1 ? u : -1);
+    }
+    while (d->clase == TOKEN_ARISTA) {
+        char esperado = imp->tipo == DIRIGIDO ? '>' : '-';
+        if (d->simbolo != esperado) {
+            return fallar(imp, d->linea, d->columna, "Use '%s' en un %s",
+                          imp->tipo == DIRIGIDO ? "->" : "--", imp->tipo == DIRIGIDO ? "digraph" : "graph");
+        }
+        if (!siguiente_token(d)) return false;
+        if (es_simbolo(d, '{') || es_palabra(d, "subgraph")) {
+            return fallar(imp, d->linea, d->columna, "Las aristas hacia subgrafos no están soportadas");
+        }
+        if (!esperar_id(d, "el nodo destino de la arista")) return false;
+        int v = nodo_del_token(d);
+        if (v < 0) return false;
+        if (imp->pasada == 2) {
+            bool nueva = true;
+            if (d->estricto && !registrar_arista(&d->aristas, u, v, imp->tipo, &nueva)) {
+                return fallar(imp, d->linea, d->columna, "Memoria insuficiente para las aristas");
+            }
+            if (nueva) emitir_arista(imp, u, v);
+        }
+        u = v;
+        if (!siguiente_token(d)) return false;
+        if (!saltar_puerto(d)) return false;
+    }
+    return leer_lista_atributos(d, -1);
+}
+
+static bool analizar_sentencias_dot(LectorDot *d, int profundidad) {
+    while (!es_simbolo(d, '}')) {
+        if (d->clase == TOKEN_FIN) {
+            return fallar(d->imp, d->linea, d->columna, "Fin de archivo inesperado: falta '}'");
+        }
+        if (!analizar_sentencia_dot(d, profundidad)) return false;
+        if (es_simbolo(d, ';') && !siguiente_token(d)) return false;
+    }
+    return true;
+}
+
+static bool analizar_dot(Importador *imp) {
+    LectorDot d;
+    memset(&d, 0, sizeof(d));
+    d.imp = imp;
+    buffer_iniciar(&d.nombre);
+
+    bool ok = siguiente_token(&d);
+    if (ok && es_palabra(&d, "strict")) {
+        d.estricto = true;
+        ok = siguiente_token(&d);
+    }
+    if (ok) {
+        if (es_palabra(&d, "graph")) {
+            imp->tipo = NO_DIRIGIDO;
+        } else if (es_palabra(&d, "digraph")) {
+            imp->tipo = DIRIGIDO;
+        } else {
+            ok = fallar(imp, d.linea, d.columna, "Se esperaba 'graph' o 'digraph'");
+        }
+    }
+    ok = ok && siguiente_token(&d);
+    if (ok && d.clase == TOKEN_ID) {
+        ok = siguiente_token(&d);
+    }
+    ok = ok && esperar_simbolo(&d, '{');
+    ok = ok && analizar_sentencias_dot(&d, 0);
+    ok = ok && esperar_simbolo(&d, '}');
+    if (ok && d.clase != TOKEN_FIN) {
+        ok = fallar(imp, d.linea, d.columna, "Contenido inesperado después del grafo (solo se lee un grafo)");
+    }
+    if (ok && d.nombre.error) {
+        ok = fallar(imp, d.linea, d.columna, "Memoria insuficiente");
+    }
+
+    buffer_liberar(&d.nombre);
+    free(d.aristas.claves);
+    return ok;
+}
+
+bool cargar_dot(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error) {
+    return ejecutar_importador(ruta, receptor, error, analizar_dot);
+}
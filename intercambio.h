@@ -0,0 +1,18 @@
+#ifndef INTERCAMBIO_H
+#define INTERCAMBIO_H
+
+#include <stdbool.h>
+#include "cargador.h"
+
+// Importadores de GraphML y Graphviz DOT. Leen el archivo por bloques en dos
+// pasadas sin guardar el documento: la primera registra los nodos (y sus
+// coordenadas) para conocer K antes del encabezado; la segunda entrega las
+// aristas. En memoria solo quedan los nombres de los nodos y sus posiciones (y,
+// en un DOT 'strict', las aristas ya vistas, para unir las repetidas).
+//
+// Las coordenadas salen de las claves GraphML con attr.name "x" e "y" y del
+// atributo "pos" de DOT ("x,y" o "x,y!"); se redondean al entero más cercano.
+bool cargar_graphml(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error);
+bool cargar_dot(const char *ruta, const ReceptorGrafo *receptor, ErrorCarga *error);
+
+#endif
@@ -0,0 +1,118 @@
+#include "matriz_bits.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "bits_simd.h"
+
+static size_t palabras_por_fila(int num_nodos) {
+    return ((size_t)num_nodos + 63) / 64;
+}
+
+bool conviene_matriz_bits(const GrafoCSR *grafo) {
+    unsigned long long palabras = (unsigned long long)grafo->num_nodos * palabras_por_fila(grafo->num_nodos);
+    return palabras * sizeof(uint64_t) <= (unsigned long long)grafo->num_arcos * sizeof(int);
+}
+
+bool matriz_bits_desde_csr(const GrafoCSR *grafo, bool simetrica, MatrizBits *matriz) {
+    int n = grafo->num_nodos;
+    matriz->num_nodos = n;
+    matriz->palabras_fila = palabras_por_fila(n);
+    matriz->filas = calloc((size_t)n * matriz->palabras_fila > 0 ? (size_t)n * matriz->palabras_fila : 1,
+                           sizeof(uint64_t));
+    if (!matriz->filas) return false;
+    marcar_arcos_matriz_bits(grafo, simetrica, matriz);
+    return true;
+}
+
+void marcar_arcos_matriz_bits(const GrafoCSR *grafo, bool simetrica, MatrizBits *matriz) {
+    for (int u = 0; u < grafo->num_nodos; u++) {
+        uint64_t *fila = fila_matriz_bits(matriz, u);
+        for (long long a = grafo->inicio[u]; a < grafo->inicio[u + 1]; a++) {
+            int v = grafo->destinos[a];
+            fila[v / 64] |= (uint64_t)1 << (v % 64);
+            if (simetrica) {
+                fila_matriz_bits(matriz, v)[u / 64] |= (uint64_t)1 << (u % 64);
+            }
+        }
+    }
+}
+
+void liberar_matriz_bits(MatrizBits *matriz) {
+    free(matriz->filas);
+    matriz->filas = NULL;
+}
+
+// Recorrido por niveles con un número fijo de palabras por fila: los conjuntos
+// van en la pila y los ciclos sobre las palabras tienen largo constante, así que
+// el compilador los desenrolla. Se genera una versión por tamaño de fila.
+#define DEFINIR_ALCANZABLES_FIJO(PALABRAS)                                                              \
+    static long long alcanzables_##PALABRAS(const MatrizBits *matriz, int origen, long long objetivo) { \
+        uint64_t visitados[PALABRAS] = {0};                                                             \
+        uint64_t frontera[PALABRAS] = {0};                                                              \
+        visitados[origen / 64] = frontera[origen / 64] = (uint64_t)1 << (origen % 64);                  \
+        long long alcanzados = 1;                                                                       \
+        while (alcanzados < objetivo) {                                                                 \
+            uint64_t siguiente[PALABRAS] = {0};                                                         \
+            for (int i = 0; i < PALABRAS; i++) {                                                        \
+                for (uint64_t palabra = frontera[i]; palabra != 0; palabra &= palabra - 1) {            \
+                    const uint64_t *fila = fila_matriz_bits(matriz, i * 64 + __builtin_ctzll(palabra)); \
+                    for (int j = 0; j < PALABRAS; j++) siguiente[j] |= fila[j] & ~visitados[j];         \
+                }                                                                                       \
+            }                                                                                           \
+            long long nuevos = 0;                                                                       \
+            for (int j = 0; j < PALABRAS; j++) {                                                        \
+                visitados[j] |= siguiente[j];                                                           \
+                frontera[j] = siguiente[j];                                                             \
+                nuevos += __builtin_popcountll(siguiente[j]);                                           \
+            }                                                                                           \
+            if (nuevos == 0) break;                                                                     \
+            alcanzados += nuevos;                                                                       \
+        }                                                                                               \
+        return alcanzados;                                                                              \
+    }
+
+DEFINIR_ALCANZABLES_FIJO(1)
+DEFINIR_ALCANZABLES_FIJO(2)
+DEFINIR_ALCANZABLES_FIJO(3)
+DEFINIR_ALCANZABLES_FIJO(4)
+
+// Filas de ancho variable: conjuntos en el heap y kernels de bits_simd.h
+static long long alcanzables_general(const MatrizBits *matriz, int origen, long long objetivo) {
+    size_t w = matriz->palabras_fila;
+    uint64_t *conjuntos = calloc(3 * w, sizeof(uint64_t));
+    if (!conjuntos) return -1;
+    uint64_t *visitados = conjuntos;
+    uint64_t *frontera = conjuntos + w;
+    uint64_t *siguiente = conjuntos + 2 * w;
+
+    visitados[origen / 64] = frontera[origen / 64] = (uint64_t)1 << (origen % 64);
+    long long alcanzados = 1;
+    while (alcanzados < objetivo) {
+        for (size_t i = 0; i < w; i++) {
+            for (uint64_t palabra = frontera[i]; palabra != 0; palabra &= palabra - 1) {
+                int u = (int)(i * 64) + __builtin_ctzll(palabra);
+                acumular_fila_bits(siguiente, fila_matriz_bits(matriz, u), visitados, w);
+            }
+        }
+        long long nuevos = absorber_frontera_bits(visitados, siguiente, w);
+        if (nuevos == 0) break;
+        alcanzados += nuevos;
+
+        uint64_t *intercambio = frontera;
+        frontera = siguiente;
+        siguiente = intercambio;
+        memset(siguiente, 0, w * sizeof(uint64_t));
+    }
+    free(conjuntos);
+    return alcanzados;
+}
+
+long long alcanzables_matriz_bits(const MatrizBits *matriz, int origen, long long objetivo) {
+    switch (matriz->palabras_fila) {
+        case 1: return alcanzables_1(matriz, origen, objetivo);
+        case 2: return alcanzables_2(matriz, origen, objetivo);
+        case 3: return alcanzables_3(matriz, origen, objetivo);
+        case 4: return alcanzables_4(matriz, origen, objetivo);
+        default: return alcanzables_general(matriz, origen, objetivo);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef MATRIZ_BITS_H
+#define MATRIZ_BITS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "grafo_csr.h"
+
+// Matriz de adyacencia de bits para grafos de cualquier tamaño: la fila u ocupa
+// palabras_fila palabras y el bit v indica si hay al menos un arco u -> v (las
+// aristas múltiples se pierden). Ocupa V^2 / 8 bytes, así que solo conviene en
+// grafos densos; a cambio los recorridos por niveles avanzan una fila entera
+// por operación con los kernels de bits_simd.h.
+typedef struct {
+    int num_nodos;
+    size_t palabras_fila;
+    uint64_t *filas;
+} MatrizBits;
+
+// Con 'simetrica' también se marca v -> u por cada arco u -> v (para la
+// conexidad débil de un grafo dirigido)
+bool matriz_bits_desde_csr(const GrafoCSR *grafo, bool simetrica, MatrizBits *matriz);
+// Marca los arcos en una matriz con filas propias (en cero); así un grafo
+// pequeño puede tener la matriz en la pila
+void marcar_arcos_matriz_bits(const GrafoCSR *grafo, bool simetrica, MatrizBits *matriz);
+void liberar_matriz_bits(MatrizBits *matriz);
+
+// Indica si la matriz no ocupa más que los destinos del CSR
+bool conviene_matriz_bits(const GrafoCSR *grafo);
+
+static inline uint64_t *fila_matriz_bits(const MatrizBits *matriz, int u) {
+    return matriz->filas + (size_t)u * matriz->palabras_fila;
+}
+
+// Recorrido por niveles desde 'origen': cada nivel junta las filas de la
+// frontera sin los ya visitados. Devuelve cuántos nodos alcanza (origen
+// incluido), y deja de buscar en cuanto llega a 'objetivo'. -1 sin memoria.
+// Con filas de hasta 4 palabras (256 nodos) usa una versión de tamaño fijo con
+// todo en la pila; con más, conjuntos en el heap y los kernels de bits_simd.h.
+long long alcanzables_matriz_bits(const MatrizBits *matriz, int origen, long long objetivo);
+
+#endif
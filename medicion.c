@@ -0,0 +1,113 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "medicion.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+// El lote deja de crecer aquí aunque no llegue a lote_minimo_us
+#define LOTE_MAXIMO (1LL << 24)
+
+static double ahora_us(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+static double medir_lote(FuncionMedida funcion, void *datos, long long lote) {
+    double inicio = ahora_us();
+    for (long long i = 0; i < lote; i++) {
+        funcion(datos);
+    }
+    return ahora_us() - inicio;
+}
+
+static int comparar_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil q (0 a 1) de valores ordenados, interpolando entre los dos vecinos
+static double percentil(const double *ordenados, int n, double q) {
+    double posicion = q * (n - 1);
+    int i = (int)posicion;
+    if (i >= n - 1) return ordenados[n - 1];
+    return ordenados[i] + (posicion - i) * (ordenados[i + 1] - ordenados[i]);
+}
+
+bool medir(const ConfiguracionMedicion *config, FuncionMedida funcion, void *datos, Medicion *medicion) {
+    int muestras = config->muestras > 0 ? config->muestras : 1;
+    double *tiempos = malloc((size_t)muestras * sizeof(double));
+    if (!tiempos) return false;
+
+    long long lote = 1;
+    while (medir_lote(funcion, datos, lote) < config->lote_minimo_us && lote < LOTE_MAXIMO) {
+        lote *= 2;
+    }
+    for (int i = 0; i < config->calentamiento; i++) {
+        medir_lote(funcion, datos, lote);
+    }
+    for (int i = 0; i < muestras; i++) {
+        tiempos[i] = medir_lote(funcion, datos, lote) / lote;
+    }
+
+    qsort(tiempos, (size_t)muestras, sizeof(double), comparar_double);
+    medicion->lote = lote;
+    medicion->muestras = muestras;
+    medicion->mediana_us = percentil(tiempos, muestras, 0.5);
+    medicion->p10_us = percentil(tiempos, muestras, 0.1);
+    medicion->p90_us = percentil(tiempos, muestras, 0.9);
+    medicion->p99_us = percentil(tiempos, muestras, 0.99);
+    medicion->min_us = tiempos[0];
+    medicion->max_us = tiempos[muestras - 1];
+    free(tiempos);
+    return true;
+}
+
+void iniciar_tabla_mediciones(TablaMediciones *tabla) {
+    tabla->filas = NULL;
+    tabla->num_filas = 0;
+    tabla->capacidad = 0;
+}
+
+bool agregar_medicion(TablaMediciones *tabla, const Medicion *medicion) {
+    if (tabla->num_filas == tabla->capacidad) {
+        int capacidad = tabla->capacidad > 0 ? 2 * tabla->capacidad : 64;
+        Medicion *ampliadas = realloc(tabla->filas, (size_t)capacidad * sizeof(Medicion));
+        if (!ampliadas) return false;
+        tabla->filas = ampliadas;
+        tabla->capacidad = capacidad;
+    }
+    tabla->filas[tabla->num_filas++] = *medicion;
+    return true;
+}
+
+void liberar_tabla_mediciones(TablaMediciones *tabla) {
+    free(tabla->filas);
+    iniciar_tabla_mediciones(tabla);
+}
+
+// Los nombres de familias y motores son identificadores: no hace falta escaparlos
+void mediciones_json(const TablaMediciones *tabla, const char *nivel_simd, BufferTexto *b) {
+    buffer_printf(b, "{\n  \"nivel_simd\": \"%s\",\n  \"resultados\": [\n", nivel_simd);
+    for (int i = 0; i < tabla->num_filas; i++) {
+        const Medicion *m = &tabla->filas[i];
+        buffer_printf(b, "    {\"familia\": \"%s\", \"n\": %d, \"aristas\": %lld, \"motor\": \"%s\", "
+                      "\"lote\": %lld, \"muestras\": %d, \"mediana_us\": %.3f, \"p10_us\": %.3f, "
+                      "\"p90_us\": %.3f, \"p99_us\": %.3f, \"min_us\": %.3f, \"max_us\": %.3f}%s\n",
+                      m->familia, m->num_nodos, m->aristas, m->motor, m->lote, m->muestras,
+                      m->mediana_us, m->p10_us, m->p90_us, m->p99_us, m->min_us, m->max_us,
+                      i + 1 < tabla->num_filas ? "," : "");
+    }
+    buffer_agregar(b, "  ]\n}\n");
+}
+
+void mediciones_csv(const TablaMediciones *tabla, BufferTexto *b) {
+    buffer_agregar(b, "familia,n,aristas,motor,lote,muestras,mediana_us,p10_us,p90_us,p99_us,min_us,max_us\n");
+    for (int i = 0; i < tabla->num_filas; i++) {
+        const Medicion *m = &tabla->filas[i];
+        buffer_printf(b, "%s,%d,%lld,%s,%lld,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                      m->familia, m->num_nodos, m->aristas, m->motor, m->lote, m->muestras,
+                      m->mediana_us, m->p10_us, m->p90_us, m->p99_us, m->min_us, m->max_us);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef MEDICION_H
+#define MEDICION_H
+
+#include <stdbool.h>
+#include "buffer_texto.h"
+
+// Medición de tiempos para el modo --bench. Una función se repite en lotes
+// calibrados (el lote se duplica hasta durar al menos lote_minimo_us, así las
+// funciones de microsegundos no quedan por debajo de la resolución del reloj);
+// los primeros lotes se descartan como calentamiento y de los demás sale el
+// tiempo por llamada.
+
+typedef void (*FuncionMedida)(void *datos);
+
+typedef struct {
+    int calentamiento;      // Lotes descartados antes de medir
+    int muestras;           // Lotes medidos
+    double lote_minimo_us;
+} ConfiguracionMedicion;
+
+// Una fila del resultado. 'familia' y 'motor' deben ser cadenas que duren tanto
+// como la tabla (literales o nombre_familia()).
+typedef struct {
+    const char *familia;
+    int num_nodos;
+    long long aristas;
+    const char *motor;
+    long long lote;         // Llamadas por muestra
+    int muestras;
+    double mediana_us;      // Tiempos por llamada
+    double p10_us;
+    double p90_us;
+    double p99_us;
+    double min_us;
+    double max_us;
+} Medicion;
+
+typedef struct {
+    Medicion *filas;
+    int num_filas;
+    int capacidad;
+} TablaMediciones;
+
+// Llena lote, muestras y los tiempos de 'medicion'. false sin memoria.
+bool medir(const ConfiguracionMedicion *config, FuncionMedida funcion, void *datos, Medicion *medicion);
+
+void iniciar_tabla_mediciones(TablaMediciones *tabla);
+bool agregar_medicion(TablaMediciones *tabla, const Medicion *medicion);
+void liberar_tabla_mediciones(TablaMediciones *tabla);
+
+// {"nivel_simd": ..., "resultados": [{...}, ...]}
+void mediciones_json(const TablaMediciones *tabla, const char *nivel_simd, BufferTexto *b);
+// Encabezado y una línea por fila
+void mediciones_csv(const TablaMediciones *tabla, BufferTexto *b);
+
+#endif
@@ -3,30 +3,34 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <math.h>
+#include <limits.h>
 #include <gtk/gtk.h>
+#include <cairo-pdf.h>
+#include <cairo-svg.h>
 #include <glib.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#include "bits_simd.h"
+#include "buffer_texto.h"
+#include "cargador.h"
+#include "de_bruijn.h"
+#include "distribucion.h"
+#include "escritor.h"
+#include "euler.h"
+#include "euler_externo.h"
+#include "filas_bits.h"
+#include "generador.h"
+#include "grafo_csr.h"
+#include "indice_espacial.h"
+#include "instantanea.h"
+#include "medicion.h"
+#include "traza.h"
+#include "grafo.h"
 
-#define MAX_NODOS 12
 #define GLADE_FILE "proyecto-4aa.glade"
-
-typedef enum {
-    NO_DIRIGIDO,
-    DIRIGIDO
-} TipoGrafo;
-
-typedef struct {
-    int x;
-    int y;
-} Coordenada;
-
-typedef struct {
-    int K;
-    TipoGrafo tipo;
-    int matriz_adyacencia[MAX_NODOS][MAX_NODOS];
-    Coordenada posiciones[MAX_NODOS];
-} Grafo;
+#define LIMITE_POSICION 1000      // Rango de los campos X/Y de las posiciones
+#define LADO_INDICE_POSICIONES 32.0   // Celda de la rejilla de indice_espacial.h
 
 // Estructura para rastrear pasos del algoritmo de Hierholzer
 typedef struct {
@@ -58,17 +62,27 @@ typedef struct {
 static Grafo grafo_actual;
 static GtkBuilder *builder;
 static GtkWidget *window_main;
-static GtkWidget *grid_matriz;
+static GtkWidget *area_matriz;
+static GtkWidget *area_lienzo;
+static GtkWidget *box_lienzo;
+static GtkWidget *combo_recorrido;
+static GtkWidget *btn_paso_anterior;
+static GtkWidget *btn_reproducir;
+static GtkWidget *btn_paso_siguiente;
+static GtkWidget *scale_paso;
+static GtkWidget *spin_velocidad;
+static GtkLabel *label_paso;
 static GtkWidget *grid_posiciones;
 static GtkWidget *spin_num_nodes;
 static GtkWidget *radio_no_dirigido;
 static GtkWidget *radio_dirigido;
 static GtkWidget *scroll_matriz;
 static GtkWidget *notebook_main;
-static GtkEntry *matriz_entries[MAX_NODOS][MAX_NODOS];
 static GtkSpinButton *pos_x_spins[MAX_NODOS];
 static GtkSpinButton *pos_y_spins[MAX_NODOS];
 static int num_nodos_actual = 0;
+static int fila_foco = 0;            // Celda activa del editor de la matriz
+static int col_foco = 0;
 
 void limpiar_matriz();
 void limpiar_posiciones();
@@ -83,20 +97,162 @@ bool encontrar_ruta_hamiltoniana(int *secuencia, int *longitud);
 bool es_euleriano();
 bool es_semieuleriano();
 int encontrar_ciclo_euleriano_hierholzer(int *secuencia);
-int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierholzer *pasos, int *num_pasos);
+int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierholzer *pasos, int *num_pasos, Traza *traza);
 int encontrar_ciclo_euleriano_fleury(int *secuencia);
-int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos);
-int encontrar_ruta_euleriana_fleury(int *secuencia);
-int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos);
-bool es_puente(int matriz[MAX_NODOS][MAX_NODOS], int u, int v, int K);
-void generar_latex(const char *filename);
-void generar_tikz_paso_hierholzer(FILE *f, PasoHierholzer *paso, int paso_num, int min_x, int min_y, double escala);
-void generar_tikz_paso_fleury(FILE *f, PasoFleury *paso, int paso_num, int min_x, int min_y, double escala);
+int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos, Traza *traza);
+int encontrar_ruta_euleriana_hierholzer(int *secuencia);
+int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos, Traza *traza);
+bool es_puente(int matriz[MAX_NODOS][MAX_NODOS], const FilaBits *filas, int u, int v, int K);
+bool generar_latex(const char *filename);
+void generar_tikz_paso_hierholzer(BufferTexto *b, PasoHierholzer *paso, int paso_num);
+void generar_tikz_paso_fleury(BufferTexto *b, PasoFleury *paso, int paso_num);
 void compilar_y_mostrar_pdf(const char *texfile);
 void guardar_grafo_archivo();
+bool guardar_grafo_actual(const char *ruta);
 void cargar_grafo_archivo();
 void on_save_button_clicked(GtkButton *button, gpointer user_data);
 void on_load_button_clicked(GtkButton *button, gpointer user_data);
+void on_preview_clicked(GtkButton *button, gpointer user_data);
+void on_distribuir_clicked(GtkButton *button, gpointer user_data);
+void actualizar_panel_propiedades();
+void reiniciar_lienzo();
+void comprobar_recorrido_lienzo();
+
+// Las vistas de grafo_actual (editor de la matriz y panel de propiedades) no
+// se actualizan en cada cambio del modelo: grafo_modificado y establecer_arista
+// solo programan una notificación, y la fuente idle refresca todo una vez por
+// vuelta del bucle principal, sin importar cuántas celdas cambiaron. Sin
+// ventana (línea de comandos) no hay nada que notificar.
+static guint notificacion_grafo;
+
+static gboolean refrescar_vistas_grafo(gpointer datos) {
+    (void)datos;
+    notificacion_grafo = 0;
+    if (area_matriz) gtk_widget_queue_draw(area_matriz);
+    if (area_lienzo) gtk_widget_queue_draw(area_lienzo);
+    comprobar_recorrido_lienzo();
+    actualizar_panel_propiedades();
+    return G_SOURCE_REMOVE;
+}
+
+static void notificar_grafo_modificado(void) {
+    if (notificacion_grafo || !window_main) return;
+    notificacion_grafo = g_idle_add(refrescar_vistas_grafo, NULL);
+}
+
+// Cambia cada vez que se modifica la matriz, el tipo o K de grafo_actual; los
+// análisis que se guardan entre llamadas la comparan para saber si siguen vigentes
+static unsigned int version_grafo = 1;
+// Igual, para grafo_actual.posiciones (también cambia con K)
+static unsigned int version_posiciones = 1;
+
+// Grados de grafo_actual y los contadores que deciden la clase euleriana. Las
+// ediciones de una celda los ajustan en O(1) (establecer_arista); los cambios
+// en bloque (cargar, limpiar, cambiar K o el tipo) los recalculan una vez.
+// En no dirigidos el grado es grado_salida.
+typedef struct {
+    int grado_entrada[MAX_NODOS];
+    int grado_salida[MAX_NODOS];
+    int nodos_grado_impar;      // Vértices con grado_salida impar
+    int nodos_desbalanceados;   // Vértices con grado_entrada != grado_salida
+    int nodos_inicio;           // grado_salida - grado_entrada == 1
+    int nodos_fin;              // grado_salida - grado_entrada == -1
+} GradosGrafo;
+
+static GradosGrafo grados_actual;
+
+// Filas de bits de grafo_actual (filas_bits.h), al día junto con los grados.
+// 'aristas' marca las celdas con alguna arista, que es lo que siguen la
+// conexidad y los recorridos; 'simples' las celdas con exactamente una, que es
+// lo que cuentan los grados y lo que exige el backtracking hamiltoniano.
+typedef struct {
+    FilaBits aristas[MAX_NODOS];
+    FilaBits simples[MAX_NODOS];
+    FilaBits simples_entrada[MAX_NODOS];    // Traspuesta de 'simples'
+} AdyacenciaBits;
+
+static AdyacenciaBits adyacencia_bits;
+
+// Suma (signo 1) o quita (signo -1) el aporte del vértice v a los contadores
+static void contar_vertice(GradosGrafo *g, int v, int signo) {
+    int diferencia = g->grado_salida[v] - g->grado_entrada[v];
+    if (g->grado_salida[v] % 2 != 0) g->nodos_grado_impar += signo;
+    if (diferencia != 0) g->nodos_desbalanceados += signo;
+    if (diferencia == 1) g->nodos_inicio += signo;
+    if (diferencia == -1) g->nodos_fin += signo;
+}
+
+static void asignar_celda_bits(int fila, int col, int valor) {
+    AdyacenciaBits *a = &adyacencia_bits;
+    if (valor > 0) {
+        poner_bit_fila(&a->aristas[fila], col);
+    } else {
+        quitar_bit_fila(&a->aristas[fila], col);
+    }
+    if (valor == 1) {
+        poner_bit_fila(&a->simples[fila], col);
+        poner_bit_fila(&a->simples_entrada[col], fila);
+    } else {
+        quitar_bit_fila(&a->simples[fila], col);
+        quitar_bit_fila(&a->simples_entrada[col], fila);
+    }
+}
+
+// Rehace las filas de bits y saca los grados con popcount
+static void recalcular_grados(void) {
+    GradosGrafo *g = &grados_actual;
+    int K = grafo_actual.K;
+    memset(g, 0, sizeof(*g));
+    AdyacenciaBits *a = &adyacencia_bits;
+    memset(a, 0, sizeof(*a));
+    for (int i = 0; i < K; i++) {
+        for (int j = 0; j < K; j++) {
+            int valor = grafo_actual.matriz_adyacencia[i][j];
+            if (valor > 0) poner_bit_fila(&a->aristas[i], j);
+            if (valor == 1) {
+                poner_bit_fila(&a->simples[i], j);
+                poner_bit_fila(&a->simples_entrada[j], i);
+            }
+        }
+    }
+    for (int i = 0; i < K; i++) {
+        g->grado_salida[i] = contar_bits_fila(&adyacencia_bits.simples[i]);
+        g->grado_entrada[i] = contar_bits_fila(&adyacencia_bits.simples_entrada[i]);
+        contar_vertice(g, i, 1);
+    }
+}
+
+// Para cambios en bloque de grafo_actual
+static void grafo_modificado(void) {
+    version_grafo++;
+    version_posiciones++;
+    recalcular_grados();
+    notificar_grafo_modificado();
+}
+
+static void posiciones_modificadas(void) {
+    version_posiciones++;
+    notificar_grafo_modificado();
+}
+
+// Cambia una celda de la matriz ajustando solo los grados de sus dos extremos.
+// No toca la celda simétrica: en no dirigidos la espeja actualizar_matriz_simetrica.
+static void establecer_arista(int fila, int col, int valor) {
+    GradosGrafo *g = &grados_actual;
+    int delta = (valor == 1) - (grafo_actual.matriz_adyacencia[fila][col] == 1);
+    grafo_actual.matriz_adyacencia[fila][col] = valor;
+    asignar_celda_bits(fila, col, valor);
+    version_grafo++;
+    notificar_grafo_modificado();
+    if (delta == 0) return;
+    
+    contar_vertice(g, fila, -1);
+    if (col != fila) contar_vertice(g, col, -1);
+    g->grado_salida[fila] += delta;
+    g->grado_entrada[col] += delta;
+    contar_vertice(g, fila, 1);
+    if (col != fila) contar_vertice(g, col, 1);
+}
 
 bool validar_numero_nodos(int k) {
     return k >= 1 && k <= MAX_NODOS;
@@ -145,6 +301,7 @@ void on_apply_nodes_clicked(GtkButton *button, gpointer user_data) {
         grafo_actual.posiciones[i].x = 0;
         grafo_actual.posiciones[i].y = 0;
     }
+    grafo_modificado();
     
     limpiar_matriz();
     limpiar_posiciones();
@@ -165,54 +322,18 @@ void on_tipo_grafo_changed(GtkToggleButton *togglebutton, gpointer user_data) {
         for (int i = 0; i < num_nodos_actual; i++) {
             for (int j = 0; j < num_nodos_actual; j++) {
                 if (i != j) {
-                    int valor = grafo_actual.matriz_adyacencia[i][j];
-                    grafo_actual.matriz_adyacencia[j][i] = valor;
-                    if (matriz_entries[j][i]) {
-                        char str[2];
-                        snprintf(str, 2, "%d", valor);
-                        gtk_entry_set_text(matriz_entries[j][i], str);
-                    }
+                    grafo_actual.matriz_adyacencia[j][i] = grafo_actual.matriz_adyacencia[i][j];
                 }
             }
         }
     }
-}
-
-void on_matriz_changed(GtkEditable *editable, gpointer user_data) {
-    GtkEntry *entry = GTK_ENTRY(editable);
-    int *coords = (int *)user_data;
-    int fila = coords[0];
-    int col = coords[1];
-    
-    const char *text = gtk_entry_get_text(entry);
-    int valor = atoi(text);
-    
-    if (valor != 0 && valor != 1) {
-        valor = 0;
-        gtk_entry_set_text(entry, "0");
-    }
-    
-    if (fila == col) {
-        valor = 0;
-        gtk_entry_set_text(entry, "0");
-    }
-    
-    grafo_actual.matriz_adyacencia[fila][col] = valor;
-    
-    if (grafo_actual.tipo == NO_DIRIGIDO && fila != col) {
-        actualizar_matriz_simetrica(fila, col);
-    }
+    // La simetrización escribe la matriz directamente: los grados se rehacen al final
+    grafo_modificado();
 }
 
 void actualizar_matriz_simetrica(int fila, int col) {
     int valor = grafo_actual.matriz_adyacencia[fila][col];
-    grafo_actual.matriz_adyacencia[col][fila] = valor;
-    
-    if (matriz_entries[col][fila]) {
-        char str[16];
-        snprintf(str, sizeof(str), "%d", valor);
-        gtk_entry_set_text(matriz_entries[col][fila], str);
-    }
+    establecer_arista(col, fila, valor);
 }
 
 void guardar_grafo_archivo() {
@@ -244,25 +365,9 @@ void guardar_grafo_archivo() {
     
     if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
         char *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
-        FILE *f = fopen(filename, "w");
+        bool guardado = guardar_grafo_actual(filename);
         
-        if (f) {
-            fprintf(f, "%d\n", grafo_actual.K);
-            fprintf(f, "%d\n", grafo_actual.tipo);
-            
-            for (int i = 0; i < grafo_actual.K; i++) {
-                for (int j = 0; j < grafo_actual.K; j++) {
-                    fprintf(f, "%d ", grafo_actual.matriz_adyacencia[i][j]);
-                }
-                fprintf(f, "\n");
-            }
-            
-            for (int i = 0; i < grafo_actual.K; i++) {
-                fprintf(f, "%d %d\n", grafo_actual.posiciones[i].x, grafo_actual.posiciones[i].y);
-            }
-            
-            fclose(f);
-            
+        if (guardado) {
             GtkWidget *dialog_success = gtk_message_dialog_new(GTK_WINDOW(window_main),
                 GTK_DIALOG_MODAL, GTK_MESSAGE_INFO, GTK_BUTTONS_OK,
                 "Grafo guardado exitosamente en: %s", filename);
@@ -294,6 +399,38 @@ void on_save_button_clicked(GtkButton *button, gpointer user_data) {
     guardar_grafo_archivo();
 }
 
+// Pone 'nuevo' (cargado o generado) en lugar del grafo actual y rehace el editor
+static void reemplazar_grafo_actual(const Grafo *nuevo) {
+    int K = nuevo->K;
+    
+    // Los radio buttons disparan on_tipo_grafo_changed, que simetriza la
+    // matriz actual; por eso se ajustan antes de copiar la nueva
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_num_nodes), K);
+    if (nuevo->tipo == NO_DIRIGIDO) {
+        gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(radio_no_dirigido), TRUE);
+    } else {
+        gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(radio_dirigido), TRUE);
+    }
+    
+    grafo_actual = *nuevo;
+    num_nodos_actual = K;
+    grafo_modificado();
+    
+    limpiar_matriz();
+    limpiar_posiciones();
+    crear_matriz_ui(K);
+    crear_posiciones_ui(K);
+    
+    for (int i = 0; i < K; i++) {
+        if (pos_x_spins[i]) {
+            gtk_spin_button_set_value(pos_x_spins[i], grafo_actual.posiciones[i].x);
+        }
+        if (pos_y_spins[i]) {
+            gtk_spin_button_set_value(pos_y_spins[i], grafo_actual.posiciones[i].y);
+        }
+    }
+}
+
 void cargar_grafo_archivo() {
     GtkWidget *dialog = gtk_file_chooser_dialog_new("Cargar Grafo",
         GTK_WINDOW(window_main), GTK_FILE_CHOOSER_ACTION_OPEN,
@@ -302,126 +439,27 @@ void cargar_grafo_archivo() {
     
     if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
         char *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
-        FILE *f = fopen(filename, "r");
-        
-        if (f) {
-            int K, tipo;
-            if (fscanf(f, "%d", &K) != 1 || fscanf(f, "%d", &tipo) != 1) {
-                GtkWidget *dialog_error = gtk_message_dialog_new(GTK_WINDOW(window_main),
-                    GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-                    "Error: Formato de archivo inválido");
-                gtk_dialog_run(GTK_DIALOG(dialog_error));
-                gtk_widget_destroy(dialog_error);
-                fclose(f);
-                g_free(filename);
-                gtk_widget_destroy(dialog);
-                return;
-            }
-            
-            if (validar_numero_nodos(K)) {
-                grafo_actual.K = K;
-                grafo_actual.tipo = (TipoGrafo)tipo;
-                num_nodos_actual = K;
-                
-                gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_num_nodes), K);
-                if (tipo == NO_DIRIGIDO) {
-                    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(radio_no_dirigido), TRUE);
-                } else {
-                    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(radio_dirigido), TRUE);
-                }
-                
-                for (int i = 0; i < K; i++) {
-                    for (int j = 0; j < K; j++) {
-                        if (fscanf(f, "%d", &grafo_actual.matriz_adyacencia[i][j]) != 1) {
-                            GtkWidget *dialog_error = gtk_message_dialog_new(GTK_WINDOW(window_main),
-                                GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-                                "Error: Formato de archivo inválido en la matriz");
-                            gtk_dialog_run(GTK_DIALOG(dialog_error));
-                            gtk_widget_destroy(dialog_error);
-                            fclose(f);
-                            g_free(filename);
-                            gtk_widget_destroy(dialog);
-                            return;
-                        }
-                    }
-                }
-                
-                for (int i = 0; i < K; i++) {
-                    if (fscanf(f, "%d %d", &grafo_actual.posiciones[i].x, &grafo_actual.posiciones[i].y) != 2) {
-                        GtkWidget *dialog_error = gtk_message_dialog_new(GTK_WINDOW(window_main),
-                            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-                            "Error: Formato de archivo inválido en las posiciones");
-                        gtk_dialog_run(GTK_DIALOG(dialog_error));
-                        gtk_widget_destroy(dialog_error);
-                        fclose(f);
-                        g_free(filename);
-                        gtk_widget_destroy(dialog);
-                        return;
-                    }
-                }
-                
-                limpiar_matriz();
-                limpiar_posiciones();
-                crear_matriz_ui(K);
-                crear_posiciones_ui(K);
-                
-                // Bloquear señales temporalmente para evitar que los callbacks interfieran
-                for (int i = 0; i < K; i++) {
-                    for (int j = 0; j < K; j++) {
-                        if (matriz_entries[i][j]) {
-                            g_signal_handlers_block_by_func(matriz_entries[i][j], 
-                                (gpointer)on_matriz_changed, NULL);
-                        }
-                    }
-                }
-                
-                for (int i = 0; i < K; i++) {
-                    for (int j = 0; j < K; j++) {
-                        if (matriz_entries[i][j]) {
-                            char str[16];
-                            snprintf(str, sizeof(str), "%d", grafo_actual.matriz_adyacencia[i][j]);
-                            gtk_entry_set_text(matriz_entries[i][j], str);
-                        }
-                    }
-                }
-                
-                // Desbloquear señales después de actualizar
-                for (int i = 0; i < K; i++) {
-                    for (int j = 0; j < K; j++) {
-                        if (matriz_entries[i][j]) {
-                            g_signal_handlers_unblock_by_func(matriz_entries[i][j], 
-                                (gpointer)on_matriz_changed, NULL);
-                        }
-                    }
-                }
-                
-                for (int i = 0; i < K; i++) {
-                    if (pos_x_spins[i]) {
-                        gtk_spin_button_set_value(pos_x_spins[i], grafo_actual.posiciones[i].x);
-                    }
-                    if (pos_y_spins[i]) {
-                        gtk_spin_button_set_value(pos_y_spins[i], grafo_actual.posiciones[i].y);
-                    }
-                }
-                
-                GtkWidget *dialog_success = gtk_message_dialog_new(GTK_WINDOW(window_main),
-                    GTK_DIALOG_MODAL, GTK_MESSAGE_INFO, GTK_BUTTONS_OK,
-                    "Grafo cargado exitosamente desde: %s", filename);
-                gtk_dialog_run(GTK_DIALOG(dialog_success));
-                gtk_widget_destroy(dialog_success);
-            } else {
-                GtkWidget *dialog_error = gtk_message_dialog_new(GTK_WINDOW(window_main),
-                    GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-                    "Error: Número de nodos inválido en el archivo (debe estar entre 1 y %d)", MAX_NODOS);
-                gtk_dialog_run(GTK_DIALOG(dialog_error));
-                gtk_widget_destroy(dialog_error);
-            }
+        
+        // Se carga en un grafo temporal para no perder el actual si el archivo tiene errores
+        Grafo cargado;
+        ReceptorGrafo receptor;
+        ErrorCarga error;
+        receptor_grafo_denso(&receptor, &cargado);
+        
+        if (cargar_grafo(filename, &receptor, &error)) {
+            reemplazar_grafo_actual(&cargado);
             
-            fclose(f);
+            GtkWidget *dialog_success = gtk_message_dialog_new(GTK_WINDOW(window_main),
+                GTK_DIALOG_MODAL, GTK_MESSAGE_INFO, GTK_BUTTONS_OK,
+                "Grafo cargado exitosamente desde: %s", filename);
+            gtk_dialog_run(GTK_DIALOG(dialog_success));
+            gtk_widget_destroy(dialog_success);
         } else {
+            char detalle[512];
+            describir_error_carga(&error, detalle, sizeof(detalle));
             GtkWidget *dialog_error = gtk_message_dialog_new(GTK_WINDOW(window_main),
                 GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-                "Error al abrir el archivo: %s", filename);
+                "Error al cargar %s\n%s", filename, detalle);
             gtk_dialog_run(GTK_DIALOG(dialog_error));
             gtk_widget_destroy(dialog_error);
         }
@@ -444,6 +482,90 @@ void on_load_button_clicked(GtkButton *button, gpointer user_data) {
     cargar_grafo_archivo();
 }
 
+// Valores por omisión de --generar, del generador de la interfaz y de --bench
+#define GRADO_MEDIO_GENERADOR 10.0
+#define GRADO_POR_OMISION 4             // Grafos regulares
+#define SEMILLA_POR_OMISION 1
+
+// Densidad por omisión de las familias al azar: la mitad de los pares en los
+// grafos pequeños y unas GRADO_MEDIO_GENERADOR aristas por nodo en los grandes
+static double densidad_por_omision(int num_nodos) {
+    return fmin(0.5, GRADO_MEDIO_GENERADOR / num_nodos);
+}
+
+static GtkWidget *agregar_campo_generador(GtkGrid *grid, int fila, const char *etiqueta, GtkWidget *campo) {
+    GtkWidget *label = gtk_label_new(etiqueta);
+    gtk_widget_set_halign(label, GTK_ALIGN_START);
+    gtk_grid_attach(grid, label, 0, fila, 1, 1);
+    gtk_grid_attach(grid, campo, 1, fila, 1, 1);
+    return campo;
+}
+
+// Genera una de las familias de generador.h (hasta MAX_NODOS nodos) en lugar
+// del grafo actual. Si los parámetros no sirven se avisa y el diálogo sigue abierto.
+void on_generar_grafo_clicked(GtkMenuItem *menuitem, gpointer user_data) {
+    (void)menuitem;
+    (void)user_data;
+    GtkWidget *dialog = gtk_dialog_new_with_buttons("Generar Grafo", GTK_WINDOW(window_main),
+        GTK_DIALOG_MODAL | GTK_DIALOG_DESTROY_WITH_PARENT,
+        "_Cancelar", GTK_RESPONSE_CANCEL,
+        "_Generar", GTK_RESPONSE_ACCEPT, NULL);
+    
+    GtkGrid *grid = GTK_GRID(gtk_grid_new());
+    gtk_grid_set_row_spacing(grid, 5);
+    gtk_grid_set_column_spacing(grid, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(grid), 10);
+    
+    GtkWidget *combo_familia = gtk_combo_box_text_new();
+    for (int f = 0; f < NUM_FAMILIAS; f++) {
+        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_familia), nombre_familia((FamiliaGrafo)f));
+    }
+    gtk_combo_box_set_active(GTK_COMBO_BOX(combo_familia), FAMILIA_COMPLETO);
+    agregar_campo_generador(grid, 0, "Familia:", combo_familia);
+    GtkWidget *spin_nodos = agregar_campo_generador(grid, 1, "Nodos:",
+        gtk_spin_button_new_with_range(1, MAX_NODOS, 1));
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_nodos), num_nodos_actual > 0 ? num_nodos_actual : 6);
+    GtkWidget *spin_densidad = agregar_campo_generador(grid, 2, "Densidad (al azar):",
+        gtk_spin_button_new_with_range(0, 1, 0.05));
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_densidad), densidad_por_omision(MAX_NODOS));
+    GtkWidget *spin_grado = agregar_campo_generador(grid, 3, "Grado (regular):",
+        gtk_spin_button_new_with_range(0, MAX_NODOS - 1, 1));
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_grado), GRADO_POR_OMISION);
+    GtkWidget *spin_semilla = agregar_campo_generador(grid, 4, "Semilla:",
+        gtk_spin_button_new_with_range(0, 1e9, 1));
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_semilla), SEMILLA_POR_OMISION);
+    
+    gtk_container_add(GTK_CONTAINER(gtk_dialog_get_content_area(GTK_DIALOG(dialog))), GTK_WIDGET(grid));
+    gtk_widget_show_all(dialog);
+    
+    while (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
+        ParametrosGenerador parametros;
+        parametros.familia = (FamiliaGrafo)gtk_combo_box_get_active(GTK_COMBO_BOX(combo_familia));
+        parametros.num_nodos = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_nodos));
+        parametros.densidad = gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_densidad));
+        parametros.grado = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_grado));
+        parametros.semilla = (uint64_t)gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_semilla));
+        parametros.limite_posicion = LIMITE_POSICION;
+        
+        Grafo generado;
+        ReceptorGrafo receptor;
+        ErrorCarga error;
+        receptor_grafo_denso(&receptor, &generado);
+        if (generar_grafo(&parametros, &receptor, &error)) {
+            reemplazar_grafo_actual(&generado);
+            break;
+        }
+        
+        GtkWidget *dialog_error = gtk_message_dialog_new(GTK_WINDOW(dialog),
+            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
+            "%s", error.mensaje);
+        gtk_dialog_run(GTK_DIALOG(dialog_error));
+        gtk_widget_destroy(dialog_error);
+    }
+    
+    gtk_widget_destroy(dialog);
+}
+
 void on_quit_clicked(GtkMenuItem *menuitem, gpointer user_data) {
     (void)menuitem;
     (void)user_data;
@@ -456,11 +578,9 @@ void on_clear_clicked(GtkButton *button, gpointer user_data) {
     for (int i = 0; i < num_nodos_actual; i++) {
         for (int j = 0; j < num_nodos_actual; j++) {
             grafo_actual.matriz_adyacencia[i][j] = 0;
-            if (matriz_entries[i][j]) {
-                gtk_entry_set_text(matriz_entries[i][j], "0");
-            }
         }
     }
+    grafo_modificado();
     
     for (int i = 0; i < num_nodos_actual; i++) {
         grafo_actual.posiciones[i].x = 0;
@@ -504,31 +624,22 @@ void on_generate_latex_clicked(GtkButton *button, gpointer user_data) {
         return;
     }
     
-    generar_latex("proyecto-4aa.tex");
-    compilar_y_mostrar_pdf("proyecto-4aa.tex");
+    if (generar_latex("proyecto-4aa.tex")) {
+        compilar_y_mostrar_pdf("proyecto-4aa.tex");
+    } else {
+        GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(window_main),
+            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
+            "Error al crear archivo LaTeX");
+        gtk_dialog_run(GTK_DIALOG(dialog));
+        gtk_widget_destroy(dialog);
+    }
 }
 
 void limpiar_matriz() {
-    if (grid_matriz) {
-        GList *children = gtk_container_get_children(GTK_CONTAINER(grid_matriz));
-        GList *iter;
-        
-        for (iter = children; iter != NULL; iter = iter->next) {
-            GtkWidget *child = GTK_WIDGET(iter->data);
-            gpointer user_data = g_object_get_data(G_OBJECT(child), "coords");
-            if (user_data) {
-                free(user_data);
-            }
-            gtk_widget_destroy(child);
-        }
-        
-        g_list_free(children);
-        
-        for (int i = 0; i < MAX_NODOS; i++) {
-            for (int j = 0; j < MAX_NODOS; j++) {
-                matriz_entries[i][j] = NULL;
-            }
-        }
+    fila_foco = 0;
+    col_foco = 0;
+    if (area_matriz) {
+        gtk_widget_set_size_request(area_matriz, 0, 0);
     }
 }
 
@@ -551,62 +662,206 @@ void limpiar_posiciones() {
     }
 }
 
-void crear_matriz_ui(int K) {
-    for (int i = 0; i < K; i++) {
-        char label[16];
-        snprintf(label, sizeof(label), "%d", i);
-        GtkWidget *lbl = gtk_label_new(label);
-        gtk_grid_attach(GTK_GRID(grid_matriz), lbl, 0, i + 1, 1, 1);
-    }
-    
-    for (int j = 0; j < K; j++) {
-        char label[16];
-        snprintf(label, sizeof(label), "%d", j);
-        GtkWidget *lbl = gtk_label_new(label);
-        gtk_grid_attach(GTK_GRID(grid_matriz), lbl, j + 1, 0, 1, 1);
-    }
-    
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            GtkWidget *entry = gtk_entry_new();
-            gtk_entry_set_max_length(GTK_ENTRY(entry), 1);
-            gtk_entry_set_width_chars(GTK_ENTRY(entry), 2);
-            
-            int *coords = malloc(2 * sizeof(int));
-            coords[0] = i;
-            coords[1] = j;
-            
-            g_object_set_data(G_OBJECT(entry), "coords", coords);
+// Editor de la matriz: un único GtkDrawingArea dentro de scroll_matriz que
+// dibuja directamente grafo_actual. El área mide (K + 1) celdas por lado (la
+// primera fila y columna son los encabezados) y cada dibujo recorre solo las
+// celdas que tocan la región expuesta, así que rehacer la vista o desplazarla
+// cuesta lo visible y no K². Un clic alterna la celda; con el teclado las
+// flechas mueven la celda activa, espacio o Enter la alternan y 0/1 la fijan.
+#define CELDA_MATRIZ 28
+
+static void rectangulo_celda(int fila, int col, GdkRectangle *r) {
+    r->x = (col + 1) * CELDA_MATRIZ;
+    r->y = (fila + 1) * CELDA_MATRIZ;
+    r->width = CELDA_MATRIZ;
+    r->height = CELDA_MATRIZ;
+}
+
+static void redibujar_celda_matriz(int fila, int col) {
+    if (!area_matriz) return;
+    GdkRectangle r;
+    rectangulo_celda(fila, col, &r);
+    gtk_widget_queue_draw_area(area_matriz, r.x, r.y, r.width, r.height);
+}
+
+static void texto_centrado(cairo_t *cr, const char *texto, double x, double y) {
+    cairo_text_extents_t ext;
+    cairo_text_extents(cr, texto, &ext);
+    cairo_move_to(cr, x + (CELDA_MATRIZ - ext.width) / 2 - ext.x_bearing,
+                  y + (CELDA_MATRIZ - ext.height) / 2 - ext.y_bearing);
+    cairo_show_text(cr, texto);
+}
+
+static gboolean on_matriz_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    (void)user_data;
+    int K = num_nodos_actual;
+    if (K == 0) return FALSE;
+    
+    // Rango de filas y columnas (contando los encabezados como -1) que toca el recorte
+    double x1, y1, x2, y2;
+    cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
+    int col_inicio = (int)(x1 / CELDA_MATRIZ) - 1;
+    int col_fin = (int)(x2 / CELDA_MATRIZ) - 1;
+    int fila_inicio = (int)(y1 / CELDA_MATRIZ) - 1;
+    int fila_fin = (int)(y2 / CELDA_MATRIZ) - 1;
+    if (col_inicio < -1) col_inicio = -1;
+    if (fila_inicio < -1) fila_inicio = -1;
+    if (col_fin > K - 1) col_fin = K - 1;
+    if (fila_fin > K - 1) fila_fin = K - 1;
+    
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 12);
+    cairo_set_line_width(cr, 1);
+    bool con_foco = gtk_widget_has_focus(widget);
+    
+    for (int i = fila_inicio; i <= fila_fin; i++) {
+        for (int j = col_inicio; j <= col_fin; j++) {
+            double x = (j + 1) * CELDA_MATRIZ;
+            double y = (i + 1) * CELDA_MATRIZ;
+            char texto[16];
             
-            // Bloquear señal temporalmente para evitar callback durante inicialización
-            g_signal_connect(entry, "changed", G_CALLBACK(on_matriz_changed), coords);
-            g_signal_handlers_block_by_func(entry, (gpointer)on_matriz_changed, NULL);
+            if (i < 0 && j < 0) continue;
+            if (i < 0 || j < 0) {
+                snprintf(texto, sizeof(texto), "%d", i < 0 ? j : i);
+                cairo_set_source_rgb(cr, 0.3, 0.3, 0.3);
+                texto_centrado(cr, texto, x, y);
+                continue;
+            }
             
+            int valor = grafo_actual.matriz_adyacencia[i][j];
             if (i == j) {
-                gtk_widget_set_sensitive(entry, FALSE);
-                gtk_entry_set_text(GTK_ENTRY(entry), "0");
-                grafo_actual.matriz_adyacencia[i][j] = 0;
+                cairo_set_source_rgb(cr, 0.85, 0.85, 0.85);
+            } else if (valor) {
+                cairo_set_source_rgb(cr, 0.55, 0.7, 0.95);
             } else {
-                // Usar el valor existente de la matriz si está disponible, sino inicializar a 0
-                char str[16];
-                snprintf(str, sizeof(str), "%d", grafo_actual.matriz_adyacencia[i][j]);
-                gtk_entry_set_text(GTK_ENTRY(entry), str);
+                cairo_set_source_rgb(cr, 1.0, 1.0, 1.0);
             }
+            cairo_rectangle(cr, x + 1, y + 1, CELDA_MATRIZ - 2, CELDA_MATRIZ - 2);
+            cairo_fill(cr);
+            
+            cairo_set_source_rgb(cr, 0.6, 0.6, 0.6);
+            cairo_rectangle(cr, x + 1.5, y + 1.5, CELDA_MATRIZ - 3, CELDA_MATRIZ - 3);
+            cairo_stroke(cr);
             
-            gtk_grid_attach(GTK_GRID(grid_matriz), entry, j + 1, i + 1, 1, 1);
-            matriz_entries[i][j] = GTK_ENTRY(entry);
+            snprintf(texto, sizeof(texto), "%d", valor);
+            cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+            texto_centrado(cr, texto, x, y);
             
-            // Desbloquear señal después de inicializar
-            g_signal_handlers_unblock_by_func(entry, (gpointer)on_matriz_changed, NULL);
+            if (con_foco && i == fila_foco && j == col_foco) {
+                cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+                cairo_set_line_width(cr, 2);
+                cairo_rectangle(cr, x + 2, y + 2, CELDA_MATRIZ - 4, CELDA_MATRIZ - 4);
+                cairo_stroke(cr);
+                cairo_set_line_width(cr, 1);
+            }
         }
     }
+    return TRUE;
+}
+
+// La diagonal queda en 0: el editor no admite lazos
+static void cambiar_celda_matriz(int fila, int col, int valor) {
+    if (fila == col || grafo_actual.matriz_adyacencia[fila][col] == valor) return;
+    
+    establecer_arista(fila, col, valor);
+    if (grafo_actual.tipo == NO_DIRIGIDO) {
+        actualizar_matriz_simetrica(fila, col);
+    }
+}
+
+static void mover_foco_matriz(int fila, int col) {
+    int K = num_nodos_actual;
+    if (fila < 0) fila = 0;
+    if (col < 0) col = 0;
+    if (fila > K - 1) fila = K - 1;
+    if (col > K - 1) col = K - 1;
+    
+    redibujar_celda_matriz(fila_foco, col_foco);
+    fila_foco = fila;
+    col_foco = col;
+    redibujar_celda_matriz(fila_foco, col_foco);
+    
+    // Desplazar la ventana para que la celda activa quede a la vista
+    GdkRectangle r;
+    rectangulo_celda(fila, col, &r);
+    GtkScrolledWindow *scroll = GTK_SCROLLED_WINDOW(scroll_matriz);
+    gtk_adjustment_clamp_page(gtk_scrolled_window_get_hadjustment(scroll), r.x, r.x + r.width);
+    gtk_adjustment_clamp_page(gtk_scrolled_window_get_vadjustment(scroll), r.y, r.y + r.height);
+}
+
+static gboolean on_matriz_button_press(GtkWidget *widget, GdkEventButton *event, gpointer user_data) {
+    (void)user_data;
+    if (event->button != 1) return FALSE;
     
-    gtk_widget_show_all(grid_matriz);
+    int col = (int)(event->x / CELDA_MATRIZ) - 1;
+    int fila = (int)(event->y / CELDA_MATRIZ) - 1;
+    gtk_widget_grab_focus(widget);
+    if (fila < 0 || col < 0 || fila >= num_nodos_actual || col >= num_nodos_actual) return TRUE;
+    
+    mover_foco_matriz(fila, col);
+    cambiar_celda_matriz(fila, col, !grafo_actual.matriz_adyacencia[fila][col]);
+    return TRUE;
+}
+
+static gboolean on_matriz_key_press(GtkWidget *widget, GdkEventKey *event, gpointer user_data) {
+    (void)widget;
+    (void)user_data;
+    if (num_nodos_actual == 0) return FALSE;
+    
+    switch (event->keyval) {
+        case GDK_KEY_Up:    mover_foco_matriz(fila_foco - 1, col_foco); return TRUE;
+        case GDK_KEY_Down:  mover_foco_matriz(fila_foco + 1, col_foco); return TRUE;
+        case GDK_KEY_Left:  mover_foco_matriz(fila_foco, col_foco - 1); return TRUE;
+        case GDK_KEY_Right: mover_foco_matriz(fila_foco, col_foco + 1); return TRUE;
+        case GDK_KEY_space:
+        case GDK_KEY_Return:
+            cambiar_celda_matriz(fila_foco, col_foco, !grafo_actual.matriz_adyacencia[fila_foco][col_foco]);
+            return TRUE;
+        case GDK_KEY_0:
+        case GDK_KEY_KP_0:
+            cambiar_celda_matriz(fila_foco, col_foco, 0);
+            return TRUE;
+        case GDK_KEY_1:
+        case GDK_KEY_KP_1:
+            cambiar_celda_matriz(fila_foco, col_foco, 1);
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+static gboolean on_matriz_foco(GtkWidget *widget, GdkEventFocus *event, gpointer user_data) {
+    (void)widget;
+    (void)event;
+    (void)user_data;
+    redibujar_celda_matriz(fila_foco, col_foco);
+    return FALSE;
+}
+
+void crear_matriz_ui(int K) {
+    for (int i = 0; i < K; i++) {
+        if (grafo_actual.matriz_adyacencia[i][i] != 0) {
+            establecer_arista(i, i, 0);
+        }
+    }
     
-    if (scroll_matriz) {
-        gtk_widget_queue_resize(scroll_matriz);
-        gtk_widget_show_all(scroll_matriz);
+    if (area_matriz) {
+        gtk_widget_set_size_request(area_matriz, (K + 1) * CELDA_MATRIZ, (K + 1) * CELDA_MATRIZ);
+    }
+}
+
+// Los campos X/Y son la otra forma de mover un nodo: el lienzo se entera igual
+// que cuando lo arrastran
+static void on_posicion_changed(GtkSpinButton *spin, gpointer user_data) {
+    (void)spin;
+    int nodo = GPOINTER_TO_INT(user_data);
+    if (pos_x_spins[nodo]) {
+        grafo_actual.posiciones[nodo].x = gtk_spin_button_get_value_as_int(pos_x_spins[nodo]);
+    }
+    if (pos_y_spins[nodo]) {
+        grafo_actual.posiciones[nodo].y = gtk_spin_button_get_value_as_int(pos_y_spins[nodo]);
     }
+    posiciones_modificadas();
 }
 
 void crear_posiciones_ui(int K) {
@@ -628,22 +883,25 @@ void crear_posiciones_ui(int K) {
         double valor_x = grafo_actual.posiciones[i].x;
         double valor_y = grafo_actual.posiciones[i].y;
         
-        GtkAdjustment *adj_x = gtk_adjustment_new(valor_x, 0, 1000, 1, 10, 0);
+        GtkAdjustment *adj_x = gtk_adjustment_new(valor_x, 0, LIMITE_POSICION, 1, 10, 0);
         GtkWidget *spin_x = gtk_spin_button_new(adj_x, 1, 0);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_x), valor_x);
         gtk_grid_attach(GTK_GRID(grid_posiciones), spin_x, 1, i + 1, 1, 1);
         pos_x_spins[i] = GTK_SPIN_BUTTON(spin_x);
+        g_signal_connect(spin_x, "value-changed", G_CALLBACK(on_posicion_changed), GINT_TO_POINTER(i));
         
-        GtkAdjustment *adj_y = gtk_adjustment_new(valor_y, 0, 1000, 1, 10, 0);
+        GtkAdjustment *adj_y = gtk_adjustment_new(valor_y, 0, LIMITE_POSICION, 1, 10, 0);
         GtkWidget *spin_y = gtk_spin_button_new(adj_y, 1, 0);
         gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_y), valor_y);
         gtk_grid_attach(GTK_GRID(grid_posiciones), spin_y, 2, i + 1, 1, 1);
         pos_y_spins[i] = GTK_SPIN_BUTTON(spin_y);
+        g_signal_connect(spin_y, "value-changed", G_CALLBACK(on_posicion_changed), GINT_TO_POINTER(i));
         
         // No inicializar a 0 aquí, mantener los valores existentes si ya están cargados
     }
     
     gtk_widget_show_all(grid_posiciones);
+    reiniciar_lienzo();
     
     GtkWidget *scroll_posiciones = gtk_widget_get_parent(grid_posiciones);
     if (scroll_posiciones) {
@@ -653,6 +911,15 @@ void crear_posiciones_ui(int K) {
 }
 
 bool validar_posiciones() {
+    IndiceEspacial indice;
+    if (construir_indice_espacial(&indice, grafo_actual.posiciones, num_nodos_actual,
+                                  LADO_INDICE_POSICIONES)) {
+        int a, b;
+        bool repetida = buscar_posicion_repetida(&indice, grafo_actual.posiciones, &a, &b);
+        liberar_indice_espacial(&indice);
+        return !repetida;
+    }
+    
     for (int i = 0; i < num_nodos_actual; i++) {
         if (posicion_duplicada(grafo_actual.posiciones, num_nodos_actual,
             grafo_actual.posiciones[i].x, grafo_actual.posiciones[i].y, i)) {
@@ -662,368 +929,389 @@ bool validar_posiciones() {
     return true;
 }
 
-bool tiene_ciclo_hamiltoniano() {
-    int K = grafo_actual.K;
-    if (K < 3) return false;
-    
-    int camino[K];
-    bool visitado[K];
-    
-    for (int i = 0; i < K; i++) {
-        visitado[i] = false;
-    }
-    
-    bool backtrack(int pos) {
-        if (pos == K) {
-            return grafo_actual.matriz_adyacencia[camino[K-1]][camino[0]] == 1;
-        }
-        
-        for (int v = 0; v < K; v++) {
-            if (!visitado[v]) {
-                if (pos == 0 || grafo_actual.matriz_adyacencia[camino[pos-1]][v] == 1) {
-                    camino[pos] = v;
-                    visitado[v] = true;
-                    
-                    if (backtrack(pos + 1)) {
-                        return true;
-                    }
-                    
-                    visitado[v] = false;
-                }
-            }
+// Conectividad de grafo_actual, calculada una vez por versión del grafo y
+// compartida por las pruebas eulerianas y hamiltonianas. Se llena la primera vez
+// que se consulta; analizar_grafo_reporte la consulta antes de lanzar los hilos,
+// así que ellos solo la leen.
+typedef struct {
+    unsigned int version;           // version_grafo con la que se calculó (0: nunca)
+    bool tiene_aristas;
+    bool aristas_conexas;           // Los vértices con aristas, en una componente (débil si es dirigido)
+    bool aristas_fuertemente_conexas;   // Dirigido: los vértices con aristas, en una sola CFC
+    bool conexo;                    // Los K vértices, en una componente (débil si es dirigido)
+    bool fuertemente_conexo;        // Dirigido: los K vértices, en una sola CFC
+} Conectividad;
+
+static Conectividad conectividad_cache;
+
+// Tarjan sobre las filas de bits: cada vértice visita solo sus vecinos
+typedef struct {
+    int indice[MAX_NODOS];
+    int bajo[MAX_NODOS];
+    bool en_pila[MAX_NODOS];
+    int pila[MAX_NODOS];
+    int tope;
+    int siguiente;
+    int componente[MAX_NODOS];
+    int num_componentes;
+} EstadoTarjan;
+
+static void tarjan_visitar(EstadoTarjan *t, int v) {
+    t->indice[v] = t->bajo[v] = t->siguiente++;
+    t->pila[t->tope++] = v;
+    t->en_pila[v] = true;
+    
+    const FilaBits *vecinos = &adyacencia_bits.aristas[v];
+    for (int w = siguiente_bit_fila(vecinos, 0); w >= 0; w = siguiente_bit_fila(vecinos, w + 1)) {
+        if (t->indice[w] < 0) {
+            tarjan_visitar(t, w);
+            if (t->bajo[w] < t->bajo[v]) t->bajo[v] = t->bajo[w];
+        } else if (t->en_pila[w] && t->indice[w] < t->bajo[v]) {
+            t->bajo[v] = t->indice[w];
         }
-        return false;
     }
     
-    return backtrack(0);
+    if (t->bajo[v] == t->indice[v]) {
+        int w;
+        do {
+            w = t->pila[--t->tope];
+            t->en_pila[w] = false;
+            t->componente[w] = t->num_componentes;
+        } while (w != v);
+        t->num_componentes++;
+    }
 }
 
-bool tiene_ruta_hamiltoniana() {
-    int K = grafo_actual.K;
-    if (K < 2) return false;
+static const Conectividad *conectividad_actual(void) {
+    Conectividad *c = &conectividad_cache;
+    if (c->version == version_grafo) return c;
     
-    int camino[K];
-    bool visitado[K];
+    int K = grafo_actual.K;
     
-    for (int i = 0; i < K; i++) {
-        visitado[i] = false;
+    // Componentes débiles (en no dirigidos son las componentes): se ignora la
+    // dirección sumando a cada fila su columna y se explora por niveles,
+    // juntando con un OR las filas de toda la frontera
+    FilaBits vecinos[MAX_NODOS];
+    memcpy(vecinos, adyacencia_bits.aristas, (size_t)K * sizeof(FilaBits));
+    if (grafo_actual.tipo == DIRIGIDO) {
+        for (int i = 0; i < K; i++) {
+            const FilaBits *fila = &adyacencia_bits.aristas[i];
+            for (int j = siguiente_bit_fila(fila, 0); j >= 0; j = siguiente_bit_fila(fila, j + 1)) {
+                poner_bit_fila(&vecinos[j], i);
+            }
+        }
     }
     
-    bool backtrack(int pos) {
-        if (pos == K) {
-            return true;
-        }
-        
-        for (int v = 0; v < K; v++) {
-            if (!visitado[v]) {
-                if (pos == 0 || grafo_actual.matriz_adyacencia[camino[pos-1]][v] == 1) {
-                    camino[pos] = v;
-                    visitado[v] = true;
-                    
-                    if (backtrack(pos + 1)) {
-                        return true;
-                    }
-                    
-                    visitado[v] = false;
-                }
+    int componente[MAX_NODOS];
+    int num_componentes = 0;
+    FilaBits visitados;
+    vaciar_fila_bits(&visitados);
+    for (int i = 0; i < K; i++) {
+        if (bit_fila(&visitados, i)) continue;
+        FilaBits frontera;
+        vaciar_fila_bits(&frontera);
+        poner_bit_fila(&frontera, i);
+        poner_bit_fila(&visitados, i);
+        while (!fila_vacia(&frontera)) {
+            FilaBits nuevos;
+            vaciar_fila_bits(&nuevos);
+            for (int v = siguiente_bit_fila(&frontera, 0); v >= 0; v = siguiente_bit_fila(&frontera, v + 1)) {
+                componente[v] = num_componentes;
+                unir_filas(&nuevos, &vecinos[v]);
             }
+            restar_filas(&nuevos, &visitados);
+            unir_filas(&visitados, &nuevos);
+            frontera = nuevos;
         }
-        return false;
+        num_componentes++;
     }
     
-    return backtrack(0);
-}
-
-bool encontrar_ciclo_hamiltoniano(int *secuencia, int *longitud) {
-    int K = grafo_actual.K;
-    if (K < 3) return false;
-    
-    int camino[K];
-    bool visitado[K];
-    
+    // Un vértice tiene aristas si su fila o su columna no están vacías
+    int componente_aristas = -1;
+    c->tiene_aristas = false;
+    c->aristas_conexas = true;
+    c->conexo = K > 0 && num_componentes == 1;
+    bool con_aristas[MAX_NODOS];
     for (int i = 0; i < K; i++) {
-        visitado[i] = false;
+        con_aristas[i] = !fila_vacia(&vecinos[i]);
+        if (!con_aristas[i]) continue;
+        c->tiene_aristas = true;
+        if (componente_aristas == -1) {
+            componente_aristas = componente[i];
+        } else if (componente[i] != componente_aristas) {
+            c->aristas_conexas = false;
+        }
     }
     
-    bool backtrack(int pos) {
-        if (pos == K) {
-            if (grafo_actual.matriz_adyacencia[camino[K-1]][camino[0]] == 1) {
-                for (int i = 0; i < K; i++) {
-                    secuencia[i] = camino[i];
-                }
-                secuencia[K] = camino[0]; // Cerrar el ciclo
-                *longitud = K + 1;
-                return true;
-            }
-            return false;
+    if (grafo_actual.tipo == NO_DIRIGIDO) {
+        c->aristas_fuertemente_conexas = c->aristas_conexas;
+        c->fuertemente_conexo = c->conexo;
+    } else {
+        EstadoTarjan t;
+        t.tope = 0;
+        t.siguiente = 0;
+        t.num_componentes = 0;
+        for (int i = 0; i < K; i++) {
+            t.indice[i] = -1;
+            t.en_pila[i] = false;
+        }
+        for (int i = 0; i < K; i++) {
+            if (t.indice[i] < 0) tarjan_visitar(&t, i);
         }
         
-        for (int v = 0; v < K; v++) {
-            if (!visitado[v]) {
-                if (pos == 0 || grafo_actual.matriz_adyacencia[camino[pos-1]][v] == 1) {
-                    camino[pos] = v;
-                    visitado[v] = true;
-                    
-                    if (backtrack(pos + 1)) {
-                        return true;
-                    }
-                    
-                    visitado[v] = false;
-                }
+        c->fuertemente_conexo = t.num_componentes == 1;
+        int cfc_aristas = -1;
+        c->aristas_fuertemente_conexas = true;
+        for (int i = 0; i < K; i++) {
+            if (!con_aristas[i]) continue;
+            if (cfc_aristas == -1) {
+                cfc_aristas = t.componente[i];
+            } else if (t.componente[i] != cfc_aristas) {
+                c->aristas_fuertemente_conexas = false;
             }
         }
-        return false;
     }
     
-    return backtrack(0);
+    c->version = version_grafo;
+    return c;
 }
 
-bool encontrar_ruta_hamiltoniana(int *secuencia, int *longitud) {
-    int K = grafo_actual.K;
-    if (K < 2) return false;
-    
-    int camino[K];
-    bool visitado[K];
+// Backtracking hamiltoniano sobre las filas 'vecinos' de un grafo de K vértices
+// (las celdas con valor 1, como adyacencia_bits.simples): prueba los vértices
+// en orden y deja en 'camino' los K vértices de la primera solución. Con
+// 'ciclo' además exige la arista del último al primero. Si 'cancelado' no es NULL se consulta en
+// cada llamada y la búsqueda se abandona (devolviendo false) cuando vale 1;
+// así el panel de propiedades puede cortar una búsqueda que quedó vieja.
+// Los candidatos de cada posición son los vecinos del vértice anterior que
+// siguen libres: una intersección de filas de bits, recorrida con ctz.
+typedef struct {
+    int K;
+    bool ciclo;
+    int *camino;
+    FilaBits vecinos[MAX_NODOS];
+    FilaBits libres;                // Vértices que todavía no están en el camino
+    gint *cancelado;
+} BusquedaHamiltoniana;
+
+static bool backtrack_hamiltoniano(BusquedaHamiltoniana *h, int pos) {
+    int K = h->K;
+    if (h->cancelado && g_atomic_int_get(h->cancelado)) return false;
     
-    for (int i = 0; i < K; i++) {
-        visitado[i] = false;
+    if (pos == K) {
+        return !h->ciclo || bit_fila(&h->vecinos[h->camino[K-1]], h->camino[0]);
     }
     
-    bool backtrack(int pos) {
-        if (pos == K) {
-            for (int i = 0; i < K; i++) {
-                secuencia[i] = camino[i];
-            }
-            *longitud = K;
+    FilaBits candidatos = h->libres;
+    if (pos > 0) intersecar_filas(&candidatos, &h->vecinos[h->camino[pos-1]]);
+    for (int v = siguiente_bit_fila(&candidatos, 0); v >= 0; v = siguiente_bit_fila(&candidatos, v + 1)) {
+        h->camino[pos] = v;
+        quitar_bit_fila(&h->libres, v);
+        
+        if (backtrack_hamiltoniano(h, pos + 1)) {
             return true;
         }
         
-        for (int v = 0; v < K; v++) {
-            if (!visitado[v]) {
-                if (pos == 0 || grafo_actual.matriz_adyacencia[camino[pos-1]][v] == 1) {
-                    camino[pos] = v;
-                    visitado[v] = true;
-                    
-                    if (backtrack(pos + 1)) {
-                        return true;
-                    }
-                    
-                    visitado[v] = false;
-                }
-            }
-        }
-        return false;
+        poner_bit_fila(&h->libres, v);
     }
+    return false;
+}
+
+static bool buscar_camino_hamiltoniano(const FilaBits *vecinos, int K, bool ciclo, int *camino, gint *cancelado) {
+    BusquedaHamiltoniana h;
+    h.K = K;
+    h.ciclo = ciclo;
+    h.camino = camino;
+    h.cancelado = cancelado;
+    memcpy(h.vecinos, vecinos, (size_t)K * sizeof(FilaBits));
+    vaciar_fila_bits(&h.libres);
+    for (int i = 0; i < K; i++) {
+        poner_bit_fila(&h.libres, i);
+    }
+    return backtrack_hamiltoniano(&h, 0);
+}
+
+bool tiene_ciclo_hamiltoniano() {
+    int K = grafo_actual.K;
+    if (K < 3) return false;
+    // Un ciclo hamiltoniano pasa por todos los vértices: sin conexidad (fuerte,
+    // si es dirigido) no hace falta el backtracking
+    if (!conectividad_actual()->fuertemente_conexo) return false;
     
-    return backtrack(0);
+    int camino[MAX_NODOS];
+    return buscar_camino_hamiltoniano(adyacencia_bits.simples, K, true, camino, NULL);
 }
 
-bool es_euleriano() {
+bool tiene_ruta_hamiltoniana() {
+    int K = grafo_actual.K;
+    if (K < 2) return false;
+    // Una ruta hamiltoniana necesita al menos conexidad débil
+    if (!conectividad_actual()->conexo) return false;
+    
+    int camino[MAX_NODOS];
+    return buscar_camino_hamiltoniano(adyacencia_bits.simples, K, false, camino, NULL);
+}
+
+bool encontrar_ciclo_hamiltoniano(int *secuencia, int *longitud) {
+    int K = grafo_actual.K;
+    if (K < 3) return false;
+    if (!conectividad_actual()->fuertemente_conexo) return false;
+    
+    if (!buscar_camino_hamiltoniano(adyacencia_bits.simples, K, true, secuencia, NULL)) return false;
+    secuencia[K] = secuencia[0]; // Cerrar el ciclo
+    *longitud = K + 1;
+    return true;
+}
+
+bool encontrar_ruta_hamiltoniana(int *secuencia, int *longitud) {
     int K = grafo_actual.K;
+    if (K < 2) return false;
+    if (!conectividad_actual()->conexo) return false;
+    
+    if (!buscar_camino_hamiltoniano(adyacencia_bits.simples, K, false, secuencia, NULL)) return false;
+    *longitud = K;
+    return true;
+}
+
+// Además de los grados, todas las aristas tienen que estar en una misma
+// componente (una sola CFC en dirigidos); los vértices aislados no cuentan
+bool es_euleriano() {
+    const Conectividad *conectividad = conectividad_actual();
+    if (!conectividad->tiene_aristas) return false;
     
     if (grafo_actual.tipo == NO_DIRIGIDO) {
-        bool tiene_aristas = false;
-        for (int i = 0; i < K; i++) {
-            for (int j = 0; j < K; j++) {
-                if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                    tiene_aristas = true;
-                    break;
-                }
-            }
-            if (tiene_aristas) break;
-        }
-        if (!tiene_aristas) return false;
-        
-        for (int i = 0; i < K; i++) {
-            int grado = 0;
-            for (int j = 0; j < K; j++) {
-                if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                    grado++;
-                }
-            }
-            if (grado % 2 != 0) {
-                return false;
-            }
-        }
-        return true;
+        return conectividad->aristas_conexas && grados_actual.nodos_grado_impar == 0;
     } else {
-        for (int i = 0; i < K; i++) {
-            int grado_entrada = 0;
-            int grado_salida = 0;
-            
-            for (int j = 0; j < K; j++) {
-                if (grafo_actual.matriz_adyacencia[j][i] == 1) {
-                    grado_entrada++;
-                }
-                if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                    grado_salida++;
-                }
-            }
-            
-            if (grado_entrada != grado_salida) {
-                return false;
-            }
-        }
-        return true;
+        return conectividad->aristas_fuertemente_conexas && grados_actual.nodos_desbalanceados == 0;
     }
 }
 
+// Con los grados de una ruta basta la conexidad débil de las aristas
 bool es_semieuleriano() {
     if (es_euleriano()) return false;
-    
-    int K = grafo_actual.K;
+    if (!conectividad_actual()->aristas_conexas) return false;
     
     if (grafo_actual.tipo == NO_DIRIGIDO) {
-        int nodos_grado_impar = 0;
-        
-        for (int i = 0; i < K; i++) {
-            int grado = 0;
-            for (int j = 0; j < K; j++) {
-                if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                    grado++;
-                }
-            }
-            if (grado % 2 != 0) {
-                nodos_grado_impar++;
-            }
-        }
-        
-        return nodos_grado_impar == 2;
+        return grados_actual.nodos_grado_impar == 2;
     } else {
-        int nodo_inicio = -1, nodo_fin = -1;
-        
-        for (int i = 0; i < K; i++) {
-            int grado_entrada = 0;
-            int grado_salida = 0;
-            
-            for (int j = 0; j < K; j++) {
-                if (grafo_actual.matriz_adyacencia[j][i] == 1) {
-                    grado_entrada++;
-                }
-                if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                    grado_salida++;
-                }
-            }
-            
-            int diferencia = grado_salida - grado_entrada;
-            if (diferencia == 1) {
-                if (nodo_inicio == -1) {
-                    nodo_inicio = i;
-                } else {
-                    return false; // Más de un nodo con diferencia +1
-                }
-            } else if (diferencia == -1) {
-                if (nodo_fin == -1) {
-                    nodo_fin = i;
-                } else {
-                    return false; // Más de un nodo con diferencia -1
-                }
-            } else if (diferencia != 0) {
-                return false;
-            }
-        }
-        
-        return (nodo_inicio != -1 && nodo_fin != -1);
+        // Un vértice con una salida de más (inicio), otro con una entrada de más (fin)
+        return grados_actual.nodos_desbalanceados == 2 &&
+               grados_actual.nodos_inicio == 1 && grados_actual.nodos_fin == 1;
     }
 }
 
 void calcular_grados_no_dirigido(int *grados) {
-    int K = grafo_actual.K;
-    for (int i = 0; i < K; i++) {
-        grados[i] = 0;
-        for (int j = 0; j < K; j++) {
-            if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                grados[i]++;
-            }
-        }
-    }
+    memcpy(grados, grados_actual.grado_salida, grafo_actual.K * sizeof(int));
 }
 
 void calcular_grados_dirigido(int *grados_entrada, int *grados_salida) {
-    int K = grafo_actual.K;
-    for (int i = 0; i < K; i++) {
-        grados_entrada[i] = 0;
-        grados_salida[i] = 0;
-        for (int j = 0; j < K; j++) {
-            if (grafo_actual.matriz_adyacencia[j][i] == 1) {
-                grados_entrada[i]++;
-            }
-            if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                grados_salida[i]++;
-            }
-        }
+    memcpy(grados_entrada, grados_actual.grado_entrada, grafo_actual.K * sizeof(int));
+    memcpy(grados_salida, grados_actual.grado_salida, grafo_actual.K * sizeof(int));
+}
+
+// Los recorridos trabajan sobre una copia de la matriz (cuántas aristas quedan
+// en cada celda) y sus filas de bits (qué celdas tienen alguna): la siguiente
+// arista desde u es el primer bit de su fila. Quita una arista u -> v de la
+// copia, y su simétrica en no dirigidos, apagando el bit de las celdas vaciadas.
+static void quitar_arista_copia(int matriz[MAX_NODOS][MAX_NODOS], FilaBits *filas, int u, int v) {
+    matriz[u][v]--;
+    if (matriz[u][v] <= 0) quitar_bit_fila(&filas[u], v);
+    if (grafo_actual.tipo == NO_DIRIGIDO) {
+        matriz[v][u]--;
+        if (matriz[v][u] <= 0) quitar_bit_fila(&filas[v], u);
     }
 }
 
-// Algoritmo de Hierholzer para encontrar ciclo euleriano
-int encontrar_ciclo_euleriano_hierholzer(int *secuencia) {
-    int K = grafo_actual.K;
-    if (!es_euleriano()) return 0;
-    
+// Primer vértice con alguna arista saliente, o 0 si no hay ninguna
+static int primer_vertice_con_aristas(const FilaBits *filas) {
+    for (int i = 0; i < grafo_actual.K; i++) {
+        if (!fila_vacia(&filas[i])) return i;
+    }
+    return 0;
+}
+
+// Núcleo de Hierholzer desde 'inicio': sirve para el ciclo y para la ruta, porque
+// desde el extremo correcto el recorrido termina solo en el otro extremo. O(m)
+// más un ctz por arista para encontrar la siguiente.
+static int hierholzer_desde(int inicio, int *secuencia) {
     // Crear copia de la matriz de adyacencia para modificar
     int matriz_copia[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_copia[i][j] = grafo_actual.matriz_adyacencia[i][j];
-        }
-    }
-    
-    // Encontrar vértice inicial (cualquier vértice con aristas)
-    int inicio = 0;
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            if (matriz_copia[i][j] > 0) {
-                inicio = i;
-                goto encontrado;
-            }
-        }
-    }
-    encontrado:
+    FilaBits filas[MAX_NODOS];
+    memcpy(matriz_copia, grafo_actual.matriz_adyacencia, sizeof(matriz_copia));
+    memcpy(filas, adyacencia_bits.aristas, sizeof(filas));
     
     // Pila para el algoritmo
     int pila[MAX_NODOS * MAX_NODOS];
     int top = 0;
     pila[top++] = inicio;
     
-    int resultado[MAX_NODOS * MAX_NODOS];
     int res_len = 0;
     
     while (top > 0) {
         int u = pila[top - 1];
         
         // Buscar arista no usada desde u
-        int v = -1;
-        for (int i = 0; i < K; i++) {
-            if (matriz_copia[u][i] > 0) {
-                v = i;
-                break;
-            }
-        }
+        int v = siguiente_bit_fila(&filas[u], 0);
         
         if (v != -1) {
-            // Remover arista
-            matriz_copia[u][v]--;
-            if (grafo_actual.tipo == NO_DIRIGIDO) {
-                matriz_copia[v][u]--;
-            }
+            quitar_arista_copia(matriz_copia, filas, u, v);
             pila[top++] = v;
         } else {
-            // No hay más aristas, agregar a resultado
-            resultado[res_len++] = u;
+            // No hay más aristas: el vértice sale de la pila y va directo a la secuencia
+            secuencia[res_len++] = u;
             top--;
         }
     }
     
-    // Copiar resultado invertido (Hierholzer produce resultado al revés)
-    for (int i = 0; i < res_len; i++) {
-        secuencia[i] = resultado[res_len - 1 - i];
+    // Hierholzer produce el recorrido al revés; se invierte en el mismo arreglo
+    // (para grafos grandes, recorrido_euleriano_csr lo emite sin guardarlo)
+    for (int i = 0, j = res_len - 1; i < j; i++, j--) {
+        int t = secuencia[i];
+        secuencia[i] = secuencia[j];
+        secuencia[j] = t;
     }
     
     return res_len;
 }
 
-// Algoritmo de Hierholzer paso a paso para visualización
-int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierholzer *pasos, int *num_pasos) {
+// Algoritmo de Hierholzer para encontrar ciclo euleriano
+int encontrar_ciclo_euleriano_hierholzer(int *secuencia) {
+    if (!es_euleriano()) return 0;
+    return hierholzer_desde(primer_vertice_con_aristas(adyacencia_bits.aristas), secuencia);
+}
+
+// Extremo inicial de la ruta euleriana: el primer vértice de grado impar (no
+// dirigido) o con más salidas que entradas (dirigido). Los grados cuentan las
+// aristas repetidas, así que se suman las celdas marcadas en las filas.
+static int inicio_ruta_euleriana(void) {
+    int K = grafo_actual.K;
+    int grado_entrada[MAX_NODOS] = {0};
+    int grado_salida[MAX_NODOS] = {0};
+    for (int i = 0; i < K; i++) {
+        const FilaBits *vecinos = &adyacencia_bits.aristas[i];
+        for (int j = siguiente_bit_fila(vecinos, 0); j >= 0; j = siguiente_bit_fila(vecinos, j + 1)) {
+            grado_salida[i] += grafo_actual.matriz_adyacencia[i][j];
+            grado_entrada[j] += grafo_actual.matriz_adyacencia[i][j];
+        }
+    }
+    for (int i = 0; i < K; i++) {
+        if (grafo_actual.tipo == NO_DIRIGIDO ? grado_salida[i] % 2 == 1 : grado_salida[i] > grado_entrada[i]) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+// Ruta euleriana con Hierholzer: arranca en un extremo y termina en el otro, en
+// tiempo lineal en las aristas (Fleury queda solo para la traza del reporte)
+int encontrar_ruta_euleriana_hierholzer(int *secuencia) {
+    if (!es_semieuleriano()) return 0;
+    return hierholzer_desde(inicio_ruta_euleriana(), secuencia);
+}
+
+// Algoritmo de Hierholzer paso a paso para visualización. Las fotos de cada paso
+// (hasta MAX_PASOS) van a 'pasos' y los cambios de todos los pasos a 'traza';
+// cualquiera de los dos puede ser NULL. Lo mismo en las versiones de Fleury.
+int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierholzer *pasos, int *num_pasos, Traza *traza) {
     int K = grafo_actual.K;
     if (!es_euleriano()) return 0;
     
@@ -1031,26 +1319,16 @@ int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierhol
     
     // Crear copia de la matriz de adyacencia para modificar
     int matriz_copia[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_copia[i][j] = grafo_actual.matriz_adyacencia[i][j];
-        }
-    }
+    FilaBits filas[MAX_NODOS];
+    memcpy(matriz_copia, grafo_actual.matriz_adyacencia, sizeof(matriz_copia));
+    memcpy(filas, adyacencia_bits.aristas, sizeof(filas));
     
     // Encontrar vértice inicial
-    int inicio = 0;
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            if (matriz_copia[i][j] > 0) {
-                inicio = i;
-                goto encontrado;
-            }
-        }
-    }
-    encontrado:
+    int inicio = primer_vertice_con_aristas(filas);
+    if (traza) iniciar_traza(traza, &grafo_actual, inicio);
     
     // Guardar paso inicial
-    if (*num_pasos < MAX_PASOS) {
+    if (pasos && *num_pasos < MAX_PASOS) {
         PasoHierholzer *p = &pasos[*num_pasos];
         for (int i = 0; i < K; i++) {
             for (int j = 0; j < K; j++) {
@@ -1088,17 +1366,11 @@ int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierhol
         int u = pila[top - 1];
         
         // Buscar arista no usada desde u
-        int v = -1;
-        for (int i = 0; i < K; i++) {
-            if (matriz_copia[u][i] > 0) {
-                v = i;
-                break;
-            }
-        }
+        int v = siguiente_bit_fila(&filas[u], 0);
         
         if (v != -1) {
             // Guardar paso: agregar arista
-            if (*num_pasos < MAX_PASOS) {
+            if (pasos && *num_pasos < MAX_PASOS) {
                 PasoHierholzer *p = &pasos[*num_pasos];
                 for (int i = 0; i < K; i++) {
                     for (int j = 0; j < K; j++) {
@@ -1125,10 +1397,8 @@ int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierhol
             }
             
             // Remover arista
-            matriz_copia[u][v]--;
-            if (grafo_actual.tipo == NO_DIRIGIDO) {
-                matriz_copia[v][u]--;
-            }
+            if (traza) traza_avanzar(traza, u, v, false);
+            quitar_arista_copia(matriz_copia, filas, u, v);
             pila[top++] = v;
             camino_actual[len_camino++] = v;
         } else {
@@ -1158,7 +1428,7 @@ int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierhol
                 num_ciclos_completos++;
                 
                 // Guardar paso: completar ciclo
-                if (*num_pasos < MAX_PASOS) {
+                if (pasos && *num_pasos < MAX_PASOS) {
                     PasoHierholzer *p = &pasos[*num_pasos];
                     for (int i = 0; i < K; i++) {
                         for (int j = 0; j < K; j++) {
@@ -1192,6 +1462,9 @@ int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierhol
                 len_camino--;
             }
             
+            if (traza) {
+                traza_retroceder(traza, encontrado_en_camino >= 0 || (u == inicio && res_len > 1));
+            }
             top--;
         }
     }
@@ -1204,119 +1477,169 @@ int encontrar_ciclo_euleriano_hierholzer_paso_a_paso(int *secuencia, PasoHierhol
     return res_len;
 }
 
-// Función para generar diagrama TikZ de un paso de Hierholzer
-void generar_tikz_paso_hierholzer(FILE *f, PasoHierholzer *paso, int paso_num, int min_x, int min_y, double escala) {
-    (void)paso_num;  // Parámetro no usado, pero se mantiene para consistencia de interfaz
+// Calcula el encuadre común de todas las figuras: desplazamiento mínimo y escala
+void calcular_encuadre_tikz(int *min_x, int *min_y, double *escala) {
     int K = grafo_actual.K;
+    int max_x = grafo_actual.posiciones[0].x;
+    int max_y = grafo_actual.posiciones[0].y;
+    *min_x = grafo_actual.posiciones[0].x;
+    *min_y = grafo_actual.posiciones[0].y;
+    
+    for (int i = 1; i < K; i++) {
+        if (grafo_actual.posiciones[i].x < *min_x) *min_x = grafo_actual.posiciones[i].x;
+        if (grafo_actual.posiciones[i].x > max_x) max_x = grafo_actual.posiciones[i].x;
+        if (grafo_actual.posiciones[i].y < *min_y) *min_y = grafo_actual.posiciones[i].y;
+        if (grafo_actual.posiciones[i].y > max_y) max_y = grafo_actual.posiciones[i].y;
+    }
     
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=%.2f]\n", escala);
+    double ancho = (max_x - *min_x > 0) ? (max_x - *min_x) : 1.0;
+    double alto = (max_y - *min_y > 0) ? (max_y - *min_y) : 1.0;
+    *escala = 12.0 / (ancho > alto ? ancho : alto);
+}
+
+// Escribe en el preámbulo los estilos, coordenadas y macros que comparten todas las
+// figuras del grafo. Cada figura solo lista qué aristas dibujar con cada estilo.
+void generar_definiciones_tikz(BufferTexto *b) {
+    int K = grafo_actual.K;
+    int min_x, min_y;
+    double escala;
+    calcular_encuadre_tikz(&min_x, &min_y, &escala);
+    
+    buffer_agregar(b, "\\tikzset{\n");
+    buffer_agregar(b, "  lienzo/.style={scale=");
+    buffer_agregar_fijo(b, escala, 2);
+    buffer_agregar(b, "},\n");
+    buffer_agregar(b, grafo_actual.tipo == DIRIGIDO ? "  sentido/.style={->},\n" : "  sentido/.style={},\n");
+    buffer_agregar(b, "  nodo/.style={circle, draw=black, fill=white, minimum size=0.8cm, font=\\scriptsize},\n");
+    buffer_agregar(b, "  arista/.style={sentido, thick},\n");
+    buffer_agregar(b, "  restante/.style={sentido, gray!40, dashed, thick},\n");
+    buffer_agregar(b, "  completo/.style={sentido, very thick},\n");
+    buffer_agregar(b, "  actual/.style={sentido, red, ultra thick},\n");
+    buffer_agregar(b, "  ruta/.style={sentido, blue, very thick},\n");
+    buffer_agregar(b, "  elegida/.style={sentido, ultra thick}\n");
+    buffer_agregar(b, "}\n");
+    
+    // Posiciones de los nodos, relativas a la esquina inferior izquierda del grafo
+    buffer_agregar(b, "\\newcommand{\\coordenadasgrafo}{");
+    for (int i = 0; i < K; i++) {
+        buffer_agregar(b, "\\coordinate (c");
+        buffer_agregar_entero(b, i);
+        buffer_agregar(b, ") at (");
+        buffer_agregar_entero(b, grafo_actual.posiciones[i].x - min_x);
+        buffer_agregar_caracter(b, ',');
+        buffer_agregar_entero(b, grafo_actual.posiciones[i].y - min_y);
+        buffer_agregar(b, ");");
+    }
+    buffer_agregar(b, "}\n");
+    
+    // \nodosgrafo dibuja todos los nodos con el estilo base; \nodoscolor{i/relleno/texto,...}
+    // y \resaltar{i}{relleno} cambian el relleno de nodos concretos
+    buffer_agregar(b, "\\newcommand{\\nodosgrafo}{\\coordenadasgrafo\\foreach \\i in {0,...,");
+    buffer_agregar_entero(b, K - 1);
+    buffer_agregar(b, "} {\\node[nodo] (n\\i) at (c\\i) {\\i};}}\n");
+    buffer_agregar(b, "\\newcommand{\\nodoscolor}[1]{\\coordenadasgrafo\\foreach \\i/\\relleno/\\letra in {#1} {\\node[nodo, fill=\\relleno, text=\\letra] (n\\i) at (c\\i) {\\i};}}\n");
+    buffer_agregar(b, "\\newcommand{\\resaltar}[2]{\\node[nodo, fill=#2] (n#1) at (c#1) {#1};}\n");
+    // \aristas{estilo}{u/v,...} dibuja un conjunto de aristas entre nodos ya colocados
+    buffer_agregar(b, "\\newcommand{\\aristas}[2]{\\foreach \\u/\\v in {#2} {\\draw[#1] (n\\u) -- (n\\v);}}\n");
+}
+
+// Emite "\aristas{estilo}{...}" con las aristas presentes en la matriz
+void generar_tikz_aristas_matriz(BufferTexto *b, const char *estilo, int matriz[MAX_NODOS][MAX_NODOS]) {
+    int K = grafo_actual.K;
+    bool primera = true;
     
-    // Dibujar aristas no usadas (grises)
     for (int i = 0; i < K; i++) {
         for (int j = 0; j < K; j++) {
-            if (paso->matriz_restante[i][j] > 0) {
-                double x1 = grafo_actual.posiciones[i].x - min_x;
-                double y1 = grafo_actual.posiciones[i].y - min_y;
-                double x2 = grafo_actual.posiciones[j].x - min_x;
-                double y2 = grafo_actual.posiciones[j].y - min_y;
-                
-                if (grafo_actual.tipo == DIRIGIDO) {
-                    fprintf(f, "\\draw[->, gray!40, dashed, thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
+            if (matriz[i][j] > 0 && (grafo_actual.tipo == DIRIGIDO || i < j)) {
+                if (primera) {
+                    buffer_agregar(b, "\\aristas{");
+                    buffer_agregar(b, estilo);
+                    buffer_agregar(b, "}{");
+                    primera = false;
                 } else {
-                    if (i < j) {
-                        fprintf(f, "\\draw[gray!40, dashed, thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-                    }
+                    buffer_agregar_caracter(b, ',');
                 }
+                buffer_agregar_entero(b, i);
+                buffer_agregar_caracter(b, '/');
+                buffer_agregar_entero(b, j);
             }
         }
     }
     
+    if (!primera) {
+        buffer_agregar(b, "}\n");
+    }
+}
+
+// Emite "\aristas{estilo}{...}" con las aristas consecutivas de una secuencia de vértices
+void generar_tikz_aristas_secuencia(BufferTexto *b, const char *estilo, const int *secuencia, int longitud) {
+    if (longitud < 2) return;
+    
+    buffer_agregar(b, "\\aristas{");
+    buffer_agregar(b, estilo);
+    buffer_agregar(b, "}{");
+    for (int i = 0; i < longitud - 1; i++) {
+        if (i > 0) buffer_agregar_caracter(b, ',');
+        buffer_agregar_entero(b, secuencia[i]);
+        buffer_agregar_caracter(b, '/');
+        buffer_agregar_entero(b, secuencia[i + 1]);
+    }
+    buffer_agregar(b, "}\n");
+}
+
+// Función para generar diagrama TikZ de un paso de Hierholzer
+void generar_tikz_paso_hierholzer(BufferTexto *b, PasoHierholzer *paso, int paso_num) {
+    (void)paso_num;  // Parámetro no usado, pero se mantiene para consistencia de interfaz
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[lienzo]\n");
+    buffer_agregar(b, "\\nodosgrafo\n");
+    
+    // Dibujar aristas no usadas (grises)
+    generar_tikz_aristas_matriz(b, "restante", paso->matriz_restante);
+    
     // Dibujar ciclos completos en diferentes colores (no usar rojo, reservado para ciclo actual)
     const char *colores_ciclos[] = {"blue", "green!70!black", "orange", "purple", "brown", "cyan"};
     for (int c = 0; c < paso->num_ciclos_completos; c++) {
-        const char *color = colores_ciclos[c % 6];
-        for (int i = 0; i < paso->len_ciclos_completos[c] - 1; i++) {
-            int u = paso->ciclos_completos[c][i];
-            int v = paso->ciclos_completos[c][i + 1];
-            double x1 = grafo_actual.posiciones[u].x - min_x;
-            double y1 = grafo_actual.posiciones[u].y - min_y;
-            double x2 = grafo_actual.posiciones[v].x - min_x;
-            double y2 = grafo_actual.posiciones[v].y - min_y;
-            
-            if (grafo_actual.tipo == DIRIGIDO) {
-                fprintf(f, "\\draw[->, %s, very thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", color, x1, y1, x2, y2);
-            } else {
-                fprintf(f, "\\draw[%s, very thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", color, x1, y1, x2, y2);
-            }
-        }
+        char estilo[64];
+        snprintf(estilo, sizeof(estilo), "completo, %s", colores_ciclos[c % 6]);
+        generar_tikz_aristas_secuencia(b, estilo, paso->ciclos_completos[c], paso->len_ciclos_completos[c]);
     }
     
     // Dibujar ciclo actual en construcción (rojo más intenso)
-    if (paso->len_ciclo_actual > 1) {
-        for (int i = 0; i < paso->len_ciclo_actual - 1; i++) {
-            int u = paso->ciclo_actual[i];
-            int v = paso->ciclo_actual[i + 1];
-            double x1 = grafo_actual.posiciones[u].x - min_x;
-            double y1 = grafo_actual.posiciones[u].y - min_y;
-            double x2 = grafo_actual.posiciones[v].x - min_x;
-            double y2 = grafo_actual.posiciones[v].y - min_y;
-            
-            if (grafo_actual.tipo == DIRIGIDO) {
-                fprintf(f, "\\draw[->, red, ultra thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-            } else {
-                fprintf(f, "\\draw[red, ultra thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-            }
-        }
-    }
+    generar_tikz_aristas_secuencia(b, "actual", paso->ciclo_actual, paso->len_ciclo_actual);
     
-    // Dibujar nodos
-    for (int i = 0; i < K; i++) {
-        double x = grafo_actual.posiciones[i].x - min_x;
-        double y = grafo_actual.posiciones[i].y - min_y;
-        fprintf(f, "\\node[circle, draw=black, fill=white, minimum size=0.8cm, font=\\scriptsize] (n%d) at (%.2f,%.2f) {%d};\n",
-                i, x, y, i);
-    }
-    
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
 }
 
 // Función auxiliar para contar componentes conexas usando DFS
-int contar_componentes(int matriz[MAX_NODOS][MAX_NODOS], int K) {
-    bool visitado[MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        visitado[i] = false;
-    }
+// Cuenta las componentes entre los vértices con aristas salientes. Cada una
+// se explora por niveles: los vecinos de toda la frontera se juntan con un OR
+// de filas y se descartan los ya visitados con una resta, palabra por palabra.
+int contar_componentes(const FilaBits *filas, int K) {
+    FilaBits visitados;
+    vaciar_fila_bits(&visitados);
     
     int componentes = 0;
     for (int i = 0; i < K; i++) {
-        // Verificar si el vértice tiene aristas
-        bool tiene_aristas = false;
-        for (int j = 0; j < K; j++) {
-            if (matriz[i][j] > 0) {
-                tiene_aristas = true;
-                break;
-            }
-        }
-        
-        if (tiene_aristas && !visitado[i]) {
-            componentes++;
-            // DFS para marcar todos los vértices conectados
-            int pila[MAX_NODOS];
-            int top = 0;
-            pila[top++] = i;
-            visitado[i] = true;
-            
-            while (top > 0) {
-                int actual = pila[--top];
-                for (int j = 0; j < K; j++) {
-                    if (matriz[actual][j] > 0 && !visitado[j]) {
-                        visitado[j] = true;
-                        pila[top++] = j;
-                    }
-                }
+        if (fila_vacia(&filas[i]) || bit_fila(&visitados, i)) continue;
+        
+        componentes++;
+        FilaBits frontera;
+        vaciar_fila_bits(&frontera);
+        poner_bit_fila(&frontera, i);
+        poner_bit_fila(&visitados, i);
+        
+        while (!fila_vacia(&frontera)) {
+            FilaBits nuevos;
+            vaciar_fila_bits(&nuevos);
+            for (int v = siguiente_bit_fila(&frontera, 0); v >= 0; v = siguiente_bit_fila(&frontera, v + 1)) {
+                unir_filas(&nuevos, &filas[v]);
             }
+            restar_filas(&nuevos, &visitados);
+            unir_filas(&visitados, &nuevos);
+            frontera = nuevos;
         }
     }
     
@@ -1324,60 +1647,57 @@ int contar_componentes(int matriz[MAX_NODOS][MAX_NODOS], int K) {
 }
 
 // Función auxiliar para verificar si una arista es un puente
-// Un puente es una arista cuya eliminación desconecta el grafo
-bool es_puente(int matriz[MAX_NODOS][MAX_NODOS], int u, int v, int K) {
-    // Contar componentes antes de eliminar la arista
-    int componentes_antes = contar_componentes(matriz, K);
-    
-    // Crear copia temporal de la matriz
-    int matriz_temp[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_temp[i][j] = matriz[i][j];
-        }
-    }
+// Un puente es una arista cuya eliminación desconecta el grafo. 'matriz' y
+// 'filas' son la copia de trabajo del recorrido (ver quitar_arista_copia).
+bool es_puente(int matriz[MAX_NODOS][MAX_NODOS], const FilaBits *filas, int u, int v, int K) {
+    if (matriz[u][v] <= 0) return false; // La arista no existe
     
-    // Eliminar la arista temporalmente
-    if (matriz_temp[u][v] > 0) {
-        matriz_temp[u][v]--;
-        if (grafo_actual.tipo == NO_DIRIGIDO) {
-            matriz_temp[v][u]--;
-        }
-    } else {
-        return false; // La arista no existe
+    // Contar componentes antes de eliminar la arista
+    int componentes_antes = contar_componentes(filas, K);
+    
+    // Eliminar la arista de una copia de las filas: con aristas repetidas la
+    // celda sigue marcada. En un lazo no dirigido la celda se descuenta dos
+    // veces, igual que al recorrerlo.
+    FilaBits filas_temp[MAX_NODOS];
+    memcpy(filas_temp, filas, (size_t)K * sizeof(FilaBits));
+    int quedan = matriz[u][v] - 1;
+    if (grafo_actual.tipo == NO_DIRIGIDO && u == v) quedan--;
+    if (quedan <= 0) quitar_bit_fila(&filas_temp[u], v);
+    if (grafo_actual.tipo == NO_DIRIGIDO && u != v && matriz[v][u] - 1 <= 0) {
+        quitar_bit_fila(&filas_temp[v], u);
     }
     
     // Contar componentes después de eliminar la arista
-    int componentes_despues = contar_componentes(matriz_temp, K);
+    int componentes_despues = contar_componentes(filas_temp, K);
     
     // Si el número de componentes aumenta, la arista es un puente
     return componentes_despues > componentes_antes;
 }
 
+// Suma de las celdas de la copia de trabajo: cada arista no dirigida cuenta
+// dos veces. Los recorridos la descuentan al quitar cada arista.
+static int sumar_celdas_copia(int matriz[MAX_NODOS][MAX_NODOS], const FilaBits *filas) {
+    int total = 0;
+    for (int i = 0; i < grafo_actual.K; i++) {
+        for (int j = siguiente_bit_fila(&filas[i], 0); j >= 0; j = siguiente_bit_fila(&filas[i], j + 1)) {
+            total += matriz[i][j];
+        }
+    }
+    return total;
+}
+
 // Algoritmo de Fleury para encontrar ciclo euleriano
 int encontrar_ciclo_euleriano_fleury(int *secuencia) {
-    int K = grafo_actual.K;
     if (!es_euleriano()) return 0;
     
     // Crear copia de la matriz
     int matriz_copia[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_copia[i][j] = grafo_actual.matriz_adyacencia[i][j];
-        }
-    }
+    FilaBits filas[MAX_NODOS];
+    memcpy(matriz_copia, grafo_actual.matriz_adyacencia, sizeof(matriz_copia));
+    memcpy(filas, adyacencia_bits.aristas, sizeof(filas));
     
     // Encontrar vértice inicial
-    int inicio = 0;
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            if (matriz_copia[i][j] > 0) {
-                inicio = i;
-                goto encontrado_fleury;
-            }
-        }
-    }
-    encontrado_fleury:
+    int inicio = primer_vertice_con_aristas(filas);
     
     int resultado[MAX_NODOS * MAX_NODOS];
     int res_len = 0;
@@ -1385,42 +1705,19 @@ int encontrar_ciclo_euleriano_fleury(int *secuencia) {
     
     resultado[res_len++] = actual;
     
+    int aristas_restantes = sumar_celdas_copia(matriz_copia, filas);
     while (true) {
-        // Contar aristas restantes
-        int aristas_restantes = 0;
-        for (int i = 0; i < K; i++) {
-            for (int j = 0; j < K; j++) {
-                aristas_restantes += matriz_copia[i][j];
-            }
-        }
         if (aristas_restantes == 0) break;
         
-        // Buscar siguiente arista (preferir no-puente)
-        int siguiente = -1;
-        for (int i = 0; i < K; i++) {
-            if (matriz_copia[actual][i] > 0) {
-                // Verificar si es puente (simplificado)
-                siguiente = i;
-                // Si solo hay una arista, debe usarla
-                int grado_actual = 0;
-                for (int j = 0; j < K; j++) {
-                    grado_actual += matriz_copia[actual][j];
-                }
-                if (grado_actual == 1) {
-                    break; // Debe usar esta arista
-                }
-                // Si hay más opciones, usar la primera (simplificación)
-                break;
-            }
-        }
+        // Siguiente arista: la primera disponible (simplificación, sin
+        // comprobar puentes)
+        int siguiente = siguiente_bit_fila(&filas[actual], 0);
         
         if (siguiente == -1) break;
         
         // Remover arista
-        matriz_copia[actual][siguiente]--;
-        if (grafo_actual.tipo == NO_DIRIGIDO) {
-            matriz_copia[siguiente][actual]--;
-        }
+        quitar_arista_copia(matriz_copia, filas, actual, siguiente);
+        aristas_restantes -= grafo_actual.tipo == NO_DIRIGIDO ? 2 : 1;
         
         actual = siguiente;
         resultado[res_len++] = actual;
@@ -1434,7 +1731,7 @@ int encontrar_ciclo_euleriano_fleury(int *secuencia) {
 }
 
 // Algoritmo de Fleury paso a paso para encontrar ciclo euleriano
-int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos) {
+int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos, Traza *traza) {
     int K = grafo_actual.K;
     if (!es_euleriano()) return 0;
     
@@ -1442,26 +1739,16 @@ int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pas
     
     // Crear copia de la matriz
     int matriz_copia[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_copia[i][j] = grafo_actual.matriz_adyacencia[i][j];
-        }
-    }
+    FilaBits filas[MAX_NODOS];
+    memcpy(matriz_copia, grafo_actual.matriz_adyacencia, sizeof(matriz_copia));
+    memcpy(filas, adyacencia_bits.aristas, sizeof(filas));
     
     // Encontrar vértice inicial
-    int inicio = 0;
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            if (matriz_copia[i][j] > 0) {
-                inicio = i;
-                goto encontrado_fleury_paso;
-            }
-        }
-    }
-    encontrado_fleury_paso:
+    int inicio = primer_vertice_con_aristas(filas);
+    if (traza) iniciar_traza(traza, &grafo_actual, inicio);
     
     // Guardar paso inicial
-    if (*num_pasos < MAX_PASOS) {
+    if (pasos && *num_pasos < MAX_PASOS) {
         PasoFleury *p = &pasos[*num_pasos];
         for (int i = 0; i < K; i++) {
             for (int j = 0; j < K; j++) {
@@ -1486,14 +1773,8 @@ int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pas
     
     resultado[res_len++] = actual;
     
+    int aristas_restantes = sumar_celdas_copia(matriz_copia, filas);
     while (true) {
-        // Contar aristas restantes
-        int aristas_restantes = 0;
-        for (int i = 0; i < K; i++) {
-            for (int j = 0; j < K; j++) {
-                aristas_restantes += matriz_copia[i][j];
-            }
-        }
         if (aristas_restantes == 0) break;
         
         // Buscar siguiente arista (preferir no-puente)
@@ -1502,32 +1783,28 @@ int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pas
         bool hay_no_puente = false;
         
         // Primero, buscar aristas que NO sean puentes
-        for (int i = 0; i < K; i++) {
-            if (matriz_copia[actual][i] > 0) {
-                if (!es_puente(matriz_copia, actual, i, K)) {
-                    siguiente = i;
-                    hay_no_puente = true;
-                    es_puente_elegido = 0;
-                    break;
-                }
+        const FilaBits *vecinos = &filas[actual];
+        for (int i = siguiente_bit_fila(vecinos, 0); i >= 0; i = siguiente_bit_fila(vecinos, i + 1)) {
+            if (!es_puente(matriz_copia, filas, actual, i, K)) {
+                siguiente = i;
+                hay_no_puente = true;
+                es_puente_elegido = 0;
+                break;
             }
         }
         
         // Si no hay aristas no-puente, usar cualquier arista disponible
         if (!hay_no_puente) {
-            for (int i = 0; i < K; i++) {
-                if (matriz_copia[actual][i] > 0) {
-                    siguiente = i;
-                    es_puente_elegido = es_puente(matriz_copia, actual, i, K) ? 1 : 0;
-                    break;
-                }
+            siguiente = siguiente_bit_fila(vecinos, 0);
+            if (siguiente >= 0) {
+                es_puente_elegido = es_puente(matriz_copia, filas, actual, siguiente, K) ? 1 : 0;
             }
         }
         
         if (siguiente == -1) break;
         
         // Guardar paso antes de eliminar la arista
-        if (*num_pasos < MAX_PASOS) {
+        if (pasos && *num_pasos < MAX_PASOS) {
             PasoFleury *p = &pasos[*num_pasos];
             for (int i = 0; i < K; i++) {
                 for (int j = 0; j < K; j++) {
@@ -1557,17 +1834,16 @@ int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pas
         }
         
         // Remover arista
-        matriz_copia[actual][siguiente]--;
-        if (grafo_actual.tipo == NO_DIRIGIDO) {
-            matriz_copia[siguiente][actual]--;
-        }
+        if (traza) traza_avanzar(traza, actual, siguiente, es_puente_elegido);
+        quitar_arista_copia(matriz_copia, filas, actual, siguiente);
+        aristas_restantes -= grafo_actual.tipo == NO_DIRIGIDO ? 2 : 1;
         
         actual = siguiente;
         resultado[res_len++] = actual;
     }
     
     // Guardar paso final
-    if (*num_pasos < MAX_PASOS) {
+    if (pasos && *num_pasos < MAX_PASOS) {
         PasoFleury *p = &pasos[*num_pasos];
         for (int i = 0; i < K; i++) {
             for (int j = 0; j < K; j++) {
@@ -1596,99 +1872,8 @@ int encontrar_ciclo_euleriano_fleury_paso_a_paso(int *secuencia, PasoFleury *pas
     return res_len;
 }
 
-// Algoritmo de Fleury para encontrar ruta euleriana
-int encontrar_ruta_euleriana_fleury(int *secuencia) {
-    int K = grafo_actual.K;
-    if (!es_semieuleriano()) return 0;
-    
-    // Crear copia de la matriz
-    int matriz_copia[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_copia[i][j] = grafo_actual.matriz_adyacencia[i][j];
-        }
-    }
-    
-    // Encontrar vértice inicial (grado impar en no dirigido, o con más salidas en dirigido)
-    int inicio = 0;
-    if (grafo_actual.tipo == NO_DIRIGIDO) {
-        for (int i = 0; i < K; i++) {
-            int grado = 0;
-            for (int j = 0; j < K; j++) {
-                grado += matriz_copia[i][j];
-            }
-            if (grado % 2 == 1) {
-                inicio = i;
-                break;
-            }
-        }
-    } else {
-        for (int i = 0; i < K; i++) {
-            int grado_entrada = 0, grado_salida = 0;
-            for (int j = 0; j < K; j++) {
-                grado_entrada += matriz_copia[j][i];
-                grado_salida += matriz_copia[i][j];
-            }
-            if (grado_salida > grado_entrada) {
-                inicio = i;
-                break;
-            }
-        }
-    }
-    
-    int resultado[MAX_NODOS * MAX_NODOS];
-    int res_len = 0;
-    int actual = inicio;
-    
-    resultado[res_len++] = actual;
-    
-    while (true) {
-        // Contar aristas restantes
-        int aristas_restantes = 0;
-        for (int i = 0; i < K; i++) {
-            for (int j = 0; j < K; j++) {
-                aristas_restantes += matriz_copia[i][j];
-            }
-        }
-        if (aristas_restantes == 0) break;
-        
-        // Buscar siguiente arista
-        int siguiente = -1;
-        for (int i = 0; i < K; i++) {
-            if (matriz_copia[actual][i] > 0) {
-                siguiente = i;
-                int grado_actual = 0;
-                for (int j = 0; j < K; j++) {
-                    grado_actual += matriz_copia[actual][j];
-                }
-                if (grado_actual == 1) {
-                    break;
-                }
-                break;
-            }
-        }
-        
-        if (siguiente == -1) break;
-        
-        // Remover arista
-        matriz_copia[actual][siguiente]--;
-        if (grafo_actual.tipo == NO_DIRIGIDO) {
-            matriz_copia[siguiente][actual]--;
-        }
-        
-        actual = siguiente;
-        resultado[res_len++] = actual;
-    }
-    
-    for (int i = 0; i < res_len; i++) {
-        secuencia[i] = resultado[i];
-    }
-    
-    return res_len;
-}
-
 // Algoritmo de Fleury paso a paso para encontrar ruta euleriana
-int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos) {
+int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *pasos, int *num_pasos, Traza *traza) {
     int K = grafo_actual.K;
     if (!es_semieuleriano()) return 0;
     
@@ -1696,41 +1881,16 @@ int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *paso
     
     // Crear copia de la matriz
     int matriz_copia[MAX_NODOS][MAX_NODOS];
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            matriz_copia[i][j] = grafo_actual.matriz_adyacencia[i][j];
-        }
-    }
+    FilaBits filas[MAX_NODOS];
+    memcpy(matriz_copia, grafo_actual.matriz_adyacencia, sizeof(matriz_copia));
+    memcpy(filas, adyacencia_bits.aristas, sizeof(filas));
     
-    // Encontrar vértice inicial (grado impar en no dirigido, o con más salidas en dirigido)
-    int inicio = 0;
-    if (grafo_actual.tipo == NO_DIRIGIDO) {
-        for (int i = 0; i < K; i++) {
-            int grado = 0;
-            for (int j = 0; j < K; j++) {
-                grado += matriz_copia[i][j];
-            }
-            if (grado % 2 == 1) {
-                inicio = i;
-                break;
-            }
-        }
-    } else {
-        for (int i = 0; i < K; i++) {
-            int grado_entrada = 0, grado_salida = 0;
-            for (int j = 0; j < K; j++) {
-                grado_entrada += matriz_copia[j][i];
-                grado_salida += matriz_copia[i][j];
-            }
-            if (grado_salida > grado_entrada) {
-                inicio = i;
-                break;
-            }
-        }
-    }
+    // Mismo extremo inicial que la ruta de Hierholzer
+    int inicio = inicio_ruta_euleriana();
+    if (traza) iniciar_traza(traza, &grafo_actual, inicio);
     
     // Guardar paso inicial
-    if (*num_pasos < MAX_PASOS) {
+    if (pasos && *num_pasos < MAX_PASOS) {
         PasoFleury *p = &pasos[*num_pasos];
         for (int i = 0; i < K; i++) {
             for (int j = 0; j < K; j++) {
@@ -1755,14 +1915,8 @@ int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *paso
     
     resultado[res_len++] = actual;
     
+    int aristas_restantes = sumar_celdas_copia(matriz_copia, filas);
     while (true) {
-        // Contar aristas restantes
-        int aristas_restantes = 0;
-        for (int i = 0; i < K; i++) {
-            for (int j = 0; j < K; j++) {
-                aristas_restantes += matriz_copia[i][j];
-            }
-        }
         if (aristas_restantes == 0) break;
         
         // Buscar siguiente arista (preferir no-puente)
@@ -1771,32 +1925,28 @@ int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *paso
         bool hay_no_puente = false;
         
         // Primero, buscar aristas que NO sean puentes
-        for (int i = 0; i < K; i++) {
-            if (matriz_copia[actual][i] > 0) {
-                if (!es_puente(matriz_copia, actual, i, K)) {
-                    siguiente = i;
-                    hay_no_puente = true;
-                    es_puente_elegido = 0;
-                    break;
-                }
+        const FilaBits *vecinos = &filas[actual];
+        for (int i = siguiente_bit_fila(vecinos, 0); i >= 0; i = siguiente_bit_fila(vecinos, i + 1)) {
+            if (!es_puente(matriz_copia, filas, actual, i, K)) {
+                siguiente = i;
+                hay_no_puente = true;
+                es_puente_elegido = 0;
+                break;
             }
         }
         
         // Si no hay aristas no-puente, usar cualquier arista disponible
         if (!hay_no_puente) {
-            for (int i = 0; i < K; i++) {
-                if (matriz_copia[actual][i] > 0) {
-                    siguiente = i;
-                    es_puente_elegido = es_puente(matriz_copia, actual, i, K) ? 1 : 0;
-                    break;
-                }
+            siguiente = siguiente_bit_fila(vecinos, 0);
+            if (siguiente >= 0) {
+                es_puente_elegido = es_puente(matriz_copia, filas, actual, siguiente, K) ? 1 : 0;
             }
         }
         
         if (siguiente == -1) break;
         
         // Guardar paso antes de eliminar la arista
-        if (*num_pasos < MAX_PASOS) {
+        if (pasos && *num_pasos < MAX_PASOS) {
             PasoFleury *p = &pasos[*num_pasos];
             for (int i = 0; i < K; i++) {
                 for (int j = 0; j < K; j++) {
@@ -1826,17 +1976,16 @@ int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *paso
         }
         
         // Remover arista
-        matriz_copia[actual][siguiente]--;
-        if (grafo_actual.tipo == NO_DIRIGIDO) {
-            matriz_copia[siguiente][actual]--;
-        }
+        if (traza) traza_avanzar(traza, actual, siguiente, es_puente_elegido);
+        quitar_arista_copia(matriz_copia, filas, actual, siguiente);
+        aristas_restantes -= grafo_actual.tipo == NO_DIRIGIDO ? 2 : 1;
         
         actual = siguiente;
         resultado[res_len++] = actual;
     }
     
     // Guardar paso final
-    if (*num_pasos < MAX_PASOS) {
+    if (pasos && *num_pasos < MAX_PASOS) {
         PasoFleury *p = &pasos[*num_pasos];
         for (int i = 0; i < K; i++) {
             for (int j = 0; j < K; j++) {
@@ -1866,604 +2015,872 @@ int encontrar_ruta_euleriana_fleury_paso_a_paso(int *secuencia, PasoFleury *paso
 }
 
 // Función para generar diagrama TikZ de un paso de Fleury
-void generar_tikz_paso_fleury(FILE *f, PasoFleury *paso, int paso_num, int min_x, int min_y, double escala) {
+void generar_tikz_paso_fleury(BufferTexto *b, PasoFleury *paso, int paso_num) {
     (void)paso_num;  // Parámetro no usado, pero se mantiene para consistencia de interfaz
-    int K = grafo_actual.K;
     
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=%.2f]\n", escala);
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[lienzo]\n");
+    buffer_agregar(b, "\\nodosgrafo\n");
     
-    // Dibujar aristas restantes (grises)
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            if (paso->matriz_restante[i][j] > 0) {
-                double x1 = grafo_actual.posiciones[i].x - min_x;
-                double y1 = grafo_actual.posiciones[i].y - min_y;
-                double x2 = grafo_actual.posiciones[j].x - min_x;
-                double y2 = grafo_actual.posiciones[j].y - min_y;
-                
-                if (grafo_actual.tipo == DIRIGIDO) {
-                    fprintf(f, "\\draw[->, gray!40, dashed, thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-                } else {
-                    if (i < j) {
-                        fprintf(f, "\\draw[gray!40, dashed, thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-                    }
-                }
-            }
-        }
+    // Resaltar el vértice actual
+    if (paso->vertice_actual >= 0) {
+        buffer_agregar(b, "\\resaltar{");
+        buffer_agregar_entero(b, paso->vertice_actual);
+        buffer_agregar(b, "}{yellow!50}\n");
     }
     
+    // Dibujar aristas restantes (grises)
+    generar_tikz_aristas_matriz(b, "restante", paso->matriz_restante);
+    
     // Dibujar la ruta construida hasta el momento (azul)
-    if (paso->len_ruta_actual > 1) {
-        for (int i = 0; i < paso->len_ruta_actual - 1; i++) {
-            int u = paso->ruta_actual[i];
-            int v = paso->ruta_actual[i + 1];
-            double x1 = grafo_actual.posiciones[u].x - min_x;
-            double y1 = grafo_actual.posiciones[u].y - min_y;
-            double x2 = grafo_actual.posiciones[v].x - min_x;
-            double y2 = grafo_actual.posiciones[v].y - min_y;
-            
-            if (grafo_actual.tipo == DIRIGIDO) {
-                fprintf(f, "\\draw[->, blue, very thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-            } else {
-                fprintf(f, "\\draw[blue, very thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-            }
-        }
-    }
+    generar_tikz_aristas_secuencia(b, "ruta", paso->ruta_actual, paso->len_ruta_actual);
     
     // Dibujar la arista elegida en este paso (rojo si es puente, verde si no)
     if (paso->arista_elegida_u >= 0 && paso->arista_elegida_v >= 0) {
-        double x1 = grafo_actual.posiciones[paso->arista_elegida_u].x - min_x;
-        double y1 = grafo_actual.posiciones[paso->arista_elegida_u].y - min_y;
-        double x2 = grafo_actual.posiciones[paso->arista_elegida_v].x - min_x;
-        double y2 = grafo_actual.posiciones[paso->arista_elegida_v].y - min_y;
-        
-        const char *color_arista = paso->es_puente ? "red" : "green!70!black";
-        const char *estilo = paso->es_puente ? "ultra thick" : "ultra thick";
-        
-        if (grafo_actual.tipo == DIRIGIDO) {
-            fprintf(f, "\\draw[->, %s, %s] (%.2f,%.2f) -- (%.2f,%.2f);\n", color_arista, estilo, x1, y1, x2, y2);
-        } else {
-            fprintf(f, "\\draw[%s, %s] (%.2f,%.2f) -- (%.2f,%.2f);\n", color_arista, estilo, x1, y1, x2, y2);
-        }
+        buffer_agregar(b, paso->es_puente ? "\\aristas{elegida, red}{" : "\\aristas{elegida, green!70!black}{");
+        buffer_agregar_entero(b, paso->arista_elegida_u);
+        buffer_agregar_caracter(b, '/');
+        buffer_agregar_entero(b, paso->arista_elegida_v);
+        buffer_agregar(b, "}\n");
     }
     
-    // Dibujar nodos
-    for (int i = 0; i < K; i++) {
-        double x = grafo_actual.posiciones[i].x - min_x;
-        double y = grafo_actual.posiciones[i].y - min_y;
-        const char *fill_color = (i == paso->vertice_actual) ? "yellow!50" : "white";
-        fprintf(f, "\\node[circle, draw=black, fill=%s, minimum size=0.8cm, font=\\scriptsize] (n%d) at (%.2f,%.2f) {%d};\n",
-                fill_color, i, x, y, i);
-    }
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+}
+
+// Resultados de los análisis que muestra el reporte. Se calculan una sola vez
+// antes de escribir, así las secciones solo leen estos datos y el grafo.
+typedef struct {
+    bool tiene_ciclo;
+    bool tiene_ruta;
+    bool euler;
+    bool semi_euler;
     
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    int secuencia_hamiltoniana[MAX_NODOS + 1];
+    int longitud_hamiltoniana;
+    bool encontrado_hamiltoniano;
+    
+    int secuencia_hierholzer[MAX_NODOS * MAX_NODOS];
+    int len_hierholzer;
+    PasoHierholzer *pasos_hierholzer;
+    int num_pasos_hierholzer;
+    int secuencia_hierholzer_pasos[MAX_NODOS * MAX_NODOS];
+    int len_hierholzer_pasos;
+    int secuencia_hierholzer_ruta[MAX_NODOS * MAX_NODOS];
+    int len_hierholzer_ruta;
+    
+    PasoFleury *pasos_fleury_ciclo;
+    int num_pasos_fleury_ciclo;
+    int secuencia_fleury_ciclo[MAX_NODOS * MAX_NODOS];
+    int len_fleury_ciclo;
+    
+    PasoFleury *pasos_fleury_ruta;
+    int num_pasos_fleury_ruta;
+    int secuencia_fleury_ruta[MAX_NODOS * MAX_NODOS];
+    int len_fleury_ruta;
+} AnalisisReporte;
+
+// Ejecuta 'funcion' en un hilo nuevo. Si el hilo no se puede crear, la ejecuta
+// en el hilo actual y devuelve NULL, así el llamador solo espera los hilos no nulos.
+static GThread *lanzar_hilo(const char *nombre, GThreadFunc funcion, gpointer datos) {
+    GThread *hilo = g_thread_try_new(nombre, funcion, datos, NULL);
+    if (!hilo) {
+        funcion(datos);
+    }
+    return hilo;
 }
 
-void generar_latex(const char *filename) {
-    FILE *f = fopen(filename, "w");
-    if (!f) {
-        GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(window_main),
-            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-            "Error al crear archivo LaTeX");
-        gtk_dialog_run(GTK_DIALOG(dialog));
-        gtk_widget_destroy(dialog);
-        return;
+// Tareas de análisis del reporte. Solo leen grafo_actual y cada una escribe
+// campos distintos de AnalisisReporte, por lo que pueden correr en paralelo.
+
+// Un ciclo hamiltoniano ya contiene una ruta hamiltoniana, así que la búsqueda
+// de la ruta solo se hace cuando no hay ciclo. La secuencia encontrada es a la
+// vez la prueba de existencia, sin repetir el backtracking.
+static gpointer tarea_hamiltoniana(gpointer datos) {
+    AnalisisReporte *a = (AnalisisReporte *)datos;
+    a->tiene_ciclo = encontrar_ciclo_hamiltoniano(a->secuencia_hamiltoniana, &a->longitud_hamiltoniana);
+    if (a->tiene_ciclo) {
+        a->tiene_ruta = true;
+    } else {
+        a->tiene_ruta = encontrar_ruta_hamiltoniana(a->secuencia_hamiltoniana, &a->longitud_hamiltoniana);
+    }
+    a->encontrado_hamiltoniano = a->tiene_ciclo || a->tiene_ruta;
+    return NULL;
+}
+
+static gpointer tarea_hierholzer(gpointer datos) {
+    AnalisisReporte *a = (AnalisisReporte *)datos;
+    if (a->semi_euler) {
+        a->len_hierholzer_ruta = encontrar_ruta_euleriana_hierholzer(a->secuencia_hierholzer_ruta);
+        return NULL;
+    }
+    a->len_hierholzer = encontrar_ciclo_euleriano_hierholzer(a->secuencia_hierholzer);
+    if (a->len_hierholzer > 0) {
+        a->len_hierholzer_pasos = encontrar_ciclo_euleriano_hierholzer_paso_a_paso(
+            a->secuencia_hierholzer_pasos, a->pasos_hierholzer, &a->num_pasos_hierholzer, NULL);
+    }
+    return NULL;
+}
+
+static gpointer tarea_fleury_ciclo(gpointer datos) {
+    AnalisisReporte *a = (AnalisisReporte *)datos;
+    a->len_fleury_ciclo = encontrar_ciclo_euleriano_fleury_paso_a_paso(
+        a->secuencia_fleury_ciclo, a->pasos_fleury_ciclo, &a->num_pasos_fleury_ciclo, NULL);
+    return NULL;
+}
+
+static gpointer tarea_fleury_ruta(gpointer datos) {
+    AnalisisReporte *a = (AnalisisReporte *)datos;
+    a->len_fleury_ruta = encontrar_ruta_euleriana_fleury_paso_a_paso(
+        a->secuencia_fleury_ruta, a->pasos_fleury_ruta, &a->num_pasos_fleury_ruta, NULL);
+    return NULL;
+}
+
+// Ejecuta los análisis del grafo actual. Las pruebas eulerianas son lineales y
+// deciden qué recorridos hacen falta; luego la búsqueda hamiltoniana y las trazas
+// de Hierholzer y Fleury corren en paralelo, así el tiempo total lo marca la más
+// lenta. Los arreglos de pasos se reservan en el heap porque cada uno ocupa
+// cientos de KB.
+static bool analizar_grafo_reporte(AnalisisReporte *a) {
+    memset(a, 0, sizeof(*a));
+    a->pasos_hierholzer = malloc(MAX_PASOS * sizeof(PasoHierholzer));
+    a->pasos_fleury_ciclo = malloc(MAX_PASOS * sizeof(PasoFleury));
+    a->pasos_fleury_ruta = malloc(MAX_PASOS * sizeof(PasoFleury));
+    if (!a->pasos_hierholzer || !a->pasos_fleury_ciclo || !a->pasos_fleury_ruta) {
+        return false;
     }
     
-    int K = grafo_actual.K;
-    
-    fprintf(f, "\\documentclass[12pt]{article}\n");
-    fprintf(f, "\\usepackage[utf8]{inputenc}\n");
-    fprintf(f, "\\usepackage[spanish]{babel}\n");
-    fprintf(f, "\\usepackage{geometry}\n");
-    fprintf(f, "\\usepackage{tikz}\n");
-    fprintf(f, "\\usetikzlibrary{positioning, arrows.meta}\n");
-    fprintf(f, "\\usepackage{graphicx}\n");
-    fprintf(f, "\\usepackage{amsmath}\n");
-    fprintf(f, "\\usepackage{xcolor}\n");
-    // Configurar búsqueda de imágenes en el directorio actual (compatible con Linux y Windows)
-    fprintf(f, "\\graphicspath{{./}{./images/}{./imagenes/}}\n");
-    fprintf(f, "\\usepackage{pdftexcmds}\n");
-    // Definir comando para incluir imágenes opcionales (compatible con Linux y Windows)
-    // Este comando verifica si la imagen existe antes de intentar incluirla
-    fprintf(f, "\\makeatletter\n");
-    fprintf(f, "\\newcommand{\\includegraphicsoptional}[2][]{%%\n");
-    fprintf(f, "  \\IfFileExists{#2}{%%\n");
-    fprintf(f, "    %% Imagen encontrada - incluir normalmente\n");
-    fprintf(f, "    \\includegraphics[#1]{#2}%%\n");
-    fprintf(f, "  }{%%\n");
-    fprintf(f, "    %% Imagen no encontrada - mostrar placeholder\n");
-    fprintf(f, "    \\fbox{\\parbox{0.3\\textwidth}{\\centering\\vspace{1.5cm}\\textcolor{gray}{\\textit{[Imagen no disponible]}}\\\\ \\small{(#2)}\\vspace{1.5cm}}}%%\n");
-    fprintf(f, "  }%%\n");
-    fprintf(f, "}\n");
-    fprintf(f, "\\makeatother\n");
-    fprintf(f, "\\geometry{a4paper, margin=2.5cm}\n");
-    fprintf(f, "\\title{Proyecto 4: Hamilton, Euler y Grafos, Parte I}\n");
-    fprintf(f, "\\author{Miembros del Grupo:\\\\Ricardo Castro\\\\Juan Carlos Valverde\\\\~\\\\Curso: Analisis de Algoritmos\\\\~\\\\Semestres: II 2025}\n");
-    fprintf(f, "\\date{\\today}\n\n");
-    fprintf(f, "\\begin{document}\n\n");
-    
-    fprintf(f, "\\maketitle\n\n");
-    fprintf(f, "\\thispagestyle{empty}\n\n");
-    fprintf(f, "\\newpage\n\n");
-    
-    fprintf(f, "\\section{William Rowan Hamilton}\n\n");
-    fprintf(f, "\\begin{figure}[h]\n");
-    fprintf(f, "\\centering\n");
-    fprintf(f, "\\includegraphicsoptional[width=0.3\\textwidth]{hamilton.jpg}\n");
-    fprintf(f, "\\caption{William Rowan Hamilton (1805-1865)}\n");
-    fprintf(f, "\\end{figure}\n\n");
-    
-    fprintf(f, "William Rowan Hamilton (1805-1865) fue un matemático, físico y astrónomo irlandés, ");
-    fprintf(f, "considerado uno de los científicos más importantes del siglo XIX. Nació en Dublín, ");
-    fprintf(f, "Irlanda, y desde muy joven demostró un talento excepcional para las matemáticas y los ");
-    fprintf(f, "idiomas. A los 13 años ya dominaba 13 idiomas, incluyendo latín, griego, hebreo, ");
-    fprintf(f, "sánscrito y persa.\n\n");
-    
-    fprintf(f, "Hamilton ingresó al Trinity College de Dublín a los 18 años, donde destacó ");
-    fprintf(f, "extraordinariamente. A los 22 años, antes de graduarse, fue nombrado Profesor de ");
-    fprintf(f, "Astronomía y Director del Observatorio de Dunsink, posiciones que mantendría durante ");
-    fprintf(f, "el resto de su vida. Su trabajo abarcó múltiples áreas de las matemáticas y la física.\n\n");
-    
-    fprintf(f, "Una de sus contribuciones más significativas fue el desarrollo del \\textbf{álgebra de ");
-    fprintf(f, "cuaterniones} en 1843. Los cuaterniones son una extensión de los números complejos a ");
-    fprintf(f, "cuatro dimensiones, representados como $q = a + bi + cj + dk$, donde $i$, $j$ y $k$ ");
-    fprintf(f, "son unidades imaginarias que satisfacen relaciones específicas. Esta invención tuvo ");
-    fprintf(f, "un impacto profundo en la física, especialmente en la mecánica cuántica y la ");
-    fprintf(f, "computación gráfica moderna.\n\n");
-    
-    fprintf(f, "En el campo de la mecánica, Hamilton desarrolló el \\textbf{principio de Hamilton}, ");
-    fprintf(f, "también conocido como principio de mínima acción, que reformuló la mecánica clásica ");
-    fprintf(f, "en términos de variaciones. Este principio es fundamental en la física teórica y ");
-    fprintf(f, "proporciona una base elegante para la mecánica lagrangiana y hamiltoniana.\n\n");
-    
-    fprintf(f, "En teoría de grafos, Hamilton es conocido por el \\textbf{problema del ciclo ");
-    fprintf(f, "hamiltoniano}, que formuló en 1857. El problema consiste en determinar si existe un ");
-    fprintf(f, "ciclo en un grafo que visite cada vértice exactamente una vez y regrese al vértice ");
-    fprintf(f, "inicial. Este problema, aunque aparentemente simple, resultó ser NP-completo y ha ");
-    fprintf(f, "sido objeto de extensa investigación en ciencias de la computación.\n\n");
-    
-    fprintf(f, "Hamilton también hizo importantes contribuciones a la óptica geométrica, desarrollando ");
-    fprintf(f, "una teoría matemática de los rayos de luz que fue precursora de la mecánica cuántica. ");
-    fprintf(f, "Su trabajo en óptica estableció conexiones profundas entre la física y las ");
-    fprintf(f, "matemáticas.\n\n");
-    
-    fprintf(f, "A lo largo de su carrera, Hamilton publicó numerosos artículos y mantuvo correspondencia ");
-    fprintf(f, "con los principales científicos de su época, incluyendo a John Herschel y Peter Guthrie ");
-    fprintf(f, "Tait. Su legado perdura no solo en las matemáticas y la física, sino también en la ");
-    fprintf(f, "forma en que concebimos las estructuras algebraicas y los problemas de optimización.\n\n");
-    
-    fprintf(f, "\\section{Ciclos y Rutas Hamiltonianas}\n\n");
-    
-    fprintf(f, "\\subsection{Definiciones Fundamentales}\n\n");
-    
-    fprintf(f, "Un \\textbf{ciclo hamiltoniano} es un ciclo cerrado en un grafo que visita cada vértice ");
-    fprintf(f, "exactamente una vez y regresa al vértice inicial. Formalmente, dado un grafo $G = (V, E)$ ");
-    fprintf(f, "con $n$ vértices, un ciclo hamiltoniano es una secuencia de vértices $v_1, v_2, \\ldots, v_n, v_1$ ");
-    fprintf(f, "tal que:\n\n");
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item Cada vértice aparece exactamente una vez en la secuencia (excepto el inicial que ");
-    fprintf(f, "aparece al inicio y al final)\n");
-    fprintf(f, "\\item Para cada par consecutivo $(v_i, v_{i+1})$ en la secuencia, existe una arista ");
-    fprintf(f, "$(v_i, v_{i+1}) \\in E$\n");
-    fprintf(f, "\\item Existe una arista $(v_n, v_1) \\in E$ que cierra el ciclo\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "Una \\textbf{ruta hamiltoniana} (o camino hamiltoniano) es un camino simple que visita ");
-    fprintf(f, "cada vértice exactamente una vez, pero no necesariamente regresa al punto de partida. ");
-    fprintf(f, "Es decir, es una secuencia de vértices $v_1, v_2, \\ldots, v_n$ donde cada vértice aparece ");
-    fprintf(f, "exactamente una vez y cada par consecutivo está conectado por una arista.\n\n");
-    
-    fprintf(f, "\\subsection{Importancia y Aplicaciones}\n\n");
-    
-    fprintf(f, "El problema de determinar si un grafo tiene un ciclo o ruta hamiltoniana es uno de los ");
-    fprintf(f, "21 problemas NP-completos originales identificados por Karp en 1972. Esto significa que:\n\n");
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item No se conoce un algoritmo eficiente (polinomial) que resuelva el problema para ");
-    fprintf(f, "grafos arbitrarios\n");
-    fprintf(f, "\\item Si existiera tal algoritmo, se resolverían todos los problemas NP-completos\n");
-    fprintf(f, "\\item Los algoritmos actuales tienen complejidad exponencial en el peor caso\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "A pesar de su complejidad, los ciclos y rutas hamiltonianas tienen numerosas aplicaciones ");
-    fprintf(f, "prácticas:\n\n");
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item \\textbf{Problema del viajante (TSP)}: Encontrar la ruta más corta que visite ");
-    fprintf(f, "todas las ciudades exactamente una vez\n");
-    fprintf(f, "\\item \\textbf{Secuenciación de tareas}: Optimizar el orden de ejecución de tareas ");
-    fprintf(f, "con dependencias\n");
-    fprintf(f, "\\item \\textbf{Diseño de circuitos}: Encontrar rutas que pasen por todos los puntos ");
-    fprintf(f, "de un circuito\n");
-    fprintf(f, "\\item \\textbf{Análisis de redes}: Estudiar la conectividad y estructura de redes complejas\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "\\subsection{Ejemplos Visuales}\n\n");
-    
-    fprintf(f, "A continuación se presentan ejemplos gráficos que ilustran estos conceptos:\n\n");
-    
-    // Ejemplo 1: Ciclo hamiltoniano en un grafo completo
-    fprintf(f, "\\subsubsection{Ejemplo 1: Ciclo Hamiltoniano}\n\n");
-    fprintf(f, "El siguiente grafo muestra un ejemplo de ciclo hamiltoniano. El ciclo está marcado en ");
-    fprintf(f, "rojo y sigue la secuencia: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (2) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin] (3) -- (0);\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (3);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (0) to[bend left=15] (1);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (1) to[bend left=15] (2);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (2) to[bend left=15] (3);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (3) to[bend left=15] (0);\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
-    
-    // Ejemplo 2: Ruta hamiltoniana
-    fprintf(f, "\\subsubsection{Ejemplo 2: Ruta Hamiltoniana}\n\n");
-    fprintf(f, "El siguiente grafo muestra una ruta hamiltoniana (no un ciclo, ya que no regresa al ");
-    fprintf(f, "vértice inicial). La ruta está marcada en verde y sigue: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3$.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (2) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (2);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (0) to[bend left=15] (1);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (1) to[bend left=15] (2);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (2) to[bend left=15] (3);\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    a->euler = es_euleriano();
+    a->semi_euler = es_semieuleriano();
     
-    // Ejemplo 3: Grafo sin ciclo hamiltoniano
-    fprintf(f, "\\subsubsection{Ejemplo 3: Grafo sin Ciclo Hamiltoniano}\n\n");
-    fprintf(f, "No todos los grafos tienen ciclos hamiltonianos. El siguiente grafo (un árbol) no tiene ");
-    fprintf(f, "ciclo hamiltoniano porque es acíclico, pero sí tiene una ruta hamiltoniana.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (1,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (0,1.5) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,1.5) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,3) {3};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (4) at (2,3) {4};\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin] (2) -- (4);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (3) to[bend right=10] (1);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (1) to[bend right=10] (0);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (0) to[bend right=10] (2);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (2) to[bend right=10] (4);\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
-    
-    fprintf(f, "\\subsection{Algoritmos y Complejidad}\n\n");
-    
-    fprintf(f, "En este proyecto, se utiliza un algoritmo de \\textbf{backtracking} (vuelta atrás) ");
-    fprintf(f, "para determinar si existe al menos un ciclo o ruta hamiltoniana en el grafo. El algoritmo ");
-    fprintf(f, "explora sistemáticamente todas las posibles rutas, retrocediendo cuando una ruta parcial ");
-    fprintf(f, "no puede completarse.\n\n");
-    
-    fprintf(f, "La complejidad temporal del algoritmo de backtracking para este problema es $O(n!)$ en el ");
-    fprintf(f, "peor caso, donde $n$ es el número de vértices. Esto se debe a que, en el peor escenario, ");
-    fprintf(f, "debe explorar todas las permutaciones posibles de los vértices.\n\n");
-    
-    fprintf(f, "Aunque el algoritmo implementado determina la \\textit{existencia} de un ciclo o ruta ");
-    fprintf(f, "hamiltoniana, no encuentra la solución específica. Para encontrar la solución completa, ");
-    fprintf(f, "sería necesario modificar el algoritmo para almacenar y retornar la secuencia de vértices ");
-    fprintf(f, "que forma el ciclo o ruta.\n\n");
-    
-    fprintf(f, "\\section{Leonhard Euler}\n\n");
-    fprintf(f, "\\begin{figure}[h]\n");
-    fprintf(f, "\\centering\n");
-    fprintf(f, "\\includegraphicsoptional[width=0.3\\textwidth]{euler.jpg}\n");
-    fprintf(f, "\\caption{Leonhard Euler (1707-1783)}\n");
-    fprintf(f, "\\end{figure}\n\n");
-    
-    fprintf(f, "Leonhard Euler (1707-1783) fue un matemático y físico suizo considerado uno de los ");
-    fprintf(f, "matemáticos más prolíficos e influyentes de la historia. Nació en Basilea, Suiza, y ");
-    fprintf(f, "desde muy joven mostró un talento excepcional para las matemáticas. Su padre, Paul ");
-    fprintf(f, "Euler, era pastor calvinista y quería que su hijo siguiera sus pasos, pero el joven ");
-    fprintf(f, "Leonhard estaba destinado a convertirse en una de las mentes más brillantes de la ciencia.\n\n");
-    
-    fprintf(f, "Euler estudió en la Universidad de Basilea bajo la tutela de Johann Bernoulli, uno de ");
-    fprintf(f, "los matemáticos más destacados de su época. A los 19 años, Euler ya había completado ");
-    fprintf(f, "su maestría y comenzaba a publicar trabajos matemáticos. En 1727, a los 20 años, fue ");
-    fprintf(f, "invitado a unirse a la Academia de Ciencias de San Petersburgo, donde permanecería hasta ");
-    fprintf(f, "1741, y luego regresaría en 1766 hasta su muerte.\n\n");
-    
-    fprintf(f, "La productividad de Euler fue extraordinaria. Publicó más de 800 artículos y libros ");
-    fprintf(f, "durante su vida, y su obra completa, que aún se está compilando, se estima que ");
-    fprintf(f, "comprenderá más de 80 volúmenes. Sus contribuciones abarcan prácticamente todas las ");
-    fprintf(f, "áreas de las matemáticas: análisis matemático, teoría de números, geometría, álgebra, ");
-    fprintf(f, "mecánica, óptica, astronomía y música.\n\n");
-    
-    fprintf(f, "Una de sus contribuciones más fundamentales fue el desarrollo y sistematización del ");
-    fprintf(f, "\\textbf{cálculo infinitesimal}. Euler introdujo la notación matemática moderna que ");
-    fprintf(f, "usamos hoy en día, incluyendo el símbolo $e$ para la base del logaritmo natural ");
-    fprintf(f, "(aproximadamente 2.71828), el símbolo $i$ para la unidad imaginaria, y la notación ");
-    fprintf(f, "$f(x)$ para funciones. También estableció la famosa identidad $e^{i\\pi} + 1 = 0$, ");
-    fprintf(f, "conocida como la identidad de Euler, que conecta cinco de los números más importantes ");
-    fprintf(f, "en matemáticas.\n\n");
-    
-    fprintf(f, "En 1736, Euler resolvió el \\textbf{problema de los puentes de Königsberg}, que se ");
-    fprintf(f, "considera el origen de la teoría de grafos. El problema consistía en determinar si ");
-    fprintf(f, "era posible cruzar los siete puentes de la ciudad de Königsberg (hoy Kaliningrado) ");
-    fprintf(f, "exactamente una vez y regresar al punto de partida. Euler demostró que esto era ");
-    fprintf(f, "imposible, sentando las bases para lo que hoy conocemos como grafos eulerianos.\n\n");
-    
-    fprintf(f, "Euler hizo contribuciones fundamentales a la \\textbf{teoría de números}, incluyendo ");
-    fprintf(f, "el teorema de Euler en aritmética modular, que generaliza el pequeño teorema de Fermat. ");
-    fprintf(f, "También trabajó extensamente en la función zeta de Riemann (aunque no con ese nombre), ");
-    fprintf(f, "estableciendo la relación entre los números primos y los números naturales.\n\n");
-    
-    fprintf(f, "En \\textbf{mecánica}, Euler desarrolló las ecuaciones de movimiento de Euler para ");
-    fprintf(f, "cuerpos rígidos y contribuyó significativamente a la mecánica de fluidos. Sus trabajos ");
-    fprintf(f, "en óptica y astronomía también fueron pioneros, incluyendo cálculos precisos de órbitas ");
-    fprintf(f, "planetarias y el desarrollo de la teoría de la refracción de la luz.\n\n");
-    
-    fprintf(f, "A pesar de perder la visión de un ojo en 1735 y quedarse completamente ciego en 1766, ");
-    fprintf(f, "Euler continuó trabajando con una productividad asombrosa. Su memoria prodigiosa le ");
-    fprintf(f, "permitía realizar cálculos complejos mentalmente, y dictaba sus trabajos a sus hijos ");
-    fprintf(f, "y asistentes. De hecho, algunos de sus trabajos más importantes fueron producidos ");
-    fprintf(f, "durante su ceguera total.\n\n");
-    
-    fprintf(f, "El legado de Euler es inmenso. Muchos conceptos, teoremas y fórmulas llevan su nombre: ");
-    fprintf(f, "el número de Euler ($e$), la fórmula de Euler, el método de Euler para ecuaciones ");
-    fprintf(f, "diferenciales, los ángulos de Euler, la función phi de Euler, y muchos más. Su ");
-    fprintf(f, "influencia se extiende no solo a las matemáticas puras, sino también a la física, la ");
-    fprintf(f, "ingeniería y la computación moderna.\n\n");
-    
-    fprintf(f, "Euler murió en San Petersburgo en 1783, dejando un legado que continúa inspirando a ");
-    fprintf(f, "matemáticos y científicos hasta el día de hoy. Su enfoque sistemático, su notación ");
-    fprintf(f, "clara y su capacidad para encontrar conexiones profundas entre diferentes áreas del ");
-    fprintf(f, "conocimiento lo convierten en uno de los pilares fundamentales de las matemáticas modernas.\n\n");
-    
-    fprintf(f, "\\section{Ciclos y Rutas Eulerianas}\n\n");
-    
-    fprintf(f, "\\subsection{El Problema de los Puentes de Königsberg}\n\n");
-    
-    fprintf(f, "El origen de los ciclos eulerianos se remonta al famoso \\textbf{problema de los puentes ");
-    fprintf(f, "de Königsberg}, resuelto por Euler en 1736. La ciudad de Königsberg (hoy Kaliningrado) ");
-    fprintf(f, "estaba dividida por el río Pregel en cuatro regiones conectadas por siete puentes. ");
-    fprintf(f, "El problema consistía en determinar si era posible dar un paseo que cruzara cada puente ");
-    fprintf(f, "exactamente una vez y regresar al punto de partida.\n\n");
-    
-    fprintf(f, "Euler modeló este problema como un grafo, donde cada región era un vértice y cada puente ");
-    fprintf(f, "era una arista. Demostró que tal recorrido era imposible, estableciendo así los ");
-    fprintf(f, "fundamentos de la teoría de grafos y los grafos eulerianos.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.0]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (A) at (0,0) {A};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (B) at (2,0) {B};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (C) at (1,1.5) {C};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (D) at (1,-1.5) {D};\n");
-    fprintf(f, "\\draw[thick] (A) -- (C);\n");
-    fprintf(f, "\\draw[thick] (A) -- (C);\n");
-    fprintf(f, "\\draw[thick] (A) -- (D);\n");
-    fprintf(f, "\\draw[thick] (B) -- (C);\n");
-    fprintf(f, "\\draw[thick] (B) -- (C);\n");
-    fprintf(f, "\\draw[thick] (B) -- (D);\n");
-    fprintf(f, "\\draw[thick] (C) -- (D);\n");
-    fprintf(f, "\\node[below] at (1,-2.2) {Grafo de los puentes de Königsberg};\n");
-    fprintf(f, "\\node[below] at (1,-2.6) {Grados: A=3, B=3, C=5, D=3 (todos impares)};\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
-    
-    fprintf(f, "Como todos los vértices tienen grado impar, el grafo no puede tener un ciclo euleriano. ");
-    fprintf(f, "Este fue el primer resultado en teoría de grafos.\n\n");
-    
-    fprintf(f, "\\subsection{Definiciones Fundamentales}\n\n");
-    
-    fprintf(f, "Un \\textbf{ciclo euleriano} es un ciclo cerrado en un grafo que recorre cada arista ");
-    fprintf(f, "exactamente una vez y regresa al vértice inicial. Formalmente, dado un grafo $G = (V, E)$ ");
-    fprintf(f, "con $m$ aristas, un ciclo euleriano es una secuencia de vértices $v_1, v_2, \\ldots, v_k, v_1$ ");
-    fprintf(f, "tal que:\n\n");
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item Cada arista del grafo aparece exactamente una vez en el ciclo\n");
-    fprintf(f, "\\item El ciclo comienza y termina en el mismo vértice\n");
-    fprintf(f, "\\item Cada par consecutivo de vértices está conectado por una arista\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "Un \\textbf{camino euleriano} (o ruta euleriana) es un camino que recorre cada arista ");
-    fprintf(f, "exactamente una vez, pero no necesariamente regresa al punto de partida. Es decir, es ");
-    fprintf(f, "una secuencia de vértices $v_1, v_2, \\ldots, v_k$ donde cada arista aparece exactamente ");
-    fprintf(f, "una vez.\n\n");
-    
-    fprintf(f, "Un grafo es \\textbf{euleriano} si tiene un ciclo euleriano. Un grafo es ");
-    fprintf(f, "\\textbf{semieuleriano} si tiene un camino euleriano pero no un ciclo euleriano.\n\n");
-    
-    fprintf(f, "\\subsection{Teorema de Euler}\n\n");
-    
-    fprintf(f, "Euler estableció condiciones necesarias y suficientes para la existencia de ciclos y ");
-    fprintf(f, "caminos eulerianos:\n\n");
-    
-    fprintf(f, "\\textbf{Teorema (Euler, 1736):} Para un grafo no dirigido conexo $G$:\n\n");
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item $G$ tiene un ciclo euleriano si y solo si todos los vértices tienen grado par\n");
-    fprintf(f, "\\item $G$ tiene un camino euleriano (pero no un ciclo) si y solo si tiene exactamente ");
-    fprintf(f, "dos vértices de grado impar. Estos vértices serán el inicio y el final del camino\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "Para grafos dirigidos:\n\n");
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item Un grafo dirigido tiene un ciclo euleriano si y solo si es fuertemente conexo ");
-    fprintf(f, "y cada vértice tiene el mismo grado de entrada que de salida\n");
-    fprintf(f, "\\item Un grafo dirigido tiene un camino euleriano si tiene exactamente un vértice ");
-    fprintf(f, "con $\\deg_{salida} - \\deg_{entrada} = 1$ (inicio), exactamente un vértice con ");
-    fprintf(f, "$\\deg_{entrada} - \\deg_{salida} = 1$ (fin), y todos los demás tienen grados iguales\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "\\subsection{Ejemplos Visuales}\n\n");
-    
-    fprintf(f, "A continuación se presentan ejemplos gráficos que ilustran estos conceptos:\n\n");
+    GThread *hilo_hierholzer = NULL;
+    GThread *hilo_fleury_ciclo = NULL;
+    GThread *hilo_fleury_ruta = NULL;
     
-    // Ejemplo 1: Ciclo euleriano
-    fprintf(f, "\\subsubsection{Ejemplo 1: Grafo Euleriano (Ciclo Euleriano)}\n\n");
-    fprintf(f, "El siguiente grafo es euleriano porque todos los vértices tienen grado par (2 o 4). ");
-    fprintf(f, "El ciclo euleriano está marcado en rojo y recorre todas las aristas exactamente una vez.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (2) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin] (3) -- (0);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (0) to[bend left=15] node[above] {1} (1);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (1) to[bend left=15] node[right] {2} (2);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (2) to[bend left=15] node[below] {3} (3);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (3) to[bend left=15] node[left] {4} (0);\n");
-    fprintf(f, "\\node[below] at (1,-0.8) {Ciclo: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$};\n");
-    fprintf(f, "\\node[below] at (1,-1.2) {Grados: todos pares (2)};\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    if (a->euler) {
+        hilo_hierholzer = lanzar_hilo("hierholzer", tarea_hierholzer, a);
+        hilo_fleury_ciclo = lanzar_hilo("fleury-ciclo", tarea_fleury_ciclo, a);
+    }
+    if (a->semi_euler) {
+        hilo_hierholzer = lanzar_hilo("hierholzer", tarea_hierholzer, a);
+        hilo_fleury_ruta = lanzar_hilo("fleury-ruta", tarea_fleury_ruta, a);
+    }
     
-    // Ejemplo 2: Camino euleriano (semieuleriano)
-    fprintf(f, "\\subsubsection{Ejemplo 2: Grafo Semieuleriano (Camino Euleriano)}\n\n");
-    fprintf(f, "El siguiente grafo es semieuleriano porque tiene exactamente dos vértices de grado impar ");
-    fprintf(f, "(vértices 0 y 3, ambos con grado 3). El camino euleriano está marcado en verde y ");
-    fprintf(f, "comienza en el vértice 0 y termina en el vértice 3.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (2) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (3);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (0) to[bend left=15] node[above] {1} (1);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (1) to[bend left=15] node[right] {2} (2);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (2) to[bend left=15] node[above] {3} (3);\n");
-    fprintf(f, "\\draw[green!70!black, very thick, ->] (3) to[bend left=15] node[left] {4} (0);\n");
-    fprintf(f, "\\node[below] at (1,-0.8) {Camino: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$};\n");
-    fprintf(f, "\\node[below] at (1,-1.2) {Grados: 0=3, 1=2, 2=2, 3=3 (dos impares)};\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    // El backtracking suele ser el análisis más costoso: corre en este hilo
+    // mientras los demás avanzan
+    tarea_hamiltoniana(a);
     
-    // Ejemplo 3: Grafo no euleriano
-    fprintf(f, "\\subsubsection{Ejemplo 3: Grafo No Euleriano}\n\n");
-    fprintf(f, "El siguiente grafo no es euleriano ni semieuleriano porque tiene más de dos vértices ");
-    fprintf(f, "de grado impar (vértices 0, 1, 2 y 3, todos con grado 3). Por lo tanto, no existe ");
-    fprintf(f, "ningún camino que recorra todas las aristas exactamente una vez.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (2) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin] (3) -- (0);\n");
-    fprintf(f, "\\draw[gray, thin] (0) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin] (1) -- (3);\n");
-    fprintf(f, "\\node[below] at (1,-0.8) {Grados: todos impares (3)};\n");
-    fprintf(f, "\\node[below] at (1,-1.2) {No es euleriano ni semieuleriano};\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    if (hilo_hierholzer) g_thread_join(hilo_hierholzer);
+    if (hilo_fleury_ciclo) g_thread_join(hilo_fleury_ciclo);
+    if (hilo_fleury_ruta) g_thread_join(hilo_fleury_ruta);
     
-    // Ejemplo 4: Grafo dirigido euleriano
-    fprintf(f, "\\subsubsection{Ejemplo 4: Grafo Dirigido Euleriano}\n\n");
-    fprintf(f, "En grafos dirigidos, un ciclo euleriano requiere que cada vértice tenga el mismo grado ");
-    fprintf(f, "de entrada que de salida. El siguiente ejemplo muestra un grafo dirigido euleriano.\n\n");
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=1.2, >=Stealth]\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
-    fprintf(f, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
-    fprintf(f, "\\draw[gray, thin, ->] (0) -- (1);\n");
-    fprintf(f, "\\draw[gray, thin, ->] (1) -- (2);\n");
-    fprintf(f, "\\draw[gray, thin, ->] (2) -- (3);\n");
-    fprintf(f, "\\draw[gray, thin, ->] (3) -- (0);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (0) to[bend left=15] node[above] {1} (1);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (1) to[bend left=15] node[right] {2} (2);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (2) to[bend left=15] node[below] {3} (3);\n");
-    fprintf(f, "\\draw[red, very thick, ->] (3) to[bend left=15] node[left] {4} (0);\n");
-    fprintf(f, "\\node[below] at (1,-0.8) {Ciclo: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$};\n");
-    fprintf(f, "\\node[below] at (1,-1.2) {Grados: entrada = salida para todos (1)};\n");
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
-    
-    fprintf(f, "\\subsection{Aplicaciones Prácticas}\n\n");
-    
-    fprintf(f, "Los ciclos y caminos eulerianos tienen numerosas aplicaciones en la vida real:\n\n");
-    
-    fprintf(f, "\\begin{itemize}\n");
-    fprintf(f, "\\item \\textbf{Recolección de basura}: Optimizar rutas para que los camiones pasen ");
-    fprintf(f, "por todas las calles exactamente una vez\n");
-    fprintf(f, "\\item \\textbf{Inspección de redes}: Verificar todas las conexiones de una red (eléctrica, ");
-    fprintf(f, "de agua, de datos) de manera eficiente\n");
-    fprintf(f, "\\item \\textbf{Impresión de circuitos}: Encontrar rutas que pasen por todas las líneas ");
-    fprintf(f, "de un circuito impreso sin repetición\n");
-    fprintf(f, "\\item \\textbf{Postal y entrega}: Diseñar rutas de entrega que cubran todas las ");
-    fprintf(f, "calles sin duplicar esfuerzo\n");
-    fprintf(f, "\\item \\textbf{Análisis de ADN}: Reconstruir secuencias genéticas a partir de fragmentos\n");
-    fprintf(f, "\\end{itemize}\n\n");
-    
-    fprintf(f, "\\section{Grafo Original}\n\n");
-    
-    int min_x = grafo_actual.posiciones[0].x;
-    int max_x = grafo_actual.posiciones[0].x;
-    int min_y = grafo_actual.posiciones[0].y;
-    int max_y = grafo_actual.posiciones[0].y;
+    return true;
+}
+
+static void liberar_analisis_reporte(AnalisisReporte *a) {
+    free(a->pasos_hierholzer);
+    free(a->pasos_fleury_ciclo);
+    free(a->pasos_fleury_ruta);
+    a->pasos_hierholzer = NULL;
+    a->pasos_fleury_ciclo = NULL;
+    a->pasos_fleury_ruta = NULL;
+}
+
+// Panel de propiedades de la ventana principal. La clase euleriana y la
+// conexidad salen de los contadores y la caché de conectividad, así que se
+// actualizan en cada edición. Las búsquedas hamiltonianas son exponenciales:
+// se programan ESPERA_PANEL_MS después de la última edición y corren en un
+// hilo sobre una copia del grafo. Cada edición cancela la búsqueda anterior;
+// el resultado se descarta si el grafo cambió mientras tanto.
+#define ESPERA_PANEL_MS 300
+
+typedef struct {
+    int K;
+    FilaBits vecinos[MAX_NODOS];    // Copia de adyacencia_bits.simples: el hilo no toca grafo_actual
+    unsigned int version;
+    gint cancelado;
+    bool buscar_ciclo;
+    bool buscar_ruta;
+    bool tiene_ciclo;
+    bool tiene_ruta;
+    gint64 microsegundos;
+} BusquedaPanel;
+
+static GtkLabel *label_prop_euleriano;
+static GtkLabel *label_prop_conexidad;
+static GtkLabel *label_prop_ciclo_ham;
+static GtkLabel *label_prop_ruta_ham;
+static BusquedaPanel *busqueda_panel;   // Búsqueda en curso (la libera mostrar_busqueda_panel)
+static guint espera_panel;              // Fuente del temporizador pendiente, 0 si no hay
+
+static void texto_resultado_panel(GtkLabel *label, bool resultado, gint64 microsegundos) {
+    char texto[64];
+    snprintf(texto, sizeof(texto), "%s (%.2f ms)", resultado ? "Sí" : "No", microsegundos / 1000.0);
+    gtk_label_set_text(label, texto);
+}
+
+static gboolean mostrar_busqueda_panel(gpointer datos) {
+    BusquedaPanel *b = (BusquedaPanel *)datos;
+    if (busqueda_panel == b) busqueda_panel = NULL;
     
-    for (int i = 1; i < K; i++) {
-        if (grafo_actual.posiciones[i].x < min_x) min_x = grafo_actual.posiciones[i].x;
-        if (grafo_actual.posiciones[i].x > max_x) max_x = grafo_actual.posiciones[i].x;
-        if (grafo_actual.posiciones[i].y < min_y) min_y = grafo_actual.posiciones[i].y;
-        if (grafo_actual.posiciones[i].y > max_y) max_y = grafo_actual.posiciones[i].y;
+    if (!g_atomic_int_get(&b->cancelado) && b->version == version_grafo) {
+        if (b->buscar_ciclo) {
+            texto_resultado_panel(label_prop_ciclo_ham, b->tiene_ciclo, b->microsegundos);
+        }
+        if (b->buscar_ruta) {
+            texto_resultado_panel(label_prop_ruta_ham, b->tiene_ruta, b->microsegundos);
+        }
+    }
+    free(b);
+    return G_SOURCE_REMOVE;
+}
+
+// Como tarea_hamiltoniana: la ruta solo se busca si no hubo ciclo
+static gpointer tarea_busqueda_panel(gpointer datos) {
+    BusquedaPanel *b = (BusquedaPanel *)datos;
+    int camino[MAX_NODOS];
+    gint64 inicio = g_get_monotonic_time();
+    
+    if (b->buscar_ciclo) {
+        b->tiene_ciclo = buscar_camino_hamiltoniano(b->vecinos, b->K, true, camino, &b->cancelado);
+    }
+    if (b->buscar_ruta) {
+        b->tiene_ruta = b->tiene_ciclo ||
+                        buscar_camino_hamiltoniano(b->vecinos, b->K, false, camino, &b->cancelado);
     }
     
-    double ancho = (max_x - min_x > 0) ? (max_x - min_x) : 1.0;
-    double alto = (max_y - min_y > 0) ? (max_y - min_y) : 1.0;
-    double escala = 12.0 / (ancho > alto ? ancho : alto);
-    
-    fprintf(f, "\\begin{center}\n");
-    fprintf(f, "\\begin{tikzpicture}[scale=%.2f]\n", escala);
+    b->microsegundos = g_get_monotonic_time() - inicio;
+    g_idle_add(mostrar_busqueda_panel, b);
+    return NULL;
+}
+
+// Sin el respaldo de lanzar_hilo: correr la búsqueda en este hilo congelaría la
+// ventana. Si no se puede crear el hilo, la búsqueda se descarta y el panel lo indica.
+static gboolean lanzar_busqueda_panel(gpointer datos) {
+    BusquedaPanel *b = (BusquedaPanel *)datos;
+    espera_panel = 0;
+    GThread *hilo = g_thread_try_new("panel-hamiltoniano", tarea_busqueda_panel, b, NULL);
+    if (hilo) {
+        g_thread_unref(hilo);
+        return G_SOURCE_REMOVE;
+    }
     
-    for (int i = 0; i < K; i++) {
-        for (int j = 0; j < K; j++) {
-            if (grafo_actual.matriz_adyacencia[i][j] == 1) {
-                double x1 = grafo_actual.posiciones[i].x - min_x;
-                double y1 = grafo_actual.posiciones[i].y - min_y;
-                double x2 = grafo_actual.posiciones[j].x - min_x;
-                double y2 = grafo_actual.posiciones[j].y - min_y;
-                
-                if (grafo_actual.tipo == DIRIGIDO) {
-                    fprintf(f, "\\draw[->, thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-                } else {
-                    if (i < j) {
-                        fprintf(f, "\\draw[thick] (%.2f,%.2f) -- (%.2f,%.2f);\n", x1, y1, x2, y2);
-                    }
-                }
+    if (busqueda_panel == b) busqueda_panel = NULL;
+    if (b->buscar_ciclo) gtk_label_set_text(label_prop_ciclo_ham, "— (no se pudo buscar)");
+    if (b->buscar_ruta) gtk_label_set_text(label_prop_ruta_ham, "— (no se pudo buscar)");
+    free(b);
+    return G_SOURCE_REMOVE;
+}
+
+static void cancelar_busqueda_panel(void) {
+    if (espera_panel) {
+        // Todavía no arrancó: el temporizador es el dueño de la búsqueda
+        g_source_remove(espera_panel);
+        espera_panel = 0;
+        free(busqueda_panel);
+    } else if (busqueda_panel) {
+        g_atomic_int_set(&busqueda_panel->cancelado, 1);
+    }
+    busqueda_panel = NULL;
+}
+
+// La llama refrescar_vistas_grafo tras los cambios de grafo_actual
+void actualizar_panel_propiedades() {
+    if (!label_prop_euleriano) return;
+    cancelar_busqueda_panel();
+    
+    int K = grafo_actual.K;
+    if (K == 0) {
+        gtk_label_set_text(label_prop_euleriano, "—");
+        gtk_label_set_text(label_prop_conexidad, "—");
+        gtk_label_set_text(label_prop_ciclo_ham, "—");
+        gtk_label_set_text(label_prop_ruta_ham, "—");
+        return;
+    }
+    
+    if (es_euleriano()) {
+        gtk_label_set_text(label_prop_euleriano, "Sí, tiene ciclo euleriano");
+    } else if (es_semieuleriano()) {
+        gtk_label_set_text(label_prop_euleriano, "Semieuleriano, tiene ruta euleriana");
+    } else {
+        gtk_label_set_text(label_prop_euleriano, "No");
+    }
+    
+    const Conectividad *conectividad = conectividad_actual();
+    if (grafo_actual.tipo == NO_DIRIGIDO) {
+        gtk_label_set_text(label_prop_conexidad, conectividad->conexo ? "Conexo" : "No conexo");
+    } else if (conectividad->fuertemente_conexo) {
+        gtk_label_set_text(label_prop_conexidad, "Fuertemente conexo");
+    } else {
+        gtk_label_set_text(label_prop_conexidad,
+                           conectividad->conexo ? "Débilmente conexo" : "No conexo");
+    }
+    
+    // Los mismos descartes que tiene_ciclo_hamiltoniano y tiene_ruta_hamiltoniana
+    bool buscar_ciclo = K >= 3 && conectividad->fuertemente_conexo;
+    bool buscar_ruta = K >= 2 && conectividad->conexo;
+    gtk_label_set_text(label_prop_ciclo_ham, buscar_ciclo ? "Buscando…" : "No");
+    gtk_label_set_text(label_prop_ruta_ham, buscar_ruta ? "Buscando…" : "No");
+    if (!buscar_ciclo && !buscar_ruta) return;
+    
+    BusquedaPanel *b = calloc(1, sizeof(BusquedaPanel));
+    if (!b) return;
+    b->K = K;
+    memcpy(b->vecinos, adyacencia_bits.simples, sizeof(b->vecinos));
+    b->version = version_grafo;
+    b->buscar_ciclo = buscar_ciclo;
+    b->buscar_ruta = buscar_ruta;
+    busqueda_panel = b;
+    espera_panel = g_timeout_add(ESPERA_PANEL_MS, lanzar_busqueda_panel, b);
+}
+
+// Guarda grafo_actual con el formato que indique la extensión (la matriz si no
+// se reconoce). En GraphML y DOT se agregan como atributos de arista el
+// recorrido euleriano y el hamiltoniano que encuentre el análisis.
+bool guardar_grafo_actual(const char *ruta) {
+    FormatoGrafo formato = formato_por_extension(ruta);
+    GrafoCSR csr;
+    if (!grafo_csr_desde_denso(&grafo_actual, &csr)) return false;
+    
+    bool ok;
+    if (formato == FORMATO_GRAPHML || formato == FORMATO_DOT) {
+        AnalisisReporte analisis;
+        ok = analizar_grafo_reporte(&analisis);
+        if (ok) {
+            RecorridoGrafo recorridos[2];
+            int num_recorridos = 0;
+            if (analisis.len_hierholzer > 0) {
+                recorridos[num_recorridos++] = (RecorridoGrafo){"euler", analisis.secuencia_hierholzer,
+                                                                analisis.len_hierholzer};
+            } else if (analisis.len_hierholzer_ruta > 0) {
+                recorridos[num_recorridos++] = (RecorridoGrafo){"euler", analisis.secuencia_hierholzer_ruta,
+                                                                analisis.len_hierholzer_ruta};
             }
+            if (analisis.encontrado_hamiltoniano) {
+                recorridos[num_recorridos++] = (RecorridoGrafo){"hamilton", analisis.secuencia_hamiltoniana,
+                                                                analisis.longitud_hamiltoniana};
+            }
+            ok = guardar_grafo_anotado(ruta, formato, &csr, recorridos, num_recorridos);
         }
+        liberar_analisis_reporte(&analisis);
+    } else {
+        ok = guardar_grafo_csr(ruta, formato, &csr);
+    }
+    
+    liberar_grafo_csr(&csr);
+    return ok;
+}
+
+// Emite una secuencia de vértices centrada como "v0 -> v1 -> ... -> vn"
+static void generar_secuencia_latex(BufferTexto *b, const int *secuencia, int longitud) {
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\Large\n");
+    for (int i = 0; i < longitud; i++) {
+        if (i > 0) buffer_agregar(b, " $\\rightarrow$ ");
+        buffer_agregar_entero(b, secuencia[i]);
     }
+    buffer_agregar(b, "\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    buffer_agregar(b, "\\normalsize\n");
+}
+
+// Encabezado del documento: paquetes, macros TikZ compartidas y portada
+static void seccion_preambulo(BufferTexto *b, const AnalisisReporte *a) {
+    (void)a;
+    
+    buffer_agregar(b, "\\documentclass[12pt]{article}\n");
+    buffer_agregar(b, "\\usepackage[utf8]{inputenc}\n");
+    buffer_agregar(b, "\\usepackage[spanish]{babel}\n");
+    buffer_agregar(b, "\\usepackage{geometry}\n");
+    buffer_agregar(b, "\\usepackage{tikz}\n");
+    buffer_agregar(b, "\\usetikzlibrary{positioning, arrows.meta}\n");
+    buffer_agregar(b, "\\usepackage{graphicx}\n");
+    buffer_agregar(b, "\\usepackage{amsmath}\n");
+    buffer_agregar(b, "\\usepackage{xcolor}\n");
+    // Configurar búsqueda de imágenes en el directorio actual (compatible con Linux y Windows)
+    buffer_agregar(b, "\\graphicspath{{./}{./images/}{./imagenes/}}\n");
+    buffer_agregar(b, "\\usepackage{pdftexcmds}\n");
+    // Definir comando para incluir imágenes opcionales (compatible con Linux y Windows)
+    // Este comando verifica si la imagen existe antes de intentar incluirla
+    buffer_agregar(b, "\\makeatletter\n");
+    buffer_agregar(b, "\\newcommand{\\includegraphicsoptional}[2][]{%\n");
+    buffer_agregar(b, "  \\IfFileExists{#2}{%\n");
+    buffer_agregar(b, "    % Imagen encontrada - incluir normalmente\n");
+    buffer_agregar(b, "    \\includegraphics[#1]{#2}%\n");
+    buffer_agregar(b, "  }{%\n");
+    buffer_agregar(b, "    % Imagen no encontrada - mostrar placeholder\n");
+    buffer_agregar(b, "    \\fbox{\\parbox{0.3\\textwidth}{\\centering\\vspace{1.5cm}\\textcolor{gray}{\\textit{[Imagen no disponible]}}\\\\ \\small{(#2)}\\vspace{1.5cm}}}%\n");
+    buffer_agregar(b, "  }%\n");
+    buffer_agregar(b, "}\n");
+    buffer_agregar(b, "\\makeatother\n");
+    buffer_agregar(b, "\\geometry{a4paper, margin=2.5cm}\n");
+    // Estilos, coordenadas y macros compartidos por todas las figuras del grafo
+    generar_definiciones_tikz(b);
+    buffer_agregar(b, "\\title{Proyecto 4: Hamilton, Euler y Grafos, Parte I}\n");
+    buffer_agregar(b, "\\author{Miembros del Grupo:\\\\Ricardo Castro\\\\Juan Carlos Valverde\\\\~\\\\Curso: Analisis de Algoritmos\\\\~\\\\Semestres: II 2025}\n");
+    buffer_agregar(b, "\\date{\\today}\n\n");
+    buffer_agregar(b, "\\begin{document}\n\n");
+    
+    buffer_agregar(b, "\\maketitle\n\n");
+    buffer_agregar(b, "\\thispagestyle{empty}\n\n");
+    buffer_agregar(b, "\\newpage\n\n");
+}
+
+// Biografía de Hamilton y teoría de ciclos y rutas hamiltonianas
+static void seccion_historia_hamilton(BufferTexto *b, const AnalisisReporte *a) {
+    (void)a;
+    
+    buffer_agregar(b, "\\section{William Rowan Hamilton}\n\n");
+    buffer_agregar(b, "\\begin{figure}[h]\n");
+    buffer_agregar(b, "\\centering\n");
+    buffer_agregar(b, "\\includegraphicsoptional[width=0.3\\textwidth]{hamilton.jpg}\n");
+    buffer_agregar(b, "\\caption{William Rowan Hamilton (1805-1865)}\n");
+    buffer_agregar(b, "\\end{figure}\n\n");
+    
+    buffer_agregar(b, "William Rowan Hamilton (1805-1865) fue un matemático, físico y astrónomo irlandés, ");
+    buffer_agregar(b, "considerado uno de los científicos más importantes del siglo XIX. Nació en Dublín, ");
+    buffer_agregar(b, "Irlanda, y desde muy joven demostró un talento excepcional para las matemáticas y los ");
+    buffer_agregar(b, "idiomas. A los 13 años ya dominaba 13 idiomas, incluyendo latín, griego, hebreo, ");
+    buffer_agregar(b, "sánscrito y persa.\n\n");
+    
+    buffer_agregar(b, "Hamilton ingresó al Trinity College de Dublín a los 18 años, donde destacó ");
+    buffer_agregar(b, "extraordinariamente. A los 22 años, antes de graduarse, fue nombrado Profesor de ");
+    buffer_agregar(b, "Astronomía y Director del Observatorio de Dunsink, posiciones que mantendría durante ");
+    buffer_agregar(b, "el resto de su vida. Su trabajo abarcó múltiples áreas de las matemáticas y la física.\n\n");
+    
+    buffer_agregar(b, "Una de sus contribuciones más significativas fue el desarrollo del \\textbf{álgebra de ");
+    buffer_agregar(b, "cuaterniones} en 1843. Los cuaterniones son una extensión de los números complejos a ");
+    buffer_agregar(b, "cuatro dimensiones, representados como $q = a + bi + cj + dk$, donde $i$, $j$ y $k$ ");
+    buffer_agregar(b, "son unidades imaginarias que satisfacen relaciones específicas. Esta invención tuvo ");
+    buffer_agregar(b, "un impacto profundo en la física, especialmente en la mecánica cuántica y la ");
+    buffer_agregar(b, "computación gráfica moderna.\n\n");
+    
+    buffer_agregar(b, "En el campo de la mecánica, Hamilton desarrolló el \\textbf{principio de Hamilton}, ");
+    buffer_agregar(b, "también conocido como principio de mínima acción, que reformuló la mecánica clásica ");
+    buffer_agregar(b, "en términos de variaciones. Este principio es fundamental en la física teórica y ");
+    buffer_agregar(b, "proporciona una base elegante para la mecánica lagrangiana y hamiltoniana.\n\n");
+    
+    buffer_agregar(b, "En teoría de grafos, Hamilton es conocido por el \\textbf{problema del ciclo ");
+    buffer_agregar(b, "hamiltoniano}, que formuló en 1857. El problema consiste en determinar si existe un ");
+    buffer_agregar(b, "ciclo en un grafo que visite cada vértice exactamente una vez y regrese al vértice ");
+    buffer_agregar(b, "inicial. Este problema, aunque aparentemente simple, resultó ser NP-completo y ha ");
+    buffer_agregar(b, "sido objeto de extensa investigación en ciencias de la computación.\n\n");
+    
+    buffer_agregar(b, "Hamilton también hizo importantes contribuciones a la óptica geométrica, desarrollando ");
+    buffer_agregar(b, "una teoría matemática de los rayos de luz que fue precursora de la mecánica cuántica. ");
+    buffer_agregar(b, "Su trabajo en óptica estableció conexiones profundas entre la física y las ");
+    buffer_agregar(b, "matemáticas.\n\n");
+    
+    buffer_agregar(b, "A lo largo de su carrera, Hamilton publicó numerosos artículos y mantuvo correspondencia ");
+    buffer_agregar(b, "con los principales científicos de su época, incluyendo a John Herschel y Peter Guthrie ");
+    buffer_agregar(b, "Tait. Su legado perdura no solo en las matemáticas y la física, sino también en la ");
+    buffer_agregar(b, "forma en que concebimos las estructuras algebraicas y los problemas de optimización.\n\n");
+    
+    buffer_agregar(b, "\\section{Ciclos y Rutas Hamiltonianas}\n\n");
+    
+    buffer_agregar(b, "\\subsection{Definiciones Fundamentales}\n\n");
+    
+    buffer_agregar(b, "Un \\textbf{ciclo hamiltoniano} es un ciclo cerrado en un grafo que visita cada vértice ");
+    buffer_agregar(b, "exactamente una vez y regresa al vértice inicial. Formalmente, dado un grafo $G = (V, E)$ ");
+    buffer_agregar(b, "con $n$ vértices, un ciclo hamiltoniano es una secuencia de vértices $v_1, v_2, \\ldots, v_n, v_1$ ");
+    buffer_agregar(b, "tal que:\n\n");
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item Cada vértice aparece exactamente una vez en la secuencia (excepto el inicial que ");
+    buffer_agregar(b, "aparece al inicio y al final)\n");
+    buffer_agregar(b, "\\item Para cada par consecutivo $(v_i, v_{i+1})$ en la secuencia, existe una arista ");
+    buffer_agregar(b, "$(v_i, v_{i+1}) \\in E$\n");
+    buffer_agregar(b, "\\item Existe una arista $(v_n, v_1) \\in E$ que cierra el ciclo\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+    
+    buffer_agregar(b, "Una \\textbf{ruta hamiltoniana} (o camino hamiltoniano) es un camino simple que visita ");
+    buffer_agregar(b, "cada vértice exactamente una vez, pero no necesariamente regresa al punto de partida. ");
+    buffer_agregar(b, "Es decir, es una secuencia de vértices $v_1, v_2, \\ldots, v_n$ donde cada vértice aparece ");
+    buffer_agregar(b, "exactamente una vez y cada par consecutivo está conectado por una arista.\n\n");
+    
+    buffer_agregar(b, "\\subsection{Importancia y Aplicaciones}\n\n");
+    
+    buffer_agregar(b, "El problema de determinar si un grafo tiene un ciclo o ruta hamiltoniana es uno de los ");
+    buffer_agregar(b, "21 problemas NP-completos originales identificados por Karp en 1972. Esto significa que:\n\n");
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item No se conoce un algoritmo eficiente (polinomial) que resuelva el problema para ");
+    buffer_agregar(b, "grafos arbitrarios\n");
+    buffer_agregar(b, "\\item Si existiera tal algoritmo, se resolverían todos los problemas NP-completos\n");
+    buffer_agregar(b, "\\item Los algoritmos actuales tienen complejidad exponencial en el peor caso\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+    
+    buffer_agregar(b, "A pesar de su complejidad, los ciclos y rutas hamiltonianas tienen numerosas aplicaciones ");
+    buffer_agregar(b, "prácticas:\n\n");
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item \\textbf{Problema del viajante (TSP)}: Encontrar la ruta más corta que visite ");
+    buffer_agregar(b, "todas las ciudades exactamente una vez\n");
+    buffer_agregar(b, "\\item \\textbf{Secuenciación de tareas}: Optimizar el orden de ejecución de tareas ");
+    buffer_agregar(b, "con dependencias\n");
+    buffer_agregar(b, "\\item \\textbf{Diseño de circuitos}: Encontrar rutas que pasen por todos los puntos ");
+    buffer_agregar(b, "de un circuito\n");
+    buffer_agregar(b, "\\item \\textbf{Análisis de redes}: Estudiar la conectividad y estructura de redes complejas\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+    
+    buffer_agregar(b, "\\subsection{Ejemplos Visuales}\n\n");
+    
+    buffer_agregar(b, "A continuación se presentan ejemplos gráficos que ilustran estos conceptos:\n\n");
+    
+    // Ejemplo 1: Ciclo hamiltoniano en un grafo completo
+    buffer_agregar(b, "\\subsubsection{Ejemplo 1: Ciclo Hamiltoniano}\n\n");
+    buffer_agregar(b, "El siguiente grafo muestra un ejemplo de ciclo hamiltoniano. El ciclo está marcado en ");
+    buffer_agregar(b, "rojo y sigue la secuencia: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (2) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (3) -- (0);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (3);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (0) to[bend left=15] (1);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (1) to[bend left=15] (2);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (2) to[bend left=15] (3);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (3) to[bend left=15] (0);\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    // Ejemplo 2: Ruta hamiltoniana
+    buffer_agregar(b, "\\subsubsection{Ejemplo 2: Ruta Hamiltoniana}\n\n");
+    buffer_agregar(b, "El siguiente grafo muestra una ruta hamiltoniana (no un ciclo, ya que no regresa al ");
+    buffer_agregar(b, "vértice inicial). La ruta está marcada en verde y sigue: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3$.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (2) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (2);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (0) to[bend left=15] (1);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (1) to[bend left=15] (2);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (2) to[bend left=15] (3);\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    // Ejemplo 3: Grafo sin ciclo hamiltoniano
+    buffer_agregar(b, "\\subsubsection{Ejemplo 3: Grafo sin Ciclo Hamiltoniano}\n\n");
+    buffer_agregar(b, "No todos los grafos tienen ciclos hamiltonianos. El siguiente grafo (un árbol) no tiene ");
+    buffer_agregar(b, "ciclo hamiltoniano porque es acíclico, pero sí tiene una ruta hamiltoniana.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (1,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (0,1.5) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,1.5) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,3) {3};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (4) at (2,3) {4};\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (2) -- (4);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (3) to[bend right=10] (1);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (1) to[bend right=10] (0);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (0) to[bend right=10] (2);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (2) to[bend right=10] (4);\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    buffer_agregar(b, "\\subsection{Algoritmos y Complejidad}\n\n");
+    
+    buffer_agregar(b, "En este proyecto, se utiliza un algoritmo de \\textbf{backtracking} (vuelta atrás) ");
+    buffer_agregar(b, "para determinar si existe al menos un ciclo o ruta hamiltoniana en el grafo. El algoritmo ");
+    buffer_agregar(b, "explora sistemáticamente todas las posibles rutas, retrocediendo cuando una ruta parcial ");
+    buffer_agregar(b, "no puede completarse.\n\n");
+    
+    buffer_agregar(b, "La complejidad temporal del algoritmo de backtracking para este problema es $O(n!)$ en el ");
+    buffer_agregar(b, "peor caso, donde $n$ es el número de vértices. Esto se debe a que, en el peor escenario, ");
+    buffer_agregar(b, "debe explorar todas las permutaciones posibles de los vértices.\n\n");
+    
+    buffer_agregar(b, "Aunque el algoritmo implementado determina la \\textit{existencia} de un ciclo o ruta ");
+    buffer_agregar(b, "hamiltoniana, no encuentra la solución específica. Para encontrar la solución completa, ");
+    buffer_agregar(b, "sería necesario modificar el algoritmo para almacenar y retornar la secuencia de vértices ");
+    buffer_agregar(b, "que forma el ciclo o ruta.\n\n");
+}
+
+// Biografía de Euler y teoría de ciclos y rutas eulerianas
+static void seccion_historia_euler(BufferTexto *b, const AnalisisReporte *a) {
+    (void)a;
+    
+    buffer_agregar(b, "\\section{Leonhard Euler}\n\n");
+    buffer_agregar(b, "\\begin{figure}[h]\n");
+    buffer_agregar(b, "\\centering\n");
+    buffer_agregar(b, "\\includegraphicsoptional[width=0.3\\textwidth]{euler.jpg}\n");
+    buffer_agregar(b, "\\caption{Leonhard Euler (1707-1783)}\n");
+    buffer_agregar(b, "\\end{figure}\n\n");
+    
+    buffer_agregar(b, "Leonhard Euler (1707-1783) fue un matemático y físico suizo considerado uno de los ");
+    buffer_agregar(b, "matemáticos más prolíficos e influyentes de la historia. Nació en Basilea, Suiza, y ");
+    buffer_agregar(b, "desde muy joven mostró un talento excepcional para las matemáticas. Su padre, Paul ");
+    buffer_agregar(b, "Euler, era pastor calvinista y quería que su hijo siguiera sus pasos, pero el joven ");
+    buffer_agregar(b, "Leonhard estaba destinado a convertirse en una de las mentes más brillantes de la ciencia.\n\n");
+    
+    buffer_agregar(b, "Euler estudió en la Universidad de Basilea bajo la tutela de Johann Bernoulli, uno de ");
+    buffer_agregar(b, "los matemáticos más destacados de su época. A los 19 años, Euler ya había completado ");
+    buffer_agregar(b, "su maestría y comenzaba a publicar trabajos matemáticos. En 1727, a los 20 años, fue ");
+    buffer_agregar(b, "invitado a unirse a la Academia de Ciencias de San Petersburgo, donde permanecería hasta ");
+    buffer_agregar(b, "1741, y luego regresaría en 1766 hasta su muerte.\n\n");
+    
+    buffer_agregar(b, "La productividad de Euler fue extraordinaria. Publicó más de 800 artículos y libros ");
+    buffer_agregar(b, "durante su vida, y su obra completa, que aún se está compilando, se estima que ");
+    buffer_agregar(b, "comprenderá más de 80 volúmenes. Sus contribuciones abarcan prácticamente todas las ");
+    buffer_agregar(b, "áreas de las matemáticas: análisis matemático, teoría de números, geometría, álgebra, ");
+    buffer_agregar(b, "mecánica, óptica, astronomía y música.\n\n");
+    
+    buffer_agregar(b, "Una de sus contribuciones más fundamentales fue el desarrollo y sistematización del ");
+    buffer_agregar(b, "\\textbf{cálculo infinitesimal}. Euler introdujo la notación matemática moderna que ");
+    buffer_agregar(b, "usamos hoy en día, incluyendo el símbolo $e$ para la base del logaritmo natural ");
+    buffer_agregar(b, "(aproximadamente 2.71828), el símbolo $i$ para la unidad imaginaria, y la notación ");
+    buffer_agregar(b, "$f(x)$ para funciones. También estableció la famosa identidad $e^{i\\pi} + 1 = 0$, ");
+    buffer_agregar(b, "conocida como la identidad de Euler, que conecta cinco de los números más importantes ");
+    buffer_agregar(b, "en matemáticas.\n\n");
+    
+    buffer_agregar(b, "En 1736, Euler resolvió el \\textbf{problema de los puentes de Königsberg}, que se ");
+    buffer_agregar(b, "considera el origen de la teoría de grafos. El problema consistía en determinar si ");
+    buffer_agregar(b, "era posible cruzar los siete puentes de la ciudad de Königsberg (hoy Kaliningrado) ");
+    buffer_agregar(b, "exactamente una vez y regresar al punto de partida. Euler demostró que esto era ");
+    buffer_agregar(b, "imposible, sentando las bases para lo que hoy conocemos como grafos eulerianos.\n\n");
+    
+    buffer_agregar(b, "Euler hizo contribuciones fundamentales a la \\textbf{teoría de números}, incluyendo ");
+    buffer_agregar(b, "el teorema de Euler en aritmética modular, que generaliza el pequeño teorema de Fermat. ");
+    buffer_agregar(b, "También trabajó extensamente en la función zeta de Riemann (aunque no con ese nombre), ");
+    buffer_agregar(b, "estableciendo la relación entre los números primos y los números naturales.\n\n");
+    
+    buffer_agregar(b, "En \\textbf{mecánica}, Euler desarrolló las ecuaciones de movimiento de Euler para ");
+    buffer_agregar(b, "cuerpos rígidos y contribuyó significativamente a la mecánica de fluidos. Sus trabajos ");
+    buffer_agregar(b, "en óptica y astronomía también fueron pioneros, incluyendo cálculos precisos de órbitas ");
+    buffer_agregar(b, "planetarias y el desarrollo de la teoría de la refracción de la luz.\n\n");
+    
+    buffer_agregar(b, "A pesar de perder la visión de un ojo en 1735 y quedarse completamente ciego en 1766, ");
+    buffer_agregar(b, "Euler continuó trabajando con una productividad asombrosa. Su memoria prodigiosa le ");
+    buffer_agregar(b, "permitía realizar cálculos complejos mentalmente, y dictaba sus trabajos a sus hijos ");
+    buffer_agregar(b, "y asistentes. De hecho, algunos de sus trabajos más importantes fueron producidos ");
+    buffer_agregar(b, "durante su ceguera total.\n\n");
+    
+    buffer_agregar(b, "El legado de Euler es inmenso. Muchos conceptos, teoremas y fórmulas llevan su nombre: ");
+    buffer_agregar(b, "el número de Euler ($e$), la fórmula de Euler, el método de Euler para ecuaciones ");
+    buffer_agregar(b, "diferenciales, los ángulos de Euler, la función phi de Euler, y muchos más. Su ");
+    buffer_agregar(b, "influencia se extiende no solo a las matemáticas puras, sino también a la física, la ");
+    buffer_agregar(b, "ingeniería y la computación moderna.\n\n");
+    
+    buffer_agregar(b, "Euler murió en San Petersburgo en 1783, dejando un legado que continúa inspirando a ");
+    buffer_agregar(b, "matemáticos y científicos hasta el día de hoy. Su enfoque sistemático, su notación ");
+    buffer_agregar(b, "clara y su capacidad para encontrar conexiones profundas entre diferentes áreas del ");
+    buffer_agregar(b, "conocimiento lo convierten en uno de los pilares fundamentales de las matemáticas modernas.\n\n");
+    
+    buffer_agregar(b, "\\section{Ciclos y Rutas Eulerianas}\n\n");
+    
+    buffer_agregar(b, "\\subsection{El Problema de los Puentes de Königsberg}\n\n");
+    
+    buffer_agregar(b, "El origen de los ciclos eulerianos se remonta al famoso \\textbf{problema de los puentes ");
+    buffer_agregar(b, "de Königsberg}, resuelto por Euler en 1736. La ciudad de Königsberg (hoy Kaliningrado) ");
+    buffer_agregar(b, "estaba dividida por el río Pregel en cuatro regiones conectadas por siete puentes. ");
+    buffer_agregar(b, "El problema consistía en determinar si era posible dar un paseo que cruzara cada puente ");
+    buffer_agregar(b, "exactamente una vez y regresar al punto de partida.\n\n");
+    
+    buffer_agregar(b, "Euler modeló este problema como un grafo, donde cada región era un vértice y cada puente ");
+    buffer_agregar(b, "era una arista. Demostró que tal recorrido era imposible, estableciendo así los ");
+    buffer_agregar(b, "fundamentos de la teoría de grafos y los grafos eulerianos.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.0]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (A) at (0,0) {A};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (B) at (2,0) {B};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (C) at (1,1.5) {C};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.6cm] (D) at (1,-1.5) {D};\n");
+    buffer_agregar(b, "\\draw[thick] (A) -- (C);\n");
+    buffer_agregar(b, "\\draw[thick] (A) -- (C);\n");
+    buffer_agregar(b, "\\draw[thick] (A) -- (D);\n");
+    buffer_agregar(b, "\\draw[thick] (B) -- (C);\n");
+    buffer_agregar(b, "\\draw[thick] (B) -- (C);\n");
+    buffer_agregar(b, "\\draw[thick] (B) -- (D);\n");
+    buffer_agregar(b, "\\draw[thick] (C) -- (D);\n");
+    buffer_agregar(b, "\\node[below] at (1,-2.2) {Grafo de los puentes de Königsberg};\n");
+    buffer_agregar(b, "\\node[below] at (1,-2.6) {Grados: A=3, B=3, C=5, D=3 (todos impares)};\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    buffer_agregar(b, "Como todos los vértices tienen grado impar, el grafo no puede tener un ciclo euleriano. ");
+    buffer_agregar(b, "Este fue el primer resultado en teoría de grafos.\n\n");
+    
+    buffer_agregar(b, "\\subsection{Definiciones Fundamentales}\n\n");
+    
+    buffer_agregar(b, "Un \\textbf{ciclo euleriano} es un ciclo cerrado en un grafo que recorre cada arista ");
+    buffer_agregar(b, "exactamente una vez y regresa al vértice inicial. Formalmente, dado un grafo $G = (V, E)$ ");
+    buffer_agregar(b, "con $m$ aristas, un ciclo euleriano es una secuencia de vértices $v_1, v_2, \\ldots, v_k, v_1$ ");
+    buffer_agregar(b, "tal que:\n\n");
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item Cada arista del grafo aparece exactamente una vez en el ciclo\n");
+    buffer_agregar(b, "\\item El ciclo comienza y termina en el mismo vértice\n");
+    buffer_agregar(b, "\\item Cada par consecutivo de vértices está conectado por una arista\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+    
+    buffer_agregar(b, "Un \\textbf{camino euleriano} (o ruta euleriana) es un camino que recorre cada arista ");
+    buffer_agregar(b, "exactamente una vez, pero no necesariamente regresa al punto de partida. Es decir, es ");
+    buffer_agregar(b, "una secuencia de vértices $v_1, v_2, \\ldots, v_k$ donde cada arista aparece exactamente ");
+    buffer_agregar(b, "una vez.\n\n");
+    
+    buffer_agregar(b, "Un grafo es \\textbf{euleriano} si tiene un ciclo euleriano. Un grafo es ");
+    buffer_agregar(b, "\\textbf{semieuleriano} si tiene un camino euleriano pero no un ciclo euleriano.\n\n");
+    
+    buffer_agregar(b, "\\subsection{Teorema de Euler}\n\n");
+    
+    buffer_agregar(b, "Euler estableció condiciones necesarias y suficientes para la existencia de ciclos y ");
+    buffer_agregar(b, "caminos eulerianos:\n\n");
+    
+    buffer_agregar(b, "\\textbf{Teorema (Euler, 1736):} Para un grafo no dirigido conexo $G$:\n\n");
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item $G$ tiene un ciclo euleriano si y solo si todos los vértices tienen grado par\n");
+    buffer_agregar(b, "\\item $G$ tiene un camino euleriano (pero no un ciclo) si y solo si tiene exactamente ");
+    buffer_agregar(b, "dos vértices de grado impar. Estos vértices serán el inicio y el final del camino\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+    
+    buffer_agregar(b, "Para grafos dirigidos:\n\n");
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item Un grafo dirigido tiene un ciclo euleriano si y solo si es fuertemente conexo ");
+    buffer_agregar(b, "y cada vértice tiene el mismo grado de entrada que de salida\n");
+    buffer_agregar(b, "\\item Un grafo dirigido tiene un camino euleriano si tiene exactamente un vértice ");
+    buffer_agregar(b, "con $\\deg_{salida} - \\deg_{entrada} = 1$ (inicio), exactamente un vértice con ");
+    buffer_agregar(b, "$\\deg_{entrada} - \\deg_{salida} = 1$ (fin), y todos los demás tienen grados iguales\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+    
+    buffer_agregar(b, "\\subsection{Ejemplos Visuales}\n\n");
+    
+    buffer_agregar(b, "A continuación se presentan ejemplos gráficos que ilustran estos conceptos:\n\n");
+    
+    // Ejemplo 1: Ciclo euleriano
+    buffer_agregar(b, "\\subsubsection{Ejemplo 1: Grafo Euleriano (Ciclo Euleriano)}\n\n");
+    buffer_agregar(b, "El siguiente grafo es euleriano porque todos los vértices tienen grado par (2 o 4). ");
+    buffer_agregar(b, "El ciclo euleriano está marcado en rojo y recorre todas las aristas exactamente una vez.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (2) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (3) -- (0);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (0) to[bend left=15] node[above] {1} (1);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (1) to[bend left=15] node[right] {2} (2);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (2) to[bend left=15] node[below] {3} (3);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (3) to[bend left=15] node[left] {4} (0);\n");
+    buffer_agregar(b, "\\node[below] at (1,-0.8) {Ciclo: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$};\n");
+    buffer_agregar(b, "\\node[below] at (1,-1.2) {Grados: todos pares (2)};\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    // Ejemplo 2: Camino euleriano (semieuleriano)
+    buffer_agregar(b, "\\subsubsection{Ejemplo 2: Grafo Semieuleriano (Camino Euleriano)}\n\n");
+    buffer_agregar(b, "El siguiente grafo es semieuleriano porque tiene exactamente dos vértices de grado impar ");
+    buffer_agregar(b, "(vértices 0 y 3, ambos con grado 3). El camino euleriano está marcado en verde y ");
+    buffer_agregar(b, "comienza en el vértice 0 y termina en el vértice 3.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (2) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (3);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (0) to[bend left=15] node[above] {1} (1);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (1) to[bend left=15] node[right] {2} (2);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (2) to[bend left=15] node[above] {3} (3);\n");
+    buffer_agregar(b, "\\draw[green!70!black, very thick, ->] (3) to[bend left=15] node[left] {4} (0);\n");
+    buffer_agregar(b, "\\node[below] at (1,-0.8) {Camino: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$};\n");
+    buffer_agregar(b, "\\node[below] at (1,-1.2) {Grados: 0=3, 1=2, 2=2, 3=3 (dos impares)};\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    // Ejemplo 3: Grafo no euleriano
+    buffer_agregar(b, "\\subsubsection{Ejemplo 3: Grafo No Euleriano}\n\n");
+    buffer_agregar(b, "El siguiente grafo no es euleriano ni semieuleriano porque tiene más de dos vértices ");
+    buffer_agregar(b, "de grado impar (vértices 0, 1, 2 y 3, todos con grado 3). Por lo tanto, no existe ");
+    buffer_agregar(b, "ningún camino que recorra todas las aristas exactamente una vez.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (2) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (3) -- (0);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (0) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin] (1) -- (3);\n");
+    buffer_agregar(b, "\\node[below] at (1,-0.8) {Grados: todos impares (3)};\n");
+    buffer_agregar(b, "\\node[below] at (1,-1.2) {No es euleriano ni semieuleriano};\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    // Ejemplo 4: Grafo dirigido euleriano
+    buffer_agregar(b, "\\subsubsection{Ejemplo 4: Grafo Dirigido Euleriano}\n\n");
+    buffer_agregar(b, "En grafos dirigidos, un ciclo euleriano requiere que cada vértice tenga el mismo grado ");
+    buffer_agregar(b, "de entrada que de salida. El siguiente ejemplo muestra un grafo dirigido euleriano.\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[scale=1.2, >=Stealth]\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (0) at (0,0) {0};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (1) at (2,0) {1};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (2) at (2,2) {2};\n");
+    buffer_agregar(b, "\\node[circle, draw=black, fill=blue!30, minimum size=0.8cm] (3) at (0,2) {3};\n");
+    buffer_agregar(b, "\\draw[gray, thin, ->] (0) -- (1);\n");
+    buffer_agregar(b, "\\draw[gray, thin, ->] (1) -- (2);\n");
+    buffer_agregar(b, "\\draw[gray, thin, ->] (2) -- (3);\n");
+    buffer_agregar(b, "\\draw[gray, thin, ->] (3) -- (0);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (0) to[bend left=15] node[above] {1} (1);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (1) to[bend left=15] node[right] {2} (2);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (2) to[bend left=15] node[below] {3} (3);\n");
+    buffer_agregar(b, "\\draw[red, very thick, ->] (3) to[bend left=15] node[left] {4} (0);\n");
+    buffer_agregar(b, "\\node[below] at (1,-0.8) {Ciclo: $0 \\rightarrow 1 \\rightarrow 2 \\rightarrow 3 \\rightarrow 0$};\n");
+    buffer_agregar(b, "\\node[below] at (1,-1.2) {Grados: entrada = salida para todos (1)};\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    buffer_agregar(b, "\\subsection{Aplicaciones Prácticas}\n\n");
+    
+    buffer_agregar(b, "Los ciclos y caminos eulerianos tienen numerosas aplicaciones en la vida real:\n\n");
+    
+    buffer_agregar(b, "\\begin{itemize}\n");
+    buffer_agregar(b, "\\item \\textbf{Recolección de basura}: Optimizar rutas para que los camiones pasen ");
+    buffer_agregar(b, "por todas las calles exactamente una vez\n");
+    buffer_agregar(b, "\\item \\textbf{Inspección de redes}: Verificar todas las conexiones de una red (eléctrica, ");
+    buffer_agregar(b, "de agua, de datos) de manera eficiente\n");
+    buffer_agregar(b, "\\item \\textbf{Impresión de circuitos}: Encontrar rutas que pasen por todas las líneas ");
+    buffer_agregar(b, "de un circuito impreso sin repetición\n");
+    buffer_agregar(b, "\\item \\textbf{Postal y entrega}: Diseñar rutas de entrega que cubran todas las ");
+    buffer_agregar(b, "calles sin duplicar esfuerzo\n");
+    buffer_agregar(b, "\\item \\textbf{Análisis de ADN}: Reconstruir secuencias genéticas a partir de fragmentos\n");
+    buffer_agregar(b, "\\end{itemize}\n\n");
+}
+
+// Dibujo del grafo con los nodos coloreados según la paridad de sus grados
+static void seccion_grafo_original(BufferTexto *b, const AnalisisReporte *a) {
+    (void)a;
+    int K = grafo_actual.K;
+    
+    buffer_agregar(b, "\\section{Grafo Original}\n\n");
+    
+    buffer_agregar(b, "\\begin{center}\n");
+    buffer_agregar(b, "\\begin{tikzpicture}[lienzo]\n");
     
     int grados[MAX_NODOS];
     int grados_entrada[MAX_NODOS];
@@ -2475,17 +2892,16 @@ void generar_latex(const char *filename) {
         calcular_grados_dirigido(grados_entrada, grados_salida);
     }
     
+    // Los nodos se colocan primero para que las aristas los referencien por nombre
+    buffer_agregar(b, "\\nodoscolor{");
     for (int i = 0; i < K; i++) {
-        double x = grafo_actual.posiciones[i].x - min_x;
-        double y = grafo_actual.posiciones[i].y - min_y;
+        const char *color;
+        const char *text_color = "black";
         
         if (grafo_actual.tipo == NO_DIRIGIDO) {
-            const char *color = (grados[i] % 2 == 0) ? "white" : "black!80";
-            const char *text_color = (grados[i] % 2 == 0) ? "black" : "white";
-            fprintf(f, "\\node[circle, draw=black, fill=%s, minimum size=0.8cm, font=\\scriptsize, text=%s] (n%d) at (%.2f,%.2f) {%d};\n",
-                color, text_color, i, x, y, i);
+            color = (grados[i] % 2 == 0) ? "white" : "black!80";
+            text_color = (grados[i] % 2 == 0) ? "black" : "white";
         } else {
-            const char *color;
             int ent_par = (grados_entrada[i] % 2 == 0) ? 1 : 0;
             int sal_par = (grados_salida[i] % 2 == 0) ? 1 : 0;
             
@@ -2493,735 +2909,749 @@ void generar_latex(const char *filename) {
             else if (ent_par && !sal_par) color = "green!30";
             else if (!ent_par && sal_par) color = "yellow!30";
             else color = "red!30";
-            
-            fprintf(f, "\\node[circle, draw=black, fill=%s, minimum size=0.8cm, font=\\scriptsize] (n%d) at (%.2f,%.2f) {%d};\n",
-                color, i, x, y, i);
         }
+        
+        if (i > 0) buffer_agregar_caracter(b, ',');
+        buffer_agregar_entero(b, i);
+        buffer_agregar_caracter(b, '/');
+        buffer_agregar(b, color);
+        buffer_agregar_caracter(b, '/');
+        buffer_agregar(b, text_color);
     }
+    buffer_agregar(b, "}\n");
     
-    fprintf(f, "\\end{tikzpicture}\n");
-    fprintf(f, "\\end{center}\n\n");
+    generar_tikz_aristas_matriz(b, "arista", grafo_actual.matriz_adyacencia);
     
-    fprintf(f, "\\subsection{Leyenda de Colores}\n\n");
+    buffer_agregar(b, "\\end{tikzpicture}\n");
+    buffer_agregar(b, "\\end{center}\n\n");
+    
+    buffer_agregar(b, "\\subsection{Leyenda de Colores}\n\n");
     if (grafo_actual.tipo == NO_DIRIGIDO) {
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item \\fcolorbox{black}{black!80}{\\rule{0.5cm}{0.5cm}} Nodos de grado impar\n");
-        fprintf(f, "\\item \\fcolorbox{black}{white}{\\rule{0.5cm}{0.5cm}} Nodos de grado par\n");
-        fprintf(f, "\\end{itemize}\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item \\fcolorbox{black}{black!80}{\\rule{0.5cm}{0.5cm}} Nodos de grado impar\n");
+        buffer_agregar(b, "\\item \\fcolorbox{black}{white}{\\rule{0.5cm}{0.5cm}} Nodos de grado par\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
     } else {
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item \\fcolorbox{black}{blue!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada par, grado de salida par\n");
-        fprintf(f, "\\item \\fcolorbox{black}{green!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada par, grado de salida impar\n");
-        fprintf(f, "\\item \\fcolorbox{black}{yellow!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada impar, grado de salida par\n");
-        fprintf(f, "\\item \\fcolorbox{black}{red!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada impar, grado de salida impar\n");
-        fprintf(f, "\\end{itemize}\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item \\fcolorbox{black}{blue!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada par, grado de salida par\n");
+        buffer_agregar(b, "\\item \\fcolorbox{black}{green!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada par, grado de salida impar\n");
+        buffer_agregar(b, "\\item \\fcolorbox{black}{yellow!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada impar, grado de salida par\n");
+        buffer_agregar(b, "\\item \\fcolorbox{black}{red!30}{\\rule{0.5cm}{0.5cm}} Grado de entrada impar, grado de salida impar\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
     }
-    
-    fprintf(f, "\\section{Propiedades del Grafo}\n\n");
-    
-    bool tiene_ciclo = tiene_ciclo_hamiltoniano();
-    bool tiene_ruta = tiene_ruta_hamiltoniana();
-    bool euler = es_euleriano();
-    bool semi_euler = es_semieuleriano();
-    
-    fprintf(f, "\\subsection{Ciclos y Rutas Hamiltonianas}\n\n");
-    
-    fprintf(f, "Para determinar la existencia de ciclos y rutas hamiltonianas en este grafo, se ha ");
-    fprintf(f, "utilizado un algoritmo de backtracking que explora sistemáticamente todas las posibles ");
-    fprintf(f, "secuencias de vértices. El algoritmo verifica si existe al menos una permutación de los ");
-    fprintf(f, "vértices que forme un ciclo o ruta válida según las aristas presentes en el grafo.\n\n");
-    
-    if (tiene_ciclo) {
-        fprintf(f, "\\textbf{Resultado: El grafo contiene al menos un ciclo hamiltoniano.}\n\n");
-        fprintf(f, "Esto significa que existe al menos una secuencia de vértices $v_1, v_2, \\ldots, v_n, v_1$ ");
-        fprintf(f, "tal que:\n\n");
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item Cada vértice del grafo aparece exactamente una vez en la secuencia (excepto ");
-        fprintf(f, "el vértice inicial que aparece al inicio y al final)\n");
-        fprintf(f, "\\item Cada par consecutivo de vértices en la secuencia está conectado por una arista\n");
-        fprintf(f, "\\item El último vértice está conectado al primero, cerrando el ciclo\n");
-        fprintf(f, "\\end{itemize}\n\n");
-        fprintf(f, "La existencia de un ciclo hamiltoniano indica que es posible visitar todos los ");
-        fprintf(f, "vértices del grafo exactamente una vez y regresar al punto de partida, siguiendo ");
-        fprintf(f, "únicamente las aristas existentes. Esta propiedad es de gran importancia en problemas ");
-        fprintf(f, "de optimización como el problema del viajante (TSP) y en el diseño de circuitos.\n\n");
+}
+
+// Resultados de los análisis hamiltoniano y euleriano
+static void seccion_propiedades(BufferTexto *b, const AnalisisReporte *a) {
+    buffer_agregar(b, "\\section{Propiedades del Grafo}\n\n");
+        
+    buffer_agregar(b, "\\subsection{Ciclos y Rutas Hamiltonianas}\n\n");
+    
+    buffer_agregar(b, "Para determinar la existencia de ciclos y rutas hamiltonianas en este grafo, se ha ");
+    buffer_agregar(b, "utilizado un algoritmo de backtracking que explora sistemáticamente todas las posibles ");
+    buffer_agregar(b, "secuencias de vértices. El algoritmo verifica si existe al menos una permutación de los ");
+    buffer_agregar(b, "vértices que forme un ciclo o ruta válida según las aristas presentes en el grafo.\n\n");
+    
+    if (a->tiene_ciclo) {
+        buffer_agregar(b, "\\textbf{Resultado: El grafo contiene al menos un ciclo hamiltoniano.}\n\n");
+        buffer_agregar(b, "Esto significa que existe al menos una secuencia de vértices $v_1, v_2, \\ldots, v_n, v_1$ ");
+        buffer_agregar(b, "tal que:\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item Cada vértice del grafo aparece exactamente una vez en la secuencia (excepto ");
+        buffer_agregar(b, "el vértice inicial que aparece al inicio y al final)\n");
+        buffer_agregar(b, "\\item Cada par consecutivo de vértices en la secuencia está conectado por una arista\n");
+        buffer_agregar(b, "\\item El último vértice está conectado al primero, cerrando el ciclo\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
+        buffer_agregar(b, "La existencia de un ciclo hamiltoniano indica que es posible visitar todos los ");
+        buffer_agregar(b, "vértices del grafo exactamente una vez y regresar al punto de partida, siguiendo ");
+        buffer_agregar(b, "únicamente las aristas existentes. Esta propiedad es de gran importancia en problemas ");
+        buffer_agregar(b, "de optimización como el problema del viajante (TSP) y en el diseño de circuitos.\n\n");
     } else {
-        fprintf(f, "\\textbf{Resultado: El grafo no contiene un ciclo hamiltoniano.}\n\n");
-        fprintf(f, "Esto significa que no existe ninguna secuencia de vértices que forme un ciclo ");
-        fprintf(f, "cerrado visitando cada vértice exactamente una vez. Las posibles razones para esto ");
-        fprintf(f, "pueden incluir:\n\n");
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item El grafo no es suficientemente denso (no hay suficientes aristas para conectar ");
-        fprintf(f, "todos los vértices en un ciclo)\n");
-        fprintf(f, "\\item Existen vértices de grado muy bajo que restringen las posibles rutas\n");
-        fprintf(f, "\\item La estructura del grafo impide la formación de un ciclo que visite todos ");
-        fprintf(f, "los vértices\n");
-        fprintf(f, "\\end{itemize}\n\n");
-        fprintf(f, "Es importante notar que la ausencia de un ciclo hamiltoniano no implica necesariamente ");
-        fprintf(f, "la ausencia de una ruta hamiltoniana, ya que una ruta no requiere regresar al ");
-        fprintf(f, "vértice inicial.\n\n");
-    }
-    
-    if (tiene_ruta) {
-        fprintf(f, "\\textbf{Resultado: El grafo contiene al menos una ruta hamiltoniana.}\n\n");
-        fprintf(f, "Esto significa que existe al menos una secuencia de vértices $v_1, v_2, \\ldots, v_n$ ");
-        fprintf(f, "tal que:\n\n");
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item Cada vértice del grafo aparece exactamente una vez en la secuencia\n");
-        fprintf(f, "\\item Cada par consecutivo de vértices en la secuencia está conectado por una arista\n");
-        fprintf(f, "\\item El camino no necesariamente regresa al vértice inicial\n");
-        fprintf(f, "\\end{itemize}\n\n");
-        fprintf(f, "La existencia de una ruta hamiltoniana indica que es posible visitar todos los ");
-        fprintf(f, "vértices del grafo exactamente una vez, aunque no se regrese al punto de partida. ");
-        fprintf(f, "Esta propiedad es útil en problemas de secuenciación, donde se necesita un orden ");
-        fprintf(f, "específico de elementos sin repetición.\n\n");
-        if (!tiene_ciclo) {
-            fprintf(f, "Nótese que aunque este grafo tiene una ruta hamiltoniana, no tiene un ciclo ");
-            fprintf(f, "hamiltoniano. Esto significa que cualquier ruta que visite todos los vértices ");
-            fprintf(f, "debe comenzar y terminar en vértices diferentes, y no puede cerrarse formando ");
-            fprintf(f, "un ciclo.\n\n");
+        buffer_agregar(b, "\\textbf{Resultado: El grafo no contiene un ciclo hamiltoniano.}\n\n");
+        buffer_agregar(b, "Esto significa que no existe ninguna secuencia de vértices que forme un ciclo ");
+        buffer_agregar(b, "cerrado visitando cada vértice exactamente una vez. Las posibles razones para esto ");
+        buffer_agregar(b, "pueden incluir:\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item El grafo no es suficientemente denso (no hay suficientes aristas para conectar ");
+        buffer_agregar(b, "todos los vértices en un ciclo)\n");
+        buffer_agregar(b, "\\item Existen vértices de grado muy bajo que restringen las posibles rutas\n");
+        buffer_agregar(b, "\\item La estructura del grafo impide la formación de un ciclo que visite todos ");
+        buffer_agregar(b, "los vértices\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
+        buffer_agregar(b, "Es importante notar que la ausencia de un ciclo hamiltoniano no implica necesariamente ");
+        buffer_agregar(b, "la ausencia de una ruta hamiltoniana, ya que una ruta no requiere regresar al ");
+        buffer_agregar(b, "vértice inicial.\n\n");
+    }
+    
+    if (a->tiene_ruta) {
+        buffer_agregar(b, "\\textbf{Resultado: El grafo contiene al menos una ruta hamiltoniana.}\n\n");
+        buffer_agregar(b, "Esto significa que existe al menos una secuencia de vértices $v_1, v_2, \\ldots, v_n$ ");
+        buffer_agregar(b, "tal que:\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item Cada vértice del grafo aparece exactamente una vez en la secuencia\n");
+        buffer_agregar(b, "\\item Cada par consecutivo de vértices en la secuencia está conectado por una arista\n");
+        buffer_agregar(b, "\\item El camino no necesariamente regresa al vértice inicial\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
+        buffer_agregar(b, "La existencia de una ruta hamiltoniana indica que es posible visitar todos los ");
+        buffer_agregar(b, "vértices del grafo exactamente una vez, aunque no se regrese al punto de partida. ");
+        buffer_agregar(b, "Esta propiedad es útil en problemas de secuenciación, donde se necesita un orden ");
+        buffer_agregar(b, "específico de elementos sin repetición.\n\n");
+        if (!a->tiene_ciclo) {
+            buffer_agregar(b, "Nótese que aunque este grafo tiene una ruta hamiltoniana, no tiene un ciclo ");
+            buffer_agregar(b, "hamiltoniano. Esto significa que cualquier ruta que visite todos los vértices ");
+            buffer_agregar(b, "debe comenzar y terminar en vértices diferentes, y no puede cerrarse formando ");
+            buffer_agregar(b, "un ciclo.\n\n");
         }
     } else {
-        fprintf(f, "\\textbf{Resultado: El grafo no contiene una ruta hamiltoniana.}\n\n");
-        fprintf(f, "Esto significa que no existe ninguna secuencia de vértices que visite cada vértice ");
-        fprintf(f, "exactamente una vez siguiendo las aristas del grafo. Si el grafo tampoco tiene un ");
-        fprintf(f, "ciclo hamiltoniano, entonces no es posible visitar todos los vértices en una sola ");
-        fprintf(f, "trayectoria sin repetir vértices.\n\n");
-        fprintf(f, "Las posibles razones para la ausencia de una ruta hamiltoniana incluyen:\n\n");
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item El grafo tiene vértices aislados o componentes desconectados\n");
-        fprintf(f, "\\item La estructura del grafo es demasiado restrictiva (por ejemplo, tiene forma ");
-        fprintf(f, "de árbol con muchas hojas)\n");
-        fprintf(f, "\\item Existen vértices que actúan como \"cuellos de botella\" que impiden el ");
-        fprintf(f, "recorrido completo\n");
-        fprintf(f, "\\end{itemize}\n\n");
-    }
-    
-    fprintf(f, "\\subsection{Propiedades Eulerianas}\n\n");
-    
-    fprintf(f, "Para determinar las propiedades eulerianas del grafo, se ha analizado la paridad de ");
-    fprintf(f, "los grados de los vértices. Según el teorema de Euler (1736), las condiciones para ");
-    fprintf(f, "la existencia de ciclos y caminos eulerianos dependen directamente de los grados de ");
-    fprintf(f, "los vértices, lo que hace que este problema sea computacionalmente más simple que el ");
-    fprintf(f, "problema hamiltoniano.\n\n");
-    
-    if (euler) {
-        fprintf(f, "\\textbf{Resultado: El grafo es euleriano.}\n\n");
-        fprintf(f, "Esto significa que el grafo contiene un \\textbf{ciclo euleriano}, es decir, un ");
-        fprintf(f, "ciclo cerrado que recorre cada arista del grafo exactamente una vez y regresa al ");
-        fprintf(f, "vértice inicial. Esta es una propiedad muy deseable en aplicaciones prácticas como ");
-        fprintf(f, "la optimización de rutas de recolección, inspección de redes y diseño de circuitos.\n\n");
+        buffer_agregar(b, "\\textbf{Resultado: El grafo no contiene una ruta hamiltoniana.}\n\n");
+        buffer_agregar(b, "Esto significa que no existe ninguna secuencia de vértices que visite cada vértice ");
+        buffer_agregar(b, "exactamente una vez siguiendo las aristas del grafo. Si el grafo tampoco tiene un ");
+        buffer_agregar(b, "ciclo hamiltoniano, entonces no es posible visitar todos los vértices en una sola ");
+        buffer_agregar(b, "trayectoria sin repetir vértices.\n\n");
+        buffer_agregar(b, "Las posibles razones para la ausencia de una ruta hamiltoniana incluyen:\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item El grafo tiene vértices aislados o componentes desconectados\n");
+        buffer_agregar(b, "\\item La estructura del grafo es demasiado restrictiva (por ejemplo, tiene forma ");
+        buffer_agregar(b, "de árbol con muchas hojas)\n");
+        buffer_agregar(b, "\\item Existen vértices que actúan como \"cuellos de botella\" que impiden el ");
+        buffer_agregar(b, "recorrido completo\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
+    }
+    
+    buffer_agregar(b, "\\subsection{Propiedades Eulerianas}\n\n");
+    
+    buffer_agregar(b, "Para determinar las propiedades eulerianas del grafo, se ha analizado la paridad de ");
+    buffer_agregar(b, "los grados de los vértices. Según el teorema de Euler (1736), las condiciones para ");
+    buffer_agregar(b, "la existencia de ciclos y caminos eulerianos dependen directamente de los grados de ");
+    buffer_agregar(b, "los vértices, lo que hace que este problema sea computacionalmente más simple que el ");
+    buffer_agregar(b, "problema hamiltoniano.\n\n");
+    
+    if (a->euler) {
+        buffer_agregar(b, "\\textbf{Resultado: El grafo es euleriano.}\n\n");
+        buffer_agregar(b, "Esto significa que el grafo contiene un \\textbf{ciclo euleriano}, es decir, un ");
+        buffer_agregar(b, "ciclo cerrado que recorre cada arista del grafo exactamente una vez y regresa al ");
+        buffer_agregar(b, "vértice inicial. Esta es una propiedad muy deseable en aplicaciones prácticas como ");
+        buffer_agregar(b, "la optimización de rutas de recolección, inspección de redes y diseño de circuitos.\n\n");
         
         if (grafo_actual.tipo == NO_DIRIGIDO) {
-            fprintf(f, "\\textbf{Análisis para grafo no dirigido:}\n\n");
-            fprintf(f, "Para que un grafo no dirigido sea euleriano, según el teorema de Euler, deben ");
-            fprintf(f, "cumplirse dos condiciones:\n\n");
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser \\textbf{conexo}: todos los vértices deben estar ");
-            fprintf(f, "conectados entre sí, de manera que exista un camino entre cualquier par de ");
-            fprintf(f, "vértices.\n");
-            fprintf(f, "\\item Todos los vértices deben tener \\textbf{grado par}: cada vértice debe ");
-            fprintf(f, "estar conectado a un número par de aristas.\n");
-            fprintf(f, "\\end{enumerate}\n\n");
-            fprintf(f, "En este grafo, se ha verificado que ambas condiciones se cumplen. La condición ");
-            fprintf(f, "de grados pares es necesaria porque, en un ciclo euleriano, cada vez que se ");
-            fprintf(f, "entra a un vértice por una arista, se debe salir por otra arista diferente. ");
-            fprintf(f, "Por lo tanto, cada vértice debe tener un número par de aristas incidentes.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis para grafo no dirigido:}\n\n");
+            buffer_agregar(b, "Para que un grafo no dirigido sea euleriano, según el teorema de Euler, deben ");
+            buffer_agregar(b, "cumplirse dos condiciones:\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser \\textbf{conexo}: todos los vértices deben estar ");
+            buffer_agregar(b, "conectados entre sí, de manera que exista un camino entre cualquier par de ");
+            buffer_agregar(b, "vértices.\n");
+            buffer_agregar(b, "\\item Todos los vértices deben tener \\textbf{grado par}: cada vértice debe ");
+            buffer_agregar(b, "estar conectado a un número par de aristas.\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "En este grafo, se ha verificado que ambas condiciones se cumplen. La condición ");
+            buffer_agregar(b, "de grados pares es necesaria porque, en un ciclo euleriano, cada vez que se ");
+            buffer_agregar(b, "entra a un vértice por una arista, se debe salir por otra arista diferente. ");
+            buffer_agregar(b, "Por lo tanto, cada vértice debe tener un número par de aristas incidentes.\n\n");
         } else {
-            fprintf(f, "\\textbf{Análisis para grafo dirigido:}\n\n");
-            fprintf(f, "Para que un grafo dirigido sea euleriano, según el teorema de Euler para grafos ");
-            fprintf(f, "dirigidos, deben cumplirse dos condiciones:\n\n");
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser \\textbf{fuertemente conexo}: debe existir un camino ");
-            fprintf(f, "dirigido desde cualquier vértice hacia cualquier otro vértice.\n");
-            fprintf(f, "\\item Cada vértice debe tener \\textbf{grado de entrada igual al grado de salida}: ");
-            fprintf(f, "para cada vértice $v$, el número de aristas que llegan a $v$ debe ser igual ");
-            fprintf(f, "al número de aristas que salen de $v$.\n");
-            fprintf(f, "\\end{enumerate}\n\n");
-            fprintf(f, "En este grafo dirigido, se ha verificado que ambas condiciones se cumplen. ");
-            fprintf(f, "La condición de balance de grados es análoga a la condición de grados pares ");
-            fprintf(f, "en grafos no dirigidos: en un ciclo euleriano dirigido, cada vez que se ");
-            fprintf(f, "entra a un vértice, se debe salir, manteniendo el balance entre aristas ");
-            fprintf(f, "entrantes y salientes.\n\n");
-        }
-        
-        fprintf(f, "\\textbf{Implicaciones prácticas:}\n\n");
-        fprintf(f, "La existencia de un ciclo euleriano significa que es posible diseñar una ruta ");
-        fprintf(f, "óptima que recorra todas las aristas del grafo exactamente una vez, sin necesidad ");
-        fprintf(f, "de repetir ninguna conexión. Esto es especialmente valioso en aplicaciones donde ");
-        fprintf(f, "se busca minimizar el tiempo o costo de recorrer todas las conexiones de una red.\n\n");
-        
-    } else if (semi_euler) {
-        fprintf(f, "\\textbf{Resultado: El grafo es semieuleriano.}\n\n");
-        fprintf(f, "Esto significa que el grafo contiene un \\textbf{camino euleriano} (también llamado ");
-        fprintf(f, "ruta euleriana), pero no un ciclo euleriano. Un camino euleriano recorre cada arista ");
-        fprintf(f, "del grafo exactamente una vez, pero no regresa al vértice inicial. Esta propiedad ");
-        fprintf(f, "es útil cuando se necesita recorrer todas las conexiones de una red, pero no es ");
-        fprintf(f, "necesario regresar al punto de partida.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis para grafo dirigido:}\n\n");
+            buffer_agregar(b, "Para que un grafo dirigido sea euleriano, según el teorema de Euler para grafos ");
+            buffer_agregar(b, "dirigidos, deben cumplirse dos condiciones:\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser \\textbf{fuertemente conexo}: debe existir un camino ");
+            buffer_agregar(b, "dirigido desde cualquier vértice hacia cualquier otro vértice.\n");
+            buffer_agregar(b, "\\item Cada vértice debe tener \\textbf{grado de entrada igual al grado de salida}: ");
+            buffer_agregar(b, "para cada vértice $v$, el número de aristas que llegan a $v$ debe ser igual ");
+            buffer_agregar(b, "al número de aristas que salen de $v$.\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "En este grafo dirigido, se ha verificado que ambas condiciones se cumplen. ");
+            buffer_agregar(b, "La condición de balance de grados es análoga a la condición de grados pares ");
+            buffer_agregar(b, "en grafos no dirigidos: en un ciclo euleriano dirigido, cada vez que se ");
+            buffer_agregar(b, "entra a un vértice, se debe salir, manteniendo el balance entre aristas ");
+            buffer_agregar(b, "entrantes y salientes.\n\n");
+        }
+        
+        buffer_agregar(b, "\\textbf{Implicaciones prácticas:}\n\n");
+        buffer_agregar(b, "La existencia de un ciclo euleriano significa que es posible diseñar una ruta ");
+        buffer_agregar(b, "óptima que recorra todas las aristas del grafo exactamente una vez, sin necesidad ");
+        buffer_agregar(b, "de repetir ninguna conexión. Esto es especialmente valioso en aplicaciones donde ");
+        buffer_agregar(b, "se busca minimizar el tiempo o costo de recorrer todas las conexiones de una red.\n\n");
+        
+    } else if (a->semi_euler) {
+        buffer_agregar(b, "\\textbf{Resultado: El grafo es semieuleriano.}\n\n");
+        buffer_agregar(b, "Esto significa que el grafo contiene un \\textbf{camino euleriano} (también llamado ");
+        buffer_agregar(b, "ruta euleriana), pero no un ciclo euleriano. Un camino euleriano recorre cada arista ");
+        buffer_agregar(b, "del grafo exactamente una vez, pero no regresa al vértice inicial. Esta propiedad ");
+        buffer_agregar(b, "es útil cuando se necesita recorrer todas las conexiones de una red, pero no es ");
+        buffer_agregar(b, "necesario regresar al punto de partida.\n\n");
         
         if (grafo_actual.tipo == NO_DIRIGIDO) {
-            fprintf(f, "\\textbf{Análisis para grafo no dirigido:}\n\n");
-            fprintf(f, "Para que un grafo no dirigido sea semieuleriano, según el teorema de Euler, ");
-            fprintf(f, "deben cumplirse dos condiciones:\n\n");
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser \\textbf{conexo}.\n");
-            fprintf(f, "\\item El grafo debe tener \\textbf{exactamente dos vértices de grado impar}. ");
-            fprintf(f, "Estos dos vértices serán necesariamente el inicio y el final del camino euleriano.\n");
-            fprintf(f, "\\end{enumerate}\n\n");
-            fprintf(f, "En este grafo, se ha verificado que se cumplen estas condiciones. La razón por ");
-            fprintf(f, "la cual se requieren exactamente dos vértices de grado impar es que, en un ");
-            fprintf(f, "camino euleriano, el vértice inicial tiene una arista más saliente que entrante ");
-            fprintf(f, "(grado impar), el vértice final tiene una arista más entrante que saliente ");
-            fprintf(f, "(grado impar), y todos los demás vértices intermedios tienen el mismo número ");
-            fprintf(f, "de aristas entrantes y salientes (grado par).\n\n");
+            buffer_agregar(b, "\\textbf{Análisis para grafo no dirigido:}\n\n");
+            buffer_agregar(b, "Para que un grafo no dirigido sea semieuleriano, según el teorema de Euler, ");
+            buffer_agregar(b, "deben cumplirse dos condiciones:\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser \\textbf{conexo}.\n");
+            buffer_agregar(b, "\\item El grafo debe tener \\textbf{exactamente dos vértices de grado impar}. ");
+            buffer_agregar(b, "Estos dos vértices serán necesariamente el inicio y el final del camino euleriano.\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "En este grafo, se ha verificado que se cumplen estas condiciones. La razón por ");
+            buffer_agregar(b, "la cual se requieren exactamente dos vértices de grado impar es que, en un ");
+            buffer_agregar(b, "camino euleriano, el vértice inicial tiene una arista más saliente que entrante ");
+            buffer_agregar(b, "(grado impar), el vértice final tiene una arista más entrante que saliente ");
+            buffer_agregar(b, "(grado impar), y todos los demás vértices intermedios tienen el mismo número ");
+            buffer_agregar(b, "de aristas entrantes y salientes (grado par).\n\n");
         } else {
-            fprintf(f, "\\textbf{Análisis para grafo dirigido:}\n\n");
-            fprintf(f, "Para que un grafo dirigido sea semieuleriano, deben cumplirse las siguientes ");
-            fprintf(f, "condiciones:\n\n");
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser \\textbf{conexo} (aunque no necesariamente fuertemente conexo).\n");
-            fprintf(f, "\\item Debe existir \\textbf{exactamente un vértice} con $\\deg_{salida} - \\deg_{entrada} = 1$ ");
-            fprintf(f, "(este será el vértice inicial del camino).\n");
-            fprintf(f, "\\item Debe existir \\textbf{exactamente un vértice} con $\\deg_{entrada} - \\deg_{salida} = 1$ ");
-            fprintf(f, "(este será el vértice final del camino).\n");
-            fprintf(f, "\\item Todos los demás vértices deben tener $\\deg_{entrada} = \\deg_{salida}$.\n");
-            fprintf(f, "\\end{enumerate}\n\n");
-            fprintf(f, "En este grafo dirigido, se ha verificado que se cumplen estas condiciones. ");
-            fprintf(f, "El desbalance de grados en exactamente dos vértices (uno con más salidas, otro ");
-            fprintf(f, "con más entradas) permite la existencia de un camino euleriano que comienza en ");
-            fprintf(f, "el vértice con exceso de salidas y termina en el vértice con exceso de entradas.\n\n");
-        }
-        
-        fprintf(f, "\\textbf{Implicaciones prácticas:}\n\n");
-        fprintf(f, "Aunque este grafo no tiene un ciclo euleriano, la existencia de un camino euleriano ");
-        fprintf(f, "significa que aún es posible recorrer todas las aristas exactamente una vez. Esto ");
-        fprintf(f, "es útil en situaciones donde el punto de inicio y fin pueden ser diferentes, como ");
-        fprintf(f, "en rutas de entrega que no requieren regresar al depósito inicial.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis para grafo dirigido:}\n\n");
+            buffer_agregar(b, "Para que un grafo dirigido sea semieuleriano, deben cumplirse las siguientes ");
+            buffer_agregar(b, "condiciones:\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser \\textbf{conexo} (aunque no necesariamente fuertemente conexo).\n");
+            buffer_agregar(b, "\\item Debe existir \\textbf{exactamente un vértice} con $\\deg_{salida} - \\deg_{entrada} = 1$ ");
+            buffer_agregar(b, "(este será el vértice inicial del camino).\n");
+            buffer_agregar(b, "\\item Debe existir \\textbf{exactamente un vértice} con $\\deg_{entrada} - \\deg_{salida} = 1$ ");
+            buffer_agregar(b, "(este será el vértice final del camino).\n");
+            buffer_agregar(b, "\\item Todos los demás vértices deben tener $\\deg_{entrada} = \\deg_{salida}$.\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "En este grafo dirigido, se ha verificado que se cumplen estas condiciones. ");
+            buffer_agregar(b, "El desbalance de grados en exactamente dos vértices (uno con más salidas, otro ");
+            buffer_agregar(b, "con más entradas) permite la existencia de un camino euleriano que comienza en ");
+            buffer_agregar(b, "el vértice con exceso de salidas y termina en el vértice con exceso de entradas.\n\n");
+        }
+        
+        buffer_agregar(b, "\\textbf{Implicaciones prácticas:}\n\n");
+        buffer_agregar(b, "Aunque este grafo no tiene un ciclo euleriano, la existencia de un camino euleriano ");
+        buffer_agregar(b, "significa que aún es posible recorrer todas las aristas exactamente una vez. Esto ");
+        buffer_agregar(b, "es útil en situaciones donde el punto de inicio y fin pueden ser diferentes, como ");
+        buffer_agregar(b, "en rutas de entrega que no requieren regresar al depósito inicial.\n\n");
         
     } else {
-        fprintf(f, "\\textbf{Resultado: El grafo no es euleriano ni semieuleriano.}\n\n");
-        fprintf(f, "Esto significa que no existe ningún ciclo ni camino que recorra todas las aristas ");
-        fprintf(f, "del grafo exactamente una vez. Por lo tanto, cualquier intento de recorrer todas ");
-        fprintf(f, "las aristas requerirá repetir al menos una de ellas.\n\n");
+        buffer_agregar(b, "\\textbf{Resultado: El grafo no es euleriano ni semieuleriano.}\n\n");
+        buffer_agregar(b, "Esto significa que no existe ningún ciclo ni camino que recorra todas las aristas ");
+        buffer_agregar(b, "del grafo exactamente una vez. Por lo tanto, cualquier intento de recorrer todas ");
+        buffer_agregar(b, "las aristas requerirá repetir al menos una de ellas.\n\n");
         
         if (grafo_actual.tipo == NO_DIRIGIDO) {
-            fprintf(f, "\\textbf{Análisis para grafo no dirigido:}\n\n");
-            fprintf(f, "Para que un grafo no dirigido tenga un ciclo o camino euleriano, según el ");
-            fprintf(f, "teorema de Euler, debe cumplir ciertas condiciones sobre los grados de sus ");
-            fprintf(f, "vértices:\n\n");
-            fprintf(f, "\\begin{itemize}\n");
-            fprintf(f, "\\item Para un \\textbf{ciclo euleriano}: todos los vértices deben tener grado par\n");
-            fprintf(f, "\\item Para un \\textbf{camino euleriano}: exactamente dos vértices deben tener ");
-            fprintf(f, "grado impar\n");
-            fprintf(f, "\\end{itemize}\n\n");
-            fprintf(f, "En este grafo, el análisis de los grados muestra que estas condiciones no se ");
-            fprintf(f, "cumplen. Las posibles razones incluyen:\n\n");
-            fprintf(f, "\\begin{itemize}\n");
-            fprintf(f, "\\item El grafo tiene más de dos vértices con grado impar (lo que impide tanto ");
-            fprintf(f, "un ciclo como un camino euleriano)\n");
-            fprintf(f, "\\item El grafo no es conexo (tiene múltiples componentes desconectados)\n");
-            fprintf(f, "\\item La distribución de grados no permite la formación de un recorrido euleriano\n");
-            fprintf(f, "\\end{itemize}\n\n");
+            buffer_agregar(b, "\\textbf{Análisis para grafo no dirigido:}\n\n");
+            buffer_agregar(b, "Para que un grafo no dirigido tenga un ciclo o camino euleriano, según el ");
+            buffer_agregar(b, "teorema de Euler, debe cumplir ciertas condiciones sobre los grados de sus ");
+            buffer_agregar(b, "vértices:\n\n");
+            buffer_agregar(b, "\\begin{itemize}\n");
+            buffer_agregar(b, "\\item Para un \\textbf{ciclo euleriano}: todos los vértices deben tener grado par\n");
+            buffer_agregar(b, "\\item Para un \\textbf{camino euleriano}: exactamente dos vértices deben tener ");
+            buffer_agregar(b, "grado impar\n");
+            buffer_agregar(b, "\\end{itemize}\n\n");
+            buffer_agregar(b, "En este grafo, el análisis de los grados muestra que estas condiciones no se ");
+            buffer_agregar(b, "cumplen. Las posibles razones incluyen:\n\n");
+            buffer_agregar(b, "\\begin{itemize}\n");
+            buffer_agregar(b, "\\item El grafo tiene más de dos vértices con grado impar (lo que impide tanto ");
+            buffer_agregar(b, "un ciclo como un camino euleriano)\n");
+            buffer_agregar(b, "\\item El grafo no es conexo (tiene múltiples componentes desconectados)\n");
+            buffer_agregar(b, "\\item La distribución de grados no permite la formación de un recorrido euleriano\n");
+            buffer_agregar(b, "\\end{itemize}\n\n");
         } else {
-            fprintf(f, "\\textbf{Análisis para grafo dirigido:}\n\n");
-            fprintf(f, "Para que un grafo dirigido tenga un ciclo o camino euleriano, deben cumplirse ");
-            fprintf(f, "condiciones específicas sobre el balance de grados:\n\n");
-            fprintf(f, "\\begin{itemize}\n");
-            fprintf(f, "\\item Para un \\textbf{ciclo euleriano}: cada vértice debe tener $\\deg_{entrada} = \\deg_{salida}$ ");
-            fprintf(f, "y el grafo debe ser fuertemente conexo\n");
-            fprintf(f, "\\item Para un \\textbf{camino euleriano}: debe haber exactamente un vértice con ");
-            fprintf(f, "$\\deg_{salida} - \\deg_{entrada} = 1$, exactamente un vértice con ");
-            fprintf(f, "$\\deg_{entrada} - \\deg_{salida} = 1$, y todos los demás con grados balanceados\n");
-            fprintf(f, "\\end{itemize}\n\n");
-            fprintf(f, "En este grafo dirigido, el análisis de los grados muestra que estas condiciones ");
-            fprintf(f, "no se cumplen. Las posibles razones incluyen:\n\n");
-            fprintf(f, "\\begin{itemize}\n");
-            fprintf(f, "\\item Hay más de dos vértices con desbalance en sus grados (más de un vértice ");
-            fprintf(f, "con exceso de salidas o entradas)\n");
-            fprintf(f, "\\item El grafo no es suficientemente conexo\n");
-            fprintf(f, "\\item La estructura de direcciones impide la formación de un recorrido euleriano\n");
-            fprintf(f, "\\end{itemize}\n\n");
-        }
-        
-        fprintf(f, "\\textbf{Implicaciones prácticas:}\n\n");
-        fprintf(f, "La ausencia de propiedades eulerianas significa que cualquier ruta que intente ");
-        fprintf(f, "recorrer todas las aristas del grafo necesariamente tendrá que repetir algunas ");
-        fprintf(f, "conexiones. Esto puede ser importante en aplicaciones donde se busca minimizar el ");
-        fprintf(f, "tiempo o costo de recorrido, ya que será necesario pasar más de una vez por ciertas ");
-        fprintf(f, "aristas.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis para grafo dirigido:}\n\n");
+            buffer_agregar(b, "Para que un grafo dirigido tenga un ciclo o camino euleriano, deben cumplirse ");
+            buffer_agregar(b, "condiciones específicas sobre el balance de grados:\n\n");
+            buffer_agregar(b, "\\begin{itemize}\n");
+            buffer_agregar(b, "\\item Para un \\textbf{ciclo euleriano}: cada vértice debe tener $\\deg_{entrada} = \\deg_{salida}$ ");
+            buffer_agregar(b, "y el grafo debe ser fuertemente conexo\n");
+            buffer_agregar(b, "\\item Para un \\textbf{camino euleriano}: debe haber exactamente un vértice con ");
+            buffer_agregar(b, "$\\deg_{salida} - \\deg_{entrada} = 1$, exactamente un vértice con ");
+            buffer_agregar(b, "$\\deg_{entrada} - \\deg_{salida} = 1$, y todos los demás con grados balanceados\n");
+            buffer_agregar(b, "\\end{itemize}\n\n");
+            buffer_agregar(b, "En este grafo dirigido, el análisis de los grados muestra que estas condiciones ");
+            buffer_agregar(b, "no se cumplen. Las posibles razones incluyen:\n\n");
+            buffer_agregar(b, "\\begin{itemize}\n");
+            buffer_agregar(b, "\\item Hay más de dos vértices con desbalance en sus grados (más de un vértice ");
+            buffer_agregar(b, "con exceso de salidas o entradas)\n");
+            buffer_agregar(b, "\\item El grafo no es suficientemente conexo\n");
+            buffer_agregar(b, "\\item La estructura de direcciones impide la formación de un recorrido euleriano\n");
+            buffer_agregar(b, "\\end{itemize}\n\n");
+        }
+        
+        buffer_agregar(b, "\\textbf{Implicaciones prácticas:}\n\n");
+        buffer_agregar(b, "La ausencia de propiedades eulerianas significa que cualquier ruta que intente ");
+        buffer_agregar(b, "recorrer todas las aristas del grafo necesariamente tendrá que repetir algunas ");
+        buffer_agregar(b, "conexiones. Esto puede ser importante en aplicaciones donde se busca minimizar el ");
+        buffer_agregar(b, "tiempo o costo de recorrido, ya que será necesario pasar más de una vez por ciertas ");
+        buffer_agregar(b, "aristas.\n\n");
     }
-    
+}
+
+// Secuencia del ciclo o ruta hamiltoniana encontrada
+static void seccion_hamiltoniano(BufferTexto *b, const AnalisisReporte *a) {
     // Sección: Ciclo o Ruta Hamiltoniana
-    fprintf(f, "\\section{Ciclo o Ruta Hamiltoniana}\n\n");
-    
-    int secuencia_hamiltoniana[MAX_NODOS + 1];
-    int longitud_hamiltoniana = 0;
-    bool encontrado_hamiltoniano = false;
-    
-    if (tiene_ciclo) {
-        encontrado_hamiltoniano = encontrar_ciclo_hamiltoniano(secuencia_hamiltoniana, &longitud_hamiltoniana);
-        if (encontrado_hamiltoniano) {
-            fprintf(f, "\\textbf{Ciclo Hamiltoniano encontrado:}\n\n");
-            fprintf(f, "El grafo contiene un ciclo hamiltoniano. A continuación se presenta una ");
-            fprintf(f, "secuencia de vértices que forma dicho ciclo:\n\n");
-            fprintf(f, "\\begin{center}\n");
-            fprintf(f, "\\Large\n");
-            for (int i = 0; i < longitud_hamiltoniana; i++) {
-                fprintf(f, "%d", secuencia_hamiltoniana[i]);
-                if (i < longitud_hamiltoniana - 1) {
-                    fprintf(f, " $\\rightarrow$ ");
-                }
-            }
-            fprintf(f, "\n");
-            fprintf(f, "\\end{center}\n\n");
-            fprintf(f, "\\normalsize\n");
-            fprintf(f, "Esta secuencia visita cada vértice exactamente una vez (excepto el vértice ");
-            fprintf(f, "inicial que aparece al inicio y al final) y forma un ciclo cerrado.\n\n");
-        }
-    } else if (tiene_ruta) {
-        encontrado_hamiltoniano = encontrar_ruta_hamiltoniana(secuencia_hamiltoniana, &longitud_hamiltoniana);
-        if (encontrado_hamiltoniano) {
-            fprintf(f, "\\textbf{Ruta Hamiltoniana encontrada:}\n\n");
-            fprintf(f, "El grafo contiene una ruta hamiltoniana (aunque no un ciclo). A continuación ");
-            fprintf(f, "se presenta una secuencia de vértices que forma dicha ruta:\n\n");
-            fprintf(f, "\\begin{center}\n");
-            fprintf(f, "\\Large\n");
-            for (int i = 0; i < longitud_hamiltoniana; i++) {
-                fprintf(f, "%d", secuencia_hamiltoniana[i]);
-                if (i < longitud_hamiltoniana - 1) {
-                    fprintf(f, " $\\rightarrow$ ");
-                }
-            }
-            fprintf(f, "\n");
-            fprintf(f, "\\end{center}\n\n");
-            fprintf(f, "\\normalsize\n");
-            fprintf(f, "Esta secuencia visita cada vértice exactamente una vez, pero no regresa al ");
-            fprintf(f, "vértice inicial.\n\n");
+    buffer_agregar(b, "\\section{Ciclo o Ruta Hamiltoniana}\n\n");
+    
+    if (a->tiene_ciclo) {
+        if (a->encontrado_hamiltoniano) {
+            buffer_agregar(b, "\\textbf{Ciclo Hamiltoniano encontrado:}\n\n");
+            buffer_agregar(b, "El grafo contiene un ciclo hamiltoniano. A continuación se presenta una ");
+            buffer_agregar(b, "secuencia de vértices que forma dicho ciclo:\n\n");
+            generar_secuencia_latex(b, a->secuencia_hamiltoniana, a->longitud_hamiltoniana);
+            buffer_agregar(b, "Esta secuencia visita cada vértice exactamente una vez (excepto el vértice ");
+            buffer_agregar(b, "inicial que aparece al inicio y al final) y forma un ciclo cerrado.\n\n");
+        }
+    } else if (a->tiene_ruta) {
+        if (a->encontrado_hamiltoniano) {
+            buffer_agregar(b, "\\textbf{Ruta Hamiltoniana encontrada:}\n\n");
+            buffer_agregar(b, "El grafo contiene una ruta hamiltoniana (aunque no un ciclo). A continuación ");
+            buffer_agregar(b, "se presenta una secuencia de vértices que forma dicha ruta:\n\n");
+            generar_secuencia_latex(b, a->secuencia_hamiltoniana, a->longitud_hamiltoniana);
+            buffer_agregar(b, "Esta secuencia visita cada vértice exactamente una vez, pero no regresa al ");
+            buffer_agregar(b, "vértice inicial.\n\n");
         }
     } else {
-        fprintf(f, "\\textbf{No se encontró ciclo ni ruta hamiltoniana.}\n\n");
-        fprintf(f, "El análisis del grafo mediante backtracking no encontró ninguna secuencia de ");
-        fprintf(f, "vértices que forme un ciclo o ruta hamiltoniana. Esto significa que no es posible ");
-        fprintf(f, "visitar todos los vértices exactamente una vez siguiendo las aristas del grafo.\n\n");
+        buffer_agregar(b, "\\textbf{No se encontró ciclo ni ruta hamiltoniana.}\n\n");
+        buffer_agregar(b, "El análisis del grafo mediante backtracking no encontró ninguna secuencia de ");
+        buffer_agregar(b, "vértices que forme un ciclo o ruta hamiltoniana. Esto significa que no es posible ");
+        buffer_agregar(b, "visitar todos los vértices exactamente una vez siguiendo las aristas del grafo.\n\n");
     }
-    
+}
+
+// Biografía de Hierholzer y ciclo euleriano con su ejecución paso a paso
+static void seccion_hierholzer(BufferTexto *b, const AnalisisReporte *a) {
     // Sección: Hierholzer
-    fprintf(f, "\\section{Carl Hierholzer}\n\n");
-    fprintf(f, "\\begin{figure}[h]\n");
-    fprintf(f, "\\centering\n");
-    fprintf(f, "\\includegraphicsoptional[width=0.3\\textwidth]{hierholzer.jpg}\n");
-    fprintf(f, "\\caption{Carl Hierholzer (1840-1871)}\n");
-    fprintf(f, "\\end{figure}\n\n");
-    
-    fprintf(f, "Carl Hierholzer (1840-1871) fue un matemático alemán conocido principalmente por su ");
-    fprintf(f, "contribución a la teoría de grafos, específicamente por el desarrollo del algoritmo ");
-    fprintf(f, "que lleva su nombre para encontrar ciclos eulerianos en grafos.\n\n");
-    
-    fprintf(f, "Hierholzer nació en Karlsruhe, Alemania, y estudió matemáticas en la Universidad de ");
-    fprintf(f, "Heidelberg. Aunque su carrera fue relativamente corta debido a su temprana muerte a ");
-    fprintf(f, "los 31 años, dejó una contribución significativa a las matemáticas.\n\n");
-    
-    fprintf(f, "En 1873, dos años después de su muerte, se publicó su trabajo más importante: ");
-    fprintf(f, "\\textit{Über die Möglichkeit, einen Linienzug ohne Wiederholung und ohne ");
-    fprintf(f, "Unterbrechung zu umfahren} (Sobre la posibilidad de recorrer un trazo de líneas sin ");
-    fprintf(f, "repetición y sin interrupción). En este trabajo, Hierholzer presentó un algoritmo ");
-    fprintf(f, "eficiente para encontrar ciclos eulerianos en grafos, resolviendo de manera práctica ");
-    fprintf(f, "el problema que Euler había caracterizado teóricamente más de un siglo antes.\n\n");
-    
-    fprintf(f, "El \\textbf{algoritmo de Hierholzer} es notable por su elegancia y eficiencia. A ");
-    fprintf(f, "diferencia de otros métodos, este algoritmo tiene complejidad temporal $O(m)$, donde ");
-    fprintf(f, "$m$ es el número de aristas, lo que lo hace óptimo para este problema. El algoritmo ");
-    fprintf(f, "funciona construyendo ciclos parciales y luego empalmándolos para formar el ciclo ");
-    fprintf(f, "euleriano completo.\n\n");
-    
-    fprintf(f, "Aunque Hierholzer murió antes de ver su trabajo publicado, su algoritmo se convirtió ");
-    fprintf(f, "en uno de los métodos estándar para resolver problemas eulerianos y sigue siendo ");
-    fprintf(f, "ampliamente utilizado en la actualidad en aplicaciones de optimización de rutas, ");
-    fprintf(f, "diseño de circuitos y análisis de redes.\n\n");
+    buffer_agregar(b, "\\section{Carl Hierholzer}\n\n");
+    buffer_agregar(b, "\\begin{figure}[h]\n");
+    buffer_agregar(b, "\\centering\n");
+    buffer_agregar(b, "\\includegraphicsoptional[width=0.3\\textwidth]{hierholzer.jpg}\n");
+    buffer_agregar(b, "\\caption{Carl Hierholzer (1840-1871)}\n");
+    buffer_agregar(b, "\\end{figure}\n\n");
+    
+    buffer_agregar(b, "Carl Hierholzer (1840-1871) fue un matemático alemán conocido principalmente por su ");
+    buffer_agregar(b, "contribución a la teoría de grafos, específicamente por el desarrollo del algoritmo ");
+    buffer_agregar(b, "que lleva su nombre para encontrar ciclos eulerianos en grafos.\n\n");
+    
+    buffer_agregar(b, "Hierholzer nació en Karlsruhe, Alemania, y estudió matemáticas en la Universidad de ");
+    buffer_agregar(b, "Heidelberg. Aunque su carrera fue relativamente corta debido a su temprana muerte a ");
+    buffer_agregar(b, "los 31 años, dejó una contribución significativa a las matemáticas.\n\n");
+    
+    buffer_agregar(b, "En 1873, dos años después de su muerte, se publicó su trabajo más importante: ");
+    buffer_agregar(b, "\\textit{Über die Möglichkeit, einen Linienzug ohne Wiederholung und ohne ");
+    buffer_agregar(b, "Unterbrechung zu umfahren} (Sobre la posibilidad de recorrer un trazo de líneas sin ");
+    buffer_agregar(b, "repetición y sin interrupción). En este trabajo, Hierholzer presentó un algoritmo ");
+    buffer_agregar(b, "eficiente para encontrar ciclos eulerianos en grafos, resolviendo de manera práctica ");
+    buffer_agregar(b, "el problema que Euler había caracterizado teóricamente más de un siglo antes.\n\n");
+    
+    buffer_agregar(b, "El \\textbf{algoritmo de Hierholzer} es notable por su elegancia y eficiencia. A ");
+    buffer_agregar(b, "diferencia de otros métodos, este algoritmo tiene complejidad temporal $O(m)$, donde ");
+    buffer_agregar(b, "$m$ es el número de aristas, lo que lo hace óptimo para este problema. El algoritmo ");
+    buffer_agregar(b, "funciona construyendo ciclos parciales y luego empalmándolos para formar el ciclo ");
+    buffer_agregar(b, "euleriano completo.\n\n");
+    
+    buffer_agregar(b, "Aunque Hierholzer murió antes de ver su trabajo publicado, su algoritmo se convirtió ");
+    buffer_agregar(b, "en uno de los métodos estándar para resolver problemas eulerianos y sigue siendo ");
+    buffer_agregar(b, "ampliamente utilizado en la actualidad en aplicaciones de optimización de rutas, ");
+    buffer_agregar(b, "diseño de circuitos y análisis de redes.\n\n");
     
     // Sección: Ciclo Euleriano con Hierholzer
-    if (euler) {
-        fprintf(f, "\\section{Ciclo Euleriano con Hierholzer}\n\n");
-        
-        int secuencia_hierholzer[MAX_NODOS * MAX_NODOS];
-        int len_hierholzer = encontrar_ciclo_euleriano_hierholzer(secuencia_hierholzer);
-        
-        if (len_hierholzer > 0) {
-            fprintf(f, "Se ha ejecutado el algoritmo de Hierholzer para encontrar un ciclo euleriano ");
-            fprintf(f, "en el grafo. El algoritmo funciona de la siguiente manera:\n\n");
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item Comienza en un vértice arbitrario con aristas incidentes\n");
-            fprintf(f, "\\item Construye un ciclo aleatorio hasta que no se puedan agregar más aristas\n");
-            fprintf(f, "\\item Si quedan aristas sin visitar, encuentra un vértice en el ciclo actual ");
-            fprintf(f, "que tenga aristas sin visitar y construye un nuevo ciclo desde ese vértice\n");
-            fprintf(f, "\\item Empalma el nuevo ciclo con el ciclo principal\n");
-            fprintf(f, "\\item Repite hasta que todas las aristas hayan sido visitadas\n");
-            fprintf(f, "\\end{enumerate}\n\n");
+    if (a->euler) {
+        buffer_agregar(b, "\\section{Ciclo Euleriano con Hierholzer}\n\n");
+        
+        if (a->len_hierholzer > 0) {
+            buffer_agregar(b, "Se ha ejecutado el algoritmo de Hierholzer para encontrar un ciclo euleriano ");
+            buffer_agregar(b, "en el grafo. El algoritmo funciona de la siguiente manera:\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item Comienza en un vértice arbitrario con aristas incidentes\n");
+            buffer_agregar(b, "\\item Construye un ciclo aleatorio hasta que no se puedan agregar más aristas\n");
+            buffer_agregar(b, "\\item Si quedan aristas sin visitar, encuentra un vértice en el ciclo actual ");
+            buffer_agregar(b, "que tenga aristas sin visitar y construye un nuevo ciclo desde ese vértice\n");
+            buffer_agregar(b, "\\item Empalma el nuevo ciclo con el ciclo principal\n");
+            buffer_agregar(b, "\\item Repite hasta que todas las aristas hayan sido visitadas\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
             
-            fprintf(f, "\\textbf{Ciclo Euleriano encontrado:}\n\n");
-            fprintf(f, "A continuación se presenta la secuencia de vértices que forma el ciclo euleriano ");
-            fprintf(f, "(los vértices pueden aparecer múltiples veces, ya que se recorren todas las ");
-            fprintf(f, "aristas):\n\n");
-            fprintf(f, "\\begin{center}\n");
-            fprintf(f, "\\Large\n");
-            for (int i = 0; i < len_hierholzer; i++) {
-                fprintf(f, "%d", secuencia_hierholzer[i]);
-                if (i < len_hierholzer - 1) {
-                    fprintf(f, " $\\rightarrow$ ");
-                }
-            }
-            fprintf(f, "\n");
-            fprintf(f, "\\end{center}\n\n");
-            fprintf(f, "\\normalsize\n");
-            fprintf(f, "Este ciclo recorre cada arista del grafo exactamente una vez y regresa al ");
-            fprintf(f, "vértice inicial.\n\n");
+            buffer_agregar(b, "\\textbf{Ciclo Euleriano encontrado:}\n\n");
+            buffer_agregar(b, "A continuación se presenta la secuencia de vértices que forma el ciclo euleriano ");
+            buffer_agregar(b, "(los vértices pueden aparecer múltiples veces, ya que se recorren todas las ");
+            buffer_agregar(b, "aristas):\n\n");
+            generar_secuencia_latex(b, a->secuencia_hierholzer, a->len_hierholzer);
+            buffer_agregar(b, "Este ciclo recorre cada arista del grafo exactamente una vez y regresa al ");
+            buffer_agregar(b, "vértice inicial.\n\n");
             
             // Trabajo extra opcional 1: Paso a paso Hierholzer
-            fprintf(f, "\\subsection{Trabajo Extra Opcional: Ejecución Paso a Paso del Algoritmo de Hierholzer}\n\n");
-            fprintf(f, "A continuación se presenta una visualización detallada de cómo el algoritmo ");
-            fprintf(f, "de Hierholzer encuentra el ciclo euleriano. El algoritmo construye ciclos ");
-            fprintf(f, "parciales y los empalma para formar la solución completa.\n\n");
+            buffer_agregar(b, "\\subsection{Trabajo Extra Opcional: Ejecución Paso a Paso del Algoritmo de Hierholzer}\n\n");
+            buffer_agregar(b, "A continuación se presenta una visualización detallada de cómo el algoritmo ");
+            buffer_agregar(b, "de Hierholzer encuentra el ciclo euleriano. El algoritmo construye ciclos ");
+            buffer_agregar(b, "parciales y los empalma para formar la solución completa.\n\n");
             
-            fprintf(f, "\\textbf{Descripción del Algoritmo:}\n\n");
-            fprintf(f, "El algoritmo de Hierholzer funciona de la siguiente manera:\n\n");
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item Se inicia desde un vértice arbitrario con aristas incidentes\n");
-            fprintf(f, "\\item Se construye un ciclo aleatorio recorriendo aristas no visitadas hasta ");
-            fprintf(f, "que no se puedan agregar más aristas (se regresa al vértice inicial del ciclo)\n");
-            fprintf(f, "\\item Si quedan aristas sin visitar, se encuentra un vértice en el ciclo actual ");
-            fprintf(f, "que tenga aristas sin visitar y se construye un nuevo ciclo desde ese vértice\n");
-            fprintf(f, "\\item Se empalma el nuevo ciclo con el ciclo principal insertándolo en el punto ");
-            fprintf(f, "donde se encontró el vértice con aristas pendientes\n");
-            fprintf(f, "\\item Se repite el proceso hasta que todas las aristas hayan sido visitadas\n");
-            fprintf(f, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "\\textbf{Descripción del Algoritmo:}\n\n");
+            buffer_agregar(b, "El algoritmo de Hierholzer funciona de la siguiente manera:\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item Se inicia desde un vértice arbitrario con aristas incidentes\n");
+            buffer_agregar(b, "\\item Se construye un ciclo aleatorio recorriendo aristas no visitadas hasta ");
+            buffer_agregar(b, "que no se puedan agregar más aristas (se regresa al vértice inicial del ciclo)\n");
+            buffer_agregar(b, "\\item Si quedan aristas sin visitar, se encuentra un vértice en el ciclo actual ");
+            buffer_agregar(b, "que tenga aristas sin visitar y se construye un nuevo ciclo desde ese vértice\n");
+            buffer_agregar(b, "\\item Se empalma el nuevo ciclo con el ciclo principal insertándolo en el punto ");
+            buffer_agregar(b, "donde se encontró el vértice con aristas pendientes\n");
+            buffer_agregar(b, "\\item Se repite el proceso hasta que todas las aristas hayan sido visitadas\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
             
-            fprintf(f, "\\textbf{Ejecución Paso a Paso:}\n\n");
-            fprintf(f, "A continuación se muestra la ejecución detallada del algoritmo. En cada paso se ");
-            fprintf(f, "muestra el estado del grafo, donde:\n\n");
-            fprintf(f, "\\begin{itemize}\n");
-            fprintf(f, "\\item Las aristas en \\textcolor{gray}{gris punteado} son aristas que aún no se han recorrido\n");
-            fprintf(f, "\\item Las aristas en \\textcolor{red}{rojo grueso} forman el ciclo parcial que se está construyendo actualmente\n");
-            fprintf(f, "\\item Las aristas en otros colores (azul, verde, naranja, etc.) son ciclos parciales que ya se completaron\n");
-            fprintf(f, "\\end{itemize}\n\n");
+            buffer_agregar(b, "\\textbf{Ejecución Paso a Paso:}\n\n");
+            buffer_agregar(b, "A continuación se muestra la ejecución detallada del algoritmo. En cada paso se ");
+            buffer_agregar(b, "muestra el estado del grafo, donde:\n\n");
+            buffer_agregar(b, "\\begin{itemize}\n");
+            buffer_agregar(b, "\\item Las aristas en \\textcolor{gray}{gris punteado} son aristas que aún no se han recorrido\n");
+            buffer_agregar(b, "\\item Las aristas en \\textcolor{red}{rojo grueso} forman el ciclo parcial que se está construyendo actualmente\n");
+            buffer_agregar(b, "\\item Las aristas en otros colores (azul, verde, naranja, etc.) son ciclos parciales que ya se completaron\n");
+            buffer_agregar(b, "\\end{itemize}\n\n");
             
-            // Ejecutar algoritmo paso a paso
-            PasoHierholzer pasos[MAX_PASOS];
-            int num_pasos = 0;
-            int secuencia_paso_a_paso[MAX_NODOS * MAX_NODOS];
-            int len_paso_a_paso = encontrar_ciclo_euleriano_hierholzer_paso_a_paso(secuencia_paso_a_paso, pasos, &num_pasos);
-            
-            // Calcular escala para los diagramas (usar los mismos valores que el grafo original)
-            int min_x = grafo_actual.posiciones[0].x;
-            int max_x = grafo_actual.posiciones[0].x;
-            int min_y = grafo_actual.posiciones[0].y;
-            int max_y = grafo_actual.posiciones[0].y;
-            for (int i = 1; i < K; i++) {
-                if (grafo_actual.posiciones[i].x < min_x) min_x = grafo_actual.posiciones[i].x;
-                if (grafo_actual.posiciones[i].x > max_x) max_x = grafo_actual.posiciones[i].x;
-                if (grafo_actual.posiciones[i].y < min_y) min_y = grafo_actual.posiciones[i].y;
-                if (grafo_actual.posiciones[i].y > max_y) max_y = grafo_actual.posiciones[i].y;
-            }
-            double ancho = (max_x - min_x > 0) ? (max_x - min_x) : 1.0;
-            double alto = (max_y - min_y > 0) ? (max_y - min_y) : 1.0;
-            double escala = 12.0 / (ancho > alto ? ancho : alto);
             
             // Generar diagramas para cada paso
-            for (int p = 0; p < num_pasos && p < 20; p++) {  // Limitar a 20 pasos para no hacer el PDF muy largo
-                fprintf(f, "\\subsubsection{Paso %d}\n\n", p + 1);
-                fprintf(f, "%s\n\n", pasos[p].descripcion);
-                generar_tikz_paso_hierholzer(f, &pasos[p], p + 1, min_x, min_y, escala);
+            for (int p = 0; p < a->num_pasos_hierholzer && p < 20; p++) {  // Limitar a 20 pasos para no hacer el PDF muy largo
+                buffer_agregar(b, "\\subsubsection{Paso ");
+                buffer_agregar_entero(b, p + 1);
+                buffer_agregar(b, "}\n\n");
+                buffer_agregar(b, a->pasos_hierholzer[p].descripcion);
+                buffer_agregar(b, "\n\n");
+                generar_tikz_paso_hierholzer(b, &a->pasos_hierholzer[p], p + 1);
             }
             
-            if (num_pasos > 20) {
-                fprintf(f, "\\textit{Nota: Se muestran los primeros 20 pasos de un total de %d pasos.}\n\n", num_pasos);
+            if (a->num_pasos_hierholzer > 20) {
+                buffer_agregar(b, "\\textit{Nota: Se muestran los primeros 20 pasos de un total de ");
+                buffer_agregar_entero(b, a->num_pasos_hierholzer);
+                buffer_agregar(b, " pasos.}\n\n");
             }
             
-            fprintf(f, "\\textbf{Ciclo Euleriano Final:}\n\n");
-            fprintf(f, "El algoritmo encontró el siguiente ciclo euleriano completo:\n\n");
-            fprintf(f, "\\begin{center}\n");
-            fprintf(f, "\\Large\n");
-            for (int i = 0; i < len_paso_a_paso; i++) {
-                fprintf(f, "%d", secuencia_paso_a_paso[i]);
-                if (i < len_paso_a_paso - 1) {
-                    fprintf(f, " $\\rightarrow$ ");
-                }
-            }
-            fprintf(f, "\n");
-            fprintf(f, "\\end{center}\n\n");
-            fprintf(f, "\\normalsize\n");
+            buffer_agregar(b, "\\textbf{Ciclo Euleriano Final:}\n\n");
+            buffer_agregar(b, "El algoritmo encontró el siguiente ciclo euleriano completo:\n\n");
+            generar_secuencia_latex(b, a->secuencia_hierholzer_pasos, a->len_hierholzer_pasos);
             
-            fprintf(f, "\\textbf{Análisis de la Ejecución:}\n\n");
-            fprintf(f, "El ciclo encontrado tiene $%d$ vértices (algunos pueden repetirse ya que se recorren ", len_paso_a_paso);
-            fprintf(f, "todas las aristas). El algoritmo garantiza que cada arista se recorra exactamente ");
-            fprintf(f, "una vez y que se regrese al vértice inicial, formando así un ciclo euleriano completo.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis de la Ejecución:}\n\n");
+            buffer_agregar(b, "El ciclo encontrado tiene $");
+            buffer_agregar_entero(b, a->len_hierholzer_pasos);
+            buffer_agregar(b, "$ vértices (algunos pueden repetirse ya que se recorren ");
+            buffer_agregar(b, "todas las aristas). El algoritmo garantiza que cada arista se recorra exactamente ");
+            buffer_agregar(b, "una vez y que se regrese al vértice inicial, formando así un ciclo euleriano completo.\n\n");
             
-            fprintf(f, "\\textbf{Complejidad:} El algoritmo de Hierholzer tiene complejidad temporal $O(m)$, ");
-            fprintf(f, "donde $m$ es el número de aristas, lo que lo hace óptimo para este problema.\n\n");
+            buffer_agregar(b, "\\textbf{Complejidad:} El algoritmo de Hierholzer tiene complejidad temporal $O(m)$, ");
+            buffer_agregar(b, "donde $m$ es el número de aristas, lo que lo hace óptimo para este problema.\n\n");
+        }
+    } else if (a->semi_euler && a->len_hierholzer_ruta > 0) {
+        buffer_agregar(b, "\\section{Ruta Euleriana con Hierholzer}\n\n");
+        buffer_agregar(b, "El grafo no tiene ciclo euleriano, pero sí una ruta euleriana. El algoritmo de ");
+        buffer_agregar(b, "Hierholzer la encuentra sin cambios: basta con comenzar en ");
+        if (grafo_actual.tipo == NO_DIRIGIDO) {
+            buffer_agregar(b, "uno de los dos vértices de grado impar. ");
+        } else {
+            buffer_agregar(b, "el vértice que tiene una arista saliente más que entrantes. ");
         }
+        buffer_agregar(b, "Al construir el recorrido desde ahí, el único vértice donde puede quedar ");
+        buffer_agregar(b, "atascado es el otro extremo, y los ciclos parciales que se empalman después ");
+        buffer_agregar(b, "completan las aristas restantes.\n\n");
+        
+        buffer_agregar(b, "\\textbf{Ruta Euleriana encontrada:}\n\n");
+        generar_secuencia_latex(b, a->secuencia_hierholzer_ruta, a->len_hierholzer_ruta);
+        buffer_agregar(b, "La ruta recorre cada arista exactamente una vez, desde el vértice $");
+        buffer_agregar_entero(b, a->secuencia_hierholzer_ruta[0]);
+        buffer_agregar(b, "$ hasta el vértice $");
+        buffer_agregar_entero(b, a->secuencia_hierholzer_ruta[a->len_hierholzer_ruta - 1]);
+        buffer_agregar(b, "$.\n\n");
+        
+        buffer_agregar(b, "\\textbf{Complejidad:} Igual que para el ciclo, $O(m)$ en el número de aristas, ");
+        buffer_agregar(b, "frente a $O(m^2)$ del algoritmo de Fleury, cuya ejecución paso a paso se ");
+        buffer_agregar(b, "muestra más adelante con fines didácticos.\n\n");
     }
+}
+
+// Biografía de Fleury
+static void seccion_fleury(BufferTexto *b, const AnalisisReporte *a) {
+    (void)a;
     
     // Sección: Pierre-Henry Fleury
-    fprintf(f, "\\section{Pierre-Henry Fleury}\n\n");
-    fprintf(f, "\\begin{figure}[h]\n");
-    fprintf(f, "\\centering\n");
-    fprintf(f, "\\includegraphicsoptional[width=0.3\\textwidth]{fleury.jpg}\n");
-    fprintf(f, "\\caption{Pierre-Henry Fleury (siglo XIX)}\n");
-    fprintf(f, "\\end{figure}\n\n");
-    
-    fprintf(f, "Pierre-Henry Fleury fue un matemático francés del siglo XIX conocido por su ");
-    fprintf(f, "contribución al desarrollo del algoritmo que lleva su nombre para encontrar ciclos ");
-    fprintf(f, "y caminos eulerianos en grafos.\n\n");
-    
-    fprintf(f, "Aunque se conoce menos sobre la vida personal de Fleury en comparación con otros ");
-    fprintf(f, "matemáticos de la época, su trabajo en teoría de grafos ha tenido un impacto ");
-    fprintf(f, "significativo. El algoritmo de Fleury fue desarrollado como una alternativa al ");
-    fprintf(f, "algoritmo de Hierholzer, ofreciendo un enfoque diferente para resolver el mismo ");
-    fprintf(f, "problema.\n\n");
-    
-    fprintf(f, "El \\textbf{algoritmo de Fleury} se caracteriza por su enfoque de eliminación de ");
-    fprintf(f, "aristas. A diferencia de Hierholzer, que construye ciclos y los empalma, Fleury ");
-    fprintf(f, "trabaja eliminando aristas del grafo mientras construye el ciclo o camino euleriano. ");
-    fprintf(f, "La clave del algoritmo está en la regla de selección de aristas: siempre que sea ");
-    fprintf(f, "posible, se debe evitar elegir una arista que sea un \\textit{puente} (una arista ");
-    fprintf(f, "cuya eliminación desconecte el grafo), a menos que no haya otra opción.\n\n");
-    
-    fprintf(f, "El algoritmo de Fleury tiene complejidad temporal $O(m^2)$ en el peor caso, donde ");
-    fprintf(f, "$m$ es el número de aristas, debido a la necesidad de verificar si una arista es un ");
-    fprintf(f, "puente en cada paso. Aunque es menos eficiente que el algoritmo de Hierholzer, ");
-    fprintf(f, "ofrece una perspectiva diferente y es útil para entender la estructura de los grafos ");
-    fprintf(f, "eulerianos.\n\n");
-    
-    fprintf(f, "El trabajo de Fleury, junto con el de Hierholzer, proporcionó herramientas prácticas ");
-    fprintf(f, "para resolver problemas que Euler había caracterizado teóricamente, permitiendo la ");
-    fprintf(f, "aplicación de estos conceptos en problemas reales de optimización de rutas y diseño ");
-    fprintf(f, "de redes.\n\n");
-    
+    buffer_agregar(b, "\\section{Pierre-Henry Fleury}\n\n");
+    buffer_agregar(b, "\\begin{figure}[h]\n");
+    buffer_agregar(b, "\\centering\n");
+    buffer_agregar(b, "\\includegraphicsoptional[width=0.3\\textwidth]{fleury.jpg}\n");
+    buffer_agregar(b, "\\caption{Pierre-Henry Fleury (siglo XIX)}\n");
+    buffer_agregar(b, "\\end{figure}\n\n");
+    
+    buffer_agregar(b, "Pierre-Henry Fleury fue un matemático francés del siglo XIX conocido por su ");
+    buffer_agregar(b, "contribución al desarrollo del algoritmo que lleva su nombre para encontrar ciclos ");
+    buffer_agregar(b, "y caminos eulerianos en grafos.\n\n");
+    
+    buffer_agregar(b, "Aunque se conoce menos sobre la vida personal de Fleury en comparación con otros ");
+    buffer_agregar(b, "matemáticos de la época, su trabajo en teoría de grafos ha tenido un impacto ");
+    buffer_agregar(b, "significativo. El algoritmo de Fleury fue desarrollado como una alternativa al ");
+    buffer_agregar(b, "algoritmo de Hierholzer, ofreciendo un enfoque diferente para resolver el mismo ");
+    buffer_agregar(b, "problema.\n\n");
+    
+    buffer_agregar(b, "El \\textbf{algoritmo de Fleury} se caracteriza por su enfoque de eliminación de ");
+    buffer_agregar(b, "aristas. A diferencia de Hierholzer, que construye ciclos y los empalma, Fleury ");
+    buffer_agregar(b, "trabaja eliminando aristas del grafo mientras construye el ciclo o camino euleriano. ");
+    buffer_agregar(b, "La clave del algoritmo está en la regla de selección de aristas: siempre que sea ");
+    buffer_agregar(b, "posible, se debe evitar elegir una arista que sea un \\textit{puente} (una arista ");
+    buffer_agregar(b, "cuya eliminación desconecte el grafo), a menos que no haya otra opción.\n\n");
+    
+    buffer_agregar(b, "El algoritmo de Fleury tiene complejidad temporal $O(m^2)$ en el peor caso, donde ");
+    buffer_agregar(b, "$m$ es el número de aristas, debido a la necesidad de verificar si una arista es un ");
+    buffer_agregar(b, "puente en cada paso. Aunque es menos eficiente que el algoritmo de Hierholzer, ");
+    buffer_agregar(b, "ofrece una perspectiva diferente y es útil para entender la estructura de los grafos ");
+    buffer_agregar(b, "eulerianos.\n\n");
+    
+    buffer_agregar(b, "El trabajo de Fleury, junto con el de Hierholzer, proporcionó herramientas prácticas ");
+    buffer_agregar(b, "para resolver problemas que Euler había caracterizado teóricamente, permitiendo la ");
+    buffer_agregar(b, "aplicación de estos conceptos en problemas reales de optimización de rutas y diseño ");
+    buffer_agregar(b, "de redes.\n\n");
+}
+
+// Ejecución paso a paso de Fleury para ciclos eulerianos
+static void seccion_fleury_ciclo(BufferTexto *b, const AnalisisReporte *a) {
     // Sección: Trabajos Extra Opcionales de Fleury
     // Siempre mostrar ambas secciones, indicando si no aplican
     
     // Trabajo extra opcional 2: Paso a paso Fleury para CICLOS EULERIANOS
-    fprintf(f, "\\section{Trabajo Extra Opcional: Ejecución Paso a Paso del Algoritmo de Fleury para Ciclos Eulerianos}\n\n");
-    
-    if (euler) {
-        fprintf(f, "Este grafo es euleriano, por lo que contiene un ciclo euleriano. A continuación se ");
-        fprintf(f, "presenta una visualización detallada de cómo el algoritmo de Fleury encuentra el ");
-        fprintf(f, "ciclo euleriano eliminando aristas del grafo.\n\n");
-        
-        fprintf(f, "\\textbf{Descripción del Algoritmo:}\n\n");
-        fprintf(f, "El algoritmo de Fleury funciona de la siguiente manera:\n\n");
-        fprintf(f, "\\begin{enumerate}\n");
-        fprintf(f, "\\item Se comienza en un vértice arbitrario del grafo\n");
-        fprintf(f, "\\item En cada paso, se selecciona una arista incidente al vértice actual\n");
-        fprintf(f, "\\item Se verifica si la arista es un \\textit{puente} (una arista cuya eliminación ");
-        fprintf(f, "desconectaría el grafo). Si es posible, se evita seleccionar puentes, a menos que ");
-        fprintf(f, "sea la única opción disponible\n");
-        fprintf(f, "\\item Se elimina la arista seleccionada del grafo\n");
-        fprintf(f, "\\item Se mueve al vértice conectado por esa arista\n");
-        fprintf(f, "\\item Se repite el proceso hasta que todas las aristas hayan sido eliminadas\n");
-        fprintf(f, "\\end{enumerate}\n\n");
-        
-        fprintf(f, "\\textbf{Ejecución Paso a Paso:}\n\n");
-        fprintf(f, "A continuación se muestra la ejecución detallada del algoritmo. En cada paso se ");
-        fprintf(f, "muestra el estado del grafo, donde:\n\n");
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item Las aristas en \\textcolor{gray}{gris punteado} son aristas que aún no se han eliminado\n");
-        fprintf(f, "\\item Las aristas en \\textcolor{blue}{azul grueso} forman la ruta construida hasta el momento\n");
-        fprintf(f, "\\item La arista en \\textcolor{green!70!black}{verde grueso} es la arista elegida en este paso (no es puente)\n");
-        fprintf(f, "\\item La arista en \\textcolor{red}{rojo grueso} es la arista elegida en este paso (es un puente, pero es la única opción)\n");
-        fprintf(f, "\\item El vértice en \\textcolor{yellow!50}{amarillo} es el vértice actual\n");
-        fprintf(f, "\\end{itemize}\n\n");
-        
-        // Ejecutar algoritmo paso a paso
-        PasoFleury pasos_fleury[MAX_PASOS];
-        int num_pasos_fleury = 0;
-        int secuencia_fleury_paso_a_paso[MAX_NODOS * MAX_NODOS];
-        __attribute__((maybe_unused)) int len_fleury_paso_a_paso = encontrar_ciclo_euleriano_fleury_paso_a_paso(secuencia_fleury_paso_a_paso, pasos_fleury, &num_pasos_fleury);
-        
-        if (len_fleury_paso_a_paso > 0 && num_pasos_fleury > 0) {
-            // Calcular escala para los diagramas
-            int min_x = grafo_actual.posiciones[0].x;
-            int max_x = grafo_actual.posiciones[0].x;
-            int min_y = grafo_actual.posiciones[0].y;
-            int max_y = grafo_actual.posiciones[0].y;
-            for (int i = 1; i < K; i++) {
-                if (grafo_actual.posiciones[i].x < min_x) min_x = grafo_actual.posiciones[i].x;
-                if (grafo_actual.posiciones[i].x > max_x) max_x = grafo_actual.posiciones[i].x;
-                if (grafo_actual.posiciones[i].y < min_y) min_y = grafo_actual.posiciones[i].y;
-                if (grafo_actual.posiciones[i].y > max_y) max_y = grafo_actual.posiciones[i].y;
-            }
-            double ancho = (max_x - min_x > 0) ? (max_x - min_x) : 1.0;
-            double alto = (max_y - min_y > 0) ? (max_y - min_y) : 1.0;
-            double escala = 12.0 / (ancho > alto ? ancho : alto);
-            
+    buffer_agregar(b, "\\section{Trabajo Extra Opcional: Ejecución Paso a Paso del Algoritmo de Fleury para Ciclos Eulerianos}\n\n");
+    
+    if (a->euler) {
+        buffer_agregar(b, "Este grafo es euleriano, por lo que contiene un ciclo euleriano. A continuación se ");
+        buffer_agregar(b, "presenta una visualización detallada de cómo el algoritmo de Fleury encuentra el ");
+        buffer_agregar(b, "ciclo euleriano eliminando aristas del grafo.\n\n");
+        
+        buffer_agregar(b, "\\textbf{Descripción del Algoritmo:}\n\n");
+        buffer_agregar(b, "El algoritmo de Fleury funciona de la siguiente manera:\n\n");
+        buffer_agregar(b, "\\begin{enumerate}\n");
+        buffer_agregar(b, "\\item Se comienza en un vértice arbitrario del grafo\n");
+        buffer_agregar(b, "\\item En cada paso, se selecciona una arista incidente al vértice actual\n");
+        buffer_agregar(b, "\\item Se verifica si la arista es un \\textit{puente} (una arista cuya eliminación ");
+        buffer_agregar(b, "desconectaría el grafo). Si es posible, se evita seleccionar puentes, a menos que ");
+        buffer_agregar(b, "sea la única opción disponible\n");
+        buffer_agregar(b, "\\item Se elimina la arista seleccionada del grafo\n");
+        buffer_agregar(b, "\\item Se mueve al vértice conectado por esa arista\n");
+        buffer_agregar(b, "\\item Se repite el proceso hasta que todas las aristas hayan sido eliminadas\n");
+        buffer_agregar(b, "\\end{enumerate}\n\n");
+        
+        buffer_agregar(b, "\\textbf{Ejecución Paso a Paso:}\n\n");
+        buffer_agregar(b, "A continuación se muestra la ejecución detallada del algoritmo. En cada paso se ");
+        buffer_agregar(b, "muestra el estado del grafo, donde:\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item Las aristas en \\textcolor{gray}{gris punteado} son aristas que aún no se han eliminado\n");
+        buffer_agregar(b, "\\item Las aristas en \\textcolor{blue}{azul grueso} forman la ruta construida hasta el momento\n");
+        buffer_agregar(b, "\\item La arista en \\textcolor{green!70!black}{verde grueso} es la arista elegida en este paso (no es puente)\n");
+        buffer_agregar(b, "\\item La arista en \\textcolor{red}{rojo grueso} es la arista elegida en este paso (es un puente, pero es la única opción)\n");
+        buffer_agregar(b, "\\item El vértice en \\textcolor{yellow!50}{amarillo} es el vértice actual\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
+        
+        
+        if (a->len_fleury_ciclo > 0 && a->num_pasos_fleury_ciclo > 0) {
             // Generar diagramas para cada paso
-            for (int p = 0; p < num_pasos_fleury && p < 20; p++) {  // Limitar a 20 pasos
-                fprintf(f, "\\subsubsection{Paso %d}\n\n", p + 1);
-                fprintf(f, "%s\n\n", pasos_fleury[p].descripcion);
-                generar_tikz_paso_fleury(f, &pasos_fleury[p], p + 1, min_x, min_y, escala);
+            for (int p = 0; p < a->num_pasos_fleury_ciclo && p < 20; p++) {  // Limitar a 20 pasos
+                buffer_agregar(b, "\\subsubsection{Paso ");
+                buffer_agregar_entero(b, p + 1);
+                buffer_agregar(b, "}\n\n");
+                buffer_agregar(b, a->pasos_fleury_ciclo[p].descripcion);
+                buffer_agregar(b, "\n\n");
+                generar_tikz_paso_fleury(b, &a->pasos_fleury_ciclo[p], p + 1);
             }
             
-            if (num_pasos_fleury > 20) {
-                fprintf(f, "\\textit{Nota: Se muestran los primeros 20 pasos de un total de %d pasos.}\n\n", num_pasos_fleury);
+            if (a->num_pasos_fleury_ciclo > 20) {
+                buffer_agregar(b, "\\textit{Nota: Se muestran los primeros 20 pasos de un total de ");
+                buffer_agregar_entero(b, a->num_pasos_fleury_ciclo);
+                buffer_agregar(b, " pasos.}\n\n");
             }
             
-            fprintf(f, "\\textbf{Ciclo Euleriano Final:}\n\n");
-            fprintf(f, "El algoritmo encontró el siguiente ciclo euleriano completo:\n\n");
-            fprintf(f, "\\begin{center}\n");
-            fprintf(f, "\\Large\n");
-            for (int i = 0; i < len_fleury_paso_a_paso; i++) {
-                fprintf(f, "%d", secuencia_fleury_paso_a_paso[i]);
-                if (i < len_fleury_paso_a_paso - 1) {
-                    fprintf(f, " $\\rightarrow$ ");
-                }
-            }
-            fprintf(f, "\n");
-            fprintf(f, "\\end{center}\n\n");
-            fprintf(f, "\\normalsize\n");
+            buffer_agregar(b, "\\textbf{Ciclo Euleriano Final:}\n\n");
+            buffer_agregar(b, "El algoritmo encontró el siguiente ciclo euleriano completo:\n\n");
+            generar_secuencia_latex(b, a->secuencia_fleury_ciclo, a->len_fleury_ciclo);
             
-            fprintf(f, "\\textbf{Análisis de la Ejecución:}\n\n");
-            fprintf(f, "El ciclo encontrado tiene $%d$ vértices. En cada paso, el algoritmo seleccionó ", len_fleury_paso_a_paso);
-            fprintf(f, "una arista evitando puentes cuando era posible, garantizando que siempre quede un ");
-            fprintf(f, "camino para regresar al vértice inicial. Al final, todas las aristas fueron ");
-            fprintf(f, "eliminadas y se formó un ciclo euleriano completo.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis de la Ejecución:}\n\n");
+            buffer_agregar(b, "El ciclo encontrado tiene $");
+            buffer_agregar_entero(b, a->len_fleury_ciclo);
+            buffer_agregar(b, "$ vértices. En cada paso, el algoritmo seleccionó ");
+            buffer_agregar(b, "una arista evitando puentes cuando era posible, garantizando que siempre quede un ");
+            buffer_agregar(b, "camino para regresar al vértice inicial. Al final, todas las aristas fueron ");
+            buffer_agregar(b, "eliminadas y se formó un ciclo euleriano completo.\n\n");
         }
         
-        fprintf(f, "\\textbf{Complejidad:} El algoritmo de Fleury tiene complejidad temporal $O(m^2)$ ");
-        fprintf(f, "en el peor caso, donde $m$ es el número de aristas, debido a la necesidad de ");
-        fprintf(f, "verificar si una arista es un puente en cada paso.\n\n");
+        buffer_agregar(b, "\\textbf{Complejidad:} El algoritmo de Fleury tiene complejidad temporal $O(m^2)$ ");
+        buffer_agregar(b, "en el peor caso, donde $m$ es el número de aristas, debido a la necesidad de ");
+        buffer_agregar(b, "verificar si una arista es un puente en cada paso.\n\n");
     } else {
-        fprintf(f, "\\textbf{Este grafo no es euleriano, por lo que no contiene un ciclo euleriano.}\n\n");
-        fprintf(f, "Para que un grafo sea euleriano y contenga un ciclo euleriano, debe cumplir las ");
-        fprintf(f, "siguientes condiciones:\n\n");
+        buffer_agregar(b, "\\textbf{Este grafo no es euleriano, por lo que no contiene un ciclo euleriano.}\n\n");
+        buffer_agregar(b, "Para que un grafo sea euleriano y contenga un ciclo euleriano, debe cumplir las ");
+        buffer_agregar(b, "siguientes condiciones:\n\n");
         if (grafo_actual.tipo == NO_DIRIGIDO) {
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser conexo\n");
-            fprintf(f, "\\item Todos los vértices deben tener grado par\n");
-            fprintf(f, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser conexo\n");
+            buffer_agregar(b, "\\item Todos los vértices deben tener grado par\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
         } else {
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser fuertemente conexo\n");
-            fprintf(f, "\\item Cada vértice debe tener grado de entrada igual al grado de salida\n");
-            fprintf(f, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser fuertemente conexo\n");
+            buffer_agregar(b, "\\item Cada vértice debe tener grado de entrada igual al grado de salida\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
         }
-        fprintf(f, "Como este grafo no cumple estas condiciones, no es posible encontrar un ciclo ");
-        fprintf(f, "euleriano mediante el algoritmo de Fleury. Por lo tanto, no se puede mostrar la ");
-        fprintf(f, "ejecución paso a paso del algoritmo para este caso.\n\n");
+        buffer_agregar(b, "Como este grafo no cumple estas condiciones, no es posible encontrar un ciclo ");
+        buffer_agregar(b, "euleriano mediante el algoritmo de Fleury. Por lo tanto, no se puede mostrar la ");
+        buffer_agregar(b, "ejecución paso a paso del algoritmo para este caso.\n\n");
     }
-    
+}
+
+// Ejecución paso a paso de Fleury para rutas eulerianas
+static void seccion_fleury_ruta(BufferTexto *b, const AnalisisReporte *a) {
     // Trabajo extra opcional 3: Paso a paso Fleury para RUTAS EULERIANAS
-    fprintf(f, "\\section{Trabajo Extra Opcional: Ejecución Paso a Paso del Algoritmo de Fleury para Rutas Eulerianas}\n\n");
-    
-    if (semi_euler) {
-        fprintf(f, "Este grafo es semieuleriano, por lo que contiene una ruta euleriana. A continuación se ");
-        fprintf(f, "presenta una visualización detallada de cómo el algoritmo de Fleury encuentra la ");
-        fprintf(f, "ruta euleriana eliminando aristas del grafo.\n\n");
-        
-        fprintf(f, "\\textbf{Descripción del Algoritmo:}\n\n");
-        fprintf(f, "Para encontrar una ruta euleriana, el algoritmo de Fleury funciona de manera ");
-        fprintf(f, "similar al caso del ciclo, pero con las siguientes diferencias:\n\n");
-        fprintf(f, "\\begin{enumerate}\n");
-        fprintf(f, "\\item Se comienza en un vértice de grado impar (en grafos no dirigidos) o en ");
-        fprintf(f, "un vértice con más aristas salientes que entrantes (en grafos dirigidos)\n");
-        fprintf(f, "\\item En cada paso, se selecciona una arista incidente al vértice actual, ");
-        fprintf(f, "evitando puentes cuando es posible\n");
-        fprintf(f, "\\item Se elimina la arista seleccionada del grafo\n");
-        fprintf(f, "\\item Se mueve al vértice conectado por esa arista\n");
-        fprintf(f, "\\item Se repite hasta que todas las aristas hayan sido eliminadas\n");
-        fprintf(f, "\\item La ruta termina en el otro vértice de grado impar (en no dirigidos) o ");
-        fprintf(f, "en un vértice con más entradas que salidas (en dirigidos)\n");
-        fprintf(f, "\\end{enumerate}\n\n");
-        
-        fprintf(f, "\\textbf{Ejecución Paso a Paso:}\n\n");
-        fprintf(f, "A continuación se muestra la ejecución detallada del algoritmo. En cada paso se ");
-        fprintf(f, "muestra el estado del grafo, donde:\n\n");
-        fprintf(f, "\\begin{itemize}\n");
-        fprintf(f, "\\item Las aristas en \\textcolor{gray}{gris punteado} son aristas que aún no se han eliminado\n");
-        fprintf(f, "\\item Las aristas en \\textcolor{blue}{azul grueso} forman la ruta construida hasta el momento\n");
-        fprintf(f, "\\item La arista en \\textcolor{green!70!black}{verde grueso} es la arista elegida en este paso (no es puente)\n");
-        fprintf(f, "\\item La arista en \\textcolor{red}{rojo grueso} es la arista elegida en este paso (es un puente, pero es la única opción)\n");
-        fprintf(f, "\\item El vértice en \\textcolor{yellow!50}{amarillo} es el vértice actual\n");
-        fprintf(f, "\\end{itemize}\n\n");
-        
-        // Ejecutar algoritmo paso a paso
-        PasoFleury pasos_fleury_ruta[MAX_PASOS];
-        int num_pasos_fleury_ruta = 0;
-        int secuencia_fleury_ruta_paso_a_paso[MAX_NODOS * MAX_NODOS];
-        __attribute__((maybe_unused)) int len_fleury_ruta_paso_a_paso = encontrar_ruta_euleriana_fleury_paso_a_paso(secuencia_fleury_ruta_paso_a_paso, pasos_fleury_ruta, &num_pasos_fleury_ruta);
-        
-        if (len_fleury_ruta_paso_a_paso > 0 && num_pasos_fleury_ruta > 0) {
-            // Calcular escala para los diagramas
-            int min_x = grafo_actual.posiciones[0].x;
-            int max_x = grafo_actual.posiciones[0].x;
-            int min_y = grafo_actual.posiciones[0].y;
-            int max_y = grafo_actual.posiciones[0].y;
-            for (int i = 1; i < K; i++) {
-                if (grafo_actual.posiciones[i].x < min_x) min_x = grafo_actual.posiciones[i].x;
-                if (grafo_actual.posiciones[i].x > max_x) max_x = grafo_actual.posiciones[i].x;
-                if (grafo_actual.posiciones[i].y < min_y) min_y = grafo_actual.posiciones[i].y;
-                if (grafo_actual.posiciones[i].y > max_y) max_y = grafo_actual.posiciones[i].y;
-            }
-            double ancho = (max_x - min_x > 0) ? (max_x - min_x) : 1.0;
-            double alto = (max_y - min_y > 0) ? (max_y - min_y) : 1.0;
-            double escala = 12.0 / (ancho > alto ? ancho : alto);
-            
+    buffer_agregar(b, "\\section{Trabajo Extra Opcional: Ejecución Paso a Paso del Algoritmo de Fleury para Rutas Eulerianas}\n\n");
+    
+    if (a->semi_euler) {
+        buffer_agregar(b, "Este grafo es semieuleriano, por lo que contiene una ruta euleriana. A continuación se ");
+        buffer_agregar(b, "presenta una visualización detallada de cómo el algoritmo de Fleury encuentra la ");
+        buffer_agregar(b, "ruta euleriana eliminando aristas del grafo.\n\n");
+        
+        buffer_agregar(b, "\\textbf{Descripción del Algoritmo:}\n\n");
+        buffer_agregar(b, "Para encontrar una ruta euleriana, el algoritmo de Fleury funciona de manera ");
+        buffer_agregar(b, "similar al caso del ciclo, pero con las siguientes diferencias:\n\n");
+        buffer_agregar(b, "\\begin{enumerate}\n");
+        buffer_agregar(b, "\\item Se comienza en un vértice de grado impar (en grafos no dirigidos) o en ");
+        buffer_agregar(b, "un vértice con más aristas salientes que entrantes (en grafos dirigidos)\n");
+        buffer_agregar(b, "\\item En cada paso, se selecciona una arista incidente al vértice actual, ");
+        buffer_agregar(b, "evitando puentes cuando es posible\n");
+        buffer_agregar(b, "\\item Se elimina la arista seleccionada del grafo\n");
+        buffer_agregar(b, "\\item Se mueve al vértice conectado por esa arista\n");
+        buffer_agregar(b, "\\item Se repite hasta que todas las aristas hayan sido eliminadas\n");
+        buffer_agregar(b, "\\item La ruta termina en el otro vértice de grado impar (en no dirigidos) o ");
+        buffer_agregar(b, "en un vértice con más entradas que salidas (en dirigidos)\n");
+        buffer_agregar(b, "\\end{enumerate}\n\n");
+        
+        buffer_agregar(b, "\\textbf{Ejecución Paso a Paso:}\n\n");
+        buffer_agregar(b, "A continuación se muestra la ejecución detallada del algoritmo. En cada paso se ");
+        buffer_agregar(b, "muestra el estado del grafo, donde:\n\n");
+        buffer_agregar(b, "\\begin{itemize}\n");
+        buffer_agregar(b, "\\item Las aristas en \\textcolor{gray}{gris punteado} son aristas que aún no se han eliminado\n");
+        buffer_agregar(b, "\\item Las aristas en \\textcolor{blue}{azul grueso} forman la ruta construida hasta el momento\n");
+        buffer_agregar(b, "\\item La arista en \\textcolor{green!70!black}{verde grueso} es la arista elegida en este paso (no es puente)\n");
+        buffer_agregar(b, "\\item La arista en \\textcolor{red}{rojo grueso} es la arista elegida en este paso (es un puente, pero es la única opción)\n");
+        buffer_agregar(b, "\\item El vértice en \\textcolor{yellow!50}{amarillo} es el vértice actual\n");
+        buffer_agregar(b, "\\end{itemize}\n\n");
+        
+        
+        if (a->len_fleury_ruta > 0 && a->num_pasos_fleury_ruta > 0) {
             // Generar diagramas para cada paso
-            for (int p = 0; p < num_pasos_fleury_ruta && p < 20; p++) {  // Limitar a 20 pasos
-                fprintf(f, "\\subsubsection{Paso %d}\n\n", p + 1);
-                fprintf(f, "%s\n\n", pasos_fleury_ruta[p].descripcion);
-                generar_tikz_paso_fleury(f, &pasos_fleury_ruta[p], p + 1, min_x, min_y, escala);
+            for (int p = 0; p < a->num_pasos_fleury_ruta && p < 20; p++) {  // Limitar a 20 pasos
+                buffer_agregar(b, "\\subsubsection{Paso ");
+                buffer_agregar_entero(b, p + 1);
+                buffer_agregar(b, "}\n\n");
+                buffer_agregar(b, a->pasos_fleury_ruta[p].descripcion);
+                buffer_agregar(b, "\n\n");
+                generar_tikz_paso_fleury(b, &a->pasos_fleury_ruta[p], p + 1);
             }
             
-            if (num_pasos_fleury_ruta > 20) {
-                fprintf(f, "\\textit{Nota: Se muestran los primeros 20 pasos de un total de %d pasos.}\n\n", num_pasos_fleury_ruta);
+            if (a->num_pasos_fleury_ruta > 20) {
+                buffer_agregar(b, "\\textit{Nota: Se muestran los primeros 20 pasos de un total de ");
+                buffer_agregar_entero(b, a->num_pasos_fleury_ruta);
+                buffer_agregar(b, " pasos.}\n\n");
             }
             
-            fprintf(f, "\\textbf{Ruta Euleriana Final:}\n\n");
-            fprintf(f, "El algoritmo encontró la siguiente ruta euleriana completa:\n\n");
-            fprintf(f, "\\begin{center}\n");
-            fprintf(f, "\\Large\n");
-            for (int i = 0; i < len_fleury_ruta_paso_a_paso; i++) {
-                fprintf(f, "%d", secuencia_fleury_ruta_paso_a_paso[i]);
-                if (i < len_fleury_ruta_paso_a_paso - 1) {
-                    fprintf(f, " $\\rightarrow$ ");
-                }
-            }
-            fprintf(f, "\n");
-            fprintf(f, "\\end{center}\n\n");
-            fprintf(f, "\\normalsize\n");
+            buffer_agregar(b, "\\textbf{Ruta Euleriana Final:}\n\n");
+            buffer_agregar(b, "El algoritmo encontró la siguiente ruta euleriana completa:\n\n");
+            generar_secuencia_latex(b, a->secuencia_fleury_ruta, a->len_fleury_ruta);
             
-            fprintf(f, "\\textbf{Análisis de la Ejecución:}\n\n");
-            fprintf(f, "La ruta encontrada tiene $%d$ vértices. El algoritmo comenzó en un vértice de ", len_fleury_ruta_paso_a_paso);
-            fprintf(f, "grado impar y, siguiendo la regla de evitar puentes, construyó una ruta que ");
-            fprintf(f, "recorre todas las aristas exactamente una vez. La ruta termina en el otro ");
-            fprintf(f, "vértice de grado impar, formando así un camino euleriano completo.\n\n");
+            buffer_agregar(b, "\\textbf{Análisis de la Ejecución:}\n\n");
+            buffer_agregar(b, "La ruta encontrada tiene $");
+            buffer_agregar_entero(b, a->len_fleury_ruta);
+            buffer_agregar(b, "$ vértices. El algoritmo comenzó en un vértice de ");
+            buffer_agregar(b, "grado impar y, siguiendo la regla de evitar puentes, construyó una ruta que ");
+            buffer_agregar(b, "recorre todas las aristas exactamente una vez. La ruta termina en el otro ");
+            buffer_agregar(b, "vértice de grado impar, formando así un camino euleriano completo.\n\n");
         }
         
-        fprintf(f, "\\textbf{Complejidad:} Al igual que en el caso del ciclo, el algoritmo tiene ");
-        fprintf(f, "complejidad temporal $O(m^2)$ en el peor caso.\n\n");
+        buffer_agregar(b, "\\textbf{Complejidad:} Al igual que en el caso del ciclo, el algoritmo tiene ");
+        buffer_agregar(b, "complejidad temporal $O(m^2)$ en el peor caso.\n\n");
     } else {
-        fprintf(f, "\\textbf{Este grafo no es semieuleriano, por lo que no contiene una ruta euleriana.}\n\n");
-        fprintf(f, "Para que un grafo sea semieuleriano y contenga una ruta euleriana, debe cumplir las ");
-        fprintf(f, "siguientes condiciones:\n\n");
+        buffer_agregar(b, "\\textbf{Este grafo no es semieuleriano, por lo que no contiene una ruta euleriana.}\n\n");
+        buffer_agregar(b, "Para que un grafo sea semieuleriano y contenga una ruta euleriana, debe cumplir las ");
+        buffer_agregar(b, "siguientes condiciones:\n\n");
         if (grafo_actual.tipo == NO_DIRIGIDO) {
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser conexo\n");
-            fprintf(f, "\\item Debe tener exactamente dos vértices con grado impar\n");
-            fprintf(f, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser conexo\n");
+            buffer_agregar(b, "\\item Debe tener exactamente dos vértices con grado impar\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
         } else {
-            fprintf(f, "\\begin{enumerate}\n");
-            fprintf(f, "\\item El grafo debe ser conexo (o tener una componente fuertemente conexa que contenga todas las aristas)\n");
-            fprintf(f, "\\item Debe haber exactamente un vértice con $\\deg_{salida} - \\deg_{entrada} = 1$ y ");
-            fprintf(f, "exactamente un vértice con $\\deg_{entrada} - \\deg_{salida} = 1$, y todos los demás ");
-            fprintf(f, "vértices deben tener grados balanceados\n");
-            fprintf(f, "\\end{enumerate}\n\n");
+            buffer_agregar(b, "\\begin{enumerate}\n");
+            buffer_agregar(b, "\\item El grafo debe ser conexo (o tener una componente fuertemente conexa que contenga todas las aristas)\n");
+            buffer_agregar(b, "\\item Debe haber exactamente un vértice con $\\deg_{salida} - \\deg_{entrada} = 1$ y ");
+            buffer_agregar(b, "exactamente un vértice con $\\deg_{entrada} - \\deg_{salida} = 1$, y todos los demás ");
+            buffer_agregar(b, "vértices deben tener grados balanceados\n");
+            buffer_agregar(b, "\\end{enumerate}\n\n");
+        }
+        buffer_agregar(b, "Como este grafo no cumple estas condiciones, no es posible encontrar una ruta ");
+        buffer_agregar(b, "euleriana mediante el algoritmo de Fleury. Por lo tanto, no se puede mostrar la ");
+        buffer_agregar(b, "ejecución paso a paso del algoritmo para este caso.\n\n");
+    }
+}
+
+static void seccion_fin(BufferTexto *b, const AnalisisReporte *a) {
+    (void)a;
+    
+    buffer_agregar(b, "\\end{document}\n");
+}
+
+typedef void (*GeneradorSeccion)(BufferTexto *b, const AnalisisReporte *a);
+
+// Secciones del reporte en el orden en que aparecen en el documento
+static const GeneradorSeccion secciones_reporte[] = {
+    seccion_preambulo,
+    seccion_historia_hamilton,
+    seccion_historia_euler,
+    seccion_grafo_original,
+    seccion_propiedades,
+    seccion_hamiltoniano,
+    seccion_hierholzer,
+    seccion_fleury,
+    seccion_fleury_ciclo,
+    seccion_fleury_ruta,
+    seccion_fin
+};
+
+#define NUM_SECCIONES_REPORTE ((int)(sizeof(secciones_reporte) / sizeof(secciones_reporte[0])))
+
+typedef struct {
+    GeneradorSeccion generar;
+    const AnalisisReporte *analisis;
+    BufferTexto buffer;
+} TareaSeccion;
+
+static gpointer generar_seccion_hilo(gpointer datos) {
+    TareaSeccion *tarea = (TareaSeccion *)datos;
+    tarea->generar(&tarea->buffer, tarea->analisis);
+    return NULL;
+}
+
+// Arma el reporte completo en 'reporte'. Las secciones son independientes
+// entre sí, por lo que cada una se genera en su propio hilo y buffer, y luego
+// se concatenan en orden.
+static bool armar_reporte_latex(BufferTexto *reporte) {
+    AnalisisReporte analisis;
+    bool ok = analizar_grafo_reporte(&analisis);
+    
+    if (ok) {
+        TareaSeccion tareas[NUM_SECCIONES_REPORTE];
+        GThread *hilos[NUM_SECCIONES_REPORTE];
+        
+        for (int i = 0; i < NUM_SECCIONES_REPORTE; i++) {
+            tareas[i].generar = secciones_reporte[i];
+            tareas[i].analisis = &analisis;
+            buffer_iniciar(&tareas[i].buffer);
+            hilos[i] = lanzar_hilo("seccion-reporte", generar_seccion_hilo, &tareas[i]);
+        }
+        
+        for (int i = 0; i < NUM_SECCIONES_REPORTE; i++) {
+            if (hilos[i]) {
+                g_thread_join(hilos[i]);
+            }
+            buffer_concatenar(reporte, &tareas[i].buffer);
+            buffer_liberar(&tareas[i].buffer);
         }
-        fprintf(f, "Como este grafo no cumple estas condiciones, no es posible encontrar una ruta ");
-        fprintf(f, "euleriana mediante el algoritmo de Fleury. Por lo tanto, no se puede mostrar la ");
-        fprintf(f, "ejecución paso a paso del algoritmo para este caso.\n\n");
     }
     
-    fprintf(f, "\\end{document}\n");
-    fclose(f);
+    liberar_analisis_reporte(&analisis);
+    return ok;
+}
+
+// Arma el reporte en memoria y lo escribe con una sola escritura
+bool generar_latex(const char *filename) {
+    BufferTexto reporte;
+    buffer_iniciar(&reporte);
+    
+    bool ok = armar_reporte_latex(&reporte) && buffer_escribir_archivo(&reporte, filename);
+    
+    buffer_liberar(&reporte);
+    return ok;
 }
 
 void compilar_y_mostrar_pdf(const char *texfile) {
@@ -3269,60 +3699,1996 @@ void compilar_y_mostrar_pdf(const char *texfile) {
     }
 }
 
-int main(int argc, char *argv[]) {
-    gtk_init(&argc, &argv);
+// Renderizado nativo con Cairo: dibuja las mismas figuras que los emisores TikZ
+// directamente sobre superficies PDF/SVG o sobre la vista previa en pantalla.
+
+typedef struct {
+    double r;
+    double g;
+    double b;
+} ColorRGB;
+
+// Equivalentes RGB de los colores xcolor usados en el documento LaTeX
+static const ColorRGB COLOR_NEGRO = {0.0, 0.0, 0.0};
+static const ColorRGB COLOR_BLANCO = {1.0, 1.0, 1.0};
+static const ColorRGB COLOR_RESTANTE = {0.8, 0.8, 0.8};        // gray!40
+static const ColorRGB COLOR_ACTUAL = {1.0, 0.0, 0.0};          // red
+static const ColorRGB COLOR_RUTA = {0.0, 0.0, 1.0};            // blue
+static const ColorRGB COLOR_NO_PUENTE = {0.0, 0.7, 0.0};       // green!70!black
+static const ColorRGB COLOR_VERTICE_ACTUAL = {1.0, 1.0, 0.5};  // yellow!50
+static const ColorRGB COLOR_IMPAR = {0.2, 0.2, 0.2};           // black!80
+static const ColorRGB COLORES_CICLOS_CAIRO[] = {
+    {0.0, 0.0, 1.0},    // blue
+    {0.0, 0.7, 0.0},    // green!70!black
+    {1.0, 0.5, 0.0},    // orange
+    {0.75, 0.0, 0.25},  // purple
+    {0.75, 0.5, 0.25},  // brown
+    {0.0, 1.0, 1.0}     // cyan
+};
+// Rellenos de nodos dirigidos según la paridad de (entrada, salida)
+static const ColorRGB COLORES_PARIDAD_DIRIGIDO[2][2] = {
+    {{1.0, 0.7, 0.7}, {1.0, 1.0, 0.7}},  // entrada impar: red!30, yellow!30
+    {{0.7, 1.0, 0.7}, {0.7, 0.7, 1.0}}   // entrada par: green!30, blue!30
+};
+
+// Grosores de línea de TikZ en puntos
+#define GROSOR_THICK 0.8
+#define GROSOR_VERY_THICK 1.2
+#define GROSOR_ULTRA_THICK 1.6
+#define RADIO_NODO_CAIRO 11.3  // minimum size=0.8cm
+
+typedef struct {
+    double escala;
+    double origen_x;
+    double origen_y;
+    int min_x;
+    int min_y;
+} EncuadreCairo;
+
+// Ajusta las posiciones del grafo al área disponible, con el eje y hacia arriba como en TikZ
+static EncuadreCairo calcular_encuadre_cairo(double ancho, double alto) {
+    int K = grafo_actual.K;
+    EncuadreCairo e;
+    int max_x = grafo_actual.posiciones[0].x;
+    int max_y = grafo_actual.posiciones[0].y;
+    e.min_x = grafo_actual.posiciones[0].x;
+    e.min_y = grafo_actual.posiciones[0].y;
     
-    builder = gtk_builder_new_from_file(GLADE_FILE);
-    if (!builder) {
-        GtkWidget *error_dialog = gtk_message_dialog_new(NULL,
-            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
-            "No se pudo cargar el archivo Glade: %s", GLADE_FILE);
-        gtk_dialog_run(GTK_DIALOG(error_dialog));
-        gtk_widget_destroy(error_dialog);
-        return 1;
+    for (int i = 1; i < K; i++) {
+        if (grafo_actual.posiciones[i].x < e.min_x) e.min_x = grafo_actual.posiciones[i].x;
+        if (grafo_actual.posiciones[i].x > max_x) max_x = grafo_actual.posiciones[i].x;
+        if (grafo_actual.posiciones[i].y < e.min_y) e.min_y = grafo_actual.posiciones[i].y;
+        if (grafo_actual.posiciones[i].y > max_y) max_y = grafo_actual.posiciones[i].y;
     }
     
-    window_main = GTK_WIDGET(gtk_builder_get_object(builder, "window_main"));
-    grid_matriz = GTK_WIDGET(gtk_builder_get_object(builder, "grid_matriz"));
-    grid_posiciones = GTK_WIDGET(gtk_builder_get_object(builder, "grid_posiciones"));
-    spin_num_nodes = GTK_WIDGET(gtk_builder_get_object(builder, "spin_num_nodes"));
-    radio_no_dirigido = GTK_WIDGET(gtk_builder_get_object(builder, "radio_no_dirigido"));
-    radio_dirigido = GTK_WIDGET(gtk_builder_get_object(builder, "radio_dirigido"));
-    scroll_matriz = GTK_WIDGET(gtk_builder_get_object(builder, "scroll_matriz"));
-    notebook_main = GTK_WIDGET(gtk_builder_get_object(builder, "notebook_main"));
-    
-    GtkWidget *btn_clear = GTK_WIDGET(gtk_builder_get_object(builder, "btn_clear"));
-    GtkWidget *btn_generate_latex = GTK_WIDGET(gtk_builder_get_object(builder, "btn_generate_latex"));
-    GtkWidget *btn_apply_nodes = GTK_WIDGET(gtk_builder_get_object(builder, "btn_apply_nodes"));
-    GtkWidget *btn_save = GTK_WIDGET(gtk_builder_get_object(builder, "btn_save"));
-    GtkWidget *btn_load = GTK_WIDGET(gtk_builder_get_object(builder, "btn_load"));
-    GtkWidget *menu_save = GTK_WIDGET(gtk_builder_get_object(builder, "menu_save"));
-    GtkWidget *menu_load = GTK_WIDGET(gtk_builder_get_object(builder, "menu_load"));
-    GtkWidget *menu_quit = GTK_WIDGET(gtk_builder_get_object(builder, "menu_quit"));
-    
-    if (btn_clear) {
-        g_signal_connect(btn_clear, "clicked", G_CALLBACK(on_clear_clicked), NULL);
+    double margen = 2.0 * RADIO_NODO_CAIRO;
+    double rango_x = (max_x - e.min_x > 0) ? (max_x - e.min_x) : 1.0;
+    double rango_y = (max_y - e.min_y > 0) ? (max_y - e.min_y) : 1.0;
+    double escala_x = (ancho - 2.0 * margen) / rango_x;
+    double escala_y = (alto - 2.0 * margen) / rango_y;
+    e.escala = escala_x < escala_y ? escala_x : escala_y;
+    if (e.escala < 0) e.escala = 0;
+    
+    // Centrar el dibujo en el área
+    e.origen_x = (ancho - rango_x * e.escala) / 2.0;
+    e.origen_y = alto - (alto - rango_y * e.escala) / 2.0;
+    return e;
+}
+
+static void posicion_cairo(const EncuadreCairo *e, int nodo, double *x, double *y) {
+    *x = e->origen_x + (grafo_actual.posiciones[nodo].x - e->min_x) * e->escala;
+    *y = e->origen_y - (grafo_actual.posiciones[nodo].y - e->min_y) * e->escala;
+}
+
+// Dibuja una arista entre los bordes de los nodos u y v, con punta de flecha si el grafo es dirigido
+static void dibujar_arista_cairo(cairo_t *cr, const EncuadreCairo *e, int u, int v,
+                                 ColorRGB color, double grosor, bool punteada) {
+    double x1, y1, x2, y2;
+    posicion_cairo(e, u, &x1, &y1);
+    posicion_cairo(e, v, &x2, &y2);
+    
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    double distancia = sqrt(dx * dx + dy * dy);
+    if (distancia <= 2.0 * RADIO_NODO_CAIRO) return;
+    dx /= distancia;
+    dy /= distancia;
+    
+    x1 += dx * RADIO_NODO_CAIRO;
+    y1 += dy * RADIO_NODO_CAIRO;
+    x2 -= dx * RADIO_NODO_CAIRO;
+    y2 -= dy * RADIO_NODO_CAIRO;
+    
+    cairo_save(cr);
+    cairo_set_source_rgb(cr, color.r, color.g, color.b);
+    cairo_set_line_width(cr, grosor);
+    if (punteada) {
+        double guiones[] = {3.0, 3.0};
+        cairo_set_dash(cr, guiones, 2, 0);
     }
-    if (btn_generate_latex) {
-        g_signal_connect(btn_generate_latex, "clicked", G_CALLBACK(on_generate_latex_clicked), NULL);
+    cairo_move_to(cr, x1, y1);
+    cairo_line_to(cr, x2, y2);
+    cairo_stroke(cr);
+    
+    if (grafo_actual.tipo == DIRIGIDO) {
+        double largo = 4.0 + 2.0 * grosor;
+        double ancho_punta = largo * 0.6;
+        cairo_set_dash(cr, NULL, 0, 0);
+        cairo_move_to(cr, x2, y2);
+        cairo_line_to(cr, x2 - dx * largo - dy * ancho_punta, y2 - dy * largo + dx * ancho_punta);
+        cairo_line_to(cr, x2 - dx * largo + dy * ancho_punta, y2 - dy * largo - dx * ancho_punta);
+        cairo_close_path(cr);
+        cairo_fill(cr);
     }
-    if (btn_apply_nodes) {
-        g_signal_connect(btn_apply_nodes, "clicked", G_CALLBACK(on_apply_nodes_clicked), NULL);
+    cairo_restore(cr);
+}
+
+static void dibujar_aristas_matriz_cairo(cairo_t *cr, const EncuadreCairo *e, int matriz[MAX_NODOS][MAX_NODOS],
+                                         ColorRGB color, double grosor, bool punteada) {
+    int K = grafo_actual.K;
+    for (int i = 0; i < K; i++) {
+        for (int j = 0; j < K; j++) {
+            if (matriz[i][j] > 0 && (grafo_actual.tipo == DIRIGIDO || i < j)) {
+                dibujar_arista_cairo(cr, e, i, j, color, grosor, punteada);
+            }
+        }
     }
-    if (btn_save) {
-        g_signal_connect(btn_save, "clicked", G_CALLBACK(on_save_button_clicked), NULL);
+}
+
+static void dibujar_aristas_secuencia_cairo(cairo_t *cr, const EncuadreCairo *e, const int *secuencia, int longitud,
+                                            ColorRGB color, double grosor) {
+    for (int i = 0; i < longitud - 1; i++) {
+        dibujar_arista_cairo(cr, e, secuencia[i], secuencia[i + 1], color, grosor, false);
     }
-    if (btn_load) {
-        g_signal_connect(btn_load, "clicked", G_CALLBACK(on_load_button_clicked), NULL);
+}
+
+static void dibujar_nodo_cairo(cairo_t *cr, const EncuadreCairo *e, int nodo, ColorRGB relleno, ColorRGB texto) {
+    double x, y;
+    posicion_cairo(e, nodo, &x, &y);
+    
+    cairo_save(cr);
+    cairo_arc(cr, x, y, RADIO_NODO_CAIRO, 0, 2 * G_PI);
+    cairo_set_source_rgb(cr, relleno.r, relleno.g, relleno.b);
+    cairo_fill_preserve(cr);
+    cairo_set_source_rgb(cr, COLOR_NEGRO.r, COLOR_NEGRO.g, COLOR_NEGRO.b);
+    cairo_set_line_width(cr, 0.4);
+    cairo_stroke(cr);
+    
+    char etiqueta[16];
+    snprintf(etiqueta, sizeof(etiqueta), "%d", nodo);
+    cairo_text_extents_t medidas;
+    cairo_select_font_face(cr, "Serif", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 8.0);
+    cairo_text_extents(cr, etiqueta, &medidas);
+    cairo_set_source_rgb(cr, texto.r, texto.g, texto.b);
+    cairo_move_to(cr, x - medidas.width / 2.0 - medidas.x_bearing, y - medidas.height / 2.0 - medidas.y_bearing);
+    cairo_show_text(cr, etiqueta);
+    cairo_restore(cr);
+}
+
+static void pintar_fondo_cairo(cairo_t *cr) {
+    cairo_set_source_rgb(cr, COLOR_BLANCO.r, COLOR_BLANCO.g, COLOR_BLANCO.b);
+    cairo_paint(cr);
+}
+
+// Grafo original con los nodos coloreados por paridad de grados (equivalente a la sección "Grafo Original")
+void renderizar_grafo_cairo(cairo_t *cr, double ancho, double alto) {
+    int K = grafo_actual.K;
+    EncuadreCairo e = calcular_encuadre_cairo(ancho, alto);
+    pintar_fondo_cairo(cr);
+    
+    dibujar_aristas_matriz_cairo(cr, &e, grafo_actual.matriz_adyacencia, COLOR_NEGRO, GROSOR_THICK, false);
+    
+    int grados[MAX_NODOS];
+    int grados_entrada[MAX_NODOS];
+    int grados_salida[MAX_NODOS];
+    if (grafo_actual.tipo == NO_DIRIGIDO) {
+        calcular_grados_no_dirigido(grados);
+    } else {
+        calcular_grados_dirigido(grados_entrada, grados_salida);
     }
-    if (radio_no_dirigido) {
-        g_signal_connect(radio_no_dirigido, "toggled", G_CALLBACK(on_tipo_grafo_changed), NULL);
+    
+    for (int i = 0; i < K; i++) {
+        if (grafo_actual.tipo == NO_DIRIGIDO) {
+            bool par = grados[i] % 2 == 0;
+            dibujar_nodo_cairo(cr, &e, i, par ? COLOR_BLANCO : COLOR_IMPAR, par ? COLOR_NEGRO : COLOR_BLANCO);
+        } else {
+            ColorRGB relleno = COLORES_PARIDAD_DIRIGIDO[grados_entrada[i] % 2 == 0][grados_salida[i] % 2 == 0];
+            dibujar_nodo_cairo(cr, &e, i, relleno, COLOR_NEGRO);
+        }
     }
-    if (radio_dirigido) {
-        g_signal_connect(radio_dirigido, "toggled", G_CALLBACK(on_tipo_grafo_changed), NULL);
+}
+
+// Paso de Hierholzer: aristas restantes, ciclos completos y ciclo en construcción
+void renderizar_paso_hierholzer_cairo(cairo_t *cr, double ancho, double alto, PasoHierholzer *paso) {
+    int K = grafo_actual.K;
+    EncuadreCairo e = calcular_encuadre_cairo(ancho, alto);
+    pintar_fondo_cairo(cr);
+    
+    dibujar_aristas_matriz_cairo(cr, &e, paso->matriz_restante, COLOR_RESTANTE, GROSOR_THICK, true);
+    for (int c = 0; c < paso->num_ciclos_completos; c++) {
+        dibujar_aristas_secuencia_cairo(cr, &e, paso->ciclos_completos[c], paso->len_ciclos_completos[c],
+                                        COLORES_CICLOS_CAIRO[c % 6], GROSOR_VERY_THICK);
     }
-    if (spin_num_nodes) {
-        g_signal_connect(spin_num_nodes, "value-changed", G_CALLBACK(on_num_nodes_changed), NULL);
+    dibujar_aristas_secuencia_cairo(cr, &e, paso->ciclo_actual, paso->len_ciclo_actual, COLOR_ACTUAL, GROSOR_ULTRA_THICK);
+    
+    for (int i = 0; i < K; i++) {
+        dibujar_nodo_cairo(cr, &e, i, COLOR_BLANCO, COLOR_NEGRO);
+    }
+}
+
+// Paso de Fleury: aristas restantes, ruta construida, arista elegida y vértice actual
+void renderizar_paso_fleury_cairo(cairo_t *cr, double ancho, double alto, PasoFleury *paso) {
+    int K = grafo_actual.K;
+    EncuadreCairo e = calcular_encuadre_cairo(ancho, alto);
+    pintar_fondo_cairo(cr);
+    
+    dibujar_aristas_matriz_cairo(cr, &e, paso->matriz_restante, COLOR_RESTANTE, GROSOR_THICK, true);
+    dibujar_aristas_secuencia_cairo(cr, &e, paso->ruta_actual, paso->len_ruta_actual, COLOR_RUTA, GROSOR_VERY_THICK);
+    if (paso->arista_elegida_u >= 0 && paso->arista_elegida_v >= 0) {
+        dibujar_arista_cairo(cr, &e, paso->arista_elegida_u, paso->arista_elegida_v,
+                             paso->es_puente ? COLOR_ACTUAL : COLOR_NO_PUENTE, GROSOR_ULTRA_THICK, false);
+    }
+    
+    for (int i = 0; i < K; i++) {
+        dibujar_nodo_cairo(cr, &e, i, i == paso->vertice_actual ? COLOR_VERTICE_ACTUAL : COLOR_BLANCO, COLOR_NEGRO);
+    }
+}
+
+// Lienzo de la pestaña "Lienzo": dibuja grafo_actual con las mismas primitivas
+// que la vista previa, pero con encuadre propio (desplazable con zoom) y
+// editable: arrastrar un nodo lo mueve, dos clics en nodos alternan la arista
+// entre ellos, arrastrar el fondo desplaza la vista y la rueda la acerca o aleja
+// alrededor del puntero. Inicio vuelve a encuadrar todo el grafo y Escape
+// descarta la selección. Los nodos se buscan con una rejilla uniforme
+// (indice_espacial.h) que se reconstruye cuando cambia version_posiciones:
+// tanto el clic como el dibujo cuestan lo que hay bajo el puntero o a la vista.
+#define UMBRAL_ARRASTRE 4.0     // Píxeles que separan un clic de un arrastre
+#define ZOOM_MINIMO 0.02
+#define ZOOM_MAXIMO 50.0
+
+typedef struct {
+    double zoom;                // Píxeles por unidad de posición; 0 si hay que encuadrar
+    double centro_x;            // Punto del grafo que queda en el centro del área
+    double centro_y;
+    int seleccionado;           // Primer extremo de la arista por alternar, o -1
+    int arrastrado;             // Nodo bajo el botón pulsado, o -1
+    bool moviendo;              // El arrastre pasó el umbral: no es un clic
+    bool desplazando;           // Se arrastra el fondo
+    double x_pulsado;
+    double y_pulsado;
+    double x_anterior;
+    double y_anterior;
+    Coordenada posicion_original;
+    IndiceEspacial indice;
+    unsigned int version_indice;    // version_posiciones del índice (0: sin construir)
+} Lienzo;
+
+static Lienzo lienzo = {.seleccionado = -1, .arrastrado = -1};
+
+void reiniciar_lienzo() {
+    lienzo.zoom = 0;
+    lienzo.seleccionado = -1;
+    lienzo.arrastrado = -1;
+    lienzo.moviendo = false;
+    lienzo.desplazando = false;
+}
+
+static const IndiceEspacial *indice_lienzo(void) {
+    if (lienzo.version_indice != version_posiciones) {
+        liberar_indice_espacial(&lienzo.indice);
+        if (!construir_indice_espacial(&lienzo.indice, grafo_actual.posiciones, grafo_actual.K,
+                                       LADO_INDICE_POSICIONES)) {
+            lienzo.version_indice = 0;
+            return NULL;
+        }
+        lienzo.version_indice = version_posiciones;
+    }
+    return &lienzo.indice;
+}
+
+// El encuadre del lienzo es un EncuadreCairo con mínimos en 0, así que sirven
+// posicion_cairo y los dibujos de la vista previa
+static EncuadreCairo encuadre_lienzo(double ancho, double alto) {
+    if (lienzo.zoom == 0 && grafo_actual.K > 0) {
+        EncuadreCairo ajuste = calcular_encuadre_cairo(ancho, alto);
+        double escala = ajuste.escala;
+        if (escala < ZOOM_MINIMO) escala = ZOOM_MINIMO;
+        if (escala > ZOOM_MAXIMO) escala = ZOOM_MAXIMO;
+        lienzo.centro_x = ajuste.min_x + (ancho / 2.0 - ajuste.origen_x) / ajuste.escala;
+        lienzo.centro_y = ajuste.min_y + (ajuste.origen_y - alto / 2.0) / ajuste.escala;
+        if (ajuste.escala <= 0) {
+            lienzo.centro_x = grafo_actual.posiciones[0].x;
+            lienzo.centro_y = grafo_actual.posiciones[0].y;
+        }
+        lienzo.zoom = escala;
+    }
+    
+    EncuadreCairo e;
+    e.escala = lienzo.zoom > 0 ? lienzo.zoom : 1.0;
+    e.min_x = 0;
+    e.min_y = 0;
+    e.origen_x = ancho / 2.0 - lienzo.centro_x * e.escala;
+    e.origen_y = alto / 2.0 + lienzo.centro_y * e.escala;
+    return e;
+}
+
+static void pantalla_a_grafo(const EncuadreCairo *e, double sx, double sy, double *x, double *y) {
+    *x = e->min_x + (sx - e->origen_x) / e->escala;
+    *y = e->min_y + (e->origen_y - sy) / e->escala;
+}
+
+static EncuadreCairo encuadre_widget_lienzo(GtkWidget *widget) {
+    return encuadre_lienzo(gtk_widget_get_allocated_width(widget), gtk_widget_get_allocated_height(widget));
+}
+
+static int nodo_bajo_puntero(GtkWidget *widget, double sx, double sy) {
+    const IndiceEspacial *indice = indice_lienzo();
+    if (!indice) return -1;
+    EncuadreCairo e = encuadre_widget_lienzo(widget);
+    double x, y;
+    pantalla_a_grafo(&e, sx, sy, &x, &y);
+    return nodo_mas_cercano(indice, grafo_actual.posiciones, x, y, RADIO_NODO_CAIRO / e.escala);
+}
+
+// Recorrido euleriano que se reproduce sobre el lienzo (traza.h). Mientras
+// está activo el lienzo muestra el estado del paso elegido en lugar del grafo.
+typedef struct {
+    bool activo;
+    bool fleury;                // Fleury (ciclo o ruta); si no, Hierholzer
+    Traza traza;
+    EstadoTraza estado;         // Estado del paso mostrado
+    unsigned int version;       // version_grafo con la que se grabó la traza
+    guint fuente;               // Temporizador de la reproducción, o 0
+    gint64 ultimo_cuadro;
+    double pendiente;           // Fracción de paso acumulada entre cuadros
+    bool moviendo_escala;       // El propio reproductor mueve scale_paso
+} Reproductor;
+
+static Reproductor reproductor;
+
+typedef struct {
+    cairo_t *cr;
+    const EncuadreCairo *e;
+    int resaltado;              // Vértice actual del recorrido, o -1
+    double x0, y0, x1, y1;      // Parte visible, en coordenadas del grafo
+} DibujoLienzo;
+
+static void dibujar_nodo_lienzo(int nodo, void *datos) {
+    DibujoLienzo *d = (DibujoLienzo *)datos;
+    ColorRGB relleno = COLOR_BLANCO;
+    if (nodo == lienzo.seleccionado || nodo == d->resaltado) {
+        relleno = COLOR_VERTICE_ACTUAL;
+    } else if (nodo == lienzo.arrastrado && lienzo.moviendo) {
+        relleno = COLOR_RESTANTE;
+    }
+    dibujar_nodo_cairo(d->cr, d->e, nodo, relleno, COLOR_NEGRO);
+}
+
+// Se descartan las aristas cuya caja queda fuera de la vista
+static void dibujar_arista_lienzo(const DibujoLienzo *d, int u, int v, ColorRGB color,
+                                  double grosor, bool punteada) {
+    const Coordenada *a = &grafo_actual.posiciones[u];
+    const Coordenada *b = &grafo_actual.posiciones[v];
+    if (fmax(a->x, b->x) < d->x0 || fmin(a->x, b->x) > d->x1 ||
+        fmax(a->y, b->y) < d->y0 || fmin(a->y, b->y) > d->y1) {
+        return;
+    }
+    dibujar_arista_cairo(d->cr, d->e, u, v, color, grosor, punteada);
+}
+
+static void dibujar_aristas_lienzo(const DibujoLienzo *d, int matriz[MAX_NODOS][MAX_NODOS],
+                                   ColorRGB color, bool punteada) {
+    int K = grafo_actual.K;
+    for (int i = 0; i < K; i++) {
+        for (int j = 0; j < K; j++) {
+            if (matriz[i][j] <= 0) continue;
+            if (grafo_actual.tipo == NO_DIRIGIDO && i > j) continue;
+            dibujar_arista_lienzo(d, i, j, color, GROSOR_THICK, punteada);
+        }
+    }
+}
+
+// Paso del recorrido con los colores de la vista previa: aristas restantes
+// punteadas; en Hierholzer el circuito ya armado en azul y la pila en rojo, en
+// Fleury la ruta en azul y la última arista elegida según sea puente o no
+static void dibujar_recorrido_lienzo(DibujoLienzo *d) {
+    const Traza *traza = &reproductor.traza;
+    const EstadoTraza *estado = &reproductor.estado;
+    dibujar_aristas_lienzo(d, reproductor.estado.restante, COLOR_RESTANTE, true);
+    
+    for (int k = 1; k < estado->len_circuito; k++) {
+        dibujar_arista_lienzo(d, traza->circuito[k], traza->circuito[k - 1], COLOR_RUTA, GROSOR_VERY_THICK, false);
+    }
+    
+    int entrada = estado->tope;
+    while (entrada >= 0) {
+        const DeltaTraza *delta = &traza->deltas[entrada];
+        ColorRGB color = COLOR_ACTUAL;
+        double grosor = GROSOR_ULTRA_THICK;
+        if (reproductor.fleury) {
+            color = COLOR_RUTA;
+            grosor = GROSOR_VERY_THICK;
+            if (entrada == estado->tope) {
+                color = delta->puente ? COLOR_ACTUAL : COLOR_NO_PUENTE;
+                grosor = GROSOR_ULTRA_THICK;
+            }
+        }
+        dibujar_arista_lienzo(d, delta->u, delta->v, color, grosor, false);
+        entrada = delta->debajo;
+    }
+    
+    if (estado->tope != PILA_VACIA_TRAZA) {
+        d->resaltado = vertice_entrada_traza(traza, estado->tope);
+    }
+}
+
+static gboolean on_lienzo_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    (void)user_data;
+    int K = grafo_actual.K;
+    pintar_fondo_cairo(cr);
+    if (K == 0) return TRUE;
+    
+    EncuadreCairo e = encuadre_widget_lienzo(widget);
+    
+    // Parte visible en coordenadas del grafo, ampliada un radio de nodo
+    double sx0, sy0, sx1, sy1;
+    cairo_clip_extents(cr, &sx0, &sy0, &sx1, &sy1);
+    DibujoLienzo d = {cr, &e, -1, 0, 0, 0, 0};
+    pantalla_a_grafo(&e, sx0, sy1, &d.x0, &d.y0);
+    pantalla_a_grafo(&e, sx1, sy0, &d.x1, &d.y1);
+    double margen = RADIO_NODO_CAIRO / e.escala;
+    d.x0 -= margen;
+    d.y0 -= margen;
+    d.x1 += margen;
+    d.y1 += margen;
+    
+    if (reproductor.activo) {
+        dibujar_recorrido_lienzo(&d);
+    } else {
+        dibujar_aristas_lienzo(&d, grafo_actual.matriz_adyacencia, COLOR_NEGRO, false);
+    }
+    
+    const IndiceEspacial *indice = indice_lienzo();
+    if (indice) {
+        nodos_en_rectangulo(indice, grafo_actual.posiciones, d.x0, d.y0, d.x1, d.y1, dibujar_nodo_lienzo, &d);
+    } else {
+        for (int i = 0; i < K; i++) {
+            dibujar_nodo_lienzo(i, &d);
+        }
+    }
+    return TRUE;
+}
+
+// Reproducción del recorrido elegido en combo_recorrido: reproducir, pausar,
+// pasos sueltos y la barra para saltar a cualquier paso. Como la traza guarda
+// un cuadro clave cada INTERVALO_CLAVES_TRAZA pasos, saltar cuesta lo mismo
+// en un recorrido corto que en uno largo. La velocidad está en pasos por
+// segundo; cada cuadro avanza los que correspondan al tiempo transcurrido.
+#define INTERVALO_REPRODUCCION_MS 33
+
+// Opciones de combo_recorrido
+enum {
+    RECORRIDO_NINGUNO,
+    RECORRIDO_HIERHOLZER,
+    RECORRIDO_FLEURY_CICLO,
+    RECORRIDO_FLEURY_RUTA
+};
+
+static void describir_paso_reproductor(char *texto, size_t tam) {
+    const Traza *traza = &reproductor.traza;
+    int paso = reproductor.estado.paso;
+    int total = traza->num_deltas;
+    char detalle[256];
+    
+    if (paso == 0) {
+        snprintf(detalle, sizeof(detalle), "se comienza desde el vértice %d.", traza->inicio);
+    } else {
+        const DeltaTraza *d = &traza->deltas[paso - 1];
+        if (d->tipo == DELTA_RETROCEDER && d->cierra_ciclo) {
+            snprintf(detalle, sizeof(detalle),
+                    "se completa un ciclo parcial en el vértice %d, que pasa al circuito.", d->u);
+        } else if (d->tipo == DELTA_RETROCEDER) {
+            snprintf(detalle, sizeof(detalle),
+                    "el vértice %d no tiene más aristas: sale de la pila y pasa al circuito.", d->u);
+        } else if (!reproductor.fleury) {
+            snprintf(detalle, sizeof(detalle),
+                    "se agrega la arista %d → %d al ciclo parcial.", d->u, d->v);
+        } else if (d->puente) {
+            snprintf(detalle, sizeof(detalle),
+                    "se elige la arista %d → %d. Es un puente, pero es la única opción desde el vértice %d.",
+                    d->u, d->v, d->u);
+        } else {
+            snprintf(detalle, sizeof(detalle),
+                    "se elige la arista %d → %d, que no es un puente.", d->u, d->v);
+        }
+    }
+    snprintf(texto, tam, "Paso %d de %d: %s%s", paso, total, detalle,
+             paso == total ? " Fin del recorrido." : "");
+}
+
+static void mostrar_paso_reproductor(int paso) {
+    ir_a_paso_traza(&reproductor.traza, &reproductor.estado, paso);
+    paso = reproductor.estado.paso;
+    
+    reproductor.moviendo_escala = true;
+    gtk_range_set_value(GTK_RANGE(scale_paso), paso);
+    reproductor.moviendo_escala = false;
+    
+    char texto[512];
+    describir_paso_reproductor(texto, sizeof(texto));
+    gtk_label_set_text(label_paso, texto);
+    gtk_widget_set_sensitive(btn_paso_anterior, paso > 0);
+    gtk_widget_set_sensitive(btn_paso_siguiente, paso < reproductor.traza.num_deltas);
+    gtk_widget_queue_draw(area_lienzo);
+}
+
+static void detener_reproduccion(void) {
+    if (reproductor.fuente) {
+        g_source_remove(reproductor.fuente);
+        reproductor.fuente = 0;
+    }
+    if (btn_reproducir) gtk_button_set_label(GTK_BUTTON(btn_reproducir), "Reproducir");
+}
+
+static void descartar_recorrido_lienzo(const char *mensaje) {
+    detener_reproduccion();
+    liberar_traza(&reproductor.traza);
+    reproductor.activo = false;
+    
+    gtk_adjustment_set_upper(gtk_range_get_adjustment(GTK_RANGE(scale_paso)), 0);
+    gtk_widget_set_sensitive(scale_paso, FALSE);
+    gtk_widget_set_sensitive(btn_reproducir, FALSE);
+    gtk_widget_set_sensitive(btn_paso_anterior, FALSE);
+    gtk_widget_set_sensitive(btn_paso_siguiente, FALSE);
+    gtk_label_set_text(label_paso, mensaje);
+    gtk_widget_queue_draw(area_lienzo);
+}
+
+// Graba la traza del recorrido elegido sobre grafo_actual
+void on_recorrido_changed(GtkComboBox *combo, gpointer user_data) {
+    (void)user_data;
+    int recorrido = gtk_combo_box_get_active(combo);
+    descartar_recorrido_lienzo("Elija un recorrido para verlo paso a paso.");
+    if (recorrido <= RECORRIDO_NINGUNO) return;
+    
+    int secuencia[MAX_NODOS * MAX_NODOS];
+    int num_pasos = 0;
+    int longitud = 0;
+    const char *falta = NULL;
+    if (num_nodos_actual == 0) {
+        falta = "Primero debe configurar el número de nodos.";
+    } else if (recorrido == RECORRIDO_HIERHOLZER) {
+        longitud = encontrar_ciclo_euleriano_hierholzer_paso_a_paso(secuencia, NULL, &num_pasos, &reproductor.traza);
+        falta = "El grafo no tiene ciclo euleriano.";
+    } else if (recorrido == RECORRIDO_FLEURY_CICLO) {
+        longitud = encontrar_ciclo_euleriano_fleury_paso_a_paso(secuencia, NULL, &num_pasos, &reproductor.traza);
+        falta = "El grafo no tiene ciclo euleriano.";
+    } else {
+        longitud = encontrar_ruta_euleriana_fleury_paso_a_paso(secuencia, NULL, &num_pasos, &reproductor.traza);
+        falta = "El grafo no tiene ruta euleriana.";
+    }
+    if (longitud == 0 || reproductor.traza.sin_memoria) {
+        liberar_traza(&reproductor.traza);
+        gtk_label_set_text(label_paso, longitud == 0 ? falta : "Memoria insuficiente para grabar el recorrido.");
+        return;
+    }
+    
+    reproductor.activo = true;
+    reproductor.fleury = recorrido != RECORRIDO_HIERHOLZER;
+    reproductor.version = version_grafo;
+    reproductor.estado.paso = -1;
+    gtk_adjustment_set_upper(gtk_range_get_adjustment(GTK_RANGE(scale_paso)), reproductor.traza.num_deltas);
+    gtk_widget_set_sensitive(scale_paso, TRUE);
+    gtk_widget_set_sensitive(btn_reproducir, TRUE);
+    mostrar_paso_reproductor(0);
+}
+
+static gboolean avanzar_reproduccion(gpointer datos) {
+    (void)datos;
+    int total = reproductor.traza.num_deltas;
+    gint64 ahora = g_get_monotonic_time();
+    double velocidad = gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_velocidad));
+    reproductor.pendiente += velocidad * (double)(ahora - reproductor.ultimo_cuadro) / 1e6;
+    reproductor.ultimo_cuadro = ahora;
+    if (reproductor.pendiente > total) reproductor.pendiente = total;
+    
+    int pasos = (int)reproductor.pendiente;
+    if (pasos == 0) return G_SOURCE_CONTINUE;
+    reproductor.pendiente -= pasos;
+    mostrar_paso_reproductor(reproductor.estado.paso + pasos);
+    
+    if (reproductor.estado.paso >= total) {
+        reproductor.fuente = 0;
+        detener_reproduccion();
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+static void alternar_reproduccion(void) {
+    if (!reproductor.activo) return;
+    if (reproductor.fuente) {
+        detener_reproduccion();
+        return;
+    }
+    // Al final, volver a reproducir empieza de nuevo
+    if (reproductor.estado.paso >= reproductor.traza.num_deltas) {
+        mostrar_paso_reproductor(0);
+    }
+    reproductor.ultimo_cuadro = g_get_monotonic_time();
+    reproductor.pendiente = 0;
+    reproductor.fuente = g_timeout_add(INTERVALO_REPRODUCCION_MS, avanzar_reproduccion, NULL);
+    gtk_button_set_label(GTK_BUTTON(btn_reproducir), "Pausa");
+}
+
+static void mover_paso_reproductor(int cambio) {
+    if (!reproductor.activo) return;
+    detener_reproduccion();
+    mostrar_paso_reproductor(reproductor.estado.paso + cambio);
+}
+
+void on_reproducir_clicked(GtkButton *button, gpointer user_data) {
+    (void)button;
+    (void)user_data;
+    alternar_reproduccion();
+}
+
+void on_paso_anterior_clicked(GtkButton *button, gpointer user_data) {
+    (void)button;
+    (void)user_data;
+    mover_paso_reproductor(-1);
+}
+
+void on_paso_siguiente_clicked(GtkButton *button, gpointer user_data) {
+    (void)button;
+    (void)user_data;
+    mover_paso_reproductor(1);
+}
+
+void on_paso_scale_changed(GtkRange *range, gpointer user_data) {
+    (void)user_data;
+    if (!reproductor.activo || reproductor.moviendo_escala) return;
+    detener_reproduccion();
+    mostrar_paso_reproductor((int)(gtk_range_get_value(range) + 0.5));
+}
+
+// La llama refrescar_vistas_grafo: una traza grabada sobre otra matriz ya no vale
+void comprobar_recorrido_lienzo() {
+    if (!reproductor.activo || reproductor.version == version_grafo) return;
+    // on_recorrido_changed descarta la traza
+    gtk_combo_box_set_active(GTK_COMBO_BOX(combo_recorrido), RECORRIDO_NINGUNO);
+    gtk_label_set_text(label_paso, "El grafo cambió: elija de nuevo un recorrido para verlo paso a paso.");
+}
+
+// Mueve un nodo a una posición entera dentro del rango de los campos X/Y
+static void mover_nodo_lienzo(int nodo, Coordenada posicion) {
+    if (posicion.x < 0) posicion.x = 0;
+    if (posicion.y < 0) posicion.y = 0;
+    if (posicion.x > LIMITE_POSICION) posicion.x = LIMITE_POSICION;
+    if (posicion.y > LIMITE_POSICION) posicion.y = LIMITE_POSICION;
+    
+    // Los campos avisan a on_posicion_changed de a uno; la asignación final deja
+    // la posición completa aunque alguno no cambie
+    if (pos_x_spins[nodo]) gtk_spin_button_set_value(pos_x_spins[nodo], posicion.x);
+    if (pos_y_spins[nodo]) gtk_spin_button_set_value(pos_y_spins[nodo], posicion.y);
+    grafo_actual.posiciones[nodo] = posicion;
+    posiciones_modificadas();
+}
+
+typedef struct {
+    int excluir;
+    int encontrado;
+} BusquedaOcupado;
+
+static void marcar_ocupado(int nodo, void *datos) {
+    BusquedaOcupado *b = (BusquedaOcupado *)datos;
+    if (nodo != b->excluir) b->encontrado = nodo;
+}
+
+static bool posicion_ocupada(int nodo) {
+    const IndiceEspacial *indice = indice_lienzo();
+    const Coordenada *p = &grafo_actual.posiciones[nodo];
+    if (!indice) {
+        return posicion_duplicada(grafo_actual.posiciones, grafo_actual.K, p->x, p->y, nodo);
+    }
+    BusquedaOcupado b = {nodo, -1};
+    nodos_en_rectangulo(indice, grafo_actual.posiciones, p->x, p->y, p->x, p->y, marcar_ocupado, &b);
+    return b.encontrado >= 0;
+}
+
+static gboolean on_lienzo_button_press(GtkWidget *widget, GdkEventButton *event, gpointer user_data) {
+    (void)user_data;
+    if (event->type != GDK_BUTTON_PRESS || (event->button != 1 && event->button != 2)) return FALSE;
+    gtk_widget_grab_focus(widget);
+    
+    lienzo.x_pulsado = lienzo.x_anterior = event->x;
+    lienzo.y_pulsado = lienzo.y_anterior = event->y;
+    lienzo.moviendo = false;
+    lienzo.arrastrado = event->button == 1 ? nodo_bajo_puntero(widget, event->x, event->y) : -1;
+    lienzo.desplazando = lienzo.arrastrado < 0;
+    if (lienzo.arrastrado >= 0) {
+        lienzo.posicion_original = grafo_actual.posiciones[lienzo.arrastrado];
+    }
+    return TRUE;
+}
+
+static gboolean on_lienzo_motion(GtkWidget *widget, GdkEventMotion *event, gpointer user_data) {
+    (void)user_data;
+    if (lienzo.arrastrado < 0 && !lienzo.desplazando) return FALSE;
+    
+    if (!lienzo.moviendo && hypot(event->x - lienzo.x_pulsado, event->y - lienzo.y_pulsado) > UMBRAL_ARRASTRE) {
+        lienzo.moviendo = true;
+    }
+    if (!lienzo.moviendo) return TRUE;
+    
+    if (lienzo.arrastrado >= 0) {
+        EncuadreCairo e = encuadre_widget_lienzo(widget);
+        double x, y;
+        pantalla_a_grafo(&e, event->x, event->y, &x, &y);
+        Coordenada posicion = {(int)lround(x), (int)lround(y)};
+        mover_nodo_lienzo(lienzo.arrastrado, posicion);
+    } else if (lienzo.zoom > 0) {
+        lienzo.centro_x -= (event->x - lienzo.x_anterior) / lienzo.zoom;
+        lienzo.centro_y += (event->y - lienzo.y_anterior) / lienzo.zoom;
+        gtk_widget_queue_draw(widget);
+    }
+    lienzo.x_anterior = event->x;
+    lienzo.y_anterior = event->y;
+    return TRUE;
+}
+
+static gboolean on_lienzo_button_release(GtkWidget *widget, GdkEventButton *event, gpointer user_data) {
+    (void)user_data;
+    if (event->button != 1 && event->button != 2) return FALSE;
+    int nodo = lienzo.arrastrado;
+    
+    if (nodo >= 0 && lienzo.moviendo) {
+        // Dos nodos no pueden compartir posición: se deshace el arrastre
+        if (posicion_ocupada(nodo)) {
+            mover_nodo_lienzo(nodo, lienzo.posicion_original);
+        }
+    } else if (nodo >= 0) {
+        // Clic en un nodo: primer extremo, o segundo extremo de la arista a alternar
+        int origen = lienzo.seleccionado;
+        if (origen < 0) {
+            lienzo.seleccionado = nodo;
+        } else {
+            lienzo.seleccionado = -1;
+            if (origen != nodo) {
+                cambiar_celda_matriz(origen, nodo, !grafo_actual.matriz_adyacencia[origen][nodo]);
+            }
+        }
+    } else if (!lienzo.moviendo) {
+        lienzo.seleccionado = -1;
+    }
+    
+    lienzo.arrastrado = -1;
+    lienzo.moviendo = false;
+    lienzo.desplazando = false;
+    gtk_widget_queue_draw(widget);
+    return TRUE;
+}
+
+static gboolean on_lienzo_scroll(GtkWidget *widget, GdkEventScroll *event, gpointer user_data) {
+    (void)user_data;
+    double pasos;
+    switch (event->direction) {
+        case GDK_SCROLL_UP: pasos = 1; break;
+        case GDK_SCROLL_DOWN: pasos = -1; break;
+        case GDK_SCROLL_SMOOTH: pasos = -event->delta_y; break;
+        default: return FALSE;
+    }
+    
+    // El punto bajo el puntero queda fijo
+    EncuadreCairo e = encuadre_widget_lienzo(widget);
+    double x, y;
+    pantalla_a_grafo(&e, event->x, event->y, &x, &y);
+    double zoom = e.escala * pow(1.1, pasos);
+    if (zoom < ZOOM_MINIMO) zoom = ZOOM_MINIMO;
+    if (zoom > ZOOM_MAXIMO) zoom = ZOOM_MAXIMO;
+    lienzo.zoom = zoom;
+    lienzo.centro_x = x - (event->x - gtk_widget_get_allocated_width(widget) / 2.0) / zoom;
+    lienzo.centro_y = y + (event->y - gtk_widget_get_allocated_height(widget) / 2.0) / zoom;
+    gtk_widget_queue_draw(widget);
+    return TRUE;
+}
+
+static gboolean on_lienzo_key_press(GtkWidget *widget, GdkEventKey *event, gpointer user_data) {
+    (void)user_data;
+    switch (event->keyval) {
+        case GDK_KEY_Home:
+            lienzo.zoom = 0;
+            break;
+        case GDK_KEY_Escape:
+            lienzo.seleccionado = -1;
+            break;
+        // Con un recorrido activo, las flechas dan pasos y el espacio reproduce o pausa
+        case GDK_KEY_Left:
+        case GDK_KEY_Right:
+            if (!reproductor.activo) return FALSE;
+            mover_paso_reproductor(event->keyval == GDK_KEY_Left ? -1 : 1);
+            return TRUE;
+        case GDK_KEY_space:
+            if (!reproductor.activo) return FALSE;
+            alternar_reproduccion();
+            return TRUE;
+        default:
+            return FALSE;
+    }
+    gtk_widget_queue_draw(widget);
+    return TRUE;
+}
+
+// Distribución automática de grafo_actual (distribucion.h). La repulsión de
+// cada iteración se reparte en tramos de nodos entre hilos; por debajo de
+// NODOS_POR_HILO nodos por hilo no compensa crearlos. En la ventana se avanza
+// unos pasos por cuadro desde un temporizador, así el lienzo muestra cómo se
+// acomodan los nodos.
+#define NODOS_POR_HILO 2048
+#define MAX_HILOS_DISTRIBUCION 64
+#define PASOS_POR_CUADRO 10
+#define INTERVALO_CUADRO_MS 16
+
+typedef struct {
+    Distribucion *distribucion;
+    int desde;
+    int hasta;
+} TramoDistribucion;
+
+static gpointer tarea_repulsion(gpointer datos) {
+    TramoDistribucion *t = (TramoDistribucion *)datos;
+    calcular_repulsion_distribucion(t->distribucion, t->desde, t->hasta);
+    return NULL;
+}
+
+// Una iteración completa; solo falla sin memoria para el quadtree
+static bool paso_distribucion(Distribucion *d) {
+    if (!preparar_paso_distribucion(d)) return false;
+    
+    int hilos = d->num_nodos / NODOS_POR_HILO;
+    int procesadores = (int)g_get_num_processors();
+    if (hilos > procesadores) hilos = procesadores;
+    if (hilos > MAX_HILOS_DISTRIBUCION) hilos = MAX_HILOS_DISTRIBUCION;
+    if (hilos < 1) hilos = 1;
+    
+    TramoDistribucion tramos[MAX_HILOS_DISTRIBUCION];
+    GThread *hilo[MAX_HILOS_DISTRIBUCION] = {NULL};
+    for (int h = 0; h < hilos; h++) {
+        tramos[h].distribucion = d;
+        tramos[h].desde = (int)((long long)d->num_nodos * h / hilos);
+        tramos[h].hasta = (int)((long long)d->num_nodos * (h + 1) / hilos);
+    }
+    for (int h = 1; h < hilos; h++) {
+        hilo[h] = lanzar_hilo("distribucion", tarea_repulsion, &tramos[h]);
+    }
+    tarea_repulsion(&tramos[0]);
+    for (int h = 1; h < hilos; h++) {
+        if (hilo[h]) g_thread_join(hilo[h]);
+    }
+    
+    aplicar_paso_distribucion(d);
+    return true;
+}
+
+typedef struct {
+    GrafoCSR grafo;
+    Distribucion distribucion;
+    unsigned int version;       // version_grafo con la que empezó
+    guint fuente;               // Temporizador de la animación, 0 si no hay
+} AnimacionDistribucion;
+
+static AnimacionDistribucion animacion_distribucion;
+
+static void terminar_distribucion_lienzo(void) {
+    AnimacionDistribucion *a = &animacion_distribucion;
+    liberar_distribucion(&a->distribucion);
+    liberar_grafo_csr(&a->grafo);
+    a->fuente = 0;
+}
+
+static gboolean animar_distribucion(gpointer datos) {
+    (void)datos;
+    AnimacionDistribucion *a = &animacion_distribucion;
+    // Con otra matriz u otra cantidad de nodos la distribución ya no corresponde
+    if (a->version != version_grafo) {
+        terminar_distribucion_lienzo();
+        return G_SOURCE_REMOVE;
+    }
+    
+    Distribucion *d = &a->distribucion;
+    bool ok = true;
+    for (int p = 0; p < PASOS_POR_CUADRO && ok && d->iteracion < d->iteraciones; p++) {
+        ok = paso_distribucion(d);
+    }
+    
+    Coordenada posiciones[MAX_NODOS];
+    if (ok && ajustar_posiciones_distribucion(d, LIMITE_POSICION, posiciones)) {
+        for (int i = 0; i < d->num_nodos; i++) {
+            mover_nodo_lienzo(i, posiciones[i]);
+        }
+        lienzo.zoom = 0;
+    }
+    
+    if (!ok || d->iteracion >= d->iteraciones) {
+        terminar_distribucion_lienzo();
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void on_distribuir_clicked(GtkButton *button, gpointer user_data) {
+    (void)button;
+    (void)user_data;
+    if (num_nodos_actual == 0) {
+        GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(window_main),
+            GTK_DIALOG_MODAL, GTK_MESSAGE_WARNING, GTK_BUTTONS_OK,
+            "Primero debe configurar el número de nodos");
+        gtk_dialog_run(GTK_DIALOG(dialog));
+        gtk_widget_destroy(dialog);
+        return;
+    }
+    
+    // Un segundo clic vuelve a empezar desde las posiciones que haya
+    AnimacionDistribucion *a = &animacion_distribucion;
+    if (a->fuente) {
+        g_source_remove(a->fuente);
+        terminar_distribucion_lienzo();
+    }
+    
+    bool convertido = grafo_csr_desde_denso(&grafo_actual, &a->grafo);
+    if (!convertido || !iniciar_distribucion(&a->distribucion, &a->grafo, ITERACIONES_DISTRIBUCION)) {
+        if (convertido) liberar_grafo_csr(&a->grafo);
+        GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(window_main),
+            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
+            "Memoria insuficiente para distribuir el grafo");
+        gtk_dialog_run(GTK_DIALOG(dialog));
+        gtk_widget_destroy(dialog);
+        return;
+    }
+    a->version = version_grafo;
+    a->fuente = g_timeout_add(INTERVALO_CUADRO_MS, animar_distribucion, NULL);
+    
+    if (notebook_main && box_lienzo) {
+        int pagina = gtk_notebook_page_num(GTK_NOTEBOOK(notebook_main), box_lienzo);
+        if (pagina >= 0) gtk_notebook_set_current_page(GTK_NOTEBOOK(notebook_main), pagina);
+    }
+}
+
+// Vistas disponibles en la vista previa y en la exportación
+typedef enum {
+    VISTA_GRAFO,
+    VISTA_HIERHOLZER,
+    VISTA_FLEURY_CICLO,
+    VISTA_FLEURY_RUTA
+} TipoVista;
+
+typedef struct {
+    GtkWidget *ventana;
+    GtkWidget *area;
+    GtkWidget *combo_vista;
+    GtkWidget *spin_paso;
+    PasoHierholzer *pasos_hierholzer;
+    int num_pasos_hierholzer;
+    PasoFleury *pasos_fleury_ciclo;
+    int num_pasos_fleury_ciclo;
+    PasoFleury *pasos_fleury_ruta;
+    int num_pasos_fleury_ruta;
+} VistaPrevia;
+
+static VistaPrevia vista_previa;
+
+static int num_pasos_vista(TipoVista vista) {
+    switch (vista) {
+        case VISTA_HIERHOLZER: return vista_previa.num_pasos_hierholzer;
+        case VISTA_FLEURY_CICLO: return vista_previa.num_pasos_fleury_ciclo;
+        case VISTA_FLEURY_RUTA: return vista_previa.num_pasos_fleury_ruta;
+        default: return 1;
+    }
+}
+
+// Dibuja el paso indicado de una vista; devuelve false si la vista no tiene pasos
+bool renderizar_vista_cairo(cairo_t *cr, double ancho, double alto, TipoVista vista, int paso) {
+    switch (vista) {
+        case VISTA_GRAFO:
+            renderizar_grafo_cairo(cr, ancho, alto);
+            return true;
+        case VISTA_HIERHOLZER:
+            if (paso >= vista_previa.num_pasos_hierholzer) return false;
+            renderizar_paso_hierholzer_cairo(cr, ancho, alto, &vista_previa.pasos_hierholzer[paso]);
+            return true;
+        case VISTA_FLEURY_CICLO:
+            if (paso >= vista_previa.num_pasos_fleury_ciclo) return false;
+            renderizar_paso_fleury_cairo(cr, ancho, alto, &vista_previa.pasos_fleury_ciclo[paso]);
+            return true;
+        case VISTA_FLEURY_RUTA:
+            if (paso >= vista_previa.num_pasos_fleury_ruta) return false;
+            renderizar_paso_fleury_cairo(cr, ancho, alto, &vista_previa.pasos_fleury_ruta[paso]);
+            return true;
+    }
+    return false;
+}
+
+// Exporta una vista a PDF (una página por paso) o a SVG (solo el paso indicado).
+// Devuelve false sin crear el archivo si la vista no tiene pasos.
+bool exportar_vista_cairo(const char *archivo, TipoVista vista, int paso) {
+    const double ancho = 595.0;  // A4 en puntos
+    const double alto = 842.0;
+    const char *ext = strrchr(archivo, '.');
+    bool es_svg = ext && strcmp(ext, ".svg") == 0;
+    
+    int total = num_pasos_vista(vista);
+    if (total == 0 || (es_svg && (paso < 0 || paso >= total))) {
+        return false;
+    }
+    
+    cairo_surface_t *superficie = es_svg ? cairo_svg_surface_create(archivo, ancho, alto)
+                                         : cairo_pdf_surface_create(archivo, ancho, alto);
+    if (cairo_surface_status(superficie) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(superficie);
+        return false;
+    }
+    
+    cairo_t *cr = cairo_create(superficie);
+    if (es_svg) {
+        renderizar_vista_cairo(cr, ancho, alto, vista, paso);
+    } else {
+        for (int p = 0; p < total; p++) {
+            renderizar_vista_cairo(cr, ancho, alto, vista, p);
+            cairo_show_page(cr);
+        }
+    }
+    cairo_destroy(cr);
+    cairo_surface_finish(superficie);
+    bool ok = cairo_surface_status(superficie) == CAIRO_STATUS_SUCCESS;
+    cairo_surface_destroy(superficie);
+    return ok;
+}
+
+static void liberar_pasos_vista_previa() {
+    free(vista_previa.pasos_hierholzer);
+    free(vista_previa.pasos_fleury_ciclo);
+    free(vista_previa.pasos_fleury_ruta);
+    vista_previa.pasos_hierholzer = NULL;
+    vista_previa.pasos_fleury_ciclo = NULL;
+    vista_previa.pasos_fleury_ruta = NULL;
+    vista_previa.num_pasos_hierholzer = 0;
+    vista_previa.num_pasos_fleury_ciclo = 0;
+    vista_previa.num_pasos_fleury_ruta = 0;
+}
+
+// Ejecuta los algoritmos paso a paso sobre el grafo actual para la vista previa
+static void calcular_pasos_vista_previa() {
+    int secuencia[MAX_NODOS * MAX_NODOS];
+    
+    liberar_pasos_vista_previa();
+    vista_previa.pasos_hierholzer = malloc(MAX_PASOS * sizeof(PasoHierholzer));
+    vista_previa.pasos_fleury_ciclo = malloc(MAX_PASOS * sizeof(PasoFleury));
+    vista_previa.pasos_fleury_ruta = malloc(MAX_PASOS * sizeof(PasoFleury));
+    if (!vista_previa.pasos_hierholzer || !vista_previa.pasos_fleury_ciclo || !vista_previa.pasos_fleury_ruta) {
+        liberar_pasos_vista_previa();
+        return;
+    }
+    
+    if (es_euleriano()) {
+        encontrar_ciclo_euleriano_hierholzer_paso_a_paso(secuencia, vista_previa.pasos_hierholzer,
+                                                         &vista_previa.num_pasos_hierholzer, NULL);
+        encontrar_ciclo_euleriano_fleury_paso_a_paso(secuencia, vista_previa.pasos_fleury_ciclo,
+                                                     &vista_previa.num_pasos_fleury_ciclo, NULL);
+    }
+    if (es_semieuleriano()) {
+        encontrar_ruta_euleriana_fleury_paso_a_paso(secuencia, vista_previa.pasos_fleury_ruta,
+                                                    &vista_previa.num_pasos_fleury_ruta, NULL);
+    }
+}
+
+static TipoVista vista_seleccionada() {
+    int activa = gtk_combo_box_get_active(GTK_COMBO_BOX(vista_previa.combo_vista));
+    return activa < 0 ? VISTA_GRAFO : (TipoVista)activa;
+}
+
+static gboolean on_vista_previa_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+    (void)user_data;
+    double ancho = gtk_widget_get_allocated_width(widget);
+    double alto = gtk_widget_get_allocated_height(widget);
+    TipoVista vista = vista_seleccionada();
+    int paso = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(vista_previa.spin_paso)) - 1;
+    
+    gint64 inicio = g_get_monotonic_time();
+    bool dibujado = renderizar_vista_cairo(cr, ancho, alto, vista, paso);
+    gint64 fin = g_get_monotonic_time();
+    
+    // El tiempo se muestra en el título para no provocar un nuevo ajuste de tamaño al dibujar
+    char titulo[128];
+    if (dibujado) {
+        snprintf(titulo, sizeof(titulo), "Vista Previa — Paso %d de %d (%.2f ms)",
+                 paso + 1, num_pasos_vista(vista), (fin - inicio) / 1000.0);
+    } else {
+        pintar_fondo_cairo(cr);
+        snprintf(titulo, sizeof(titulo), "Vista Previa — El algoritmo no aplica a este grafo");
+    }
+    gtk_window_set_title(GTK_WINDOW(vista_previa.ventana), titulo);
+    return TRUE;
+}
+
+static void on_vista_previa_cambiada(GtkWidget *widget, gpointer user_data) {
+    (void)widget;
+    (void)user_data;
+    int total = num_pasos_vista(vista_seleccionada());
+    gtk_spin_button_set_range(GTK_SPIN_BUTTON(vista_previa.spin_paso), 1, total > 0 ? total : 1);
+    gtk_widget_queue_draw(vista_previa.area);
+}
+
+static void on_vista_previa_exportar(GtkButton *button, gpointer user_data) {
+    (void)button;
+    const char *extension = (const char *)user_data;
+    GtkWidget *dialog = gtk_file_chooser_dialog_new("Exportar Vista",
+        GTK_WINDOW(vista_previa.ventana), GTK_FILE_CHOOSER_ACTION_SAVE,
+        "_Cancelar", GTK_RESPONSE_CANCEL,
+        "_Guardar", GTK_RESPONSE_ACCEPT, NULL);
+    gtk_file_chooser_set_do_overwrite_confirmation(GTK_FILE_CHOOSER(dialog), TRUE);
+    char nombre[32];
+    snprintf(nombre, sizeof(nombre), "vista%s", extension);
+    gtk_file_chooser_set_current_name(GTK_FILE_CHOOSER(dialog), nombre);
+    
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
+        char *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+        int paso = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(vista_previa.spin_paso)) - 1;
+        TipoVista vista = vista_seleccionada();
+        if (!exportar_vista_cairo(filename, vista, paso)) {
+            GtkWidget *dialog_error = num_pasos_vista(vista) == 0
+                ? gtk_message_dialog_new(GTK_WINDOW(vista_previa.ventana),
+                      GTK_DIALOG_MODAL, GTK_MESSAGE_WARNING, GTK_BUTTONS_OK,
+                      "No se exportó la vista: el algoritmo no aplica a este grafo")
+                : gtk_message_dialog_new(GTK_WINDOW(vista_previa.ventana),
+                      GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
+                      "Error al exportar la vista: %s", filename);
+            gtk_dialog_run(GTK_DIALOG(dialog_error));
+            gtk_widget_destroy(dialog_error);
+        }
+        g_free(filename);
+    }
+    
+    gtk_widget_destroy(dialog);
+}
+
+static void on_vista_previa_destroy(GtkWidget *widget, gpointer user_data) {
+    (void)widget;
+    (void)user_data;
+    liberar_pasos_vista_previa();
+    vista_previa.ventana = NULL;
+}
+
+static void crear_ventana_vista_previa() {
+    vista_previa.ventana = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+    gtk_window_set_title(GTK_WINDOW(vista_previa.ventana), "Vista Previa");
+    gtk_window_set_default_size(GTK_WINDOW(vista_previa.ventana), 700, 600);
+    gtk_window_set_transient_for(GTK_WINDOW(vista_previa.ventana), GTK_WINDOW(window_main));
+    
+    GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+    GtkWidget *barra = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+    gtk_container_add(GTK_CONTAINER(vista_previa.ventana), box);
+    
+    vista_previa.combo_vista = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(vista_previa.combo_vista), "Grafo original");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(vista_previa.combo_vista), "Hierholzer (ciclo)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(vista_previa.combo_vista), "Fleury (ciclo)");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(vista_previa.combo_vista), "Fleury (ruta)");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(vista_previa.combo_vista), VISTA_GRAFO);
+    
+    vista_previa.spin_paso = gtk_spin_button_new_with_range(1, 1, 1);
+    GtkWidget *btn_pdf = gtk_button_new_with_label("Exportar PDF");
+    GtkWidget *btn_svg = gtk_button_new_with_label("Exportar SVG");
+    
+    gtk_box_pack_start(GTK_BOX(barra), gtk_label_new("Vista:"), FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(barra), vista_previa.combo_vista, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(barra), gtk_label_new("Paso:"), FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(barra), vista_previa.spin_paso, FALSE, FALSE, 0);
+    gtk_box_pack_end(GTK_BOX(barra), btn_svg, FALSE, FALSE, 0);
+    gtk_box_pack_end(GTK_BOX(barra), btn_pdf, FALSE, FALSE, 0);
+    
+    vista_previa.area = gtk_drawing_area_new();
+    
+    gtk_box_pack_start(GTK_BOX(box), barra, FALSE, FALSE, 5);
+    gtk_box_pack_start(GTK_BOX(box), vista_previa.area, TRUE, TRUE, 0);
+    
+    g_signal_connect(vista_previa.area, "draw", G_CALLBACK(on_vista_previa_draw), NULL);
+    g_signal_connect(vista_previa.combo_vista, "changed", G_CALLBACK(on_vista_previa_cambiada), NULL);
+    g_signal_connect(vista_previa.spin_paso, "value-changed", G_CALLBACK(on_vista_previa_cambiada), NULL);
+    g_signal_connect(btn_pdf, "clicked", G_CALLBACK(on_vista_previa_exportar), ".pdf");
+    g_signal_connect(btn_svg, "clicked", G_CALLBACK(on_vista_previa_exportar), ".svg");
+    g_signal_connect(vista_previa.ventana, "destroy", G_CALLBACK(on_vista_previa_destroy), NULL);
+}
+
+void on_preview_clicked(GtkButton *button, gpointer user_data) {
+    (void)button;
+    (void)user_data;
+    if (num_nodos_actual == 0) {
+        GtkWidget *dialog = gtk_message_dialog_new(GTK_WINDOW(window_main),
+            GTK_DIALOG_MODAL, GTK_MESSAGE_WARNING, GTK_BUTTONS_OK,
+            "Primero debe configurar el número de nodos");
+        gtk_dialog_run(GTK_DIALOG(dialog));
+        gtk_widget_destroy(dialog);
+        return;
+    }
+    
+    for (int i = 0; i < num_nodos_actual; i++) {
+        if (pos_x_spins[i]) {
+            grafo_actual.posiciones[i].x = gtk_spin_button_get_value_as_int(pos_x_spins[i]);
+        }
+        if (pos_y_spins[i]) {
+            grafo_actual.posiciones[i].y = gtk_spin_button_get_value_as_int(pos_y_spins[i]);
+        }
+    }
+    
+    if (!vista_previa.ventana) {
+        crear_ventana_vista_previa();
+    }
+    calcular_pasos_vista_previa();
+    on_vista_previa_cambiada(NULL, NULL);
+    gtk_widget_show_all(vista_previa.ventana);
+    gtk_window_present(GTK_WINDOW(vista_previa.ventana));
+}
+
+// Receptor que solo cuenta lo leído, para validar archivos de cualquier tamaño
+typedef struct {
+    int K;
+    TipoGrafo tipo;
+    long long arcos;
+    long long lazos;
+} ResumenCarga;
+
+static bool resumen_encabezado(void *datos, int K, TipoGrafo tipo, ErrorCarga *error) {
+    (void)error;
+    ResumenCarga *resumen = (ResumenCarga *)datos;
+    resumen->K = K;
+    resumen->tipo = tipo;
+    return true;
+}
+
+static void resumen_arista(void *datos, int u, int v, int peso) {
+    ResumenCarga *resumen = (ResumenCarga *)datos;
+    resumen->arcos += peso;
+    if (u == v) {
+        resumen->lazos += peso;
+    }
+}
+
+static void imprimir_error_carga(const char *ruta, const ErrorCarga *error) {
+    if (error->linea > 0) {
+        fprintf(stderr, "%s:%d:%d: %s\n", ruta, error->linea, error->columna, error->mensaje);
+    } else {
+        fprintf(stderr, "%s: %s\n", ruta, error->mensaje);
+    }
+}
+
+static void imprimir_uso(FILE *salida, const char *programa) {
+    fprintf(salida, "Uso: %s [opción]\n", programa);
+    fprintf(salida, "Sin opciones se abre la interfaz gráfica.\n\n");
+    fprintf(salida, "  --verificar ARCHIVO          valida el archivo (en una instantánea .p4g, también\n");
+    fprintf(salida, "                               la suma de verificación) y muestra un resumen\n");
+    fprintf(salida, "  --latex ARCHIVO [SALIDA]     genera el reporte LaTeX (por defecto proyecto-4aa.tex)\n");
+    fprintf(salida, "  --convertir ENTRADA SALIDA   cambia de formato según la extensión de SALIDA\n");
+    fprintf(salida, "                               (.p4g, .graphml, .dot/.gv, .el/.aristas,\n");
+    fprintf(salida, "                               .col/.gr/.dimacs u otra para matriz)\n");
+    fprintf(salida, "  --euler ARCHIVO [SALIDA]     escribe el ciclo (o la ruta) euleriano, un vértice\n");
+    fprintf(salida, "                               por línea; con SALIDA .eul usa el formato binario\n");
+    fprintf(salida, "  --euler-externo ARCHIVO [SALIDA [MB]]\n");
+    fprintf(salida, "                               igual, con las aristas en disco y MB de memoria\n");
+    fprintf(salida, "                               (256 por defecto) más el estado por nodo\n");
+    fprintf(salida, "  --ensamblar ARCHIVO K [SALIDA]\n");
+    fprintf(salida, "                               reconstruye la secuencia de las lecturas (FASTA o\n");
+    fprintf(salida, "                               una por línea) con el grafo de de Bruijn de\n");
+    fprintf(salida, "                               k-meros, K entre 2 y 32; escribe FASTA\n");
+    fprintf(salida, "  --recorrido ARCHIVO.eul      muestra un recorrido binario como texto\n");
+    fprintf(salida, "  --distribuir ENTRADA SALIDA  calcula las posiciones (0 a %d) por fuerzas y\n", LIMITE_POSICION);
+    fprintf(salida, "                               guarda en el formato de SALIDA\n");
+    fprintf(salida, "  --generar FAMILIA N SALIDA [PARÁMETRO [SEMILLA]]\n");
+    fprintf(salida, "                               genera un grafo de N nodos y lo guarda en el\n");
+    fprintf(salida, "                               formato de SALIDA. FAMILIA: completo, ciclo, camino,\n");
+    fprintf(salida, "                               estrella, bipartito, aleatorio, euleriano, rueda,\n");
+    fprintf(salida, "                               arbol, dirigido, hamiltoniano o regular. PARÁMETRO\n");
+    fprintf(salida, "                               es el grado en regular (%d por defecto) y la\n", GRADO_POR_OMISION);
+    fprintf(salida, "                               densidad en las familias al azar (por defecto\n");
+    fprintf(salida, "                               %.0f aristas por nodo, hasta 0.5); SEMILLA, %d\n", GRADO_MEDIO_GENERADOR, SEMILLA_POR_OMISION);
+    fprintf(salida, "  --bench [json|csv [SALIDA]]  mide los algoritmos sobre las familias de grafos\n");
+    fprintf(salida, "                               generadas en varios tamaños (mediana y percentiles\n");
+    fprintf(salida, "                               por llamada, en microsegundos)\n");
+    fprintf(salida, "  --ayuda                      muestra esta ayuda\n");
+}
+
+static int comando_verificar(const char *ruta) {
+    ResumenCarga resumen = {0};
+    ReceptorGrafo receptor = {resumen_encabezado, resumen_arista, NULL, &resumen};
+    ErrorCarga error;
+    
+    if (!cargar_grafo(ruta, &receptor, &error)) {
+        imprimir_error_carga(ruta, &error);
+        return 1;
+    }
+    
+    // En la matriz de un grafo no dirigido cada arista aparece dos veces, salvo los lazos
+    long long aristas = resumen.tipo == NO_DIRIGIDO ? (resumen.arcos + resumen.lazos) / 2 : resumen.arcos;
+    printf("%s: %d nodos, %s, %lld aristas\n", ruta, resumen.K,
+           resumen.tipo == DIRIGIDO ? "dirigido" : "no dirigido", aristas);
+    return 0;
+}
+
+static int comando_latex(const char *ruta, const char *salida) {
+    Grafo cargado;
+    ReceptorGrafo receptor;
+    ErrorCarga error;
+    receptor_grafo_denso(&receptor, &cargado);
+    
+    if (!cargar_grafo(ruta, &receptor, &error)) {
+        imprimir_error_carga(ruta, &error);
+        return 1;
+    }
+    
+    grafo_actual = cargado;
+    num_nodos_actual = cargado.K;
+    grafo_modificado();
+    if (!validar_posiciones()) {
+        fprintf(stderr, "%s: No puede haber dos nodos en la misma posición\n", ruta);
+        return 1;
+    }
+    if (!generar_latex(salida)) {
+        fprintf(stderr, "%s: Error al crear archivo LaTeX\n", salida);
+        return 1;
+    }
+    return 0;
+}
+
+// Guarda en el formato que indica la extensión de 'ruta'. Los grafos que caben
+// en la interfaz se exportan con los recorridos del análisis.
+static bool guardar_grafo_consola(const GrafoCSR *grafo, const char *ruta) {
+    Grafo denso;
+    if (grafo_denso_desde_csr(grafo, &denso)) {
+        grafo_actual = denso;
+        num_nodos_actual = denso.K;
+        grafo_modificado();
+        return guardar_grafo_actual(ruta);
+    }
+    return guardar_grafo_csr(ruta, formato_por_extension(ruta), grafo);
+}
+
+// Convierte sin pasar por la matriz densa, así que no tiene el límite de MAX_NODOS.
+// Las instantáneas .p4g se proyectan en memoria en lugar de leerse; como en los
+// demás comandos, se revisan la cabecera y los arcos, y la suma queda para --verificar.
+static int comando_convertir(const char *entrada, const char *salida) {
+    GrafoCSR grafo;
+    ErrorCarga error;
+    
+    if (!abrir_grafo_csr(entrada, &grafo, false, &error)) {
+        imprimir_error_carga(entrada, &error);
+        return 1;
+    }
+    
+    bool ok = guardar_grafo_consola(&grafo, salida);
+    liberar_grafo_csr(&grafo);
+    if (!ok) {
+        fprintf(stderr, "%s: Error al guardar el archivo\n", salida);
+        return 1;
+    }
+    return 0;
+}
+
+static bool termina_en_eul(const char *ruta) {
+    size_t n = strlen(ruta);
+    return n >= 4 && strcmp(ruta + n - 4, ".eul") == 0;
+}
+
+// Escribe el recorrido euleriano mientras se calcula, sin guardarlo en memoria.
+// Sin SALIDA (o con "-") se escribe en la salida estándar. Con 'externo' las
+// aristas quedan en disco y solo se usan 'memoria_mb' MB más el estado por nodo.
+static int comando_euler(const char *entrada, const char *salida, bool externo, long memoria_mb) {
+    GrafoCSR grafo;
+    ErrorCarga error;
+    if (!externo && !abrir_grafo_csr(entrada, &grafo, false, &error)) {
+        imprimir_error_carga(entrada, &error);
+        return 1;
+    }
+    
+    bool a_consola = !salida || strcmp(salida, "-") == 0;
+    FILE *archivo = a_consola ? stdout : fopen(salida, "wb");
+    if (!archivo) {
+        fprintf(stderr, "%s: No se pudo crear el archivo\n", salida);
+        if (!externo) liberar_grafo_csr(&grafo);
+        return 1;
+    }
+    
+    SumideroRecorrido sumidero;
+    SalidaRecorrido salida_recorrido;
+    ClaseEuleriana clase;
+    sumidero_archivo(&sumidero, &salida_recorrido, archivo,
+                     !a_consola && termina_en_eul(salida) ? RECORRIDO_BINARIO : RECORRIDO_TEXTO);
+    bool ok;
+    if (externo) {
+        ConfiguracionExterna config = {(size_t)memoria_mb << 20, NULL};
+        ok = recorrido_euleriano_externo(entrada, &config, &sumidero, &clase, &error);
+    } else {
+        const char *motivo;
+        ok = recorrido_euleriano_csr(&grafo, &sumidero, &clase, &motivo);
+        liberar_grafo_csr(&grafo);
+        memset(&error, 0, sizeof(error));
+        if (motivo) snprintf(error.mensaje, sizeof(error.mensaje), "%s", motivo);
+    }
+    buffer_liberar(&salida_recorrido.buffer);
+    if (!a_consola && fclose(archivo) != 0) ok = false;
+    
+    if (!ok && error.mensaje[0] != '\0') {
+        if (!a_consola) remove(salida);
+        imprimir_error_carga(entrada, &error);
+        return 1;
+    }
+    if (clase == EULER_NINGUNO) {
+        if (!a_consola) remove(salida);
+        fprintf(stderr, "%s: El grafo no tiene ciclo ni ruta euleriana\n", entrada);
+        return 1;
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: Error al escribir el recorrido\n", a_consola ? "stdout" : salida);
+        return 1;
+    }
+    fprintf(stderr, "%s: %s\n", entrada, clase == EULER_CICLO ? "ciclo euleriano" : "ruta euleriana");
+    return 0;
+}
+
+// Arma el grafo de de Bruijn de las lecturas y escribe en FASTA la secuencia
+// que deletrea su recorrido euleriano
+static int comando_ensamblar(const char *entrada, int k, const char *salida) {
+    GrafoCSR grafo;
+    ConstructorCSR constructor;
+    ReceptorGrafo receptor;
+    DeBruijn de_bruijn;
+    ErrorCarga error;
+    iniciar_constructor_csr(&constructor, &grafo);
+    receptor_grafo_csr(&receptor, &constructor);
+    
+    bool cargado = cargar_de_bruijn(entrada, k, &receptor, &de_bruijn, &error);
+    bool construido = terminar_constructor_csr(&constructor);
+    if (!cargado || !construido) {
+        if (cargado) {
+            fprintf(stderr, "%s: Memoria insuficiente\n", entrada);
+            liberar_de_bruijn(&de_bruijn);
+        } else {
+            imprimir_error_carga(entrada, &error);
+        }
+        liberar_grafo_csr(&grafo);
+        return 1;
+    }
+    
+    int inicio;
+    ClaseEuleriana clase = clasificar_euleriano_csr(&grafo, &inicio);
+    fprintf(stderr, "%s: %lld k-meros, %d (k-1)-meros distintos\n", entrada,
+            de_bruijn.num_kmeros, de_bruijn.num_nodos);
+    if (clase == EULER_NINGUNO) {
+        fprintf(stderr, "%s: El grafo de de Bruijn no tiene ciclo ni ruta euleriana "
+                "(faltan k-meros o hay más de una secuencia)\n", entrada);
+        liberar_de_bruijn(&de_bruijn);
+        liberar_grafo_csr(&grafo);
+        return 1;
+    }
+    
+    bool a_consola = !salida || strcmp(salida, "-") == 0;
+    FILE *archivo = a_consola ? stdout : fopen(salida, "wb");
+    bool ok = archivo != NULL;
+    if (ok) {
+        SumideroRecorrido sumidero;
+        SalidaSecuencia secuencia;
+        sumidero_secuencia(&sumidero, &secuencia, archivo, &de_bruijn, clase == EULER_CICLO);
+        ok = recorrido_euleriano_csr(&grafo, &sumidero, NULL, NULL);
+        buffer_liberar(&secuencia.buffer);
+        if (!a_consola && fclose(archivo) != 0) ok = false;
+    }
+    liberar_de_bruijn(&de_bruijn);
+    liberar_grafo_csr(&grafo);
+    
+    if (!ok) {
+        fprintf(stderr, "%s: Error al escribir la secuencia\n", a_consola ? "stdout" : salida);
+        return 1;
+    }
+    fprintf(stderr, "%s: secuencia %s\n", entrada, clase == EULER_CICLO ? "circular" : "lineal");
+    return 0;
+}
+
+// Distribuye grafos de cualquier tamaño: trabaja sobre el CSR, sin el límite de MAX_NODOS
+static int comando_distribuir(const char *entrada, const char *salida) {
+    GrafoCSR grafo;
+    ErrorCarga error;
+    if (!abrir_grafo_csr(entrada, &grafo, false, &error)) {
+        imprimir_error_carga(entrada, &error);
+        return 1;
+    }
+    if ((long long)grafo.num_nodos > (long long)(LIMITE_POSICION + 1) * (LIMITE_POSICION + 1)) {
+        fprintf(stderr, "%s: Hay más nodos que posiciones entre 0 y %d\n", entrada, LIMITE_POSICION);
+        liberar_grafo_csr(&grafo);
+        return 1;
+    }
+    
+    // Las posiciones de una instantánea proyectada son de solo lectura: las
+    // nuevas van en un arreglo aparte
+    Coordenada *posiciones = malloc((grafo.num_nodos > 0 ? (size_t)grafo.num_nodos : 1) * sizeof(Coordenada));
+    Distribucion distribucion;
+    bool ok = posiciones && iniciar_distribucion(&distribucion, &grafo, ITERACIONES_DISTRIBUCION);
+    if (ok) {
+        while (ok && distribucion.iteracion < distribucion.iteraciones) {
+            ok = paso_distribucion(&distribucion);
+        }
+        ok = ok && ajustar_posiciones_distribucion(&distribucion, LIMITE_POSICION, posiciones);
+        liberar_distribucion(&distribucion);
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: Memoria insuficiente\n", entrada);
+        free(posiciones);
+        liberar_grafo_csr(&grafo);
+        return 1;
+    }
+    
+    Coordenada *originales = grafo.posiciones;
+    grafo.posiciones = posiciones;
+    ok = guardar_grafo_csr(salida, formato_por_extension(salida), &grafo);
+    grafo.posiciones = originales;
+    free(posiciones);
+    liberar_grafo_csr(&grafo);
+    if (!ok) {
+        fprintf(stderr, "%s: Error al guardar el archivo\n", salida);
+        return 1;
+    }
+    return 0;
+}
+
+static int comando_recorrido(const char *ruta) {
+    FILE *archivo = fopen(ruta, "rb");
+    if (!archivo) {
+        fprintf(stderr, "%s: No se pudo abrir el archivo\n", ruta);
+        return 1;
+    }
+    
+    SumideroRecorrido sumidero;
+    SalidaRecorrido salida;
+    sumidero_archivo(&sumidero, &salida, stdout, RECORRIDO_TEXTO);
+    bool ok = leer_recorrido_binario(archivo, &sumidero);
+    buffer_liberar(&salida.buffer);
+    fclose(archivo);
+    
+    if (!ok) {
+        fprintf(stderr, "%s: Recorrido binario inválido o incompleto\n", ruta);
+        return 1;
+    }
+    return 0;
+}
+
+// Genera directamente en un CSR; si falla muestra el motivo
+static bool generar_grafo_csr(const ParametrosGenerador *parametros, GrafoCSR *grafo) {
+    ConstructorCSR constructor;
+    ReceptorGrafo receptor;
+    ErrorCarga error;
+    iniciar_constructor_csr(&constructor, grafo);
+    receptor_grafo_csr(&receptor, &constructor);
+    bool generado = generar_grafo(parametros, &receptor, &error);
+    bool construido = terminar_constructor_csr(&constructor);
+    if (!generado || !construido) {
+        fprintf(stderr, "%s: %s\n", nombre_familia(parametros->familia),
+                generado ? "Memoria insuficiente" : error.mensaje);
+        liberar_grafo_csr(grafo);
+        return false;
+    }
+    return true;
+}
+
+// FAMILIA N [PARAMETRO [SEMILLA]] de --generar. PARAMETRO es el grado en los
+// regulares y la densidad (0 a 1) en las demás; NULL usa los valores por omisión.
+static bool leer_parametros_generador(const char *familia, const char *nodos, const char *parametro,
+                                      const char *semilla, ParametrosGenerador *parametros) {
+    char *fin;
+    if (!familia_por_nombre(familia, &parametros->familia)) return false;
+    long n = strtol(nodos, &fin, 10);
+    if (*fin != '\0' || n < 1 || n >= INT_MAX) return false;
+    parametros->num_nodos = (int)n;
+    parametros->densidad = densidad_por_omision((int)n);
+    parametros->grado = GRADO_POR_OMISION;
+    parametros->semilla = SEMILLA_POR_OMISION;
+    parametros->limite_posicion = LIMITE_POSICION;
+    
+    if (parametro && parametros->familia == FAMILIA_REGULAR) {
+        long grado = strtol(parametro, &fin, 10);
+        if (*fin != '\0' || grado < 0 || grado >= INT_MAX) return false;
+        parametros->grado = (int)grado;
+    } else if (parametro) {
+        double densidad = strtod(parametro, &fin);
+        if (*fin != '\0' || !(densidad >= 0 && densidad <= 1)) return false;
+        parametros->densidad = densidad;
+    }
+    if (semilla) {
+        unsigned long long valor = strtoull(semilla, &fin, 10);
+        if (*fin != '\0' || *semilla == '-') return false;
+        parametros->semilla = valor;
+    }
+    return true;
+}
+
+// Genera una familia en cualquier tamaño (sin el límite de MAX_NODOS) y la
+// guarda en el formato de SALIDA
+static int comando_generar(const ParametrosGenerador *parametros, const char *salida) {
+    GrafoCSR grafo;
+    if (!generar_grafo_csr(parametros, &grafo)) return 1;
+    
+    long long aristas = grafo.tipo == NO_DIRIGIDO ? grafo.num_arcos / 2 : grafo.num_arcos;
+    bool ok = guardar_grafo_consola(&grafo, salida);
+    liberar_grafo_csr(&grafo);
+    if (!ok) {
+        fprintf(stderr, "%s: Error al guardar el archivo\n", salida);
+        return 1;
+    }
+    fprintf(stderr, "%s: %s, %d nodos, %lld aristas\n", salida, nombre_familia(parametros->familia),
+            parametros->num_nodos, aristas);
+    return 0;
+}
+
+// Modo --bench: mide los motores sobre las familias de generador.h en tamaños
+// crecientes. Los motores de la interfaz trabajan sobre grafo_actual, así que
+// cada instancia se carga ahí igual que un archivo (hasta MAX_NODOS nodos); el
+// clasificador y el recorrido de grafos grandes se miden sobre el CSR.
+static const int TAMANOS_BENCH_DENSO[] = {6, 9, 12};
+static const int TAMANOS_BENCH_CSR[] = {1000, 10000, 100000};
+#define MAX_ARCOS_BENCH 4000000.0       // Las instancias CSR más grandes se saltan
+
+static const ConfiguracionMedicion CONFIG_BENCH = {3, 21, 2000.0};
+
+// Los resultados se acumulan aquí para que el compilador no descarte llamadas
+static volatile long long resultado_bench;
+
+static void bench_conectividad(void *datos) {
+    (void)datos;
+    version_grafo++;    // Invalida la caché: se mide el cálculo, no la consulta
+    resultado_bench += conectividad_actual()->conexo;
+}
+
+static void bench_hamilton_decision(void *datos) {
+    (void)datos;
+    resultado_bench += tiene_ciclo_hamiltoniano() || tiene_ruta_hamiltoniana();
+}
+
+static void bench_hamilton_testigo(void *datos) {
+    (void)datos;
+    int secuencia[MAX_NODOS + 1];
+    int longitud = 0;
+    if (!encontrar_ciclo_hamiltoniano(secuencia, &longitud)) {
+        encontrar_ruta_hamiltoniana(secuencia, &longitud);
+    }
+    resultado_bench += longitud;
+}
+
+static void bench_hierholzer(void *datos) {
+    (void)datos;
+    int secuencia[MAX_NODOS * MAX_NODOS];
+    resultado_bench += es_euleriano() ? encontrar_ciclo_euleriano_hierholzer(secuencia)
+                                      : encontrar_ruta_euleriana_hierholzer(secuencia);
+}
+
+static void bench_fleury_ciclo(void *datos) {
+    (void)datos;
+    int secuencia[MAX_NODOS * MAX_NODOS];
+    int num_pasos = 0;
+    resultado_bench += encontrar_ciclo_euleriano_fleury_paso_a_paso(secuencia, NULL, &num_pasos, NULL);
+}
+
+static void bench_fleury_ruta(void *datos) {
+    (void)datos;
+    int secuencia[MAX_NODOS * MAX_NODOS];
+    int num_pasos = 0;
+    resultado_bench += encontrar_ruta_euleriana_fleury_paso_a_paso(secuencia, NULL, &num_pasos, NULL);
+}
+
+static void bench_reporte(void *datos) {
+    BufferTexto *reporte = (BufferTexto *)datos;
+    buffer_vaciar(reporte);
+    resultado_bench += armar_reporte_latex(reporte);
+}
+
+static bool contar_encabezado_bench(void *datos, int K, TipoGrafo tipo, ErrorCarga *error) {
+    (void)datos;
+    (void)K;
+    (void)tipo;
+    (void)error;
+    return true;
+}
+
+static void contar_arista_bench(void *datos, int u, int v, int peso) {
+    (void)u;
+    (void)v;
+    *(long long *)datos += peso;
+}
+
+static void bench_generar(void *datos) {
+    const ParametrosGenerador *parametros = (const ParametrosGenerador *)datos;
+    long long arcos = 0;
+    ReceptorGrafo receptor = {contar_encabezado_bench, contar_arista_bench, NULL, &arcos};
+    ErrorCarga error;
+    generar_grafo(parametros, &receptor, &error);
+    resultado_bench += arcos;
+}
+
+static void bench_clasificar_csr(void *datos) {
+    int inicio;
+    resultado_bench += clasificar_euleriano_csr((const GrafoCSR *)datos, &inicio);
+}
+
+static bool contar_vertice_bench(void *datos, int v) {
+    (void)v;
+    (*(long long *)datos)++;
+    return true;
+}
+
+static void bench_euler_csr(void *datos) {
+    long long vertices = 0;
+    SumideroRecorrido sumidero = {NULL, contar_vertice_bench, NULL, &vertices};
+    recorrido_euleriano_csr((const GrafoCSR *)datos, &sumidero, NULL, NULL);
+    resultado_bench += vertices;
+}
+
+// Mide un motor sobre la instancia de 'fila' y agrega el resultado a la tabla
+static bool medir_motor(TablaMediciones *tabla, Medicion fila, const char *motor,
+                        FuncionMedida funcion, void *datos) {
+    fila.motor = motor;
+    if (!medir(&CONFIG_BENCH, funcion, datos, &fila)) return false;
+    fprintf(stderr, "  %-10s %6d %-18s %12.3f us\n", fila.familia, fila.num_nodos, motor, fila.mediana_us);
+    return agregar_medicion(tabla, &fila);
+}
+
+static bool bench_instancia_densa(TablaMediciones *tabla, const ParametrosGenerador *parametros) {
+    Grafo generado;
+    ReceptorGrafo receptor;
+    ErrorCarga error;
+    receptor_grafo_denso(&receptor, &generado);
+    if (!generar_grafo(parametros, &receptor, &error)) {
+        fprintf(stderr, "%s: %s\n", nombre_familia(parametros->familia), error.mensaje);
+        return false;
+    }
+    grafo_actual = generado;
+    num_nodos_actual = generado.K;
+    grafo_modificado();
+    
+    Medicion fila = {0};
+    fila.familia = nombre_familia(parametros->familia);
+    fila.num_nodos = generado.K;
+    for (int i = 0; i < generado.K; i++) {
+        for (int j = 0; j < generado.K; j++) {
+            fila.aristas += generado.matriz_adyacencia[i][j];
+        }
+    }
+    if (generado.tipo == NO_DIRIGIDO) fila.aristas /= 2;
+    
+    BufferTexto reporte;
+    buffer_iniciar(&reporte);
+    bool euler = es_euleriano();
+    bool semi_euler = es_semieuleriano();
+    bool ok = medir_motor(tabla, fila, "conectividad", bench_conectividad, NULL) &&
+              medir_motor(tabla, fila, "hamilton_decision", bench_hamilton_decision, NULL) &&
+              medir_motor(tabla, fila, "hamilton_testigo", bench_hamilton_testigo, NULL) &&
+              (!(euler || semi_euler) || medir_motor(tabla, fila, "hierholzer", bench_hierholzer, NULL)) &&
+              (!euler || medir_motor(tabla, fila, "fleury_ciclo", bench_fleury_ciclo, NULL)) &&
+              (!semi_euler || medir_motor(tabla, fila, "fleury_ruta", bench_fleury_ruta, NULL)) &&
+              medir_motor(tabla, fila, "reporte", bench_reporte, &reporte);
+    buffer_liberar(&reporte);
+    return ok;
+}
+
+static bool bench_instancia_csr(TablaMediciones *tabla, ParametrosGenerador *parametros) {
+    GrafoCSR grafo;
+    if (!generar_grafo_csr(parametros, &grafo)) return false;
+    
+    Medicion fila = {0};
+    fila.familia = nombre_familia(parametros->familia);
+    fila.num_nodos = grafo.num_nodos;
+    fila.aristas = grafo.tipo == NO_DIRIGIDO ? grafo.num_arcos / 2 : grafo.num_arcos;
+    
+    int inicio;
+    bool ok = medir_motor(tabla, fila, "generar", bench_generar, parametros) &&
+              medir_motor(tabla, fila, "clasificar_csr", bench_clasificar_csr, &grafo) &&
+              (clasificar_euleriano_csr(&grafo, &inicio) == EULER_NINGUNO ||
+               medir_motor(tabla, fila, "euler_csr", bench_euler_csr, &grafo));
+    liberar_grafo_csr(&grafo);
+    return ok;
+}
+
+// Mide todas las familias y escribe la tabla en JSON o CSV. Sin SALIDA (o con
+// "-") se escribe en la salida estándar; el avance va a stderr.
+static int comando_bench(bool csv, const char *salida) {
+    TablaMediciones tabla;
+    iniciar_tabla_mediciones(&tabla);
+    bool ok = true;
+    
+    for (int f = 0; f < NUM_FAMILIAS && ok; f++) {
+        for (size_t t = 0; t < sizeof(TAMANOS_BENCH_DENSO) / sizeof(int) && ok; t++) {
+            int n = TAMANOS_BENCH_DENSO[t];
+            ParametrosGenerador parametros = {(FamiliaGrafo)f, n, densidad_por_omision(n),
+                                              GRADO_POR_OMISION, SEMILLA_POR_OMISION, LIMITE_POSICION};
+            ok = bench_instancia_densa(&tabla, &parametros);
+        }
+    }
+    for (int f = 0; f < NUM_FAMILIAS && ok; f++) {
+        for (size_t t = 0; t < sizeof(TAMANOS_BENCH_CSR) / sizeof(int) && ok; t++) {
+            int n = TAMANOS_BENCH_CSR[t];
+            ParametrosGenerador parametros = {(FamiliaGrafo)f, n, densidad_por_omision(n),
+                                              GRADO_POR_OMISION, SEMILLA_POR_OMISION, 0};
+            double arcos = aristas_esperadas(&parametros) * (f == FAMILIA_DIRIGIDO ? 1 : 2);
+            if (arcos > MAX_ARCOS_BENCH) continue;
+            ok = bench_instancia_csr(&tabla, &parametros);
+        }
+    }
+    
+    BufferTexto texto;
+    buffer_iniciar(&texto);
+    if (ok) {
+        if (csv) {
+            mediciones_csv(&tabla, &texto);
+        } else {
+            mediciones_json(&tabla, nombre_nivel_simd(nivel_simd()), &texto);
+        }
+        ok = !texto.error;
+    }
+    bool escrito = false;
+    if (ok) {
+        bool a_consola = !salida || strcmp(salida, "-") == 0;
+        escrito = a_consola ? fwrite(texto.datos, 1, texto.longitud, stdout) == texto.longitud
+                            : buffer_escribir_archivo(&texto, salida);
+        if (!escrito) fprintf(stderr, "%s: Error al escribir los resultados\n", a_consola ? "stdout" : salida);
+    } else {
+        fprintf(stderr, "bench: Memoria insuficiente\n");
+    }
+    buffer_liberar(&texto);
+    liberar_tabla_mediciones(&tabla);
+    return escrito ? 0 : 1;
+}
+
+// Atiende los comandos del modo consola, que usan el mismo cargador que la
+// interfaz. Devuelve -1 si no hay comando y se debe abrir la ventana; las
+// opciones desconocidas se dejan a GTK (por ejemplo --display).
+static int ejecutar_linea_comandos(int argc, char *argv[]) {
+    if (argc < 2) return -1;
+    const char *comando = argv[1];
+    
+    if (strcmp(comando, "--ayuda") == 0 || strcmp(comando, "-h") == 0) {
+        imprimir_uso(stdout, argv[0]);
+        return 0;
+    }
+    if (strcmp(comando, "--verificar") == 0 && argc == 3) {
+        return comando_verificar(argv[2]);
+    }
+    if (strcmp(comando, "--latex") == 0 && (argc == 3 || argc == 4)) {
+        return comando_latex(argv[2], argc == 4 ? argv[3] : "proyecto-4aa.tex");
+    }
+    if (strcmp(comando, "--euler") == 0 && (argc == 3 || argc == 4)) {
+        return comando_euler(argv[2], argc == 4 ? argv[3] : NULL, false, 0);
+    }
+    if (strcmp(comando, "--euler-externo") == 0 && argc >= 3 && argc <= 5) {
+        char *fin = NULL;
+        long memoria_mb = argc == 5 ? strtol(argv[4], &fin, 10) : 0;
+        if (argc < 5 || (*fin == '\0' && memoria_mb > 0 && memoria_mb <= (1L << 20))) {
+            return comando_euler(argv[2], argc >= 4 ? argv[3] : NULL, true, memoria_mb);
+        }
+    }
+    if (strcmp(comando, "--ensamblar") == 0 && (argc == 4 || argc == 5)) {
+        char *fin;
+        long k = strtol(argv[3], &fin, 10);
+        if (*fin == '\0' && k >= 2 && k <= MAX_K_DE_BRUIJN) {
+            return comando_ensamblar(argv[2], (int)k, argc == 5 ? argv[4] : NULL);
+        }
+    }
+    if (strcmp(comando, "--recorrido") == 0 && argc == 3) {
+        return comando_recorrido(argv[2]);
+    }
+    if (strcmp(comando, "--convertir") == 0 && argc == 4) {
+        return comando_convertir(argv[2], argv[3]);
+    }
+    if (strcmp(comando, "--distribuir") == 0 && argc == 4) {
+        return comando_distribuir(argv[2], argv[3]);
+    }
+    if (strcmp(comando, "--generar") == 0 && argc >= 5 && argc <= 7) {
+        ParametrosGenerador parametros;
+        if (leer_parametros_generador(argv[2], argv[3], argc >= 6 ? argv[5] : NULL,
+                                      argc == 7 ? argv[6] : NULL, &parametros)) {
+            return comando_generar(&parametros, argv[4]);
+        }
+    }
+    if (strcmp(comando, "--bench") == 0 && argc <= 4) {
+        if (argc == 2 || strcmp(argv[2], "json") == 0 || strcmp(argv[2], "csv") == 0) {
+            return comando_bench(argc > 2 && strcmp(argv[2], "csv") == 0, argc == 4 ? argv[3] : NULL);
+        }
+    }
+    if (strcmp(comando, "--verificar") == 0 || strcmp(comando, "--latex") == 0 ||
+        strcmp(comando, "--convertir") == 0 || strcmp(comando, "--euler") == 0 ||
+        strcmp(comando, "--euler-externo") == 0 || strcmp(comando, "--ensamblar") == 0 ||
+        strcmp(comando, "--recorrido") == 0 || strcmp(comando, "--distribuir") == 0 ||
+        strcmp(comando, "--generar") == 0 || strcmp(comando, "--bench") == 0) {
+        imprimir_uso(stderr, argv[0]);
+        return 2;
+    }
+    return -1;
+}
+
+int main(int argc, char *argv[]) {
+    int codigo = ejecutar_linea_comandos(argc, argv);
+    if (codigo >= 0) {
+        return codigo;
+    }
+    
+    gtk_init(&argc, &argv);
+    
+    builder = gtk_builder_new_from_file(GLADE_FILE);
+    if (!builder) {
+        GtkWidget *error_dialog = gtk_message_dialog_new(NULL,
+            GTK_DIALOG_MODAL, GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
+            "No se pudo cargar el archivo Glade: %s", GLADE_FILE);
+        gtk_dialog_run(GTK_DIALOG(error_dialog));
+        gtk_widget_destroy(error_dialog);
+        return 1;
+    }
+    
+    window_main = GTK_WIDGET(gtk_builder_get_object(builder, "window_main"));
+    area_matriz = GTK_WIDGET(gtk_builder_get_object(builder, "area_matriz"));
+    area_lienzo = GTK_WIDGET(gtk_builder_get_object(builder, "area_lienzo"));
+    box_lienzo = GTK_WIDGET(gtk_builder_get_object(builder, "box_lienzo"));
+    combo_recorrido = GTK_WIDGET(gtk_builder_get_object(builder, "combo_recorrido"));
+    btn_paso_anterior = GTK_WIDGET(gtk_builder_get_object(builder, "btn_paso_anterior"));
+    btn_reproducir = GTK_WIDGET(gtk_builder_get_object(builder, "btn_reproducir"));
+    btn_paso_siguiente = GTK_WIDGET(gtk_builder_get_object(builder, "btn_paso_siguiente"));
+    scale_paso = GTK_WIDGET(gtk_builder_get_object(builder, "scale_paso"));
+    spin_velocidad = GTK_WIDGET(gtk_builder_get_object(builder, "spin_velocidad"));
+    label_paso = GTK_LABEL(gtk_builder_get_object(builder, "label_paso"));
+    grid_posiciones = GTK_WIDGET(gtk_builder_get_object(builder, "grid_posiciones"));
+    spin_num_nodes = GTK_WIDGET(gtk_builder_get_object(builder, "spin_num_nodes"));
+    radio_no_dirigido = GTK_WIDGET(gtk_builder_get_object(builder, "radio_no_dirigido"));
+    radio_dirigido = GTK_WIDGET(gtk_builder_get_object(builder, "radio_dirigido"));
+    scroll_matriz = GTK_WIDGET(gtk_builder_get_object(builder, "scroll_matriz"));
+    notebook_main = GTK_WIDGET(gtk_builder_get_object(builder, "notebook_main"));
+    label_prop_euleriano = GTK_LABEL(gtk_builder_get_object(builder, "label_prop_euleriano"));
+    label_prop_conexidad = GTK_LABEL(gtk_builder_get_object(builder, "label_prop_conexidad"));
+    label_prop_ciclo_ham = GTK_LABEL(gtk_builder_get_object(builder, "label_prop_ciclo_ham"));
+    label_prop_ruta_ham = GTK_LABEL(gtk_builder_get_object(builder, "label_prop_ruta_ham"));
+    
+    GtkWidget *btn_clear = GTK_WIDGET(gtk_builder_get_object(builder, "btn_clear"));
+    GtkWidget *btn_generate_latex = GTK_WIDGET(gtk_builder_get_object(builder, "btn_generate_latex"));
+    GtkWidget *btn_apply_nodes = GTK_WIDGET(gtk_builder_get_object(builder, "btn_apply_nodes"));
+    GtkWidget *btn_save = GTK_WIDGET(gtk_builder_get_object(builder, "btn_save"));
+    GtkWidget *btn_load = GTK_WIDGET(gtk_builder_get_object(builder, "btn_load"));
+    GtkWidget *btn_preview = GTK_WIDGET(gtk_builder_get_object(builder, "btn_preview"));
+    GtkWidget *btn_distribuir = GTK_WIDGET(gtk_builder_get_object(builder, "btn_distribuir"));
+    GtkWidget *menu_save = GTK_WIDGET(gtk_builder_get_object(builder, "menu_save"));
+    GtkWidget *menu_load = GTK_WIDGET(gtk_builder_get_object(builder, "menu_load"));
+    GtkWidget *menu_quit = GTK_WIDGET(gtk_builder_get_object(builder, "menu_quit"));
+    
+    if (btn_clear) {
+        g_signal_connect(btn_clear, "clicked", G_CALLBACK(on_clear_clicked), NULL);
+    }
+    if (btn_generate_latex) {
+        g_signal_connect(btn_generate_latex, "clicked", G_CALLBACK(on_generate_latex_clicked), NULL);
+    }
+    if (btn_apply_nodes) {
+        g_signal_connect(btn_apply_nodes, "clicked", G_CALLBACK(on_apply_nodes_clicked), NULL);
+    }
+    if (btn_save) {
+        g_signal_connect(btn_save, "clicked", G_CALLBACK(on_save_button_clicked), NULL);
+    }
+    if (btn_load) {
+        g_signal_connect(btn_load, "clicked", G_CALLBACK(on_load_button_clicked), NULL);
+    }
+    if (btn_preview) {
+        g_signal_connect(btn_preview, "clicked", G_CALLBACK(on_preview_clicked), NULL);
+    }
+    if (btn_distribuir) {
+        g_signal_connect(btn_distribuir, "clicked", G_CALLBACK(on_distribuir_clicked), NULL);
+    }
+    if (radio_no_dirigido) {
+        g_signal_connect(radio_no_dirigido, "toggled", G_CALLBACK(on_tipo_grafo_changed), NULL);
+    }
+    if (radio_dirigido) {
+        g_signal_connect(radio_dirigido, "toggled", G_CALLBACK(on_tipo_grafo_changed), NULL);
+    }
+    if (spin_num_nodes) {
+        g_signal_connect(spin_num_nodes, "value-changed", G_CALLBACK(on_num_nodes_changed), NULL);
     }
     if (menu_save) {
         g_signal_connect(menu_save, "activate", G_CALLBACK(on_save_clicked), NULL);
@@ -3333,12 +5699,38 @@ int main(int argc, char *argv[]) {
     if (menu_quit) {
         g_signal_connect(menu_quit, "activate", G_CALLBACK(on_quit_clicked), NULL);
     }
+    if (area_matriz) {
+        gtk_widget_add_events(area_matriz, GDK_BUTTON_PRESS_MASK | GDK_KEY_PRESS_MASK | GDK_FOCUS_CHANGE_MASK);
+        g_signal_connect(area_matriz, "draw", G_CALLBACK(on_matriz_draw), NULL);
+        g_signal_connect(area_matriz, "button-press-event", G_CALLBACK(on_matriz_button_press), NULL);
+        g_signal_connect(area_matriz, "key-press-event", G_CALLBACK(on_matriz_key_press), NULL);
+        g_signal_connect(area_matriz, "focus-in-event", G_CALLBACK(on_matriz_foco), NULL);
+        g_signal_connect(area_matriz, "focus-out-event", G_CALLBACK(on_matriz_foco), NULL);
+    }
+    
+    if (area_lienzo) {
+        gtk_widget_add_events(area_lienzo, GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK |
+                              GDK_BUTTON_MOTION_MASK | GDK_SCROLL_MASK | GDK_SMOOTH_SCROLL_MASK |
+                              GDK_KEY_PRESS_MASK);
+        g_signal_connect(area_lienzo, "draw", G_CALLBACK(on_lienzo_draw), NULL);
+        g_signal_connect(area_lienzo, "button-press-event", G_CALLBACK(on_lienzo_button_press), NULL);
+        g_signal_connect(area_lienzo, "motion-notify-event", G_CALLBACK(on_lienzo_motion), NULL);
+        g_signal_connect(area_lienzo, "button-release-event", G_CALLBACK(on_lienzo_button_release), NULL);
+        g_signal_connect(area_lienzo, "scroll-event", G_CALLBACK(on_lienzo_scroll), NULL);
+        g_signal_connect(area_lienzo, "key-press-event", G_CALLBACK(on_lienzo_key_press), NULL);
+    }
+    if (combo_recorrido) {
+        g_signal_connect(combo_recorrido, "changed", G_CALLBACK(on_recorrido_changed), NULL);
+        g_signal_connect(btn_reproducir, "clicked", G_CALLBACK(on_reproducir_clicked), NULL);
+        g_signal_connect(btn_paso_anterior, "clicked", G_CALLBACK(on_paso_anterior_clicked), NULL);
+        g_signal_connect(btn_paso_siguiente, "clicked", G_CALLBACK(on_paso_siguiente_clicked), NULL);
+        g_signal_connect(scale_paso, "value-changed", G_CALLBACK(on_paso_scale_changed), NULL);
+    }
     
     grafo_actual.K = 0;
     grafo_actual.tipo = NO_DIRIGIDO;
     memset(grafo_actual.matriz_adyacencia, 0, sizeof(grafo_actual.matriz_adyacencia));
     memset(grafo_actual.posiciones, 0, sizeof(grafo_actual.posiciones));
-    memset(matriz_entries, 0, sizeof(matriz_entries));
     memset(pos_x_spins, 0, sizeof(pos_x_spins));
     memset(pos_y_spins, 0, sizeof(pos_y_spins));
     
@@ -0,0 +1,3 @@
+# El número de aristas no cabe en 64 bits: se rechaza en lugar de recortarse
+2 0 99999999999999999999
+0 1
@@ -0,0 +1,64 @@
+#!/bin/sh
+# Pruebas de regresión de la línea de comandos: cada caso corre el programa sobre
+# un archivo de este directorio y compara el código de salida y lo que escribe.
+# Uso: sh pruebas/correr.sh [PROGRAMA]   (por defecto ./proyecto-4aa)
+
+cd "$(dirname "$0")/.." || exit 1
+programa=${1:-./proyecto-4aa}
+total=0
+fallos=0
+
+# caso CÓDIGO SALIDA ARGUMENTOS...: SALIDA es lo esperado en stdout y stderr juntos
+caso() {
+    esperado_codigo=$1
+    esperado=$2
+    shift 2
+    total=$((total + 1))
+    obtenido=$("$programa" "$@" 2>&1)
+    codigo=$?
+    if [ "$codigo" -ne "$esperado_codigo" ] || [ "$obtenido" != "$esperado" ]; then
+        fallos=$((fallos + 1))
+        echo "FALLA: $*"
+        echo "  esperado ($esperado_codigo): $esperado"
+        echo "  obtenido ($codigo): $obtenido"
+    fi
+}
+
+# Una sección CDATA cuyo texto termina en ']' se cierra con "]]]>"
+caso 0 "pruebas/cdata_corchete.graphml: 3 nodos, no dirigido, 3 aristas" \
+    --verificar pruebas/cdata_corchete.graphml
+
+# Instantánea (little-endian) con la cabecera intacta y un destino fuera de rango:
+# se rechaza al abrirla aunque no se calcule la suma
+caso 1 "pruebas/destino_fuera.p4g: Arco con destino fuera de rango" \
+    --euler pruebas/destino_fuera.p4g
+
+# Un entero de 20 cifras es un error de rango en su posición, no un valor recortado
+caso 1 "pruebas/aristas_desborde.el:2:5: Valor 99999999999999999999 fuera de rango para el número de aristas (debe estar entre 0 y 2305843009213693951)" \
+    --verificar pruebas/aristas_desborde.el
+
+# En un DOT 'strict' las aristas repetidas se cargan una sola vez
+caso 0 "pruebas/estricto.dot: 3 nodos, no dirigido, 3 aristas" \
+    --verificar pruebas/estricto.dot
+
+# Matriz no dirigida que no es simétrica aunque los totales coinciden
+# (a[0][1] = a[2][0] = 1): se rechaza en lugar de recorrer otro grafo
+caso 1 "pruebas/asimetrica.txt: La matriz de un grafo no dirigido no es simétrica" \
+    --euler-externo pruebas/asimetrica.txt
+# El motor en memoria la rechaza igual al emparejar los arcos
+caso 1 "pruebas/asimetrica.txt: La matriz de un grafo no dirigido no es simétrica" \
+    --euler pruebas/asimetrica.txt
+
+# Líneas '#' del preprocesador de C en DOT, al principio y con sangría
+caso 0 "pruebas/preprocesador.dot: 3 nodos, no dirigido, 2 aristas" \
+    --verificar pruebas/preprocesador.dot
+
+# GraphML: directed="false" en un grafo dirigido son dos arcos; directed="true"
+# en uno no dirigido se rechaza
+caso 0 "pruebas/mixto.graphml: 3 nodos, dirigido, 3 aristas" \
+    --verificar pruebas/mixto.graphml
+caso 1 "pruebas/mixto_no_dirigido.graphml:9:5: Arista dirigida en un grafo no dirigido: los grafos mixtos no están soportados" \
+    --verificar pruebas/mixto_no_dirigido.graphml
+
+echo "$((total - fallos)) de $total pruebas correctas"
+[ "$fallos" -eq 0 ]
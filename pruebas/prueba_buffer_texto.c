@@ -0,0 +1,51 @@
+// Compara buffer_agregar_fijo con "%.*f" de printf, en especial en los valores
+// que quedan a mitad de camino entre dos redondeos
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../buffer_texto.h"
+
+static int fallos = 0;
+static int total = 0;
+
+static void comparar(double valor, int decimales) {
+    char esperado[64];
+    snprintf(esperado, sizeof(esperado), "%.*f", decimales, valor);
+    BufferTexto b;
+    buffer_iniciar(&b);
+    buffer_agregar_fijo(&b, valor, decimales);
+    buffer_agregar_caracter(&b, '\0');
+    total++;
+    if (b.error || strcmp(b.datos, esperado) != 0) {
+        fallos++;
+        printf("FALLA: %.17g con %d decimales: esperado %s, obtenido %s\n",
+               valor, decimales, esperado, b.error ? "(sin memoria)" : b.datos);
+    }
+    buffer_liberar(&b);
+}
+
+int main(void) {
+    // Empates y casi empates: 0.125 es exacto (printf redondea al par), 2.675 y
+    // 1.005 quedan apenas por debajo de la mitad en binario
+    static const double empates[] = {0.125, 0.375, 2.5, 3.5, 2.675, 1.005, 0.045, 12.0 / 96,
+                                     -0.125, -2.675, 0.5, 1.5, -0.5, -0.001, 0.0, -0.0};
+    for (size_t i = 0; i < sizeof(empates) / sizeof(empates[0]); i++) {
+        for (int d = 0; d <= 4; d++) {
+            comparar(empates[i], d);
+        }
+    }
+    // Escalas del reporte (12 cm sobre el ancho en píxeles) y valores al azar
+    for (int ancho = 1; ancho <= 4000; ancho++) {
+        comparar(12.0 / ancho, 2);
+    }
+    srand(1);
+    for (int i = 0; i < 100000; i++) {
+        double valor = (rand() - RAND_MAX / 2) / 1000.0;
+        comparar(valor, rand() % 5);
+        comparar(valor / 8, 2);
+    }
+
+    printf("%d de %d pruebas correctas\n", total - fallos, total);
+    return fallos == 0 ? 0 : 1;
+}
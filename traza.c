@@ -0,0 +1,137 @@
+#include "traza.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void iniciar_traza(Traza *traza, const Grafo *grafo, int inicio) {
+    memset(traza, 0, sizeof(*traza));
+    traza->K = grafo->K;
+    traza->tipo = grafo->tipo;
+    traza->inicio = inicio;
+    traza->actual.tope = -1;
+    memcpy(traza->actual.restante, grafo->matriz_adyacencia, sizeof(traza->actual.restante));
+
+    traza->capacidad_claves = 16;
+    traza->claves = malloc((size_t)traza->capacidad_claves * sizeof(EstadoTraza));
+    if (!traza->claves) {
+        traza->sin_memoria = true;
+        return;
+    }
+    traza->claves[traza->num_claves++] = traza->actual;
+}
+
+void liberar_traza(Traza *traza) {
+    free(traza->deltas);
+    free(traza->claves);
+    free(traza->circuito);
+    traza->deltas = NULL;
+    traza->claves = NULL;
+    traza->circuito = NULL;
+    traza->num_deltas = 0;
+    traza->num_claves = 0;
+}
+
+// Duplica la capacidad de un arreglo; deja el original intacto si no hay memoria
+static bool crecer(void **arreglo, int *capacidad, size_t tam_elemento, int minima) {
+    if (*capacidad >= minima) return true;
+    int nueva = *capacidad > 0 ? *capacidad : 64;
+    while (nueva < minima) {
+        if (nueva > (1 << 29)) return false;
+        nueva *= 2;
+    }
+    void *ampliado = realloc(*arreglo, (size_t)nueva * tam_elemento);
+    if (!ampliado) return false;
+    *arreglo = ampliado;
+    *capacidad = nueva;
+    return true;
+}
+
+int vertice_entrada_traza(const Traza *traza, int entrada) {
+    return entrada >= 0 ? traza->deltas[entrada].v : traza->inicio;
+}
+
+int entrada_debajo_traza(const Traza *traza, int entrada) {
+    return entrada >= 0 ? traza->deltas[entrada].debajo : PILA_VACIA_TRAZA;
+}
+
+static void aplicar_delta(const Traza *traza, EstadoTraza *estado) {
+    const DeltaTraza *d = &traza->deltas[estado->paso];
+    if (d->tipo == DELTA_AVANZAR) {
+        estado->restante[d->u][d->v]--;
+        if (traza->tipo == NO_DIRIGIDO) {
+            estado->restante[d->v][d->u]--;
+        }
+        estado->tope = estado->paso;
+    } else {
+        estado->tope = entrada_debajo_traza(traza, estado->tope);
+        estado->len_circuito++;
+    }
+    estado->paso++;
+}
+
+static DeltaTraza *nuevo_delta(Traza *traza) {
+    if (traza->sin_memoria) return NULL;
+    int n = traza->num_deltas;
+    if (n > 0 && n % INTERVALO_CLAVES_TRAZA == 0) {
+        if (!crecer((void **)&traza->claves, &traza->capacidad_claves, sizeof(EstadoTraza),
+                    traza->num_claves + 1)) {
+            traza->sin_memoria = true;
+            return NULL;
+        }
+        traza->claves[traza->num_claves++] = traza->actual;
+    }
+    if (!crecer((void **)&traza->deltas, &traza->capacidad_deltas, sizeof(DeltaTraza), n + 1)) {
+        traza->sin_memoria = true;
+        return NULL;
+    }
+    DeltaTraza *d = &traza->deltas[n];
+    memset(d, 0, sizeof(*d));
+    return d;
+}
+
+void traza_avanzar(Traza *traza, int u, int v, bool puente) {
+    DeltaTraza *d = nuevo_delta(traza);
+    if (!d) return;
+    d->tipo = DELTA_AVANZAR;
+    d->u = u;
+    d->v = v;
+    d->debajo = traza->actual.tope;
+    d->puente = puente;
+    traza->num_deltas++;
+    aplicar_delta(traza, &traza->actual);
+}
+
+void traza_retroceder(Traza *traza, bool cierra_ciclo) {
+    if (traza->actual.tope == PILA_VACIA_TRAZA) return;
+    DeltaTraza *d = nuevo_delta(traza);
+    if (!d) return;
+    if (!crecer((void **)&traza->circuito, &traza->capacidad_circuito, sizeof(int),
+                traza->actual.len_circuito + 1)) {
+        traza->sin_memoria = true;
+        return;
+    }
+    d->tipo = DELTA_RETROCEDER;
+    d->u = vertice_entrada_traza(traza, traza->actual.tope);
+    d->v = d->u;
+    d->debajo = PILA_VACIA_TRAZA;
+    d->cierra_ciclo = cierra_ciclo;
+    traza->circuito[traza->actual.len_circuito] = d->u;
+    traza->num_deltas++;
+    aplicar_delta(traza, &traza->actual);
+}
+
+void ir_a_paso_traza(const Traza *traza, EstadoTraza *estado, int paso) {
+    if (paso < 0) paso = 0;
+    if (paso > traza->num_deltas) paso = traza->num_deltas;
+
+    bool seguir = estado->paso >= 0 && estado->paso <= paso &&
+                  paso - estado->paso < INTERVALO_CLAVES_TRAZA;
+    if (!seguir) {
+        int k = paso / INTERVALO_CLAVES_TRAZA;
+        if (k >= traza->num_claves) k = traza->num_claves - 1;
+        *estado = traza->claves[k];
+    }
+    while (estado->paso < paso) {
+        aplicar_delta(traza, estado);
+    }
+}
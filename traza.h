@@ -0,0 +1,75 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <stdbool.h>
+#include "grafo.h"
+
+// Traza de un recorrido euleriano paso a paso (Hierholzer o Fleury) para
+// reproducirla en la interfaz. En lugar de guardar una foto del estado por paso
+// (como PasoHierholzer y PasoFleury) se guarda solo lo que cambia: avanzar por
+// una arista o retroceder desde la cima de la pila. Para ir a cualquier paso se
+// parte del cuadro clave anterior, guardado cada INTERVALO_CLAVES_TRAZA pasos,
+// y se repiten como mucho ese número de cambios, así que buscar cuesta lo mismo
+// con diez pasos que con cientos de miles.
+//
+// La pila del recorrido es persistente: cada avance es una entrada que recuerda
+// la entrada que tenía debajo, de modo que la pila de cualquier paso se lee
+// desde su cima sin copiarla. La entrada -1 es el vértice inicial.
+
+#define INTERVALO_CLAVES_TRAZA 512
+#define PILA_VACIA_TRAZA -2
+
+typedef enum {
+    DELTA_AVANZAR,          // Se usa la arista u -> v y v queda en la cima
+    DELTA_RETROCEDER        // La cima u sale de la pila y se agrega al circuito
+} TipoDelta;
+
+typedef struct {
+    int u;
+    int v;
+    int debajo;                 // DELTA_AVANZAR: cima anterior de la pila
+    unsigned char tipo;
+    unsigned char puente;       // Fleury: la arista elegida era un puente
+    unsigned char cierra_ciclo; // Hierholzer: el retroceso completa un ciclo parcial
+} DeltaTraza;
+
+// Estado después de 'paso' cambios
+typedef struct {
+    int paso;
+    int tope;                   // Entrada en la cima, -1 o PILA_VACIA_TRAZA
+    int len_circuito;           // Vértices de 'circuito' ya agregados
+    int restante[MAX_NODOS][MAX_NODOS];
+} EstadoTraza;
+
+typedef struct {
+    int K;
+    TipoGrafo tipo;
+    int inicio;
+    DeltaTraza *deltas;
+    int num_deltas;
+    int capacidad_deltas;
+    EstadoTraza *claves;        // claves[k]: estado en el paso k * INTERVALO_CLAVES_TRAZA
+    int num_claves;
+    int capacidad_claves;
+    int *circuito;              // Vértices en el orden en que salen de la pila
+    int capacidad_circuito;
+    EstadoTraza actual;         // Estado al final de lo grabado
+    bool sin_memoria;           // Falló una reserva; lo grabado después se pierde
+} Traza;
+
+// Empieza a grabar sobre 'grafo' desde 'inicio'
+void iniciar_traza(Traza *traza, const Grafo *grafo, int inicio);
+void traza_avanzar(Traza *traza, int u, int v, bool puente);
+void traza_retroceder(Traza *traza, bool cierra_ciclo);
+void liberar_traza(Traza *traza);
+
+// Lleva 'estado' al paso indicado (entre 0 y num_deltas). Si 'estado' viene
+// de una llamada anterior y el paso está poco más adelante, sigue desde ahí;
+// con estado->paso < 0 siempre parte de un cuadro clave.
+void ir_a_paso_traza(const Traza *traza, EstadoTraza *estado, int paso);
+
+// Vértice de una entrada de la pila y la entrada que tiene debajo
+int vertice_entrada_traza(const Traza *traza, int entrada);
+int entrada_debajo_traza(const Traza *traza, int entrada);
+
+#endif